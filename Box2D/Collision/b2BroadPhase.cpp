@@ -29,17 +29,28 @@ b2BroadPhase::b2BroadPhase()
 	m_moveCapacity = 16;
 	m_moveCount = 0;
 	m_moveBuffer = (int32*)b2Alloc(m_moveCapacity * sizeof(int32));
+
+	m_moveKeyCapacity = 16;
+	m_moveKeys = (b2MoveKey*)b2Alloc(m_moveKeyCapacity * sizeof(b2MoveKey));
+
+	m_queryProxyId = e_nullProxy;
+	m_queryTree = e_dynamicTree;
 }
 
 b2BroadPhase::~b2BroadPhase()
 {
 	b2Free(m_moveBuffer);
+	b2Free(m_moveKeys);
 	b2Free(m_pairBuffer);
 }
 
-int32 b2BroadPhase::CreateProxy(const b2AABB& aabb, void* userData)
+int32 b2BroadPhase::CreateProxy(const b2AABB& aabb, void* userData, bool isStatic)
 {
-	int32 proxyId = m_tree.CreateProxy(aabb, userData);
+	// New proxies are held back and built into the tree together
+	// on the next pair update.
+	int32 tree = isStatic ? e_staticTree : e_dynamicTree;
+	int32 nodeId = m_trees[tree].CreateDeferredProxy(aabb, userData);
+	int32 proxyId = MakeProxyId(nodeId, tree);
 	++m_proxyCount;
 	BufferMove(proxyId);
 	return proxyId;
@@ -49,12 +60,12 @@ void b2BroadPhase::DestroyProxy(int32 proxyId)
 {
 	UnBufferMove(proxyId);
 	--m_proxyCount;
-	m_tree.DestroyProxy(proxyId);
+	GetTree(proxyId).DestroyProxy(GetNodeId(proxyId));
 }
 
 void b2BroadPhase::MoveProxy(int32 proxyId, const b2AABB& aabb, const b2Vec2& displacement)
 {
-	bool buffer = m_tree.MoveProxy(proxyId, aabb, displacement);
+	bool buffer = GetTree(proxyId).MoveProxy(GetNodeId(proxyId), aabb, displacement);
 	if (buffer)
 	{
 		BufferMove(proxyId);
@@ -68,6 +79,16 @@ void b2BroadPhase::TouchProxy(int32 proxyId)
 
 void b2BroadPhase::BufferMove(int32 proxyId)
 {
+	// A proxy is only queried once per update.
+	b2DynamicTree& tree = GetTree(proxyId);
+	int32 nodeId = GetNodeId(proxyId);
+	if (tree.WasMoved(nodeId))
+	{
+		return;
+	}
+
+	tree.SetMoved(nodeId, true);
+
 	if (m_moveCount == m_moveCapacity)
 	{
 		int32* oldBuffer = m_moveBuffer;
@@ -92,15 +113,88 @@ void b2BroadPhase::UnBufferMove(int32 proxyId)
 	}
 }
 
+// Spread the low 16 bits of x out to the even bits.
+static inline uint32 b2SpreadBits(uint32 x)
+{
+	x &= 0x0000ffff;
+	x = (x | (x << 8)) & 0x00ff00ff;
+	x = (x | (x << 4)) & 0x0f0f0f0f;
+	x = (x | (x << 2)) & 0x33333333;
+	x = (x | (x << 1)) & 0x55555555;
+	return x;
+}
+
+// Drop the destroyed proxies from the move buffer and sort the rest by the
+// Morton code of their fat AABB centers.
+void b2BroadPhase::SortMoveBuffer()
+{
+	if (m_moveKeyCapacity < m_moveCount)
+	{
+		b2Free(m_moveKeys);
+		m_moveKeyCapacity = m_moveCapacity;
+		m_moveKeys = (b2MoveKey*)b2Alloc(m_moveKeyCapacity * sizeof(b2MoveKey));
+	}
+
+	int32 count = 0;
+	b2Vec2 lower(b2_maxFloat, b2_maxFloat);
+	b2Vec2 upper(-b2_maxFloat, -b2_maxFloat);
+	for (int32 i = 0; i < m_moveCount; ++i)
+	{
+		int32 proxyId = m_moveBuffer[i];
+		if (proxyId == e_nullProxy)
+		{
+			continue;
+		}
+
+		b2Vec2 c = GetFatAABB(proxyId).GetCenter();
+		lower = b2Min(lower, c);
+		upper = b2Max(upper, c);
+
+		m_moveBuffer[count] = proxyId;
+		++count;
+	}
+	m_moveCount = count;
+
+	if (count < 2)
+	{
+		return;
+	}
+
+	b2Vec2 extent = upper - lower;
+	float32 scale = 65535.0f / b2Max(b2Max(extent.x, extent.y), b2_epsilon);
+	for (int32 i = 0; i < count; ++i)
+	{
+		int32 proxyId = m_moveBuffer[i];
+		b2Vec2 c = scale * (GetFatAABB(proxyId).GetCenter() - lower);
+		m_moveKeys[i].code = b2SpreadBits(uint32(c.x)) | (b2SpreadBits(uint32(c.y)) << 1);
+		m_moveKeys[i].proxyId = proxyId;
+	}
+
+	std::sort(m_moveKeys, m_moveKeys + count, b2MoveKeyLessThan);
+
+	for (int32 i = 0; i < count; ++i)
+	{
+		m_moveBuffer[i] = m_moveKeys[i].proxyId;
+	}
+}
+
 // This is called from b2DynamicTree::Query when we are gathering pairs.
-bool b2BroadPhase::QueryCallback(int32 proxyId)
+bool b2BroadPhase::QueryCallback(int32 nodeId)
 {
+	int32 proxyId = MakeProxyId(nodeId, m_queryTree);
+
 	// A proxy cannot form a pair with itself.
 	if (proxyId == m_queryProxyId)
 	{
 		return true;
 	}
 
+	// Both proxies moved so both query. Only one adds the pair.
+	if (proxyId < m_queryProxyId && m_trees[m_queryTree].WasMoved(nodeId))
+	{
+		return true;
+	}
+
 	// Grow the pair buffer as needed.
 	if (m_pairCount == m_pairCapacity)
 	{
@@ -30,9 +30,19 @@ struct b2Pair
 	int32 proxyIdB;
 };
 
+/// A moved proxy keyed by the Morton code of its fat AABB center.
+struct b2MoveKey
+{
+	uint32 code;
+	int32 proxyId;
+};
+
 /// The broad-phase is used for computing pairs and performing volume queries and ray casts.
 /// This broad-phase does not persist pairs. Instead, this reports potentially new pairs.
 /// It is up to the client to consume the new pairs and to track subsequent overlap.
+/// Static proxies are kept in their own tree. They never pair with each other and
+/// a level's worth of them is bulk built into a tree on the next pair update.
+/// A proxy id holds the tree node index and the tree it is in.
 class b2BroadPhase
 {
 public:
@@ -46,8 +56,8 @@ public:
 	~b2BroadPhase();
 
 	/// Create a proxy with an initial AABB. Pairs are not reported until
-	/// UpdatePairs is called.
-	int32 CreateProxy(const b2AABB& aabb, void* userData);
+	/// UpdatePairs is called. Static proxies don't pair with each other.
+	int32 CreateProxy(const b2AABB& aabb, void* userData, bool isStatic = false);
 
 	/// Destroy a proxy. It is up to the client to remove any pairs.
 	void DestroyProxy(int32 proxyId);
@@ -90,13 +100,13 @@ public:
 	template <typename T>
 	void RayCast(T* callback, const b2RayCastInput& input) const;
 
-	/// Get the height of the embedded tree.
+	/// Get the height of the taller embedded tree.
 	int32 GetTreeHeight() const;
 
-	/// Get the balance of the embedded tree.
+	/// Get the worst balance of the embedded trees.
 	int32 GetTreeBalance() const;
 
-	/// Get the quality metric of the embedded tree.
+	/// Get the quality metric of the embedded tree for moving proxies.
 	float32 GetTreeQuality() const;
 
 	/// Shift the world origin. Useful for large worlds.
@@ -108,12 +118,65 @@ private:
 
 	friend class b2DynamicTree;
 
+	enum
+	{
+		e_dynamicTree = 0,
+		e_staticTree = 1
+	};
+
+	/// Passes a tree query on to the client with broad-phase proxy ids.
+	template <typename T>
+	struct QueryWrapper
+	{
+		bool QueryCallback(int32 nodeId)
+		{
+			return callback->QueryCallback(MakeProxyId(nodeId, tree));
+		}
+
+		T* callback;
+		int32 tree;
+	};
+
+	/// Passes a tree ray cast on to the client with broad-phase proxy ids.
+	/// The clipped ray and termination carry over to the next tree.
+	template <typename T>
+	struct RayCastWrapper
+	{
+		float32 RayCastCallback(const b2RayCastInput& input, int32 nodeId)
+		{
+			float32 value = callback->RayCastCallback(input, MakeProxyId(nodeId, tree));
+			if (value == 0.0f)
+			{
+				terminated = true;
+			}
+			else if (value > 0.0f)
+			{
+				maxFraction = value;
+			}
+			return value;
+		}
+
+		T* callback;
+		int32 tree;
+		float32 maxFraction;
+		bool terminated;
+	};
+
+	static int32 MakeProxyId(int32 nodeId, int32 tree) { return (nodeId << 1) | tree; }
+	static int32 GetNodeId(int32 proxyId) { return proxyId >> 1; }
+	static int32 GetTreeIndex(int32 proxyId) { return proxyId & 1; }
+
+	b2DynamicTree& GetTree(int32 proxyId) { return m_trees[GetTreeIndex(proxyId)]; }
+	const b2DynamicTree& GetTree(int32 proxyId) const { return m_trees[GetTreeIndex(proxyId)]; }
+
 	void BufferMove(int32 proxyId);
 	void UnBufferMove(int32 proxyId);
 
-	bool QueryCallback(int32 proxyId);
+	void SortMoveBuffer();
 
-	b2DynamicTree m_tree;
+	bool QueryCallback(int32 nodeId);
+
+	b2DynamicTree m_trees[2];
 
 	int32 m_proxyCount;
 
@@ -121,11 +184,15 @@ private:
 	int32 m_moveCapacity;
 	int32 m_moveCount;
 
+	b2MoveKey* m_moveKeys;
+	int32 m_moveKeyCapacity;
+
 	b2Pair* m_pairBuffer;
 	int32 m_pairCapacity;
 	int32 m_pairCount;
 
 	int32 m_queryProxyId;
+	int32 m_queryTree;
 };
 
 /// This is used to sort pairs.
@@ -144,21 +211,32 @@ inline bool b2PairLessThan(const b2Pair& pair1, const b2Pair& pair2)
 	return false;
 }
 
+/// This is used to sort moved proxies along the Morton curve.
+inline bool b2MoveKeyLessThan(const b2MoveKey& key1, const b2MoveKey& key2)
+{
+	if (key1.code != key2.code)
+	{
+		return key1.code < key2.code;
+	}
+
+	return key1.proxyId < key2.proxyId;
+}
+
 inline void* b2BroadPhase::GetUserData(int32 proxyId) const
 {
-	return m_tree.GetUserData(proxyId);
+	return GetTree(proxyId).GetUserData(GetNodeId(proxyId));
 }
 
 inline bool b2BroadPhase::TestOverlap(int32 proxyIdA, int32 proxyIdB) const
 {
-	const b2AABB& aabbA = m_tree.GetFatAABB(proxyIdA);
-	const b2AABB& aabbB = m_tree.GetFatAABB(proxyIdB);
+	const b2AABB& aabbA = GetFatAABB(proxyIdA);
+	const b2AABB& aabbB = GetFatAABB(proxyIdB);
 	return b2TestOverlap(aabbA, aabbB);
 }
 
 inline const b2AABB& b2BroadPhase::GetFatAABB(int32 proxyId) const
 {
-	return m_tree.GetFatAABB(proxyId);
+	return GetTree(proxyId).GetFatAABB(GetNodeId(proxyId));
 }
 
 inline int32 b2BroadPhase::GetProxyCount() const
@@ -168,90 +246,114 @@ inline int32 b2BroadPhase::GetProxyCount() const
 
 inline int32 b2BroadPhase::GetTreeHeight() const
 {
-	return m_tree.GetHeight();
+	return b2Max(m_trees[e_dynamicTree].GetHeight(), m_trees[e_staticTree].GetHeight());
 }
 
 inline int32 b2BroadPhase::GetTreeBalance() const
 {
-	return m_tree.GetMaxBalance();
+	return b2Max(m_trees[e_dynamicTree].GetMaxBalance(), m_trees[e_staticTree].GetMaxBalance());
 }
 
 inline float32 b2BroadPhase::GetTreeQuality() const
 {
-	return m_tree.GetAreaRatio();
+	return m_trees[e_dynamicTree].GetAreaRatio();
 }
 
 template <typename T>
 void b2BroadPhase::UpdatePairs(T* callback)
 {
+	// Build the proxies created since the last update into the trees.
+	m_trees[e_dynamicTree].InsertPending();
+	m_trees[e_staticTree].InsertPending();
+
 	// Reset pair buffer
 	m_pairCount = 0;
 
-	// Perform tree queries for all moving proxies.
+	// Query in Morton order so that neighboring queries walk
+	// the same tree nodes.
+	SortMoveBuffer();
+
+	// Perform tree queries for all moving proxies. Every proxy queries the
+	// dynamic tree and only non-static proxies query the static tree. A pair
+	// of moved proxies is only added by the query of the larger id.
 	for (int32 i = 0; i < m_moveCount; ++i)
 	{
 		m_queryProxyId = m_moveBuffer[i];
-		if (m_queryProxyId == e_nullProxy)
-		{
-			continue;
-		}
 
 		// We have to query the tree with the fat AABB so that
 		// we don't fail to create a pair that may touch later.
-		const b2AABB& fatAABB = m_tree.GetFatAABB(m_queryProxyId);
+		const b2AABB& fatAABB = GetFatAABB(m_queryProxyId);
 
 		// Query tree, create pairs and add them pair buffer.
-		m_tree.Query(this, fatAABB);
+		m_queryTree = e_dynamicTree;
+		m_trees[e_dynamicTree].Query(this, fatAABB);
+
+		if (GetTreeIndex(m_queryProxyId) == e_dynamicTree)
+		{
+			m_queryTree = e_staticTree;
+			m_trees[e_staticTree].Query(this, fatAABB);
+		}
 	}
 
 	// Reset move buffer
+	for (int32 i = 0; i < m_moveCount; ++i)
+	{
+		int32 proxyId = m_moveBuffer[i];
+		GetTree(proxyId).SetMoved(GetNodeId(proxyId), false);
+	}
 	m_moveCount = 0;
 
-	// Sort the pair buffer to expose duplicates.
-	std::sort(m_pairBuffer, m_pairBuffer + m_pairCount, b2PairLessThan);
-
-	// Send the pairs back to the client.
-	int32 i = 0;
-	while (i < m_pairCount)
+	// Send the pairs back to the client. There are no duplicates.
+	for (int32 i = 0; i < m_pairCount; ++i)
 	{
-		b2Pair* primaryPair = m_pairBuffer + i;
-		void* userDataA = m_tree.GetUserData(primaryPair->proxyIdA);
-		void* userDataB = m_tree.GetUserData(primaryPair->proxyIdB);
+		const b2Pair* pair = m_pairBuffer + i;
+		void* userDataA = GetUserData(pair->proxyIdA);
+		void* userDataB = GetUserData(pair->proxyIdB);
 
 		callback->AddPair(userDataA, userDataB);
-		++i;
-
-		// Skip any duplicate pairs.
-		while (i < m_pairCount)
-		{
-			b2Pair* pair = m_pairBuffer + i;
-			if (pair->proxyIdA != primaryPair->proxyIdA || pair->proxyIdB != primaryPair->proxyIdB)
-			{
-				break;
-			}
-			++i;
-		}
 	}
-
-	// Try to keep the tree balanced.
-	//m_tree.Rebalance(4);
 }
 
 template <typename T>
 inline void b2BroadPhase::Query(T* callback, const b2AABB& aabb) const
 {
-	m_tree.Query(callback, aabb);
+	QueryWrapper<T> wrapper;
+	wrapper.callback = callback;
+
+	wrapper.tree = e_dynamicTree;
+	m_trees[e_dynamicTree].Query(&wrapper, aabb);
+
+	wrapper.tree = e_staticTree;
+	m_trees[e_staticTree].Query(&wrapper, aabb);
 }
 
 template <typename T>
 inline void b2BroadPhase::RayCast(T* callback, const b2RayCastInput& input) const
 {
-	m_tree.RayCast(callback, input);
+	RayCastWrapper<T> wrapper;
+	wrapper.callback = callback;
+	wrapper.maxFraction = input.maxFraction;
+	wrapper.terminated = false;
+
+	wrapper.tree = e_dynamicTree;
+	m_trees[e_dynamicTree].RayCast(&wrapper, input);
+
+	if (wrapper.terminated)
+	{
+		return;
+	}
+
+	b2RayCastInput subInput = input;
+	subInput.maxFraction = wrapper.maxFraction;
+
+	wrapper.tree = e_staticTree;
+	m_trees[e_staticTree].RayCast(&wrapper, subInput);
 }
 
 inline void b2BroadPhase::ShiftOrigin(const b2Vec2& newOrigin)
 {
-	m_tree.ShiftOrigin(newOrigin);
+	m_trees[e_dynamicTree].ShiftOrigin(newOrigin);
+	m_trees[e_staticTree].ShiftOrigin(newOrigin);
 }
 
 #endif
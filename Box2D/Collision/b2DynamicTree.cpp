@@ -18,6 +18,7 @@
 
 #include "Box2D/Collision/b2DynamicTree.h"
 #include <string.h>
+#include <algorithm>
 
 b2DynamicTree::b2DynamicTree()
 {
@@ -41,12 +42,19 @@ b2DynamicTree::b2DynamicTree()
 	m_path = 0;
 
 	m_insertionCount = 0;
+
+	m_proxyCount = 0;
+
+	m_pendingCapacity = 16;
+	m_pendingCount = 0;
+	m_pending = (int32*)b2Alloc(m_pendingCapacity * sizeof(int32));
 }
 
 b2DynamicTree::~b2DynamicTree()
 {
 	// This frees the entire tree in one shot.
 	b2Free(m_nodes);
+	b2Free(m_pending);
 }
 
 // Allocate a node from the pool. Grow the pool if necessary.
@@ -84,6 +92,7 @@ int32 b2DynamicTree::AllocateNode()
 	m_nodes[nodeId].child2 = b2_nullNode;
 	m_nodes[nodeId].height = 0;
 	m_nodes[nodeId].userData = nullptr;
+	m_nodes[nodeId].moved = false;
 	++m_nodeCount;
 	return nodeId;
 }
@@ -115,16 +124,89 @@ int32 b2DynamicTree::CreateProxy(const b2AABB& aabb, void* userData)
 
 	InsertLeaf(proxyId);
 
+	++m_proxyCount;
+
+	return proxyId;
+}
+
+int32 b2DynamicTree::CreateDeferredProxy(const b2AABB& aabb, void* userData)
+{
+	int32 proxyId = AllocateNode();
+
+	// Fatten the aabb.
+	b2Vec2 r(b2_aabbExtension, b2_aabbExtension);
+	m_nodes[proxyId].aabb.lowerBound = aabb.lowerBound - r;
+	m_nodes[proxyId].aabb.upperBound = aabb.upperBound + r;
+	m_nodes[proxyId].userData = userData;
+	m_nodes[proxyId].height = 0;
+	m_nodes[proxyId].parent = b2_pendingNode;
+
+	if (m_pendingCount == m_pendingCapacity)
+	{
+		int32* oldPending = m_pending;
+		m_pendingCapacity *= 2;
+		m_pending = (int32*)b2Alloc(m_pendingCapacity * sizeof(int32));
+		memcpy(m_pending, oldPending, m_pendingCount * sizeof(int32));
+		b2Free(oldPending);
+	}
+
+	m_pending[m_pendingCount] = proxyId;
+	++m_pendingCount;
+
+	++m_proxyCount;
+
 	return proxyId;
 }
 
+void b2DynamicTree::InsertPending()
+{
+	if (m_pendingCount == 0)
+	{
+		return;
+	}
+
+	// Rebuilding is cheaper than inserting one at a time once the
+	// pending proxies are a good part of the tree. This is the common
+	// case when a level is loaded.
+	if (4 * m_pendingCount >= m_proxyCount)
+	{
+		Rebuild();
+		return;
+	}
+
+	for (int32 i = 0; i < m_pendingCount; ++i)
+	{
+		InsertLeaf(m_pending[i]);
+	}
+
+	m_pendingCount = 0;
+}
+
 void b2DynamicTree::DestroyProxy(int32 proxyId)
 {
 	b2Assert(0 <= proxyId && proxyId < m_nodeCapacity);
 	b2Assert(m_nodes[proxyId].IsLeaf());
 
-	RemoveLeaf(proxyId);
+	if (m_nodes[proxyId].parent == b2_pendingNode)
+	{
+		for (int32 i = 0; i < m_pendingCount; ++i)
+		{
+			if (m_pending[i] == proxyId)
+			{
+				m_pending[i] = m_pending[m_pendingCount - 1];
+				--m_pendingCount;
+				break;
+			}
+		}
+	}
+	else
+	{
+		RemoveLeaf(proxyId);
+	}
+
 	FreeNode(proxyId);
+
+	--m_proxyCount;
 }
 
 bool b2DynamicTree::MoveProxy(int32 proxyId, const b2AABB& aabb, const b2Vec2& displacement)
@@ -138,8 +220,6 @@ bool b2DynamicTree::MoveProxy(int32 proxyId, const b2AABB& aabb, const b2Vec2& d
 		return false;
 	}
 
-	RemoveLeaf(proxyId);
-
 	// Extend AABB.
 	b2AABB b = aabb;
 	b2Vec2 r(b2_aabbExtension, b2_aabbExtension);
@@ -167,6 +247,15 @@ bool b2DynamicTree::MoveProxy(int32 proxyId, const b2AABB& aabb, const b2Vec2& d
 		b.upperBound.y += d.y;
 	}
 
+	if (m_nodes[proxyId].parent == b2_pendingNode)
+	{
+		// Not in the tree yet.
+		m_nodes[proxyId].aabb = b;
+		return true;
+	}
+
+	RemoveLeaf(proxyId);
+
 	m_nodes[proxyId].aabb = b;
 
 	InsertLeaf(proxyId);
@@ -766,9 +855,216 @@ void b2DynamicTree::RebuildBottomUp()
 	m_root = nodes[0];
 	b2Free(nodes);
 
+	// The pending leaves were built in with the rest.
+	m_pendingCount = 0;
+
 	Validate();
 }
 
+void b2DynamicTree::Rebuild()
+{
+	int32* leaves = (int32*)b2Alloc(b2Max(m_proxyCount, 1) * sizeof(int32));
+	int32 count = 0;
+
+	// Build array of leaves. Free the rest.
+	for (int32 i = 0; i < m_nodeCapacity; ++i)
+	{
+		if (m_nodes[i].height < 0)
+		{
+			// free node in pool
+			continue;
+		}
+
+		if (m_nodes[i].IsLeaf())
+		{
+			m_nodes[i].parent = b2_nullNode;
+			leaves[count] = i;
+			++count;
+		}
+		else
+		{
+			FreeNode(i);
+		}
+	}
+
+	b2Assert(count == m_proxyCount);
+	m_pendingCount = 0;
+
+	// Relink the free list in index order so the new internal nodes
+	// are packed at the front of the pool in the order they are visited.
+	m_freeList = b2_nullNode;
+	for (int32 i = m_nodeCapacity - 1; i >= 0; --i)
+	{
+		if (m_nodes[i].height < 0)
+		{
+			m_nodes[i].next = m_freeList;
+			m_freeList = i;
+		}
+	}
+
+	if (count == 0)
+	{
+		m_root = b2_nullNode;
+	}
+	else
+	{
+		m_root = BuildNode(leaves, count);
+		m_nodes[m_root].parent = b2_nullNode;
+	}
+
+	b2Free(leaves);
+
+	Validate();
+}
+
+// Build a sub-tree over the leaves and return its root. The leaves are
+// split where the summed perimeter of the two sides, weighted by their
+// leaf counts, is least. The centroids are binned along the widest axis.
+int32 b2DynamicTree::BuildNode(int32* leaves, int32 count)
+{
+	if (count == 1)
+	{
+		return leaves[0];
+	}
+
+	const int32 binCount = 16;
+
+	b2Vec2 lower = m_nodes[leaves[0]].aabb.GetCenter();
+	b2Vec2 upper = lower;
+	for (int32 i = 1; i < count; ++i)
+	{
+		b2Vec2 c = m_nodes[leaves[i]].aabb.GetCenter();
+		lower = b2Min(lower, c);
+		upper = b2Max(upper, c);
+	}
+
+	b2Vec2 extent = upper - lower;
+	int32 axis = extent.x >= extent.y ? 0 : 1;
+	float32 axisLower = lower(axis);
+	float32 axisExtent = extent(axis);
+
+	int32 split = 0;
+
+	if (axisExtent > b2_epsilon)
+	{
+		// An inverted box that any combine replaces.
+		b2AABB emptyAABB;
+		emptyAABB.lowerBound.Set(b2_maxFloat, b2_maxFloat);
+		emptyAABB.upperBound.Set(-b2_maxFloat, -b2_maxFloat);
+
+		int32 binLeafCount[binCount];
+		b2AABB binAABB[binCount];
+		for (int32 i = 0; i < binCount; ++i)
+		{
+			binLeafCount[i] = 0;
+			binAABB[i] = emptyAABB;
+		}
+
+		float32 scale = binCount / axisExtent;
+		for (int32 i = 0; i < count; ++i)
+		{
+			const b2AABB& aabb = m_nodes[leaves[i]].aabb;
+			int32 bin = b2Min(int32(scale * (aabb.GetCenter()(axis) - axisLower)), binCount - 1);
+			binAABB[bin].Combine(aabb);
+			++binLeafCount[bin];
+		}
+
+		// Sweep from the right to get the cost of every right side.
+		float32 rightCost[binCount];
+		int32 rightCount = 0;
+		b2AABB rightAABB = emptyAABB;
+		for (int32 i = binCount - 1; i > 0; --i)
+		{
+			if (binLeafCount[i] > 0)
+			{
+				rightAABB.Combine(binAABB[i]);
+				rightCount += binLeafCount[i];
+			}
+			rightCost[i] = rightCount > 0 ? rightCount * rightAABB.GetPerimeter() : 0.0f;
+		}
+
+		// Sweep from the left and pick the cheapest split. Skip splits that
+		// leave one side nearly empty so the tree depth stays logarithmic
+		// when the centroids are spread unevenly.
+		int32 minSideCount = b2Max(1, count / (2 * binCount));
+		float32 minCost = b2_maxFloat;
+		int32 splitBin = 0;
+		int32 leftCount = 0;
+		b2AABB leftAABB = emptyAABB;
+		for (int32 i = 0; i < binCount - 1; ++i)
+		{
+			if (binLeafCount[i] > 0)
+			{
+				leftAABB.Combine(binAABB[i]);
+				leftCount += binLeafCount[i];
+			}
+
+			if (leftCount < minSideCount || count - leftCount < minSideCount)
+			{
+				continue;
+			}
+
+			float32 cost = leftCount * leftAABB.GetPerimeter() + rightCost[i + 1];
+			if (cost < minCost)
+			{
+				minCost = cost;
+				splitBin = i + 1;
+				split = leftCount;
+			}
+		}
+
+		if (split > 0)
+		{
+			// Partition the leaves on the split bin.
+			int32 i = 0;
+			int32 j = count - 1;
+			while (i <= j)
+			{
+				int32 bin = b2Min(int32(scale * (m_nodes[leaves[i]].aabb.GetCenter()(axis) - axisLower)), binCount - 1);
+				if (bin < splitBin)
+				{
+					++i;
+				}
+				else
+				{
+					b2Swap(leaves[i], leaves[j]);
+					--j;
+				}
+			}
+			b2Assert(i == split);
+		}
+	}
+
+	if (split == 0)
+	{
+		// The centroids are stacked or no split is balanced enough.
+		// Split at the median.
+		split = count / 2;
+		std::nth_element(leaves, leaves + split, leaves + count,
+			[this, axis](int32 a, int32 b)
+			{
+				return m_nodes[a].aabb.GetCenter()(axis) < m_nodes[b].aabb.GetCenter()(axis);
+			});
+	}
+
+	// Allocate the parent before the children so that a sub-tree is
+	// contiguous in the pool. The pool may grow so don't hold pointers.
+	int32 parentIndex = AllocateNode();
+	int32 child1 = BuildNode(leaves, split);
+	int32 child2 = BuildNode(leaves + split, count - split);
+
+	b2TreeNode* parent = m_nodes + parentIndex;
+	parent->child1 = child1;
+	parent->child2 = child2;
+	parent->height = 1 + b2Max(m_nodes[child1].height, m_nodes[child2].height);
+	parent->aabb.Combine(m_nodes[child1].aabb, m_nodes[child2].aabb);
+
+	m_nodes[child1].parent = parentIndex;
+	m_nodes[child2].parent = parentIndex;
+
+	return parentIndex;
+}
+
 void b2DynamicTree::ShiftOrigin(const b2Vec2& newOrigin)
 {
 	// Build array of leaves. Free the rest.
@@ -24,6 +24,9 @@
 
 #define b2_nullNode (-1)
 
+// Parent of a leaf that is waiting to be inserted.
+#define b2_pendingNode (-2)
+
 /// A node in the dynamic tree. The client does not interact with this directly.
 struct b2TreeNode
 {
@@ -48,6 +51,9 @@ struct b2TreeNode
 
 	// leaf = 0, free node = -1
 	int32 height;
+
+	// Moved since the last pair update. Used by the broad-phase.
+	bool moved;
 };
 
 /// A dynamic AABB tree broad-phase, inspired by Nathanael Presson's btDbvt.
@@ -70,6 +76,18 @@ public:
 	/// Create a proxy. Provide a tight fitting AABB and a userData pointer.
 	int32 CreateProxy(const b2AABB& aabb, void* userData);
 
+	/// Create a proxy without inserting it. Queries test it on its own until
+	/// InsertPending is called. Many proxies created this way are built into
+	/// the tree at once, which is faster and gives a better tree.
+	int32 CreateDeferredProxy(const b2AABB& aabb, void* userData);
+
+	/// Insert the deferred proxies. A few are inserted one at a time and
+	/// many rebuild the tree.
+	void InsertPending();
+
+	/// Get the number of deferred proxies waiting to be inserted.
+	int32 GetPendingCount() const;
+
 	/// Destroy a proxy. This asserts if the id is invalid.
 	void DestroyProxy(int32 proxyId);
 
@@ -86,6 +104,10 @@ public:
 	/// Get the fat AABB for a proxy.
 	const b2AABB& GetFatAABB(int32 proxyId) const;
 
+	/// Get-Set the moved flag of a proxy.
+	bool WasMoved(int32 proxyId) const;
+	void SetMoved(int32 proxyId, bool moved);
+
 	/// Query an AABB for overlapping proxies. The callback class
 	/// is called for each proxy that overlaps the supplied AABB.
 	template <typename T>
@@ -118,6 +140,10 @@ public:
 	/// Build an optimal tree. Very expensive. For testing.
 	void RebuildBottomUp();
 
+	/// Build the tree top down with a binned surface area heuristic. The internal
+	/// nodes are packed at the front of the node pool in depth first order.
+	void Rebuild();
+
 	/// Shift the world origin. Useful for large worlds.
 	/// The shift formula is: position -= newOrigin
 	/// @param newOrigin the new origin with respect to the old origin
@@ -133,6 +159,8 @@ private:
 
 	int32 Balance(int32 index);
 
+	int32 BuildNode(int32* leaves, int32 count);
+
 	int32 ComputeHeight() const;
 	int32 ComputeHeight(int32 nodeId) const;
 
@@ -147,6 +175,13 @@ private:
 
 	int32 m_freeList;
 
+	int32 m_proxyCount;
+
+	/// Deferred proxies waiting to be inserted.
+	int32* m_pending;
+	int32 m_pendingCount;
+	int32 m_pendingCapacity;
+
 	/// This is used to incrementally traverse the tree for re-balancing.
 	uint32 m_path;
 
@@ -165,12 +200,35 @@ inline const b2AABB& b2DynamicTree::GetFatAABB(int32 proxyId) const
 	return m_nodes[proxyId].aabb;
 }
 
+inline bool b2DynamicTree::WasMoved(int32 proxyId) const
+{
+	b2Assert(0 <= proxyId && proxyId < m_nodeCapacity);
+	return m_nodes[proxyId].moved;
+}
+
+inline void b2DynamicTree::SetMoved(int32 proxyId, bool moved)
+{
+	b2Assert(0 <= proxyId && proxyId < m_nodeCapacity);
+	m_nodes[proxyId].moved = moved;
+}
+
+inline int32 b2DynamicTree::GetPendingCount() const
+{
+	return m_pendingCount;
+}
+
 template <typename T>
 inline void b2DynamicTree::Query(T* callback, const b2AABB& aabb) const
 {
 	b2GrowableStack<int32, 256> stack;
 	stack.Push(m_root);
 
+	// Deferred proxies aren't in the tree yet so test them as leaves.
+	for (int32 i = 0; i < m_pendingCount; ++i)
+	{
+		stack.Push(m_pending[i]);
+	}
+
 	while (stack.GetCount() > 0)
 	{
 		int32 nodeId = stack.Pop();
@@ -229,6 +287,12 @@ inline void b2DynamicTree::RayCast(T* callback, const b2RayCastInput& input) con
 	b2GrowableStack<int32, 256> stack;
 	stack.Push(m_root);
 
+	// Deferred proxies aren't in the tree yet so test them as leaves.
+	for (int32 i = 0; i < m_pendingCount; ++i)
+	{
+		stack.Push(m_pending[i]);
+	}
+
 	while (stack.GetCount() > 0)
 	{
 		int32 nodeId = stack.Pop();
@@ -29,21 +29,6 @@
 
 bool g_blockSolve = true;
 
-struct b2ContactPositionConstraint
-{
-	b2Vec2 localPoints[b2_maxManifoldPoints];
-	b2Vec2 localNormal;
-	b2Vec2 localPoint;
-	int32 indexA;
-	int32 indexB;
-	float32 invMassA, invMassB;
-	b2Vec2 localCenterA, localCenterB;
-	float32 invIA, invIB;
-	b2Manifold::Type type;
-	float32 radiusA, radiusB;
-	int32 pointCount;
-};
-
 b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 {
 	m_step = def->step;
@@ -55,6 +40,13 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 	m_velocities = def->velocities;
 	m_contacts = def->contacts;
 
+	m_wide = m_step.wideContacts && m_count > 0;
+	m_wideVelocityConstraints = nullptr;
+	m_widePositionConstraints = nullptr;
+	m_wideCount = 0;
+	m_overflowIndices = nullptr;
+	m_overflowCount = 0;
+
 	// Initialize position independent portions of the constraints.
 	for (int32 i = 0; i < m_count; ++i)
 	{
@@ -73,12 +65,20 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 		int32 pointCount = manifold->pointCount;
 		b2Assert(pointCount > 0);
 
+		int32 indexA = bodyA->m_islandIndex;
+		int32 indexB = bodyB->m_islandIndex;
+		if (def->indices)
+		{
+			indexA = def->indices[2 * i];
+			indexB = def->indices[2 * i + 1];
+		}
+
 		b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
 		vc->friction = contact->m_friction;
 		vc->restitution = contact->m_restitution;
 		vc->tangentSpeed = contact->m_tangentSpeed;
-		vc->indexA = bodyA->m_islandIndex;
-		vc->indexB = bodyB->m_islandIndex;
+		vc->indexA = indexA;
+		vc->indexB = indexB;
 		vc->invMassA = bodyA->m_invMass;
 		vc->invMassB = bodyB->m_invMass;
 		vc->invIA = bodyA->m_invI;
@@ -89,8 +89,8 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 		vc->normalMass.SetZero();
 
 		b2ContactPositionConstraint* pc = m_positionConstraints + i;
-		pc->indexA = bodyA->m_islandIndex;
-		pc->indexB = bodyB->m_islandIndex;
+		pc->indexA = indexA;
+		pc->indexB = indexB;
 		pc->invMassA = bodyA->m_invMass;
 		pc->invMassB = bodyB->m_invMass;
 		pc->localCenterA = bodyA->m_sweep.localCenter;
@@ -133,6 +133,12 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 
 b2ContactSolver::~b2ContactSolver()
 {
+	if (m_wideVelocityConstraints)
+	{
+		m_allocator->Free(m_overflowIndices);
+		m_allocator->Free(m_widePositionConstraints);
+		m_allocator->Free(m_wideVelocityConstraints);
+	}
 	m_allocator->Free(m_velocityConstraints);
 	m_allocator->Free(m_positionConstraints);
 }
@@ -247,6 +253,11 @@ void b2ContactSolver::InitializeVelocityConstraints()
 			}
 		}
 	}
+
+	if (m_wide && m_wideVelocityConstraints == nullptr)
+	{
+		PrepareWideConstraints();
+	}
 }
 
 void b2ContactSolver::WarmStart()
@@ -291,8 +302,17 @@ void b2ContactSolver::WarmStart()
 
 void b2ContactSolver::SolveVelocityConstraints()
 {
-	for (int32 i = 0; i < m_count; ++i)
+	// The wide solver leaves the contacts it couldn't color.
+	int32 count = m_count;
+	if (m_wide)
+	{
+		SolveWideVelocityConstraints();
+		count = m_overflowCount;
+	}
+
+	for (int32 n = 0; n < count; ++n)
 	{
+		int32 i = m_wide ? m_overflowIndices[n] : n;
 		b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
 
 		int32 indexA = vc->indexA;
@@ -603,6 +623,11 @@ void b2ContactSolver::SolveVelocityConstraints()
 
 void b2ContactSolver::StoreImpulses()
 {
+	if (m_wide)
+	{
+		StoreWideImpulses();
+	}
+
 	for (int32 i = 0; i < m_count; ++i)
 	{
 		b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
@@ -672,8 +697,17 @@ bool b2ContactSolver::SolvePositionConstraints()
 {
 	float32 minSeparation = 0.0f;
 
-	for (int32 i = 0; i < m_count; ++i)
+	// The wide solver leaves the contacts it couldn't color.
+	int32 count = m_count;
+	if (m_wide)
+	{
+		minSeparation = SolveWidePositionConstraints();
+		count = m_overflowCount;
+	}
+
+	for (int32 n = 0; n < count; ++n)
 	{
+		int32 i = m_wide ? m_overflowIndices[n] : n;
 		b2ContactPositionConstraint* pc = m_positionConstraints + i;
 
 		int32 indexA = pc->indexA;
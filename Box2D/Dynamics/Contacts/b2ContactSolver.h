@@ -26,7 +26,8 @@
 class b2Contact;
 class b2Body;
 class b2StackAllocator;
-struct b2ContactPositionConstraint;
+struct b2WideVelocityConstraint;
+struct b2WidePositionConstraint;
 
 struct b2VelocityConstraintPoint
 {
@@ -56,6 +57,21 @@ struct b2ContactVelocityConstraint
 	int32 contactIndex;
 };
 
+struct b2ContactPositionConstraint
+{
+	b2Vec2 localPoints[b2_maxManifoldPoints];
+	b2Vec2 localNormal;
+	b2Vec2 localPoint;
+	int32 indexA;
+	int32 indexB;
+	float32 invMassA, invMassB;
+	b2Vec2 localCenterA, localCenterB;
+	float32 invIA, invIB;
+	b2Manifold::Type type;
+	float32 radiusA, radiusB;
+	int32 pointCount;
+};
+
 struct b2ContactSolverDef
 {
 	b2TimeStep step;
@@ -64,6 +80,10 @@ struct b2ContactSolverDef
 	b2Position* positions;
 	b2Velocity* velocities;
 	b2StackAllocator* allocator;
+
+	// Island indices of body A and B for each contact. Used instead of
+	// b2Body::m_islandIndex when islands sharing static bodies are solved together.
+	const int32* indices = nullptr;
 };
 
 class b2ContactSolver
@@ -89,6 +109,21 @@ public:
 	b2ContactVelocityConstraint* m_velocityConstraints;
 	b2Contact** m_contacts;
 	int m_count;
+
+	// Wide solver. The contacts are colored so no two contacts of a color share a
+	// moving body and each color is solved several contacts at a time with SIMD.
+	// Contacts that don't fit in a color are solved one at a time.
+	void PrepareWideConstraints();
+	void SolveWideVelocityConstraints();
+	void StoreWideImpulses();
+	float32 SolveWidePositionConstraints();
+
+	bool m_wide;
+	b2WideVelocityConstraint* m_wideVelocityConstraints;
+	b2WidePositionConstraint* m_widePositionConstraints;
+	int32 m_wideCount;
+	int32* m_overflowIndices;
+	int32 m_overflowCount;
 };
 
 #endif
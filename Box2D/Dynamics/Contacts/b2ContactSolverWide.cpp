@@ -0,0 +1,903 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+// Wide contact solver. The contact graph is colored so no two contacts of a
+// color share a body that moves. The contacts of a color are then solved in
+// groups of b2_simdWidth with the same math as the sequential solver.
+
+#include "Box2D/Dynamics/Contacts/b2ContactSolver.h"
+
+#include "Box2D/Dynamics/Contacts/b2Contact.h"
+#include "Box2D/Common/b2StackAllocator.h"
+#include <string.h>
+
+extern bool g_blockSolve;
+
+#if defined(__AVX__)
+
+#include <immintrin.h>
+
+#define b2_simdWidth 8
+
+typedef __m256 b2FloatW;
+
+inline b2FloatW b2LoadW(const float32* p) { return _mm256_loadu_ps(p); }
+inline void b2StoreW(float32* p, b2FloatW a) { _mm256_storeu_ps(p, a); }
+inline b2FloatW b2SplatW(float32 s) { return _mm256_set1_ps(s); }
+inline b2FloatW b2AddW(b2FloatW a, b2FloatW b) { return _mm256_add_ps(a, b); }
+inline b2FloatW b2SubW(b2FloatW a, b2FloatW b) { return _mm256_sub_ps(a, b); }
+inline b2FloatW b2MulW(b2FloatW a, b2FloatW b) { return _mm256_mul_ps(a, b); }
+inline b2FloatW b2DivW(b2FloatW a, b2FloatW b) { return _mm256_div_ps(a, b); }
+inline b2FloatW b2MinW(b2FloatW a, b2FloatW b) { return _mm256_min_ps(a, b); }
+inline b2FloatW b2MaxW(b2FloatW a, b2FloatW b) { return _mm256_max_ps(a, b); }
+inline b2FloatW b2SqrtW(b2FloatW a) { return _mm256_sqrt_ps(a); }
+inline b2FloatW b2GreaterEqualW(b2FloatW a, b2FloatW b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+inline b2FloatW b2GreaterW(b2FloatW a, b2FloatW b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+inline b2FloatW b2AndW(b2FloatW a, b2FloatW b) { return _mm256_and_ps(a, b); }
+inline b2FloatW b2SelectW(b2FloatW mask, b2FloatW a, b2FloatW b) { return _mm256_blendv_ps(b, a, mask); }
+
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#include <emmintrin.h>
+
+#define b2_simdWidth 4
+
+typedef __m128 b2FloatW;
+
+inline b2FloatW b2LoadW(const float32* p) { return _mm_loadu_ps(p); }
+inline void b2StoreW(float32* p, b2FloatW a) { _mm_storeu_ps(p, a); }
+inline b2FloatW b2SplatW(float32 s) { return _mm_set1_ps(s); }
+inline b2FloatW b2AddW(b2FloatW a, b2FloatW b) { return _mm_add_ps(a, b); }
+inline b2FloatW b2SubW(b2FloatW a, b2FloatW b) { return _mm_sub_ps(a, b); }
+inline b2FloatW b2MulW(b2FloatW a, b2FloatW b) { return _mm_mul_ps(a, b); }
+inline b2FloatW b2DivW(b2FloatW a, b2FloatW b) { return _mm_div_ps(a, b); }
+inline b2FloatW b2MinW(b2FloatW a, b2FloatW b) { return _mm_min_ps(a, b); }
+inline b2FloatW b2MaxW(b2FloatW a, b2FloatW b) { return _mm_max_ps(a, b); }
+inline b2FloatW b2SqrtW(b2FloatW a) { return _mm_sqrt_ps(a); }
+inline b2FloatW b2GreaterEqualW(b2FloatW a, b2FloatW b) { return _mm_cmpge_ps(a, b); }
+inline b2FloatW b2GreaterW(b2FloatW a, b2FloatW b) { return _mm_cmpgt_ps(a, b); }
+inline b2FloatW b2AndW(b2FloatW a, b2FloatW b) { return _mm_and_ps(a, b); }
+inline b2FloatW b2SelectW(b2FloatW mask, b2FloatW a, b2FloatW b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#include <arm_neon.h>
+
+#define b2_simdWidth 4
+
+typedef float32x4_t b2FloatW;
+
+inline b2FloatW b2LoadW(const float32* p) { return vld1q_f32(p); }
+inline void b2StoreW(float32* p, b2FloatW a) { vst1q_f32(p, a); }
+inline b2FloatW b2SplatW(float32 s) { return vdupq_n_f32(s); }
+inline b2FloatW b2AddW(b2FloatW a, b2FloatW b) { return vaddq_f32(a, b); }
+inline b2FloatW b2SubW(b2FloatW a, b2FloatW b) { return vsubq_f32(a, b); }
+inline b2FloatW b2MulW(b2FloatW a, b2FloatW b) { return vmulq_f32(a, b); }
+inline b2FloatW b2MinW(b2FloatW a, b2FloatW b) { return vminq_f32(a, b); }
+inline b2FloatW b2MaxW(b2FloatW a, b2FloatW b) { return vmaxq_f32(a, b); }
+inline b2FloatW b2GreaterEqualW(b2FloatW a, b2FloatW b) { return vreinterpretq_f32_u32(vcgeq_f32(a, b)); }
+inline b2FloatW b2GreaterW(b2FloatW a, b2FloatW b) { return vreinterpretq_f32_u32(vcgtq_f32(a, b)); }
+inline b2FloatW b2AndW(b2FloatW a, b2FloatW b) { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+inline b2FloatW b2SelectW(b2FloatW mask, b2FloatW a, b2FloatW b) { return vbslq_f32(vreinterpretq_u32_f32(mask), a, b); }
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+inline b2FloatW b2DivW(b2FloatW a, b2FloatW b) { return vdivq_f32(a, b); }
+inline b2FloatW b2SqrtW(b2FloatW a) { return vsqrtq_f32(a); }
+#else
+inline b2FloatW b2DivW(b2FloatW a, b2FloatW b)
+{
+	float32 x[4], y[4];
+	vst1q_f32(x, a);
+	vst1q_f32(y, b);
+	for (int32 i = 0; i < 4; ++i)
+	{
+		x[i] /= y[i];
+	}
+	return vld1q_f32(x);
+}
+
+inline b2FloatW b2SqrtW(b2FloatW a)
+{
+	float32 x[4];
+	vst1q_f32(x, a);
+	for (int32 i = 0; i < 4; ++i)
+	{
+		x[i] = b2Sqrt(x[i]);
+	}
+	return vld1q_f32(x);
+}
+#endif
+
+#else
+
+// Portable fallback with the same lane layout. Masks are all bits set or clear.
+#define b2_simdWidth 4
+
+struct b2FloatW
+{
+	float32 v[4];
+};
+
+inline b2FloatW b2LoadW(const float32* p) { b2FloatW r; memcpy(r.v, p, sizeof(r.v)); return r; }
+inline void b2StoreW(float32* p, b2FloatW a) { memcpy(p, a.v, sizeof(a.v)); }
+inline b2FloatW b2SplatW(float32 s) { b2FloatW r; for (int32 i = 0; i < 4; ++i) { r.v[i] = s; } return r; }
+inline b2FloatW b2AddW(b2FloatW a, b2FloatW b) { for (int32 i = 0; i < 4; ++i) { a.v[i] += b.v[i]; } return a; }
+inline b2FloatW b2SubW(b2FloatW a, b2FloatW b) { for (int32 i = 0; i < 4; ++i) { a.v[i] -= b.v[i]; } return a; }
+inline b2FloatW b2MulW(b2FloatW a, b2FloatW b) { for (int32 i = 0; i < 4; ++i) { a.v[i] *= b.v[i]; } return a; }
+inline b2FloatW b2DivW(b2FloatW a, b2FloatW b) { for (int32 i = 0; i < 4; ++i) { a.v[i] /= b.v[i]; } return a; }
+inline b2FloatW b2MinW(b2FloatW a, b2FloatW b) { for (int32 i = 0; i < 4; ++i) { a.v[i] = b2Min(a.v[i], b.v[i]); } return a; }
+inline b2FloatW b2MaxW(b2FloatW a, b2FloatW b) { for (int32 i = 0; i < 4; ++i) { a.v[i] = b2Max(a.v[i], b.v[i]); } return a; }
+inline b2FloatW b2SqrtW(b2FloatW a) { for (int32 i = 0; i < 4; ++i) { a.v[i] = b2Sqrt(a.v[i]); } return a; }
+
+inline b2FloatW b2MaskW(bool* flags)
+{
+	b2FloatW r;
+	for (int32 i = 0; i < 4; ++i)
+	{
+		uint32 bits = flags[i] ? 0xFFFFFFFF : 0;
+		memcpy(r.v + i, &bits, sizeof(bits));
+	}
+	return r;
+}
+
+inline b2FloatW b2GreaterEqualW(b2FloatW a, b2FloatW b) { bool f[4]; for (int32 i = 0; i < 4; ++i) { f[i] = a.v[i] >= b.v[i]; } return b2MaskW(f); }
+inline b2FloatW b2GreaterW(b2FloatW a, b2FloatW b) { bool f[4]; for (int32 i = 0; i < 4; ++i) { f[i] = a.v[i] > b.v[i]; } return b2MaskW(f); }
+
+inline b2FloatW b2AndW(b2FloatW a, b2FloatW b)
+{
+	for (int32 i = 0; i < 4; ++i)
+	{
+		uint32 x, y;
+		memcpy(&x, a.v + i, sizeof(x));
+		memcpy(&y, b.v + i, sizeof(y));
+		x &= y;
+		memcpy(a.v + i, &x, sizeof(x));
+	}
+	return a;
+}
+
+inline b2FloatW b2SelectW(b2FloatW mask, b2FloatW a, b2FloatW b)
+{
+	for (int32 i = 0; i < 4; ++i)
+	{
+		uint32 m;
+		memcpy(&m, mask.v + i, sizeof(m));
+		if (m == 0)
+		{
+			a.v[i] = b.v[i];
+		}
+	}
+	return a;
+}
+
+#endif
+
+inline b2FloatW b2ZeroW() { return b2SplatW(0.0f); }
+
+// A moving body is only in one contact of a color. Static and kinematic
+// bodies are read by many.
+inline bool b2IsMoving(float32 invMass, float32 invI)
+{
+	return invMass > 0.0f || invI > 0.0f;
+}
+
+// Number of colors tried before a contact is solved on its own.
+const int32 b2_wideColorCount = 12;
+
+struct b2WideVelocityPoint
+{
+	float32 rAx[b2_simdWidth], rAy[b2_simdWidth];
+	float32 rBx[b2_simdWidth], rBy[b2_simdWidth];
+	float32 normalImpulse[b2_simdWidth];
+	float32 tangentImpulse[b2_simdWidth];
+	float32 normalMass[b2_simdWidth];
+	float32 tangentMass[b2_simdWidth];
+	float32 velocityBias[b2_simdWidth];
+};
+
+// b2_simdWidth velocity constraints in lanes. Empty lanes have an index of -1.
+struct b2WideVelocityConstraint
+{
+	b2WideVelocityPoint points[b2_maxManifoldPoints];
+	float32 normalX[b2_simdWidth], normalY[b2_simdWidth];
+	float32 k11[b2_simdWidth], k12[b2_simdWidth], k22[b2_simdWidth];
+	float32 normalMass11[b2_simdWidth], normalMass12[b2_simdWidth];
+	float32 normalMass21[b2_simdWidth], normalMass22[b2_simdWidth];
+	float32 invMassA[b2_simdWidth], invMassB[b2_simdWidth];
+	float32 invIA[b2_simdWidth], invIB[b2_simdWidth];
+	float32 friction[b2_simdWidth];
+	float32 tangentSpeed[b2_simdWidth];
+	float32 blockSolve[b2_simdWidth];
+	int32 indexA[b2_simdWidth], indexB[b2_simdWidth];
+	int32 constraintIndex[b2_simdWidth];
+};
+
+// b2_simdWidth position constraints in lanes.
+struct b2WidePositionConstraint
+{
+	float32 localPointsX[b2_maxManifoldPoints][b2_simdWidth];
+	float32 localPointsY[b2_maxManifoldPoints][b2_simdWidth];
+	float32 pointActive[b2_maxManifoldPoints][b2_simdWidth];
+	float32 localNormalX[b2_simdWidth], localNormalY[b2_simdWidth];
+	float32 localPointX[b2_simdWidth], localPointY[b2_simdWidth];
+	float32 localCenterAx[b2_simdWidth], localCenterAy[b2_simdWidth];
+	float32 localCenterBx[b2_simdWidth], localCenterBy[b2_simdWidth];
+	float32 invMassA[b2_simdWidth], invMassB[b2_simdWidth];
+	float32 invIA[b2_simdWidth], invIB[b2_simdWidth];
+	float32 radius[b2_simdWidth];
+	float32 circles[b2_simdWidth];
+	float32 faceB[b2_simdWidth];
+	int32 indexA[b2_simdWidth], indexB[b2_simdWidth];
+};
+
+// Color the contacts and copy them into lanes. Called after the velocity
+// constraints are initialized.
+void b2ContactSolver::PrepareWideConstraints()
+{
+	const int32 W = b2_simdWidth;
+
+	int32 bodyCount = 0;
+	for (int32 i = 0; i < m_count; ++i)
+	{
+		bodyCount = b2Max(bodyCount, b2Max(m_velocityConstraints[i].indexA, m_velocityConstraints[i].indexB) + 1);
+	}
+
+	// The lanes of a color round up to whole groups.
+	int32 capacity = m_count / W + b2_wideColorCount;
+	m_wideVelocityConstraints = (b2WideVelocityConstraint*)m_allocator->Allocate(capacity * sizeof(b2WideVelocityConstraint));
+	m_widePositionConstraints = (b2WidePositionConstraint*)m_allocator->Allocate(capacity * sizeof(b2WidePositionConstraint));
+	m_overflowIndices = (int32*)m_allocator->Allocate(m_count * sizeof(int32));
+	m_overflowCount = 0;
+
+	// One bit per body for each color.
+	int32 wordCount = (bodyCount + 31) / 32;
+	uint32* bodyBits = (uint32*)m_allocator->Allocate(b2_wideColorCount * wordCount * sizeof(uint32));
+	memset(bodyBits, 0, b2_wideColorCount * wordCount * sizeof(uint32));
+	int32* colors = (int32*)m_allocator->Allocate(m_count * sizeof(int32));
+
+	int32 colorCounts[b2_wideColorCount] = {};
+
+	// Greedy coloring in island order.
+	for (int32 i = 0; i < m_count; ++i)
+	{
+		const b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
+		bool movingA = b2IsMoving(vc->invMassA, vc->invIA);
+		bool movingB = b2IsMoving(vc->invMassB, vc->invIB);
+		uint32 wordA = vc->indexA / 32, bitA = 1u << (vc->indexA % 32);
+		uint32 wordB = vc->indexB / 32, bitB = 1u << (vc->indexB % 32);
+
+		colors[i] = -1;
+		for (int32 c = 0; c < b2_wideColorCount; ++c)
+		{
+			uint32* bits = bodyBits + c * wordCount;
+			if ((movingA && (bits[wordA] & bitA)) || (movingB && (bits[wordB] & bitB)))
+			{
+				continue;
+			}
+
+			if (movingA)
+			{
+				bits[wordA] |= bitA;
+			}
+			if (movingB)
+			{
+				bits[wordB] |= bitB;
+			}
+
+			colors[i] = c;
+			++colorCounts[c];
+			break;
+		}
+
+		if (colors[i] == -1)
+		{
+			m_overflowIndices[m_overflowCount++] = i;
+		}
+	}
+
+	// The first group of each color.
+	int32 colorGroups[b2_wideColorCount];
+	int32 colorLanes[b2_wideColorCount] = {};
+	m_wideCount = 0;
+	for (int32 c = 0; c < b2_wideColorCount; ++c)
+	{
+		colorGroups[c] = m_wideCount;
+		m_wideCount += (colorCounts[c] + W - 1) / W;
+	}
+	b2Assert(m_wideCount <= capacity);
+
+	// Only the last group of a color can have empty lanes. They have no mass and no body.
+	for (int32 c = 0; c < b2_wideColorCount; ++c)
+	{
+		if (colorCounts[c] % W == 0)
+		{
+			continue;
+		}
+
+		int32 last = colorGroups[c] + colorCounts[c] / W;
+		memset(m_wideVelocityConstraints + last, 0, sizeof(b2WideVelocityConstraint));
+		memset(m_widePositionConstraints + last, 0, sizeof(b2WidePositionConstraint));
+		for (int32 j = colorCounts[c] % W; j < W; ++j)
+		{
+			m_wideVelocityConstraints[last].indexA[j] = -1;
+			m_wideVelocityConstraints[last].indexB[j] = -1;
+			m_wideVelocityConstraints[last].constraintIndex[j] = -1;
+			m_widePositionConstraints[last].indexA[j] = -1;
+			m_widePositionConstraints[last].indexB[j] = -1;
+		}
+	}
+
+	for (int32 i = 0; i < m_count; ++i)
+	{
+		int32 c = colors[i];
+		if (c == -1)
+		{
+			continue;
+		}
+
+		int32 lane = colorLanes[c]++;
+		b2WideVelocityConstraint* wvc = m_wideVelocityConstraints + colorGroups[c] + lane / W;
+		b2WidePositionConstraint* wpc = m_widePositionConstraints + colorGroups[c] + lane / W;
+		int32 j = lane % W;
+
+		const b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
+		wvc->indexA[j] = vc->indexA;
+		wvc->indexB[j] = vc->indexB;
+		wvc->constraintIndex[j] = i;
+		wvc->invMassA[j] = vc->invMassA;
+		wvc->invMassB[j] = vc->invMassB;
+		wvc->invIA[j] = vc->invIA;
+		wvc->invIB[j] = vc->invIB;
+		wvc->normalX[j] = vc->normal.x;
+		wvc->normalY[j] = vc->normal.y;
+		wvc->friction[j] = vc->friction;
+		wvc->tangentSpeed[j] = vc->tangentSpeed;
+		wvc->blockSolve[j] = (vc->pointCount == 2 && g_blockSolve) ? 1.0f : 0.0f;
+		wvc->k11[j] = vc->K.ex.x;
+		wvc->k12[j] = vc->K.ex.y;
+		wvc->k22[j] = vc->K.ey.y;
+		wvc->normalMass11[j] = vc->normalMass.ex.x;
+		wvc->normalMass21[j] = vc->normalMass.ex.y;
+		wvc->normalMass12[j] = vc->normalMass.ey.x;
+		wvc->normalMass22[j] = vc->normalMass.ey.y;
+
+		// Unused points have no mass so they apply no impulse.
+		for (int32 k = 0; k < b2_maxManifoldPoints; ++k)
+		{
+			b2WideVelocityPoint* wvp = wvc->points + k;
+			if (k >= vc->pointCount)
+			{
+				wvp->rAx[j] = wvp->rAy[j] = wvp->rBx[j] = wvp->rBy[j] = 0.0f;
+				wvp->normalImpulse[j] = wvp->tangentImpulse[j] = 0.0f;
+				wvp->normalMass[j] = wvp->tangentMass[j] = wvp->velocityBias[j] = 0.0f;
+				continue;
+			}
+
+			const b2VelocityConstraintPoint* vcp = vc->points + k;
+			wvp->rAx[j] = vcp->rA.x;
+			wvp->rAy[j] = vcp->rA.y;
+			wvp->rBx[j] = vcp->rB.x;
+			wvp->rBy[j] = vcp->rB.y;
+			wvp->normalImpulse[j] = vcp->normalImpulse;
+			wvp->tangentImpulse[j] = vcp->tangentImpulse;
+			wvp->normalMass[j] = vcp->normalMass;
+			wvp->tangentMass[j] = vcp->tangentMass;
+			wvp->velocityBias[j] = vcp->velocityBias;
+		}
+
+		const b2ContactPositionConstraint* pc = m_positionConstraints + i;
+		wpc->indexA[j] = pc->indexA;
+		wpc->indexB[j] = pc->indexB;
+		wpc->invMassA[j] = pc->invMassA;
+		wpc->invMassB[j] = pc->invMassB;
+		wpc->invIA[j] = pc->invIA;
+		wpc->invIB[j] = pc->invIB;
+		wpc->localCenterAx[j] = pc->localCenterA.x;
+		wpc->localCenterAy[j] = pc->localCenterA.y;
+		wpc->localCenterBx[j] = pc->localCenterB.x;
+		wpc->localCenterBy[j] = pc->localCenterB.y;
+		wpc->localNormalX[j] = pc->localNormal.x;
+		wpc->localNormalY[j] = pc->localNormal.y;
+		wpc->localPointX[j] = pc->localPoint.x;
+		wpc->localPointY[j] = pc->localPoint.y;
+		wpc->radius[j] = pc->radiusA + pc->radiusB;
+		wpc->circles[j] = pc->type == b2Manifold::e_circles ? 1.0f : 0.0f;
+		wpc->faceB[j] = pc->type == b2Manifold::e_faceB ? 1.0f : 0.0f;
+
+		for (int32 k = 0; k < b2_maxManifoldPoints; ++k)
+		{
+			// The position solver uses every point of the manifold.
+			int32 point = b2Min(k, pc->pointCount - 1);
+			wpc->localPointsX[k][j] = pc->localPoints[point].x;
+			wpc->localPointsY[k][j] = pc->localPoints[point].y;
+			wpc->pointActive[k][j] = k < pc->pointCount ? 1.0f : 0.0f;
+		}
+	}
+
+	m_allocator->Free(colors);
+	m_allocator->Free(bodyBits);
+}
+
+// Copy the impulses back so they can be stored and reported.
+void b2ContactSolver::StoreWideImpulses()
+{
+	for (int32 i = 0; i < m_wideCount; ++i)
+	{
+		const b2WideVelocityConstraint* wvc = m_wideVelocityConstraints + i;
+		for (int32 j = 0; j < b2_simdWidth; ++j)
+		{
+			if (wvc->constraintIndex[j] == -1)
+			{
+				continue;
+			}
+
+			b2ContactVelocityConstraint* vc = m_velocityConstraints + wvc->constraintIndex[j];
+			for (int32 k = 0; k < vc->pointCount; ++k)
+			{
+				vc->points[k].normalImpulse = wvc->points[k].normalImpulse[j];
+				vc->points[k].tangentImpulse = wvc->points[k].tangentImpulse[j];
+			}
+		}
+	}
+}
+
+// Body velocities of a group of lanes.
+struct b2WideBody
+{
+	b2FloatW vx, vy, w;
+};
+
+static void b2GatherVelocities(b2WideBody* body, const b2Velocity* velocities, const int32* indices)
+{
+	float32 vx[b2_simdWidth], vy[b2_simdWidth], w[b2_simdWidth];
+	for (int32 j = 0; j < b2_simdWidth; ++j)
+	{
+		int32 index = indices[j];
+		if (index == -1)
+		{
+			vx[j] = vy[j] = w[j] = 0.0f;
+			continue;
+		}
+
+		vx[j] = velocities[index].v.x;
+		vy[j] = velocities[index].v.y;
+		w[j] = velocities[index].w;
+	}
+
+	body->vx = b2LoadW(vx);
+	body->vy = b2LoadW(vy);
+	body->w = b2LoadW(w);
+}
+
+static void b2ScatterVelocities(b2Velocity* velocities, const b2WideBody* body, const int32* indices,
+								const float32* invMass, const float32* invI)
+{
+	float32 vx[b2_simdWidth], vy[b2_simdWidth], w[b2_simdWidth];
+	b2StoreW(vx, body->vx);
+	b2StoreW(vy, body->vy);
+	b2StoreW(w, body->w);
+
+	for (int32 j = 0; j < b2_simdWidth; ++j)
+	{
+		int32 index = indices[j];
+		if (index == -1 || b2IsMoving(invMass[j], invI[j]) == false)
+		{
+			continue;
+		}
+
+		velocities[index].v.Set(vx[j], vy[j]);
+		velocities[index].w = w[j];
+	}
+}
+
+// Apply the impulse P at the points of A and B.
+static inline void b2ApplyImpulseW(b2WideBody* A, b2WideBody* B,
+								   b2FloatW mA, b2FloatW iA, b2FloatW mB, b2FloatW iB,
+								   b2FloatW rAx, b2FloatW rAy, b2FloatW rBx, b2FloatW rBy,
+								   b2FloatW Px, b2FloatW Py)
+{
+	A->vx = b2SubW(A->vx, b2MulW(mA, Px));
+	A->vy = b2SubW(A->vy, b2MulW(mA, Py));
+	A->w = b2SubW(A->w, b2MulW(iA, b2SubW(b2MulW(rAx, Py), b2MulW(rAy, Px))));
+
+	B->vx = b2AddW(B->vx, b2MulW(mB, Px));
+	B->vy = b2AddW(B->vy, b2MulW(mB, Py));
+	B->w = b2AddW(B->w, b2MulW(iB, b2SubW(b2MulW(rBx, Py), b2MulW(rBy, Px))));
+}
+
+// Relative velocity at the contact point.
+static inline void b2RelativeVelocityW(const b2WideBody& A, const b2WideBody& B,
+									   b2FloatW rAx, b2FloatW rAy, b2FloatW rBx, b2FloatW rBy,
+									   b2FloatW* dvx, b2FloatW* dvy)
+{
+	*dvx = b2AddW(b2SubW(b2SubW(B.vx, b2MulW(B.w, rBy)), A.vx), b2MulW(A.w, rAy));
+	*dvy = b2SubW(b2SubW(b2AddW(B.vy, b2MulW(B.w, rBx)), A.vy), b2MulW(A.w, rAx));
+}
+
+void b2ContactSolver::SolveWideVelocityConstraints()
+{
+	const b2FloatW zero = b2ZeroW();
+
+	for (int32 i = 0; i < m_wideCount; ++i)
+	{
+		b2WideVelocityConstraint* wvc = m_wideVelocityConstraints + i;
+
+		b2WideBody A, B;
+		b2GatherVelocities(&A, m_velocities, wvc->indexA);
+		b2GatherVelocities(&B, m_velocities, wvc->indexB);
+
+		b2FloatW mA = b2LoadW(wvc->invMassA);
+		b2FloatW iA = b2LoadW(wvc->invIA);
+		b2FloatW mB = b2LoadW(wvc->invMassB);
+		b2FloatW iB = b2LoadW(wvc->invIB);
+
+		b2FloatW nx = b2LoadW(wvc->normalX);
+		b2FloatW ny = b2LoadW(wvc->normalY);
+		b2FloatW tx = ny;
+		b2FloatW ty = b2SubW(zero, nx);
+		b2FloatW friction = b2LoadW(wvc->friction);
+		b2FloatW tangentSpeed = b2LoadW(wvc->tangentSpeed);
+
+		b2FloatW rAx[b2_maxManifoldPoints], rAy[b2_maxManifoldPoints];
+		b2FloatW rBx[b2_maxManifoldPoints], rBy[b2_maxManifoldPoints];
+		b2FloatW normalImpulse[b2_maxManifoldPoints];
+		for (int32 j = 0; j < b2_maxManifoldPoints; ++j)
+		{
+			b2WideVelocityPoint* wvp = wvc->points + j;
+			rAx[j] = b2LoadW(wvp->rAx);
+			rAy[j] = b2LoadW(wvp->rAy);
+			rBx[j] = b2LoadW(wvp->rBx);
+			rBy[j] = b2LoadW(wvp->rBy);
+			normalImpulse[j] = b2LoadW(wvp->normalImpulse);
+		}
+
+		// Solve tangent constraints first because non-penetration is more important
+		// than friction.
+		for (int32 j = 0; j < b2_maxManifoldPoints; ++j)
+		{
+			b2WideVelocityPoint* wvp = wvc->points + j;
+
+			b2FloatW dvx, dvy;
+			b2RelativeVelocityW(A, B, rAx[j], rAy[j], rBx[j], rBy[j], &dvx, &dvy);
+
+			b2FloatW vt = b2SubW(b2AddW(b2MulW(dvx, tx), b2MulW(dvy, ty)), tangentSpeed);
+			b2FloatW lambda = b2MulW(b2LoadW(wvp->tangentMass), b2SubW(zero, vt));
+
+			b2FloatW maxFriction = b2MulW(friction, normalImpulse[j]);
+			b2FloatW oldImpulse = b2LoadW(wvp->tangentImpulse);
+			b2FloatW newImpulse = b2MaxW(b2SubW(zero, maxFriction), b2MinW(b2AddW(oldImpulse, lambda), maxFriction));
+			lambda = b2SubW(newImpulse, oldImpulse);
+			b2StoreW(wvp->tangentImpulse, newImpulse);
+
+			b2ApplyImpulseW(&A, &B, mA, iA, mB, iB, rAx[j], rAy[j], rBx[j], rBy[j],
+							b2MulW(lambda, tx), b2MulW(lambda, ty));
+		}
+
+		// The block solver starts from the velocities after friction.
+		b2WideBody blockA = A, blockB = B;
+
+		// Solve normal constraints one point at a time. Unused points have no mass.
+		b2FloatW pointImpulse[b2_maxManifoldPoints];
+		for (int32 j = 0; j < b2_maxManifoldPoints; ++j)
+		{
+			b2WideVelocityPoint* wvp = wvc->points + j;
+
+			b2FloatW dvx, dvy;
+			b2RelativeVelocityW(A, B, rAx[j], rAy[j], rBx[j], rBy[j], &dvx, &dvy);
+
+			b2FloatW vn = b2AddW(b2MulW(dvx, nx), b2MulW(dvy, ny));
+			b2FloatW lambda = b2MulW(b2SubW(zero, b2LoadW(wvp->normalMass)), b2SubW(vn, b2LoadW(wvp->velocityBias)));
+
+			b2FloatW newImpulse = b2MaxW(b2AddW(normalImpulse[j], lambda), zero);
+			lambda = b2SubW(newImpulse, normalImpulse[j]);
+			pointImpulse[j] = newImpulse;
+
+			b2ApplyImpulseW(&A, &B, mA, iA, mB, iB, rAx[j], rAy[j], rBx[j], rBy[j],
+							b2MulW(lambda, nx), b2MulW(lambda, ny));
+		}
+
+		// Block solver for two point manifolds. See b2ContactSolver::SolveVelocityConstraints.
+		// Each case is solved in every lane and the first valid one is kept.
+		{
+			b2FloatW ax = normalImpulse[0];
+			b2FloatW ay = normalImpulse[1];
+
+			b2FloatW dv1x, dv1y, dv2x, dv2y;
+			b2RelativeVelocityW(blockA, blockB, rAx[0], rAy[0], rBx[0], rBy[0], &dv1x, &dv1y);
+			b2RelativeVelocityW(blockA, blockB, rAx[1], rAy[1], rBx[1], rBy[1], &dv2x, &dv2y);
+
+			b2FloatW vn1 = b2AddW(b2MulW(dv1x, nx), b2MulW(dv1y, ny));
+			b2FloatW vn2 = b2AddW(b2MulW(dv2x, nx), b2MulW(dv2y, ny));
+
+			b2FloatW k11 = b2LoadW(wvc->k11);
+			b2FloatW k12 = b2LoadW(wvc->k12);
+			b2FloatW k22 = b2LoadW(wvc->k22);
+
+			// b' = b - K * a
+			b2FloatW bx = b2SubW(b2SubW(vn1, b2LoadW(wvc->points[0].velocityBias)), b2AddW(b2MulW(k11, ax), b2MulW(k12, ay)));
+			b2FloatW by = b2SubW(b2SubW(vn2, b2LoadW(wvc->points[1].velocityBias)), b2AddW(b2MulW(k12, ax), b2MulW(k22, ay)));
+
+			// Case 1: vn = 0
+			b2FloatW x1x = b2SubW(zero, b2AddW(b2MulW(b2LoadW(wvc->normalMass11), bx), b2MulW(b2LoadW(wvc->normalMass12), by)));
+			b2FloatW x1y = b2SubW(zero, b2AddW(b2MulW(b2LoadW(wvc->normalMass21), bx), b2MulW(b2LoadW(wvc->normalMass22), by)));
+			b2FloatW valid1 = b2AndW(b2GreaterEqualW(x1x, zero), b2GreaterEqualW(x1y, zero));
+
+			// Case 2: vn1 = 0 and x2 = 0
+			b2FloatW x2x = b2SubW(zero, b2MulW(b2LoadW(wvc->points[0].normalMass), bx));
+			b2FloatW vn2Case2 = b2AddW(b2MulW(k12, x2x), by);
+			b2FloatW valid2 = b2AndW(b2GreaterEqualW(x2x, zero), b2GreaterEqualW(vn2Case2, zero));
+
+			// Case 3: vn2 = 0 and x1 = 0
+			b2FloatW x3y = b2SubW(zero, b2MulW(b2LoadW(wvc->points[1].normalMass), by));
+			b2FloatW vn1Case3 = b2AddW(b2MulW(k12, x3y), bx);
+			b2FloatW valid3 = b2AndW(b2GreaterEqualW(x3y, zero), b2GreaterEqualW(vn1Case3, zero));
+
+			// Case 4: x1 = 0 and x2 = 0
+			b2FloatW valid4 = b2AndW(b2GreaterEqualW(bx, zero), b2GreaterEqualW(by, zero));
+
+			// No solution keeps the old impulse.
+			b2FloatW xx = b2SelectW(valid4, zero, ax);
+			b2FloatW xy = b2SelectW(valid4, zero, ay);
+			xx = b2SelectW(valid3, zero, xx);
+			xy = b2SelectW(valid3, x3y, xy);
+			xx = b2SelectW(valid2, x2x, xx);
+			xy = b2SelectW(valid2, zero, xy);
+			xx = b2SelectW(valid1, x1x, xx);
+			xy = b2SelectW(valid1, x1y, xy);
+
+			b2FloatW dx = b2SubW(xx, ax);
+			b2FloatW dy = b2SubW(xy, ay);
+
+			b2ApplyImpulseW(&blockA, &blockB, mA, iA, mB, iB, rAx[0], rAy[0], rBx[0], rBy[0],
+							b2MulW(dx, nx), b2MulW(dx, ny));
+			b2ApplyImpulseW(&blockA, &blockB, mA, iA, mB, iB, rAx[1], rAy[1], rBx[1], rBy[1],
+							b2MulW(dy, nx), b2MulW(dy, ny));
+
+			b2FloatW block = b2GreaterW(b2LoadW(wvc->blockSolve), zero);
+			A.vx = b2SelectW(block, blockA.vx, A.vx);
+			A.vy = b2SelectW(block, blockA.vy, A.vy);
+			A.w = b2SelectW(block, blockA.w, A.w);
+			B.vx = b2SelectW(block, blockB.vx, B.vx);
+			B.vy = b2SelectW(block, blockB.vy, B.vy);
+			B.w = b2SelectW(block, blockB.w, B.w);
+			pointImpulse[0] = b2SelectW(block, xx, pointImpulse[0]);
+			pointImpulse[1] = b2SelectW(block, xy, pointImpulse[1]);
+		}
+
+		b2StoreW(wvc->points[0].normalImpulse, pointImpulse[0]);
+		b2StoreW(wvc->points[1].normalImpulse, pointImpulse[1]);
+
+		b2ScatterVelocities(m_velocities, &A, wvc->indexA, wvc->invMassA, wvc->invIA);
+		b2ScatterVelocities(m_velocities, &B, wvc->indexB, wvc->invMassB, wvc->invIB);
+	}
+}
+
+// Body positions of a group of lanes. The rotation is kept with the angle.
+struct b2WidePosition
+{
+	b2FloatW cx, cy, a;
+	b2FloatW s, c;
+};
+
+static void b2GatherPositions(b2WidePosition* body, const b2Position* positions, const int32* indices)
+{
+	float32 cx[b2_simdWidth], cy[b2_simdWidth], a[b2_simdWidth], s[b2_simdWidth], c[b2_simdWidth];
+	for (int32 j = 0; j < b2_simdWidth; ++j)
+	{
+		int32 index = indices[j];
+		if (index == -1)
+		{
+			cx[j] = cy[j] = a[j] = s[j] = 0.0f;
+			c[j] = 1.0f;
+			continue;
+		}
+
+		cx[j] = positions[index].c.x;
+		cy[j] = positions[index].c.y;
+		a[j] = positions[index].a;
+		s[j] = sinf(a[j]);
+		c[j] = cosf(a[j]);
+	}
+
+	body->cx = b2LoadW(cx);
+	body->cy = b2LoadW(cy);
+	body->a = b2LoadW(a);
+	body->s = b2LoadW(s);
+	body->c = b2LoadW(c);
+}
+
+static void b2ScatterPositions(b2Position* positions, const b2WidePosition* body, const int32* indices,
+							   const float32* invMass, const float32* invI)
+{
+	float32 cx[b2_simdWidth], cy[b2_simdWidth], a[b2_simdWidth];
+	b2StoreW(cx, body->cx);
+	b2StoreW(cy, body->cy);
+	b2StoreW(a, body->a);
+
+	for (int32 j = 0; j < b2_simdWidth; ++j)
+	{
+		int32 index = indices[j];
+		if (index == -1 || b2IsMoving(invMass[j], invI[j]) == false)
+		{
+			continue;
+		}
+
+		positions[index].c.Set(cx[j], cy[j]);
+		positions[index].a = a[j];
+	}
+}
+
+// Rotate the body by a small angle. The rotation is normalized so it stays close
+// to the sine and cosine of the angle.
+static inline void b2IntegrateRotationW(b2WidePosition* body, b2FloatW da)
+{
+	b2FloatW s = b2AddW(body->s, b2MulW(da, body->c));
+	b2FloatW c = b2SubW(body->c, b2MulW(da, body->s));
+	b2FloatW invLength = b2DivW(b2SplatW(1.0f), b2SqrtW(b2AddW(b2MulW(s, s), b2MulW(c, c))));
+	body->s = b2MulW(s, invLength);
+	body->c = b2MulW(c, invLength);
+}
+
+// World point of a local point of the body.
+static inline void b2TransformPointW(const b2WidePosition& body, b2FloatW lcx, b2FloatW lcy,
+									 b2FloatW x, b2FloatW y, b2FloatW* wx, b2FloatW* wy)
+{
+	// The body origin is the center of mass less the rotated local center.
+	b2FloatW dx = b2SubW(x, lcx);
+	b2FloatW dy = b2SubW(y, lcy);
+	*wx = b2AddW(body.cx, b2SubW(b2MulW(body.c, dx), b2MulW(body.s, dy)));
+	*wy = b2AddW(body.cy, b2AddW(b2MulW(body.s, dx), b2MulW(body.c, dy)));
+}
+
+float32 b2ContactSolver::SolveWidePositionConstraints()
+{
+	const b2FloatW zero = b2ZeroW();
+	const b2FloatW half = b2SplatW(0.5f);
+	b2FloatW minSeparation = zero;
+
+	for (int32 i = 0; i < m_wideCount; ++i)
+	{
+		b2WidePositionConstraint* wpc = m_widePositionConstraints + i;
+
+		b2WidePosition A, B;
+		b2GatherPositions(&A, m_positions, wpc->indexA);
+		b2GatherPositions(&B, m_positions, wpc->indexB);
+
+		b2FloatW mA = b2LoadW(wpc->invMassA);
+		b2FloatW iA = b2LoadW(wpc->invIA);
+		b2FloatW mB = b2LoadW(wpc->invMassB);
+		b2FloatW iB = b2LoadW(wpc->invIB);
+		b2FloatW lcAx = b2LoadW(wpc->localCenterAx);
+		b2FloatW lcAy = b2LoadW(wpc->localCenterAy);
+		b2FloatW lcBx = b2LoadW(wpc->localCenterBx);
+		b2FloatW lcBy = b2LoadW(wpc->localCenterBy);
+		b2FloatW lnx = b2LoadW(wpc->localNormalX);
+		b2FloatW lny = b2LoadW(wpc->localNormalY);
+		b2FloatW lpx = b2LoadW(wpc->localPointX);
+		b2FloatW lpy = b2LoadW(wpc->localPointY);
+		b2FloatW radius = b2LoadW(wpc->radius);
+		b2FloatW circles = b2GreaterW(b2LoadW(wpc->circles), zero);
+		b2FloatW faceB = b2GreaterW(b2LoadW(wpc->faceB), zero);
+
+		for (int32 j = 0; j < b2_maxManifoldPoints; ++j)
+		{
+			b2FloatW active = b2GreaterW(b2LoadW(wpc->pointActive[j]), zero);
+			b2FloatW cpx = b2LoadW(wpc->localPointsX[j]);
+			b2FloatW cpy = b2LoadW(wpc->localPointsY[j]);
+
+			// Face manifolds. The reference body has the normal and plane point.
+			b2WidePosition ref, inc;
+			b2FloatW refCx = b2SelectW(faceB, lcBx, lcAx), refCy = b2SelectW(faceB, lcBy, lcAy);
+			b2FloatW incCx = b2SelectW(faceB, lcAx, lcBx), incCy = b2SelectW(faceB, lcAy, lcBy);
+			ref.cx = b2SelectW(faceB, B.cx, A.cx);
+			ref.cy = b2SelectW(faceB, B.cy, A.cy);
+			ref.s = b2SelectW(faceB, B.s, A.s);
+			ref.c = b2SelectW(faceB, B.c, A.c);
+			inc.cx = b2SelectW(faceB, A.cx, B.cx);
+			inc.cy = b2SelectW(faceB, A.cy, B.cy);
+			inc.s = b2SelectW(faceB, A.s, B.s);
+			inc.c = b2SelectW(faceB, A.c, B.c);
+
+			b2FloatW nx = b2SubW(b2MulW(ref.c, lnx), b2MulW(ref.s, lny));
+			b2FloatW ny = b2AddW(b2MulW(ref.s, lnx), b2MulW(ref.c, lny));
+
+			b2FloatW planeX, planeY, clipX, clipY;
+			b2TransformPointW(ref, refCx, refCy, lpx, lpy, &planeX, &planeY);
+			b2TransformPointW(inc, incCx, incCy, cpx, cpy, &clipX, &clipY);
+
+			b2FloatW separation = b2SubW(b2AddW(b2MulW(b2SubW(clipX, planeX), nx), b2MulW(b2SubW(clipY, planeY), ny)), radius);
+			b2FloatW px = clipX;
+			b2FloatW py = clipY;
+
+			// Ensure normal points from A to B
+			nx = b2SelectW(faceB, b2SubW(zero, nx), nx);
+			ny = b2SelectW(faceB, b2SubW(zero, ny), ny);
+
+			// Circle manifolds.
+			{
+				b2FloatW pointAx, pointAy, pointBx, pointBy;
+				b2TransformPointW(A, lcAx, lcAy, lpx, lpy, &pointAx, &pointAy);
+				b2TransformPointW(B, lcBx, lcBy, cpx, cpy, &pointBx, &pointBy);
+
+				b2FloatW dx = b2SubW(pointBx, pointAx);
+				b2FloatW dy = b2SubW(pointBy, pointAy);
+				b2FloatW length = b2SqrtW(b2AddW(b2MulW(dx, dx), b2MulW(dy, dy)));
+				b2FloatW normalize = b2GreaterEqualW(length, b2SplatW(b2_epsilon));
+				b2FloatW cnx = b2SelectW(normalize, b2DivW(dx, length), dx);
+				b2FloatW cny = b2SelectW(normalize, b2DivW(dy, length), dy);
+
+				nx = b2SelectW(circles, cnx, nx);
+				ny = b2SelectW(circles, cny, ny);
+				px = b2SelectW(circles, b2MulW(half, b2AddW(pointAx, pointBx)), px);
+				py = b2SelectW(circles, b2MulW(half, b2AddW(pointAy, pointBy)), py);
+				separation = b2SelectW(circles, b2SubW(b2AddW(b2MulW(dx, cnx), b2MulW(dy, cny)), radius), separation);
+			}
+
+			b2FloatW rAx = b2SubW(px, A.cx);
+			b2FloatW rAy = b2SubW(py, A.cy);
+			b2FloatW rBx = b2SubW(px, B.cx);
+			b2FloatW rBy = b2SubW(py, B.cy);
+
+			// Track max constraint error.
+			minSeparation = b2MinW(minSeparation, b2SelectW(active, separation, zero));
+
+			// Prevent large corrections and allow slop.
+			b2FloatW C = b2MulW(b2SplatW(b2_baumgarte), b2AddW(separation, b2SplatW(b2_linearSlop)));
+			C = b2MinW(b2MaxW(C, b2SplatW(-b2_maxLinearCorrection)), zero);
+
+			// Compute the effective mass.
+			b2FloatW rnA = b2SubW(b2MulW(rAx, ny), b2MulW(rAy, nx));
+			b2FloatW rnB = b2SubW(b2MulW(rBx, ny), b2MulW(rBy, nx));
+			b2FloatW K = b2AddW(b2AddW(mA, mB), b2AddW(b2MulW(iA, b2MulW(rnA, rnA)), b2MulW(iB, b2MulW(rnB, rnB))));
+
+			// Compute normal impulse
+			b2FloatW solve = b2AndW(active, b2GreaterW(K, zero));
+			b2FloatW impulse = b2SelectW(solve, b2SubW(zero, b2DivW(C, K)), zero);
+
+			b2FloatW Px = b2MulW(impulse, nx);
+			b2FloatW Py = b2MulW(impulse, ny);
+
+			b2FloatW daA = b2MulW(iA, b2SubW(b2MulW(rAx, Py), b2MulW(rAy, Px)));
+			b2FloatW daB = b2MulW(iB, b2SubW(b2MulW(rBx, Py), b2MulW(rBy, Px)));
+
+			A.cx = b2SubW(A.cx, b2MulW(mA, Px));
+			A.cy = b2SubW(A.cy, b2MulW(mA, Py));
+			A.a = b2SubW(A.a, daA);
+			b2IntegrateRotationW(&A, b2SubW(zero, daA));
+
+			B.cx = b2AddW(B.cx, b2MulW(mB, Px));
+			B.cy = b2AddW(B.cy, b2MulW(mB, Py));
+			B.a = b2AddW(B.a, daB);
+			b2IntegrateRotationW(&B, daB);
+		}
+
+		b2ScatterPositions(m_positions, &A, wpc->indexA, wpc->invMassA, wpc->invIA);
+		b2ScatterPositions(m_positions, &B, wpc->indexB, wpc->invMassB, wpc->invIB);
+	}
+
+	float32 separations[b2_simdWidth];
+	b2StoreW(separations, minSeparation);
+
+	float32 result = 0.0f;
+	for (int32 j = 0; j < b2_simdWidth; ++j)
+	{
+		result = b2Min(result, separations[j]);
+	}
+
+	return result;
+}
@@ -123,6 +123,9 @@ void b2Body::SetType(b2BodyType type)
 		return;
 	}
 
+	// Static proxies live in their own broad-phase tree.
+	bool moveTree = (m_type == b2_staticBody) != (type == b2_staticBody);
+
 	m_type = type;
 
 	ResetMassData();
@@ -155,6 +158,14 @@ void b2Body::SetType(b2BodyType type)
 	b2BroadPhase* broadPhase = &m_world->m_contactManager.m_broadPhase;
 	for (b2Fixture* f = m_fixtureList; f; f = f->m_next)
 	{
+		if (moveTree && (m_flags & e_activeFlag))
+		{
+			// New proxies are reported like touched ones.
+			f->DestroyProxies(broadPhase);
+			f->CreateProxies(broadPhase, m_xf);
+			continue;
+		}
+
 		int32 proxyCount = f->m_proxyCount;
 		for (int32 i = 0; i < proxyCount; ++i)
 		{
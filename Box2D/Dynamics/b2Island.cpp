@@ -162,6 +162,11 @@ b2Island::b2Island(
 	m_allocator = allocator;
 	m_listener = listener;
 
+	m_shared = false;
+	m_contactIndices = nullptr;
+	m_impulses = nullptr;
+	m_asleep = false;
+
 	m_bodies = (b2Body**)m_allocator->Allocate(bodyCapacity * sizeof(b2Body*));
 	m_contacts = (b2Contact**)m_allocator->Allocate(contactCapacity	 * sizeof(b2Contact*));
 	m_joints = (b2Joint**)m_allocator->Allocate(jointCapacity * sizeof(b2Joint*));
@@ -197,8 +202,12 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 		float32 w = b->m_angularVelocity;
 
 		// Store positions for continuous collision.
-		b->m_sweep.c0 = b->m_sweep.c;
-		b->m_sweep.a0 = b->m_sweep.a;
+		// Static bodies don't move so they're left alone when shared.
+		if (m_shared == false || b->m_type != b2_staticBody)
+		{
+			b->m_sweep.c0 = b->m_sweep.c;
+			b->m_sweep.a0 = b->m_sweep.a;
+		}
 
 		if (b->m_type == b2_dynamicBody)
 		{
@@ -239,6 +248,7 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	contactSolverDef.positions = m_positions;
 	contactSolverDef.velocities = m_velocities;
 	contactSolverDef.allocator = m_allocator;
+	contactSolverDef.indices = m_contactIndices;
 
 	b2ContactSolver contactSolver(&contactSolverDef);
 	contactSolver.InitializeVelocityConstraints();
@@ -330,6 +340,11 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	for (int32 i = 0; i < m_bodyCount; ++i)
 	{
 		b2Body* body = m_bodies[i];
+		if (m_shared && body->m_type == b2_staticBody)
+		{
+			continue;
+		}
+
 		body->m_sweep.c = m_positions[i].c;
 		body->m_sweep.a = m_positions[i].a;
 		body->m_linearVelocity = m_velocities[i].v;
@@ -341,6 +356,8 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 
 	Report(contactSolver.m_velocityConstraints);
 
+	m_asleep = false;
+
 	if (allowSleep)
 	{
 		float32 minSleepTime = b2_maxFloat;
@@ -372,9 +389,18 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 
 		if (minSleepTime >= b2_timeToSleep && positionSolved)
 		{
+			m_asleep = true;
+
 			for (int32 i = 0; i < m_bodyCount; ++i)
 			{
 				b2Body* b = m_bodies[i];
+
+				// The world puts shared static bodies to sleep after the islands are solved.
+				if (m_shared && b->m_type == b2_staticBody)
+				{
+					continue;
+				}
+
 				b->SetAwake(false);
 			}
 		}
@@ -515,7 +541,7 @@ void b2Island::SolveTOI(const b2TimeStep& subStep, int32 toiIndexA, int32 toiInd
 
 void b2Island::Report(const b2ContactVelocityConstraint* constraints)
 {
-	if (m_listener == nullptr)
+	if (m_listener == nullptr && m_impulses == nullptr)
 	{
 		return;
 	}
@@ -534,6 +560,13 @@ void b2Island::Report(const b2ContactVelocityConstraint* constraints)
 			impulse.tangentImpulses[j] = vc->points[j].tangentImpulse;
 		}
 
+		// Saved for the world to report after all the islands are solved.
+		if (m_impulses)
+		{
+			m_impulses[i] = impulse;
+			continue;
+		}
+
 		m_listener->PostSolve(c, &impulse);
 	}
 }
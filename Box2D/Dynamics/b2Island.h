@@ -28,6 +28,7 @@ class b2Joint;
 class b2StackAllocator;
 class b2ContactListener;
 struct b2ContactVelocityConstraint;
+struct b2ContactImpulse;
 struct b2Profile;
 
 /// This is an internal class.
@@ -74,6 +75,17 @@ public:
 	b2StackAllocator* m_allocator;
 	b2ContactListener* m_listener;
 
+	// Set when islands are solved at the same time. Static bodies are shared
+	// between islands so they are only read. The contact solver uses the
+	// island indices of the contacts and the impulses are saved instead of
+	// reported to the listener.
+	bool m_shared;
+	const int32* m_contactIndices;
+	b2ContactImpulse* m_impulses;
+
+	// Did the island fall asleep in the last solve
+	bool m_asleep;
+
 	b2Body** m_bodies;
 	b2Contact** m_contacts;
 	b2Joint** m_joints;
@@ -33,12 +33,18 @@
 #include "Box2D/Common/b2Draw.h"
 #include "Box2D/Common/b2Timer.h"
 #include <new>
+#include <atomic>
+#include <algorithm>
 
 b2World::b2World(const b2Vec2& gravity)
 {
 	m_destructionListener = nullptr;
 	m_debugDraw = nullptr;
 
+	m_taskExecutor = nullptr;
+	m_workerAllocators = nullptr;
+	m_workerCount = 0;
+
 	m_bodyList = nullptr;
 	m_jointList = nullptr;
 
@@ -46,6 +52,7 @@ b2World::b2World(const b2Vec2& gravity)
 	m_jointCount = 0;
 
 	m_warmStarting = true;
+	m_wideContactSolver = false;
 	m_continuousPhysics = true;
 	m_subStepping = false;
 
@@ -82,6 +89,8 @@ b2World::~b2World()
 
 		b = bNext;
 	}
+
+	SetTaskExecutor(nullptr);
 }
 
 void b2World::SetDestructionListener(b2DestructionListener* listener)
@@ -104,6 +113,35 @@ void b2World::SetDebugDraw(b2Draw* debugDraw)
 	m_debugDraw = debugDraw;
 }
 
+void b2World::SetTaskExecutor(b2TaskExecutor* executor)
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return;
+	}
+
+	for (int32 i = 0; i < m_workerCount; ++i)
+	{
+		m_workerAllocators[i].~b2StackAllocator();
+	}
+	b2Free(m_workerAllocators);
+
+	m_taskExecutor = executor;
+	m_workerAllocators = nullptr;
+	m_workerCount = 0;
+
+	if (executor)
+	{
+		m_workerCount = b2Max(executor->GetWorkerCount(), 1);
+		m_workerAllocators = (b2StackAllocator*)b2Alloc(m_workerCount * sizeof(b2StackAllocator));
+		for (int32 i = 0; i < m_workerCount; ++i)
+		{
+			new (m_workerAllocators + i) b2StackAllocator;
+		}
+	}
+}
+
 b2Body* b2World::CreateBody(const b2BodyDef* def)
 {
 	b2Assert(IsLocked() == false);
@@ -389,13 +427,6 @@ void b2World::Solve(const b2TimeStep& step)
 	m_profile.solveVelocity = 0.0f;
 	m_profile.solvePosition = 0.0f;
 
-	// Size the island for the worst case.
-	b2Island island(m_bodyCount,
-					m_contactManager.m_contactCount,
-					m_jointCount,
-					&m_stackAllocator,
-					m_contactManager.m_contactListener);
-
 	// Clear all the island flags.
 	for (b2Body* b = m_bodyList; b; b = b->m_next)
 	{
@@ -410,134 +441,350 @@ void b2World::Solve(const b2TimeStep& step)
 		j->m_islandFlag = false;
 	}
 
-	// Build and simulate all awake islands.
-	int32 stackSize = m_bodyCount;
-	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
-	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	if (m_workerCount > 1)
 	{
-		if (seed->m_flags & b2Body::e_islandFlag)
+		SolveIslands(step);
+	}
+	else
+	{
+		// Size the island for the worst case.
+		b2Island island(m_bodyCount,
+						m_contactManager.m_contactCount,
+						m_jointCount,
+						&m_stackAllocator,
+						m_contactManager.m_contactListener);
+
+		// Build and simulate all awake islands.
+		int32 stackSize = m_bodyCount;
+		b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
+		for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
 		{
-			continue;
+			if (seed->m_flags & b2Body::e_islandFlag)
+			{
+				continue;
+			}
+
+			if (seed->IsAwake() == false || seed->IsActive() == false)
+			{
+				continue;
+			}
+
+			// The seed can be dynamic or kinematic.
+			if (seed->GetType() == b2_staticBody)
+			{
+				continue;
+			}
+
+			// Reset island and stack.
+			island.Clear();
+			BuildIsland(&island, seed, stack, stackSize);
+
+			b2Profile profile;
+			island.Solve(&profile, step, m_gravity, m_allowSleep);
+			m_profile.solveInit += profile.solveInit;
+			m_profile.solveVelocity += profile.solveVelocity;
+			m_profile.solvePosition += profile.solvePosition;
+
+			// Post solve cleanup.
+			for (int32 i = 0; i < island.m_bodyCount; ++i)
+			{
+				// Allow static bodies to participate in other islands.
+				b2Body* b = island.m_bodies[i];
+				if (b->GetType() == b2_staticBody)
+				{
+					b->m_flags &= ~b2Body::e_islandFlag;
+				}
+			}
 		}
 
-		if (seed->IsAwake() == false || seed->IsActive() == false)
+		m_stackAllocator.Free(stack);
+	}
+
+	{
+		b2Timer timer;
+		// Synchronize fixtures, check for out of range bodies.
+		for (b2Body* b = m_bodyList; b; b = b->GetNext())
 		{
-			continue;
+			// If a body was not in an island then it did not move.
+			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			{
+				continue;
+			}
+
+			if (b->GetType() == b2_staticBody)
+			{
+				continue;
+			}
+
+			// Update fixtures (for broad-phase).
+			b->SynchronizeFixtures();
 		}
 
-		// The seed can be dynamic or kinematic.
-		if (seed->GetType() == b2_staticBody)
+		// Look for new contacts.
+		m_contactManager.FindNewContacts();
+		m_profile.broadphase = timer.GetMilliseconds();
+	}
+}
+
+// Add the seed and everything connected to it to the island.
+void b2World::BuildIsland(b2Island* island, b2Body* seed, b2Body** stack, int32 stackSize)
+{
+	int32 stackCount = 0;
+	stack[stackCount++] = seed;
+	seed->m_flags |= b2Body::e_islandFlag;
+
+	// Perform a depth first search (DFS) on the constraint graph.
+	while (stackCount > 0)
+	{
+		// Grab the next body off the stack and add it to the island.
+		b2Body* b = stack[--stackCount];
+		b2Assert(b->IsActive() == true);
+		island->Add(b);
+
+		// Make sure the body is awake (without resetting sleep timer).
+		b->m_flags |= b2Body::e_awakeFlag;
+
+		// To keep islands as small as possible, we don't
+		// propagate islands across static bodies.
+		if (b->GetType() == b2_staticBody)
 		{
 			continue;
 		}
 
-		// Reset island and stack.
-		island.Clear();
-		int32 stackCount = 0;
-		stack[stackCount++] = seed;
-		seed->m_flags |= b2Body::e_islandFlag;
-
-		// Perform a depth first search (DFS) on the constraint graph.
-		while (stackCount > 0)
+		// Search all contacts connected to this body.
+		for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
 		{
-			// Grab the next body off the stack and add it to the island.
-			b2Body* b = stack[--stackCount];
-			b2Assert(b->IsActive() == true);
-			island.Add(b);
+			b2Contact* contact = ce->contact;
 
-			// Make sure the body is awake (without resetting sleep timer).
-			b->m_flags |= b2Body::e_awakeFlag;
+			// Has this contact already been added to an island?
+			if (contact->m_flags & b2Contact::e_islandFlag)
+			{
+				continue;
+			}
 
-			// To keep islands as small as possible, we don't
-			// propagate islands across static bodies.
-			if (b->GetType() == b2_staticBody)
+			// Is this contact solid and touching?
+			if (contact->IsEnabled() == false ||
+				contact->IsTouching() == false)
 			{
 				continue;
 			}
 
-			// Search all contacts connected to this body.
-			for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
+			// Skip sensors.
+			bool sensorA = contact->m_fixtureA->m_isSensor;
+			bool sensorB = contact->m_fixtureB->m_isSensor;
+			if (sensorA || sensorB)
 			{
-				b2Contact* contact = ce->contact;
+				continue;
+			}
 
-				// Has this contact already been added to an island?
-				if (contact->m_flags & b2Contact::e_islandFlag)
-				{
-					continue;
-				}
+			island->Add(contact);
+			contact->m_flags |= b2Contact::e_islandFlag;
 
-				// Is this contact solid and touching?
-				if (contact->IsEnabled() == false ||
-					contact->IsTouching() == false)
-				{
-					continue;
-				}
+			b2Body* other = ce->other;
 
-				// Skip sensors.
-				bool sensorA = contact->m_fixtureA->m_isSensor;
-				bool sensorB = contact->m_fixtureB->m_isSensor;
-				if (sensorA || sensorB)
-				{
-					continue;
-				}
+			// Was the other body already added to this island?
+			if (other->m_flags & b2Body::e_islandFlag)
+			{
+				continue;
+			}
 
-				island.Add(contact);
-				contact->m_flags |= b2Contact::e_islandFlag;
+			b2Assert(stackCount < stackSize);
+			stack[stackCount++] = other;
+			other->m_flags |= b2Body::e_islandFlag;
+		}
 
-				b2Body* other = ce->other;
+		// Search all joints connect to this body.
+		for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+		{
+			if (je->joint->m_islandFlag == true)
+			{
+				continue;
+			}
 
-				// Was the other body already added to this island?
-				if (other->m_flags & b2Body::e_islandFlag)
-				{
-					continue;
-				}
+			b2Body* other = je->other;
 
-				b2Assert(stackCount < stackSize);
-				stack[stackCount++] = other;
-				other->m_flags |= b2Body::e_islandFlag;
+			// Don't simulate joints connected to inactive bodies.
+			if (other->IsActive() == false)
+			{
+				continue;
 			}
 
-			// Search all joints connect to this body.
-			for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+			island->Add(je->joint);
+			je->joint->m_islandFlag = true;
+
+			if (other->m_flags & b2Body::e_islandFlag)
 			{
-				if (je->joint->m_islandFlag == true)
-				{
-					continue;
-				}
+				continue;
+			}
 
-				b2Body* other = je->other;
+			b2Assert(stackCount < stackSize);
+			stack[stackCount++] = other;
+			other->m_flags |= b2Body::e_islandFlag;
+		}
+	}
 
-				// Don't simulate joints connected to inactive bodies.
-				if (other->IsActive() == false)
-				{
-					continue;
-				}
+	B2_NOT_USED(stackSize);
+}
 
-				island.Add(je->joint);
-				je->joint->m_islandFlag = true;
+// A range of the bodies, contacts and joints of all the islands.
+struct b2IslandRange
+{
+	int32 bodyStart, bodyCount;
+	int32 contactStart, contactCount;
+	int32 jointStart, jointCount;
+	bool asleep;
+};
 
-				if (other->m_flags & b2Body::e_islandFlag)
-				{
-					continue;
-				}
+// Solves the islands in the ranges. The workers take the next island
+// until they run out. Each island is solved the same as on one thread.
+class b2SolveIslandsTask : public b2Task
+{
+public:
+	void Execute(int32 workerIndex) override
+	{
+		for (;;)
+		{
+			int32 i = m_next.fetch_add(1);
+			if (i >= m_count)
+			{
+				break;
+			}
 
-				b2Assert(stackCount < stackSize);
-				stack[stackCount++] = other;
-				other->m_flags |= b2Body::e_islandFlag;
+			Solve(m_ranges + m_order[i], m_allocators + workerIndex, m_profiles + workerIndex);
+		}
+	}
+
+	void Solve(b2IslandRange* range, b2StackAllocator* allocator, b2Profile* profileSum)
+	{
+		b2Island island(range->bodyCount, range->contactCount, range->jointCount, allocator, nullptr);
+		island.m_shared = true;
+		island.m_contactIndices = m_contactIndices + 2 * range->contactStart;
+		island.m_impulses = m_impulses ? m_impulses + range->contactStart : nullptr;
+
+		// Joints use the island indices of the bodies so islands with joints
+		// are solved on their own after the others. The static bodies of the
+		// other islands are shared so their indices are left alone.
+		for (int32 i = 0; i < range->bodyCount; ++i)
+		{
+			if (range->jointCount > 0)
+			{
+				island.Add(m_bodies[range->bodyStart + i]);
+			}
+			else
+			{
+				island.m_bodies[island.m_bodyCount++] = m_bodies[range->bodyStart + i];
 			}
 		}
+		for (int32 i = 0; i < range->contactCount; ++i)
+		{
+			island.Add(m_contacts[range->contactStart + i]);
+		}
+		for (int32 i = 0; i < range->jointCount; ++i)
+		{
+			island.Add(m_joints[range->jointStart + i]);
+		}
 
 		b2Profile profile;
-		island.Solve(&profile, step, m_gravity, m_allowSleep);
-		m_profile.solveInit += profile.solveInit;
-		m_profile.solveVelocity += profile.solveVelocity;
-		m_profile.solvePosition += profile.solvePosition;
+		island.Solve(&profile, m_step, m_gravity, m_allowSleep);
+		profileSum->solveInit += profile.solveInit;
+		profileSum->solveVelocity += profile.solveVelocity;
+		profileSum->solvePosition += profile.solvePosition;
 
-		// Post solve cleanup.
-		for (int32 i = 0; i < island.m_bodyCount; ++i)
+		range->asleep = island.m_asleep;
+	}
+
+	b2TimeStep m_step;
+	b2Vec2 m_gravity;
+	bool m_allowSleep;
+
+	b2Body** m_bodies;
+	b2Contact** m_contacts;
+	b2Joint** m_joints;
+	const int32* m_contactIndices;
+	b2ContactImpulse* m_impulses;
+
+	b2IslandRange* m_ranges;
+	const int32* m_order;
+	int32 m_count;
+	std::atomic<int32> m_next;
+
+	b2StackAllocator* m_allocators;
+	b2Profile* m_profiles;
+};
+
+// Build all the awake islands and solve them on the task executor's workers.
+// The contact listener and static bodies are updated after in island order.
+void b2World::SolveIslands(const b2TimeStep& step)
+{
+	int32 contactCount = m_contactManager.m_contactCount;
+	b2ContactListener* listener = m_contactManager.m_contactListener;
+
+	// Static bodies can be in more than one island. Each one is added
+	// by a contact or joint.
+	b2Island islands(m_bodyCount + contactCount + m_jointCount,
+					 contactCount,
+					 m_jointCount,
+					 &m_stackAllocator,
+					 nullptr);
+
+	int32 stackSize = m_bodyCount;
+	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
+	b2IslandRange* ranges = (b2IslandRange*)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2IslandRange));
+	int32* order = (int32*)m_stackAllocator.Allocate(m_bodyCount * sizeof(int32));
+	int32* contactIndices = (int32*)m_stackAllocator.Allocate(2 * contactCount * sizeof(int32));
+	b2ContactImpulse* impulses = nullptr;
+	if (listener)
+	{
+		impulses = (b2ContactImpulse*)m_stackAllocator.Allocate(contactCount * sizeof(b2ContactImpulse));
+	}
+	b2Profile* profiles = (b2Profile*)m_stackAllocator.Allocate(m_workerCount * sizeof(b2Profile));
+	memset(profiles, 0, m_workerCount * sizeof(b2Profile));
+
+	// Build all the islands the same as solving them one at a time.
+	int32 islandCount = 0;
+	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	{
+		if (seed->m_flags & b2Body::e_islandFlag)
+		{
+			continue;
+		}
+
+		if (seed->IsAwake() == false || seed->IsActive() == false)
 		{
-			// Allow static bodies to participate in other islands.
-			b2Body* b = island.m_bodies[i];
+			continue;
+		}
+
+		// The seed can be dynamic or kinematic.
+		if (seed->GetType() == b2_staticBody)
+		{
+			continue;
+		}
+
+		b2IslandRange* range = ranges + islandCount++;
+		range->bodyStart = islands.m_bodyCount;
+		range->contactStart = islands.m_contactCount;
+		range->jointStart = islands.m_jointCount;
+		range->asleep = false;
+
+		BuildIsland(&islands, seed, stack, stackSize);
+
+		range->bodyCount = islands.m_bodyCount - range->bodyStart;
+		range->contactCount = islands.m_contactCount - range->contactStart;
+		range->jointCount = islands.m_jointCount - range->jointStart;
+
+		// Save the island indices of the contact bodies before
+		// a static body is added to the next island.
+		for (int32 i = range->contactStart; i < islands.m_contactCount; ++i)
+		{
+			b2Contact* c = islands.m_contacts[i];
+			contactIndices[2 * i] = c->m_fixtureA->m_body->m_islandIndex - range->bodyStart;
+			contactIndices[2 * i + 1] = c->m_fixtureB->m_body->m_islandIndex - range->bodyStart;
+		}
+
+		// Allow static bodies to participate in other islands.
+		for (int32 i = range->bodyStart; i < islands.m_bodyCount; ++i)
+		{
+			b2Body* b = islands.m_bodies[i];
 			if (b->GetType() == b2_staticBody)
 			{
 				b->m_flags &= ~b2Body::e_islandFlag;
@@ -545,32 +792,107 @@ void b2World::Solve(const b2TimeStep& step)
 		}
 	}
 
-	m_stackAllocator.Free(stack);
+	// Islands without joints are solved on the workers, largest first.
+	int32 workCount = 0;
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		if (ranges[i].jointCount == 0)
+		{
+			order[workCount++] = i;
+		}
+	}
 
+	std::sort(order, order + workCount, [ranges](int32 a, int32 b)
 	{
-		b2Timer timer;
-		// Synchronize fixtures, check for out of range bodies.
-		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+		int32 sizeA = ranges[a].bodyCount + ranges[a].contactCount;
+		int32 sizeB = ranges[b].bodyCount + ranges[b].contactCount;
+		return sizeA > sizeB || (sizeA == sizeB && a < b);
+	});
+
+	int32 jointIslandCount = 0;
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		if (ranges[i].jointCount > 0)
 		{
-			// If a body was not in an island then it did not move.
-			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			order[workCount + jointIslandCount++] = i;
+		}
+	}
+
+	b2SolveIslandsTask task;
+	task.m_step = step;
+	task.m_gravity = m_gravity;
+	task.m_allowSleep = m_allowSleep;
+	task.m_bodies = islands.m_bodies;
+	task.m_contacts = islands.m_contacts;
+	task.m_joints = islands.m_joints;
+	task.m_contactIndices = contactIndices;
+	task.m_impulses = impulses;
+	task.m_ranges = ranges;
+	task.m_order = order;
+	task.m_count = workCount;
+	task.m_next = 0;
+	task.m_allocators = m_workerAllocators;
+	task.m_profiles = profiles;
+
+	if (workCount > 1)
+	{
+		m_taskExecutor->Run(&task, m_workerCount);
+	}
+	else
+	{
+		task.Execute(0);
+	}
+
+	// Joints read the island indices of the bodies while solving.
+	for (int32 i = workCount; i < workCount + jointIslandCount; ++i)
+	{
+		task.Solve(ranges + order[i], &m_stackAllocator, profiles);
+	}
+
+	for (int32 i = 0; i < m_workerCount; ++i)
+	{
+		m_profile.solveInit += profiles[i].solveInit;
+		m_profile.solveVelocity += profiles[i].solveVelocity;
+		m_profile.solvePosition += profiles[i].solvePosition;
+	}
+
+	// Report and put static bodies to sleep in the order they were solved
+	// on one thread.
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		const b2IslandRange* range = ranges + i;
+
+		if (impulses)
+		{
+			for (int32 j = range->contactStart; j < range->contactStart + range->contactCount; ++j)
 			{
-				continue;
+				listener->PostSolve(islands.m_contacts[j], impulses + j);
 			}
+		}
 
+		for (int32 j = range->bodyStart; j < range->bodyStart + range->bodyCount; ++j)
+		{
+			b2Body* b = islands.m_bodies[j];
 			if (b->GetType() == b2_staticBody)
 			{
-				continue;
+				b->m_flags |= b2Body::e_awakeFlag;
+				if (range->asleep)
+				{
+					b->SetAwake(false);
+				}
 			}
-
-			// Update fixtures (for broad-phase).
-			b->SynchronizeFixtures();
 		}
+	}
 
-		// Look for new contacts.
-		m_contactManager.FindNewContacts();
-		m_profile.broadphase = timer.GetMilliseconds();
+	m_stackAllocator.Free(profiles);
+	if (impulses)
+	{
+		m_stackAllocator.Free(impulses);
 	}
+	m_stackAllocator.Free(contactIndices);
+	m_stackAllocator.Free(order);
+	m_stackAllocator.Free(ranges);
+	m_stackAllocator.Free(stack);
 }
 
 // Find TOI contacts and solve them.
@@ -860,6 +1182,7 @@ void b2World::SolveTOI(const b2TimeStep& step)
 		subStep.positionIterations = 20;
 		subStep.velocityIterations = step.velocityIterations;
 		subStep.warmStarting = false;
+		subStep.wideContacts = false;
 		island.SolveTOI(subStep, bA->m_islandIndex, bB->m_islandIndex);
 
 		// Reset island flags and synchronize broad-phase proxies.
@@ -923,6 +1246,7 @@ void b2World::Step(float32 dt, int32 velocityIterations, int32 positionIteration
 	step.dtRatio = m_inv_dt0 * dt;
 
 	step.warmStarting = m_warmStarting;
+	step.wideContacts = m_wideContactSolver;
 	
 	// Update contacts. This is where some contacts are destroyed.
 	{
@@ -33,6 +33,7 @@ struct b2JointDef;
 class b2Body;
 class b2Draw;
 class b2Fixture;
+class b2Island;
 class b2Joint;
 
 /// The world class manages all physics entities, dynamic simulation,
@@ -66,6 +67,13 @@ public:
 	/// by you and must remain in scope.
 	void SetDebugDraw(b2Draw* debugDraw);
 
+	/// Register a task executor to solve islands on worker threads. The executor
+	/// is owned by you and must remain in scope. Each worker gets its own stack
+	/// allocator. Islands are independent so the results match solving them on
+	/// the calling thread. Pass nullptr to solve on the calling thread.
+	/// @warning This function is locked during callbacks.
+	void SetTaskExecutor(b2TaskExecutor* executor);
+
 	/// Create a rigid body given a definition. No reference to the definition
 	/// is retained.
 	/// @warning This function is locked during callbacks.
@@ -157,6 +165,11 @@ public:
 	void SetSubStepping(bool flag) { m_subStepping = flag; }
 	bool GetSubStepping() const { return m_subStepping; }
 
+	/// Enable/disable the wide contact solver. The contacts are graph colored and
+	/// solved several at a time with SIMD. The results are close to the sequential solver.
+	void SetWideContactSolver(bool flag) { m_wideContactSolver = flag; }
+	bool GetWideContactSolver() const { return m_wideContactSolver; }
+
 	/// Get the number of broad-phase proxies.
 	int32 GetProxyCount() const;
 
@@ -225,8 +238,11 @@ private:
 	friend class b2Controller;
 
 	void Solve(const b2TimeStep& step);
+	void SolveIslands(const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
 
+	void BuildIsland(b2Island* island, b2Body* seed, b2Body** stack, int32 stackSize);
+
 	void DrawJoint(b2Joint* joint);
 	void DrawShape(b2Fixture* shape, const b2Transform& xf, const b2Color& color);
 
@@ -249,6 +265,10 @@ private:
 	b2DestructionListener* m_destructionListener;
 	b2Draw* m_debugDraw;
 
+	b2TaskExecutor* m_taskExecutor;
+	b2StackAllocator* m_workerAllocators;
+	int32 m_workerCount;
+
 	// This is used to compute the time step ratio to
 	// support a variable time step.
 	float32 m_inv_dt0;
@@ -257,6 +277,7 @@ private:
 	bool m_warmStarting;
 	bool m_continuousPhysics;
 	bool m_subStepping;
+	bool m_wideContactSolver;
 
 	bool m_stepComplete;
 
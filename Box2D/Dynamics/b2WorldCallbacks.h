@@ -152,4 +152,32 @@ public:
 									const b2Vec2& normal, float32 fraction) = 0;
 };
 
+/// Work the world splits across workers. See b2TaskExecutor.
+class b2Task
+{
+public:
+	virtual ~b2Task() {}
+
+	/// Do the work of a worker. Each worker index has its own scratch memory.
+	virtual void Execute(int32 workerIndex) = 0;
+};
+
+/// Implement this class to solve islands on your own worker threads.
+/// See b2World::SetTaskExecutor
+class b2TaskExecutor
+{
+public:
+	virtual ~b2TaskExecutor() {}
+
+	/// The number of workers, including the calling thread. This is read
+	/// when the executor is set.
+	virtual int32 GetWorkerCount() = 0;
+
+	/// Call task->Execute once for each worker index in [0, workerCount)
+	/// and return when all the calls are done. Calls with different worker
+	/// indices may run at the same time. The calling thread may run any of them.
+	/// workerCount is the count the world read when the executor was set.
+	virtual void Run(b2Task* task, int32 workerCount) = 0;
+};
+
 #endif
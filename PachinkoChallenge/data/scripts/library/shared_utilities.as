@@ -9,14 +9,9 @@
 
 /************************************************************************
 *    DESC:  Hold the script execution in time
+*           The script is not resumed until the time is up
 ************************************************************************/
 shared void Hold( float time )
 {
-    do
-    {
-        time -= HighResTimer.getElapsedTime();
-
-        Suspend();
-    }
-    while( time > 0 );
+    WaitMs( time );
 }
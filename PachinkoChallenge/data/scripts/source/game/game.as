@@ -41,6 +41,9 @@ class CGame
     //
     void init()
     {
+        // Read the menu scripts on a background thread while the device is created
+        ScriptMgr.preloadGroup( "(menu)" );
+
         // Create the rendering device
         Device.create( "data/shaders/pipeline.cfg" );
         
@@ -85,6 +88,9 @@ class CGame
             else if( nextState == NStateDefs::EGS_RUN )
                 @mGameState = CRunState();
 
+            // The old state is gone so collect all of its garbage before the new state starts
+            ScriptMgr.collectGarbage( true );
+
             // Do any pre-game loop init's
             mGameState.init();
         }
@@ -26,16 +26,22 @@ void main()
 /************************************************************************
 *    DESC:  Physics callbacks
 ************************************************************************/
-void Physics_BeginContact( CSprite & spriteA, CSprite & spriteB )
+void Physics_BeginContacts( CContactList2D & contacts )
 {
     if( hGame !is null )
-        hGame.beginContact( spriteA, spriteB );
+    {
+        for( uint i = 0; i < contacts.size(); ++i )
+            hGame.beginContact( contacts[i].getSpriteA(), contacts[i].getSpriteB() );
+    }
 }
 
-void Physics_EndContact( CSprite & spriteA, CSprite & spriteB )
+void Physics_EndContacts( CContactList2D & contacts )
 {
     if( hGame !is null )
-        hGame.endContact( spriteA, spriteB );
+    {
+        for( uint i = 0; i < contacts.size(); ++i )
+            hGame.endContact( contacts[i].getSpriteA(), contacts[i].getSpriteB() );
+    }
 }
 
 void Physics_DestroyFixture( CSprite & sprite )
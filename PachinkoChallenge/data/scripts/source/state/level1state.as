@@ -278,7 +278,7 @@ final class CRunState : CCommonState
     void physics() override
     {
         if( !MenuMgr.isActive() )
-            mPhysicsWorld.variableTimeStep();
+            mPhysicsWorld.fixedTimeStep();
     }
 
     //
@@ -82,7 +82,7 @@ final class CTitleScreenState : CCommonState
     //
     void physics() override
     {
-        mPhysicsWorld.variableTimeStep();
+        mPhysicsWorld.fixedTimeStep();
     }
 
     //
@@ -1857,12 +1857,94 @@ void asCContext::CallInterfaceMethod(asCScriptFunction *func)
 	CallScriptFunction(realFunc);
 }
 
+// Threaded dispatch. Each byte code jumps straight to the code of the next one
+// through a table of label addresses instead of going back to the switch. The
+// labels as values extension is only available on GCC and Clang. AS_DEBUG keeps
+// the switch as it gathers the statistics and checks the sizes in the loop
+#if defined(AS_COMPUTED_GOTO) && (defined(__GNUC__) || defined(__clang__)) && !defined(AS_DEBUG)
+	#define AS_THREADED_DISPATCH
+#endif
+
+#ifdef AS_THREADED_DISPATCH
+	#define AS_CASE(op)     case op: op_##op
+	#define AS_NEXT()       goto *dispatchTable[*(asBYTE*)l_bc]
+#else
+	#define AS_CASE(op)     case op
+	#define AS_NEXT()       break
+#endif
+
 void asCContext::ExecuteNext()
 {
 	asDWORD *l_bc = m_regs.programPointer;
 	asDWORD *l_sp = m_regs.stackPointer;
 	asDWORD *l_fp = m_regs.stackFramePointer;
 
+#ifdef AS_THREADED_DISPATCH
+	// Must be in the same order as asEBCInstr
+	static const void * const dispatchTable[256] =
+	{
+		&&op_asBC_PopPtr, &&op_asBC_PshGPtr, &&op_asBC_PshC4, &&op_asBC_PshV4,
+		&&op_asBC_PSF, &&op_asBC_SwapPtr, &&op_asBC_NOT, &&op_asBC_PshG4,
+		&&op_asBC_LdGRdR4, &&op_asBC_CALL, &&op_asBC_RET, &&op_asBC_JMP,
+		&&op_asBC_JZ, &&op_asBC_JNZ, &&op_asBC_JS, &&op_asBC_JNS,
+		&&op_asBC_JP, &&op_asBC_JNP, &&op_asBC_TZ, &&op_asBC_TNZ,
+		&&op_asBC_TS, &&op_asBC_TNS, &&op_asBC_TP, &&op_asBC_TNP,
+		&&op_asBC_NEGi, &&op_asBC_NEGf, &&op_asBC_NEGd, &&op_asBC_INCi16,
+		&&op_asBC_INCi8, &&op_asBC_DECi16, &&op_asBC_DECi8, &&op_asBC_INCi,
+		&&op_asBC_DECi, &&op_asBC_INCf, &&op_asBC_DECf, &&op_asBC_INCd,
+		&&op_asBC_DECd, &&op_asBC_IncVi, &&op_asBC_DecVi, &&op_asBC_BNOT,
+		&&op_asBC_BAND, &&op_asBC_BOR, &&op_asBC_BXOR, &&op_asBC_BSLL,
+		&&op_asBC_BSRL, &&op_asBC_BSRA, &&op_asBC_COPY, &&op_asBC_PshC8,
+		&&op_asBC_PshVPtr, &&op_asBC_RDSPtr, &&op_asBC_CMPd, &&op_asBC_CMPu,
+		&&op_asBC_CMPf, &&op_asBC_CMPi, &&op_asBC_CMPIi, &&op_asBC_CMPIf,
+		&&op_asBC_CMPIu, &&op_asBC_JMPP, &&op_asBC_PopRPtr, &&op_asBC_PshRPtr,
+		&&op_asBC_STR, &&op_asBC_CALLSYS, &&op_asBC_CALLBND, &&op_asBC_SUSPEND,
+		&&op_asBC_ALLOC, &&op_asBC_FREE, &&op_asBC_LOADOBJ, &&op_asBC_STOREOBJ,
+		&&op_asBC_GETOBJ, &&op_asBC_REFCPY, &&op_asBC_CHKREF, &&op_asBC_GETOBJREF,
+		&&op_asBC_GETREF, &&op_asBC_PshNull, &&op_asBC_ClrVPtr, &&op_asBC_OBJTYPE,
+		&&op_asBC_TYPEID, &&op_asBC_SetV4, &&op_asBC_SetV8, &&op_asBC_ADDSi,
+		&&op_asBC_CpyVtoV4, &&op_asBC_CpyVtoV8, &&op_asBC_CpyVtoR4, &&op_asBC_CpyVtoR8,
+		&&op_asBC_CpyVtoG4, &&op_asBC_CpyRtoV4, &&op_asBC_CpyRtoV8, &&op_asBC_CpyGtoV4,
+		&&op_asBC_WRTV1, &&op_asBC_WRTV2, &&op_asBC_WRTV4, &&op_asBC_WRTV8,
+		&&op_asBC_RDR1, &&op_asBC_RDR2, &&op_asBC_RDR4, &&op_asBC_RDR8,
+		&&op_asBC_LDG, &&op_asBC_LDV, &&op_asBC_PGA, &&op_asBC_CmpPtr,
+		&&op_asBC_VAR, &&op_asBC_iTOf, &&op_asBC_fTOi, &&op_asBC_uTOf,
+		&&op_asBC_fTOu, &&op_asBC_sbTOi, &&op_asBC_swTOi, &&op_asBC_ubTOi,
+		&&op_asBC_uwTOi, &&op_asBC_dTOi, &&op_asBC_dTOu, &&op_asBC_dTOf,
+		&&op_asBC_iTOd, &&op_asBC_uTOd, &&op_asBC_fTOd, &&op_asBC_ADDi,
+		&&op_asBC_SUBi, &&op_asBC_MULi, &&op_asBC_DIVi, &&op_asBC_MODi,
+		&&op_asBC_ADDf, &&op_asBC_SUBf, &&op_asBC_MULf, &&op_asBC_DIVf,
+		&&op_asBC_MODf, &&op_asBC_ADDd, &&op_asBC_SUBd, &&op_asBC_MULd,
+		&&op_asBC_DIVd, &&op_asBC_MODd, &&op_asBC_ADDIi, &&op_asBC_SUBIi,
+		&&op_asBC_MULIi, &&op_asBC_ADDIf, &&op_asBC_SUBIf, &&op_asBC_MULIf,
+		&&op_asBC_SetG4, &&op_asBC_ChkRefS, &&op_asBC_ChkNullV, &&op_asBC_CALLINTF,
+		&&op_asBC_iTOb, &&op_asBC_iTOw, &&op_asBC_SetV1, &&op_asBC_SetV2,
+		&&op_asBC_Cast, &&op_asBC_i64TOi, &&op_asBC_uTOi64, &&op_asBC_iTOi64,
+		&&op_asBC_fTOi64, &&op_asBC_dTOi64, &&op_asBC_fTOu64, &&op_asBC_dTOu64,
+		&&op_asBC_i64TOf, &&op_asBC_u64TOf, &&op_asBC_i64TOd, &&op_asBC_u64TOd,
+		&&op_asBC_NEGi64, &&op_asBC_INCi64, &&op_asBC_DECi64, &&op_asBC_BNOT64,
+		&&op_asBC_ADDi64, &&op_asBC_SUBi64, &&op_asBC_MULi64, &&op_asBC_DIVi64,
+		&&op_asBC_MODi64, &&op_asBC_BAND64, &&op_asBC_BOR64, &&op_asBC_BXOR64,
+		&&op_asBC_BSLL64, &&op_asBC_BSRL64, &&op_asBC_BSRA64, &&op_asBC_CMPi64,
+		&&op_asBC_CMPu64, &&op_asBC_ChkNullS, &&op_asBC_ClrHi, &&op_asBC_JitEntry,
+		&&op_asBC_CallPtr, &&op_asBC_FuncPtr, &&op_asBC_LoadThisR, &&op_asBC_PshV8,
+		&&op_asBC_DIVu, &&op_asBC_MODu, &&op_asBC_DIVu64, &&op_asBC_MODu64,
+		&&op_asBC_LoadRObjR, &&op_asBC_LoadVObjR, &&op_asBC_RefCpyV, &&op_asBC_JLowZ,
+		&&op_asBC_JLowNZ, &&op_asBC_AllocMem, &&op_asBC_SetListSize, &&op_asBC_PshListElmnt,
+		&&op_asBC_SetListType, &&op_asBC_POWi, &&op_asBC_POWu, &&op_asBC_POWf,
+		&&op_asBC_POWd, &&op_asBC_POWdi, &&op_asBC_POWi64, &&op_asBC_POWu64,
+		&&op_asBC_Thiscall1,
+		// 201 - 255 aren't used
+		&&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused,
+		&&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused,
+		&&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused,
+		&&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused,
+		&&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused,
+		&&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused,
+		&&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused, &&op_unused
+	};
+#endif
+
 	for(;;)
 	{
 
@@ -1880,57 +1962,61 @@ void asCContext::ExecuteNext()
 	// It will be faster since only one lookup will be
 	// made to find the correct jump destination. If not
 	// in order, the switch will make two lookups.
+#ifdef AS_THREADED_DISPATCH
+	// The unused byte codes go through the switch
+	op_unused:
+#endif
 	switch( *(asBYTE*)l_bc )
 	{
 //--------------
 // memory access functions
 
-	case asBC_PopPtr:
+	AS_CASE(asBC_PopPtr):
 		// Pop a pointer from the stack
 		l_sp += AS_PTR_SIZE;
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_PshGPtr:
+	AS_CASE(asBC_PshGPtr):
 		// Replaces PGA + RDSPtr
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = *(asPWORD*)asBC_PTRARG(l_bc);
 		l_bc += 1 + AS_PTR_SIZE;
-		break;
+		AS_NEXT();
 
 	// Push a dword value on the stack
-	case asBC_PshC4:
+	AS_CASE(asBC_PshC4):
 		--l_sp;
 		*l_sp = asBC_DWORDARG(l_bc);
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
 	// Push the dword value of a variable on the stack
-	case asBC_PshV4:
+	AS_CASE(asBC_PshV4):
 		--l_sp;
 		*l_sp = *(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// Push the address of a variable on the stack
-	case asBC_PSF:
+	AS_CASE(asBC_PSF):
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = asPWORD(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// Swap the top 2 pointers on the stack
-	case asBC_SwapPtr:
+	AS_CASE(asBC_SwapPtr):
 		{
 			asPWORD p = *(asPWORD*)l_sp;
 			*(asPWORD*)l_sp = *(asPWORD*)(l_sp+AS_PTR_SIZE);
 			*(asPWORD*)(l_sp+AS_PTR_SIZE) = p;
 			l_bc++;
 		}
-		break;
+		AS_NEXT();
 
 	// Do a boolean not operation, modifying the value of the variable
-	case asBC_NOT:
+	AS_CASE(asBC_NOT):
 #if AS_SIZEOF_BOOL == 1
 		{
 			// Set the value to true if it is equal to 0
@@ -1949,28 +2035,28 @@ void asCContext::ExecuteNext()
 		*(l_fp - asBC_SWORDARG0(l_bc)) = (*(l_fp - asBC_SWORDARG0(l_bc)) == 0 ? VALUE_OF_BOOLEAN_TRUE : 0);
 #endif
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// Push the dword value of a global variable on the stack
-	case asBC_PshG4:
+	AS_CASE(asBC_PshG4):
 		--l_sp;
 		*l_sp = *(asDWORD*)asBC_PTRARG(l_bc);
 		l_bc += 1 + AS_PTR_SIZE;
-		break;
+		AS_NEXT();
 
 	// Load the address of a global variable in the register, then
 	// copy the value of the global variable into a local variable
-	case asBC_LdGRdR4:
+	AS_CASE(asBC_LdGRdR4):
 		*(void**)&m_regs.valueRegister = (void*)asBC_PTRARG(l_bc);
 		*(l_fp - asBC_SWORDARG0(l_bc)) = **(asDWORD**)&m_regs.valueRegister;
 		l_bc += 1+AS_PTR_SIZE;
-		break;
+		AS_NEXT();
 
 //----------------
 // path control instructions
 
 	// Begin execution of a script function
-	case asBC_CALL:
+	AS_CASE(asBC_CALL):
 		{
 			int i = asBC_INTARG(l_bc);
 			l_bc += 2;
@@ -1994,10 +2080,10 @@ void asCContext::ExecuteNext()
 			if( m_status != asEXECUTION_ACTIVE )
 				return;
 		}
-		break;
+		AS_NEXT();
 
 	// Return to the caller, and remove the arguments from the stack
-	case asBC_RET:
+	AS_CASE(asBC_RET):
 		{
 			// Return if this was the first function, or a nested execution
 			if( m_callStack.GetLength() == 0 ||
@@ -2020,68 +2106,68 @@ void asCContext::ExecuteNext()
 			// Pop arguments from stack
 			l_sp += w;
 		}
-		break;
+		AS_NEXT();
 
 	// Jump to a relative position
-	case asBC_JMP:
+	AS_CASE(asBC_JMP):
 		l_bc += 2 + asBC_INTARG(l_bc);
-		break;
+		AS_NEXT();
 
 //----------------
 // Conditional jumps
 
 	// Jump to a relative position if the value in the register is 0
-	case asBC_JZ:
+	AS_CASE(asBC_JZ):
 		if( *(int*)&m_regs.valueRegister == 0 )
 			l_bc += asBC_INTARG(l_bc) + 2;
 		else
 			l_bc += 2;
-		break;
+		AS_NEXT();
 
 	// Jump to a relative position if the value in the register is not 0
-	case asBC_JNZ:
+	AS_CASE(asBC_JNZ):
 		if( *(int*)&m_regs.valueRegister != 0 )
 			l_bc += asBC_INTARG(l_bc) + 2;
 		else
 			l_bc += 2;
-		break;
+		AS_NEXT();
 
 	// Jump to a relative position if the value in the register is negative
-	case asBC_JS:
+	AS_CASE(asBC_JS):
 		if( *(int*)&m_regs.valueRegister < 0 )
 			l_bc += asBC_INTARG(l_bc) + 2;
 		else
 			l_bc += 2;
-		break;
+		AS_NEXT();
 
 	// Jump to a relative position if the value in the register it not negative
-	case asBC_JNS:
+	AS_CASE(asBC_JNS):
 		if( *(int*)&m_regs.valueRegister >= 0 )
 			l_bc += asBC_INTARG(l_bc) + 2;
 		else
 			l_bc += 2;
-		break;
+		AS_NEXT();
 
 	// Jump to a relative position if the value in the register is greater than 0
-	case asBC_JP:
+	AS_CASE(asBC_JP):
 		if( *(int*)&m_regs.valueRegister > 0 )
 			l_bc += asBC_INTARG(l_bc) + 2;
 		else
 			l_bc += 2;
-		break;
+		AS_NEXT();
 
 	// Jump to a relative position if the value in the register is not greater than 0
-	case asBC_JNP:
+	AS_CASE(asBC_JNP):
 		if( *(int*)&m_regs.valueRegister <= 0 )
 			l_bc += asBC_INTARG(l_bc) + 2;
 		else
 			l_bc += 2;
-		break;
+		AS_NEXT();
 //--------------------
 // test instructions
 
 	// If the value in the register is 0, then set the register to 1, else to 0
-	case asBC_TZ:
+	AS_CASE(asBC_TZ):
 #if AS_SIZEOF_BOOL == 1
 		{
 			// Set the value to true if it is equal to 0
@@ -2105,10 +2191,10 @@ void asCContext::ExecuteNext()
 		*(int*)&m_regs.valueRegister = (*(int*)&m_regs.valueRegister == 0 ? VALUE_OF_BOOLEAN_TRUE : 0);
 #endif
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// If the value in the register is not 0, then set the register to 1, else to 0
-	case asBC_TNZ:
+	AS_CASE(asBC_TNZ):
 #if AS_SIZEOF_BOOL == 1
 		{
 			// Set the value to true if it is not equal to 0
@@ -2132,10 +2218,10 @@ void asCContext::ExecuteNext()
 		*(int*)&m_regs.valueRegister = (*(int*)&m_regs.valueRegister == 0 ? 0 : VALUE_OF_BOOLEAN_TRUE);
 #endif
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// If the value in the register is negative, then set the register to 1, else to 0
-	case asBC_TS:
+	AS_CASE(asBC_TS):
 #if AS_SIZEOF_BOOL == 1
 		{
 			// Set the value to true if it is less than 0
@@ -2159,10 +2245,10 @@ void asCContext::ExecuteNext()
 		*(int*)&m_regs.valueRegister = (*(int*)&m_regs.valueRegister < 0 ? VALUE_OF_BOOLEAN_TRUE : 0);
 #endif
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// If the value in the register is not negative, then set the register to 1, else to 0
-	case asBC_TNS:
+	AS_CASE(asBC_TNS):
 #if AS_SIZEOF_BOOL == 1
 		{
 			// Set the value to true if it is not less than 0
@@ -2186,10 +2272,10 @@ void asCContext::ExecuteNext()
 		*(int*)&m_regs.valueRegister = (*(int*)&m_regs.valueRegister < 0 ? 0 : VALUE_OF_BOOLEAN_TRUE);
 #endif
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// If the value in the register is greater than 0, then set the register to 1, else to 0
-	case asBC_TP:
+	AS_CASE(asBC_TP):
 #if AS_SIZEOF_BOOL == 1
 		{
 			// Set the value to true if it is greater than 0
@@ -2213,10 +2299,10 @@ void asCContext::ExecuteNext()
 		*(int*)&m_regs.valueRegister = (*(int*)&m_regs.valueRegister > 0 ? VALUE_OF_BOOLEAN_TRUE : 0);
 #endif
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// If the value in the register is not greater than 0, then set the register to 1, else to 0
-	case asBC_TNP:
+	AS_CASE(asBC_TNP):
 #if AS_SIZEOF_BOOL == 1
 		{
 			// Set the value to true if it is not greater than 0
@@ -2240,150 +2326,150 @@ void asCContext::ExecuteNext()
 		*(int*)&m_regs.valueRegister = (*(int*)&m_regs.valueRegister > 0 ? 0 : VALUE_OF_BOOLEAN_TRUE);
 #endif
 		l_bc++;
-		break;
+		AS_NEXT();
 
 //--------------------
 // negate value
 
 	// Negate the integer value in the variable
-	case asBC_NEGi:
+	AS_CASE(asBC_NEGi):
 		*(l_fp - asBC_SWORDARG0(l_bc)) = asDWORD(-int(*(l_fp - asBC_SWORDARG0(l_bc))));
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// Negate the float value in the variable
-	case asBC_NEGf:
+	AS_CASE(asBC_NEGf):
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = -*(float*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// Negate the double value in the variable
-	case asBC_NEGd:
+	AS_CASE(asBC_NEGd):
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = -*(double*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
 //-------------------------
 // Increment value pointed to by address in register
 
 	// Increment the short value pointed to by the register
-	case asBC_INCi16:
+	AS_CASE(asBC_INCi16):
 		(**(short**)&m_regs.valueRegister)++;
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// Increment the byte value pointed to by the register
-	case asBC_INCi8:
+	AS_CASE(asBC_INCi8):
 		(**(char**)&m_regs.valueRegister)++;
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// Decrement the short value pointed to by the register
-	case asBC_DECi16:
+	AS_CASE(asBC_DECi16):
 		(**(short**)&m_regs.valueRegister)--;
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// Decrement the byte value pointed to by the register
-	case asBC_DECi8:
+	AS_CASE(asBC_DECi8):
 		(**(char**)&m_regs.valueRegister)--;
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// Increment the integer value pointed to by the register
-	case asBC_INCi:
+	AS_CASE(asBC_INCi):
 		++(**(int**)&m_regs.valueRegister);
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// Decrement the integer value pointed to by the register
-	case asBC_DECi:
+	AS_CASE(asBC_DECi):
 		--(**(int**)&m_regs.valueRegister);
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// Increment the float value pointed to by the register
-	case asBC_INCf:
+	AS_CASE(asBC_INCf):
 		++(**(float**)&m_regs.valueRegister);
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// Decrement the float value pointed to by the register
-	case asBC_DECf:
+	AS_CASE(asBC_DECf):
 		--(**(float**)&m_regs.valueRegister);
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// Increment the double value pointed to by the register
-	case asBC_INCd:
+	AS_CASE(asBC_INCd):
 		++(**(double**)&m_regs.valueRegister);
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// Decrement the double value pointed to by the register
-	case asBC_DECd:
+	AS_CASE(asBC_DECd):
 		--(**(double**)&m_regs.valueRegister);
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// Increment the local integer variable
-	case asBC_IncVi:
+	AS_CASE(asBC_IncVi):
 		(*(int*)(l_fp - asBC_SWORDARG0(l_bc)))++;
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// Decrement the local integer variable
-	case asBC_DecVi:
+	AS_CASE(asBC_DecVi):
 		(*(int*)(l_fp - asBC_SWORDARG0(l_bc)))--;
 		l_bc++;
-		break;
+		AS_NEXT();
 
 //--------------------
 // bits instructions
 
 	// Do a bitwise not on the value in the variable
-	case asBC_BNOT:
+	AS_CASE(asBC_BNOT):
 		*(l_fp - asBC_SWORDARG0(l_bc)) = ~*(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	// Do a bitwise and of two variables and store the result in a third variable
-	case asBC_BAND:
+	AS_CASE(asBC_BAND):
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(l_fp - asBC_SWORDARG1(l_bc)) & *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
 	// Do a bitwise or of two variables and store the result in a third variable
-	case asBC_BOR:
+	AS_CASE(asBC_BOR):
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(l_fp - asBC_SWORDARG1(l_bc)) | *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
 	// Do a bitwise xor of two variables and store the result in a third variable
-	case asBC_BXOR:
+	AS_CASE(asBC_BXOR):
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(l_fp - asBC_SWORDARG1(l_bc)) ^ *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
 	// Do a logical shift left of two variables and store the result in a third variable
-	case asBC_BSLL:
+	AS_CASE(asBC_BSLL):
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(l_fp - asBC_SWORDARG1(l_bc)) << *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
 	// Do a logical shift right of two variables and store the result in a third variable
-	case asBC_BSRL:
+	AS_CASE(asBC_BSRL):
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(l_fp - asBC_SWORDARG1(l_bc)) >> *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
 	// Do an arithmetic shift right of two variables and store the result in a third variable
-	case asBC_BSRA:
+	AS_CASE(asBC_BSRA):
 		*(l_fp - asBC_SWORDARG0(l_bc)) = int(*(l_fp - asBC_SWORDARG1(l_bc))) >> *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_COPY:
+	AS_CASE(asBC_COPY):
 		{
 			void *d = (void*)*(asPWORD*)l_sp; l_sp += AS_PTR_SIZE;
 			void *s = (void*)*(asPWORD*)l_sp;
@@ -2404,21 +2490,21 @@ void asCContext::ExecuteNext()
 			*(asPWORD**)l_sp = (asPWORD*)d;
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_PshC8:
+	AS_CASE(asBC_PshC8):
 		l_sp -= 2;
 		*(asQWORD*)l_sp = asBC_QWORDARG(l_bc);
 		l_bc += 3;
-		break;
+		AS_NEXT();
 
-	case asBC_PshVPtr:
+	AS_CASE(asBC_PshVPtr):
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = *(asPWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_RDSPtr:
+	AS_CASE(asBC_RDSPtr):
 		{
 			// The pointer must not be null
 			asPWORD a = *(asPWORD*)l_sp;
@@ -2435,11 +2521,11 @@ void asCContext::ExecuteNext()
 			*(asPWORD*)l_sp = *(asPWORD*)a;
 		}
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	//----------------------------
 	// Comparisons
-	case asBC_CMPd:
+	AS_CASE(asBC_CMPd):
 		{
 			// Do a comparison of the values, rather than a subtraction
 			// in order to get proper behaviour for infinity values.
@@ -2450,9 +2536,9 @@ void asCContext::ExecuteNext()
 			else                   *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_CMPu:
+	AS_CASE(asBC_CMPu):
 		{
 			asDWORD d1 = *(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 			asDWORD d2 = *(asDWORD*)(l_fp - asBC_SWORDARG1(l_bc));
@@ -2461,9 +2547,9 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_CMPf:
+	AS_CASE(asBC_CMPf):
 		{
 			// Do a comparison of the values, rather than a subtraction
 			// in order to get proper behaviour for infinity values.
@@ -2474,9 +2560,9 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_CMPi:
+	AS_CASE(asBC_CMPi):
 		{
 			int i1 = *(int*)(l_fp - asBC_SWORDARG0(l_bc));
 			int i2 = *(int*)(l_fp - asBC_SWORDARG1(l_bc));
@@ -2485,11 +2571,11 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		AS_NEXT();
 
 	//----------------------------
 	// Comparisons with constant value
-	case asBC_CMPIi:
+	AS_CASE(asBC_CMPIi):
 		{
 			int i1 = *(int*)(l_fp - asBC_SWORDARG0(l_bc));
 			int i2 = asBC_INTARG(l_bc);
@@ -2498,9 +2584,9 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_CMPIf:
+	AS_CASE(asBC_CMPIf):
 		{
 			// Do a comparison of the values, rather than a subtraction
 			// in order to get proper behaviour for infinity values.
@@ -2511,9 +2597,9 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_CMPIu:
+	AS_CASE(asBC_CMPIu):
 		{
 			asDWORD d1 = *(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 			asDWORD d2 = asBC_DWORDARG(l_bc);
@@ -2522,31 +2608,31 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_JMPP:
+	AS_CASE(asBC_JMPP):
 		l_bc += 1 + (*(int*)(l_fp - asBC_SWORDARG0(l_bc)))*2;
-		break;
+		AS_NEXT();
 
-	case asBC_PopRPtr:
+	AS_CASE(asBC_PopRPtr):
 		*(asPWORD*)&m_regs.valueRegister = *(asPWORD*)l_sp;
 		l_sp += AS_PTR_SIZE;
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_PshRPtr:
+	AS_CASE(asBC_PshRPtr):
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = *(asPWORD*)&m_regs.valueRegister;
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_STR:
+	AS_CASE(asBC_STR):
 		// TODO: NEWSTRING: Deprecate this instruction
 		asASSERT(false);
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_CALLSYS:
+	AS_CASE(asBC_CALLSYS):
 		{
 			// Get function ID from the argument
 			int i = asBC_INTARG(l_bc);
@@ -2585,9 +2671,9 @@ void asCContext::ExecuteNext()
 				}
 			}
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_CALLBND:
+	AS_CASE(asBC_CALLBND):
 		{
 			// TODO: Clean-up: This code is very similar to asBC_CallPtr. Create a shared method for them
 			// Get the function ID from the stack
@@ -2666,9 +2752,9 @@ void asCContext::ExecuteNext()
 			if( m_status != asEXECUTION_ACTIVE )
 				return;
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_SUSPEND:
+	AS_CASE(asBC_SUSPEND):
 		if( m_regs.doProcessSuspend )
 		{
 			if( m_lineCallback )
@@ -2694,9 +2780,9 @@ void asCContext::ExecuteNext()
 		}
 
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_ALLOC:
+	AS_CASE(asBC_ALLOC):
 		{
 			asCObjectType *objType = (asCObjectType*)asBC_PTRARG(l_bc);
 			int func = asBC_INTARG(l_bc+AS_PTR_SIZE);
@@ -2792,9 +2878,9 @@ void asCContext::ExecuteNext()
 				}
 			}
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_FREE:
+	AS_CASE(asBC_FREE):
 		{
 			// Get the variable that holds the object handle/reference
 			asPWORD *a = (asPWORD*)asPWORD(l_fp - asBC_SWORDARG0(l_bc));
@@ -2830,9 +2916,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc += 1+AS_PTR_SIZE;
-		break;
+		AS_NEXT();
 
-	case asBC_LOADOBJ:
+	AS_CASE(asBC_LOADOBJ):
 		{
 			// Move the object pointer from the object variable into the object register
 			void **a = (void**)(l_fp - asBC_SWORDARG0(l_bc));
@@ -2841,16 +2927,16 @@ void asCContext::ExecuteNext()
 			*a = 0;
 		}
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_STOREOBJ:
+	AS_CASE(asBC_STOREOBJ):
 		// Move the object pointer from the object register to the object variable
 		*(asPWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = asPWORD(m_regs.objectRegister);
 		m_regs.objectRegister = 0;
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_GETOBJ:
+	AS_CASE(asBC_GETOBJ):
 		{
 			// Read variable index from location on stack
 			asPWORD *a = (asPWORD*)(l_sp + asBC_WORDARG0(l_bc));
@@ -2862,9 +2948,9 @@ void asCContext::ExecuteNext()
 			*v = 0;
 		}
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_REFCPY:
+	AS_CASE(asBC_REFCPY):
 		{
 			asCObjectType *objType = (asCObjectType*)asBC_PTRARG(l_bc);
 			asSTypeBehaviour *beh = &objType->beh;
@@ -2896,9 +2982,9 @@ void asCContext::ExecuteNext()
 			*d = s;
 		}
 		l_bc += 1+AS_PTR_SIZE;
-		break;
+		AS_NEXT();
 
-	case asBC_CHKREF:
+	AS_CASE(asBC_CHKREF):
 		{
 			// Verify if the pointer on the stack is null
 			// This is used when validating a pointer that an operator will work on
@@ -2914,9 +3000,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_GETOBJREF:
+	AS_CASE(asBC_GETOBJREF):
 		{
 			// Get the location on the stack where the reference will be placed
 			asPWORD *a = (asPWORD*)(l_sp + asBC_WORDARG0(l_bc));
@@ -2925,9 +3011,9 @@ void asCContext::ExecuteNext()
 			*(asPWORD**)a = *(asPWORD**)(l_fp - *a);
 		}
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_GETREF:
+	AS_CASE(asBC_GETREF):
 		{
 			// Get the location on the stack where the reference will be placed
 			asPWORD *a = (asPWORD*)(l_sp + asBC_WORDARG0(l_bc));
@@ -2936,49 +3022,49 @@ void asCContext::ExecuteNext()
 			*(asPWORD**)a = (asPWORD*)(l_fp - (int)*a);
 		}
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_PshNull:
+	AS_CASE(asBC_PshNull):
 		// Push a null pointer on the stack
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = 0;
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_ClrVPtr:
+	AS_CASE(asBC_ClrVPtr):
 		// TODO: runtime optimize: Is this instruction really necessary?
 		//                         CallScriptFunction() can clear the null handles upon entry, just as is done for
 		//                         all other object variables
 		// Clear pointer variable
 		*(asPWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = 0;
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_OBJTYPE:
+	AS_CASE(asBC_OBJTYPE):
 		// Push the object type on the stack
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = asBC_PTRARG(l_bc);
 		l_bc += 1+AS_PTR_SIZE;
-		break;
+		AS_NEXT();
 
-	case asBC_TYPEID:
+	AS_CASE(asBC_TYPEID):
 		// Equivalent to PshC4, but kept as separate instruction for bytecode serialization
 		--l_sp;
 		*l_sp = asBC_DWORDARG(l_bc);
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_SetV4:
+	AS_CASE(asBC_SetV4):
 		*(l_fp - asBC_SWORDARG0(l_bc)) = asBC_DWORDARG(l_bc);
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_SetV8:
+	AS_CASE(asBC_SetV8):
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = asBC_QWORDARG(l_bc);
 		l_bc += 3;
-		break;
+		AS_NEXT();
 
-	case asBC_ADDSi:
+	AS_CASE(asBC_ADDSi):
 		{
 			// The pointer must not be null
 			asPWORD a = *(asPWORD*)l_sp;
@@ -2995,71 +3081,71 @@ void asCContext::ExecuteNext()
 			*(asPWORD*)l_sp = a + asBC_SWORDARG0(l_bc);
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_CpyVtoV4:
+	AS_CASE(asBC_CpyVtoV4):
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(l_fp - asBC_SWORDARG1(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_CpyVtoV8:
+	AS_CASE(asBC_CpyVtoV8):
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_CpyVtoR4:
+	AS_CASE(asBC_CpyVtoR4):
 		*(asDWORD*)&m_regs.valueRegister = *(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_CpyVtoR8:
+	AS_CASE(asBC_CpyVtoR8):
 		*(asQWORD*)&m_regs.valueRegister = *(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_CpyVtoG4:
+	AS_CASE(asBC_CpyVtoG4):
 		*(asDWORD*)asBC_PTRARG(l_bc) = *(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc += 1 + AS_PTR_SIZE;
-		break;
+		AS_NEXT();
 
-	case asBC_CpyRtoV4:
+	AS_CASE(asBC_CpyRtoV4):
 		*(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asDWORD*)&m_regs.valueRegister;
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_CpyRtoV8:
+	AS_CASE(asBC_CpyRtoV8):
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = m_regs.valueRegister;
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_CpyGtoV4:
+	AS_CASE(asBC_CpyGtoV4):
 		*(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asDWORD*)asBC_PTRARG(l_bc);
 		l_bc += 1 + AS_PTR_SIZE;
-		break;
+		AS_NEXT();
 
-	case asBC_WRTV1:
+	AS_CASE(asBC_WRTV1):
 		// The pointer in the register points to a byte, and *(l_fp - offset) too
 		**(asBYTE**)&m_regs.valueRegister = *(asBYTE*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_WRTV2:
+	AS_CASE(asBC_WRTV2):
 		// The pointer in the register points to a word, and *(l_fp - offset) too
 		**(asWORD**)&m_regs.valueRegister = *(asWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_WRTV4:
+	AS_CASE(asBC_WRTV4):
 		**(asDWORD**)&m_regs.valueRegister = *(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_WRTV8:
+	AS_CASE(asBC_WRTV8):
 		**(asQWORD**)&m_regs.valueRegister = *(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_RDR1:
+	AS_CASE(asBC_RDR1):
 		{
 			// The pointer in the register points to a byte, and *(l_fp - offset) will also point to a byte
 			asBYTE *bPtr = (asBYTE*)(l_fp - asBC_SWORDARG0(l_bc));
@@ -3069,9 +3155,9 @@ void asCContext::ExecuteNext()
 			bPtr[3] = 0;
 		}
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_RDR2:
+	AS_CASE(asBC_RDR2):
 		{
 			// The pointer in the register points to a word, and *(l_fp - offset) will also point to a word
 			asWORD *wPtr = (asWORD*)(l_fp - asBC_SWORDARG0(l_bc));
@@ -3079,35 +3165,35 @@ void asCContext::ExecuteNext()
 			wPtr[1] = 0;                      // 0 the rest of the DWORD
 		}
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_RDR4:
+	AS_CASE(asBC_RDR4):
 		*(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = **(asDWORD**)&m_regs.valueRegister;
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_RDR8:
+	AS_CASE(asBC_RDR8):
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = **(asQWORD**)&m_regs.valueRegister;
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_LDG:
+	AS_CASE(asBC_LDG):
 		*(asPWORD*)&m_regs.valueRegister = asBC_PTRARG(l_bc);
 		l_bc += 1+AS_PTR_SIZE;
-		break;
+		AS_NEXT();
 
-	case asBC_LDV:
+	AS_CASE(asBC_LDV):
 		*(asDWORD**)&m_regs.valueRegister = (l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_PGA:
+	AS_CASE(asBC_PGA):
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = asBC_PTRARG(l_bc);
 		l_bc += 1+AS_PTR_SIZE;
-		break;
+		AS_NEXT();
 
-	case asBC_CmpPtr:
+	AS_CASE(asBC_CmpPtr):
 		{
 			// TODO: runtime optimize: This instruction should really just be an equals, and return true or false.
 			//                         The instruction is only used for is and !is tests anyway.
@@ -3118,110 +3204,110 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_VAR:
+	AS_CASE(asBC_VAR):
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = (asPWORD)asBC_SWORDARG0(l_bc);
 		l_bc++;
-		break;
+		AS_NEXT();
 
 	//----------------------------
 	// Type conversions
-	case asBC_iTOf:
+	AS_CASE(asBC_iTOf):
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = float(*(int*)(l_fp - asBC_SWORDARG0(l_bc)));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_fTOi:
+	AS_CASE(asBC_fTOi):
 		*(l_fp - asBC_SWORDARG0(l_bc)) = int(*(float*)(l_fp - asBC_SWORDARG0(l_bc)));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_uTOf:
+	AS_CASE(asBC_uTOf):
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = float(*(l_fp - asBC_SWORDARG0(l_bc)));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_fTOu:
+	AS_CASE(asBC_fTOu):
 		// We must cast to int first, because on some compilers the cast of a negative float value to uint result in 0
 		*(l_fp - asBC_SWORDARG0(l_bc)) = asUINT(int(*(float*)(l_fp - asBC_SWORDARG0(l_bc))));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_sbTOi:
+	AS_CASE(asBC_sbTOi):
 		// *(l_fp - offset) points to a char, and will point to an int afterwards
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(signed char*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_swTOi:
+	AS_CASE(asBC_swTOi):
 		// *(l_fp - offset) points to a short, and will point to an int afterwards
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(short*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_ubTOi:
+	AS_CASE(asBC_ubTOi):
 		// (l_fp - offset) points to a byte, and will point to an int afterwards
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(asBYTE*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_uwTOi:
+	AS_CASE(asBC_uwTOi):
 		// *(l_fp - offset) points to a word, and will point to an int afterwards
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(asWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_dTOi:
+	AS_CASE(asBC_dTOi):
 		*(l_fp - asBC_SWORDARG0(l_bc)) = int(*(double*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_dTOu:
+	AS_CASE(asBC_dTOu):
 		// We must cast to int first, because on some compilers the cast of a negative float value to uint result in 0
 		*(l_fp - asBC_SWORDARG0(l_bc)) = asUINT(int(*(double*)(l_fp - asBC_SWORDARG1(l_bc))));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_dTOf:
+	AS_CASE(asBC_dTOf):
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = float(*(double*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_iTOd:
+	AS_CASE(asBC_iTOd):
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = double(*(int*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_uTOd:
+	AS_CASE(asBC_uTOd):
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = double(*(asUINT*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_fTOd:
+	AS_CASE(asBC_fTOd):
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = double(*(float*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
 	//------------------------------
 	// Math operations
-	case asBC_ADDi:
+	AS_CASE(asBC_ADDi):
 		*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = *(int*)(l_fp - asBC_SWORDARG1(l_bc)) + *(int*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_SUBi:
+	AS_CASE(asBC_SUBi):
 		*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = *(int*)(l_fp - asBC_SWORDARG1(l_bc)) - *(int*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_MULi:
+	AS_CASE(asBC_MULi):
 		*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = *(int*)(l_fp - asBC_SWORDARG1(l_bc)) * *(int*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_DIVi:
+	AS_CASE(asBC_DIVi):
 		{
 			int divider = *(int*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -3254,9 +3340,9 @@ void asCContext::ExecuteNext()
 			*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = *(int*)(l_fp - asBC_SWORDARG1(l_bc)) / divider;
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_MODi:
+	AS_CASE(asBC_MODi):
 		{
 			int divider = *(int*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -3289,24 +3375,24 @@ void asCContext::ExecuteNext()
 			*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = *(int*)(l_fp - asBC_SWORDARG1(l_bc)) % divider;
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_ADDf:
+	AS_CASE(asBC_ADDf):
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = *(float*)(l_fp - asBC_SWORDARG1(l_bc)) + *(float*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_SUBf:
+	AS_CASE(asBC_SUBf):
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = *(float*)(l_fp - asBC_SWORDARG1(l_bc)) - *(float*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_MULf:
+	AS_CASE(asBC_MULf):
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = *(float*)(l_fp - asBC_SWORDARG1(l_bc)) * *(float*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_DIVf:
+	AS_CASE(asBC_DIVf):
 		{
 			float divider = *(float*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -3323,9 +3409,9 @@ void asCContext::ExecuteNext()
 			*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = *(float*)(l_fp - asBC_SWORDARG1(l_bc)) / divider;
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_MODf:
+	AS_CASE(asBC_MODf):
 		{
 			float divider = *(float*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -3342,24 +3428,24 @@ void asCContext::ExecuteNext()
 			*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = fmodf(*(float*)(l_fp - asBC_SWORDARG1(l_bc)), divider);
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_ADDd:
+	AS_CASE(asBC_ADDd):
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = *(double*)(l_fp - asBC_SWORDARG1(l_bc)) + *(double*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_SUBd:
+	AS_CASE(asBC_SUBd):
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = *(double*)(l_fp - asBC_SWORDARG1(l_bc)) - *(double*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_MULd:
+	AS_CASE(asBC_MULd):
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = *(double*)(l_fp - asBC_SWORDARG1(l_bc)) * *(double*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_DIVd:
+	AS_CASE(asBC_DIVd):
 		{
 			double divider = *(double*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -3377,9 +3463,9 @@ void asCContext::ExecuteNext()
 			*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = *(double*)(l_fp - asBC_SWORDARG1(l_bc)) / divider;
 			l_bc += 2;
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_MODd:
+	AS_CASE(asBC_MODd):
 		{
 			double divider = *(double*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -3397,47 +3483,47 @@ void asCContext::ExecuteNext()
 			*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = fmod(*(double*)(l_fp - asBC_SWORDARG1(l_bc)), divider);
 			l_bc += 2;
 		}
-		break;
+		AS_NEXT();
 
 	//------------------------------
 	// Math operations with constant value
-	case asBC_ADDIi:
+	AS_CASE(asBC_ADDIi):
 		*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = *(int*)(l_fp - asBC_SWORDARG1(l_bc)) + asBC_INTARG(l_bc+1);
 		l_bc += 3;
-		break;
+		AS_NEXT();
 
-	case asBC_SUBIi:
+	AS_CASE(asBC_SUBIi):
 		*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = *(int*)(l_fp - asBC_SWORDARG1(l_bc)) - asBC_INTARG(l_bc+1);
 		l_bc += 3;
-		break;
+		AS_NEXT();
 
-	case asBC_MULIi:
+	AS_CASE(asBC_MULIi):
 		*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = *(int*)(l_fp - asBC_SWORDARG1(l_bc)) * asBC_INTARG(l_bc+1);
 		l_bc += 3;
-		break;
+		AS_NEXT();
 
-	case asBC_ADDIf:
+	AS_CASE(asBC_ADDIf):
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = *(float*)(l_fp - asBC_SWORDARG1(l_bc)) + asBC_FLOATARG(l_bc+1);
 		l_bc += 3;
-		break;
+		AS_NEXT();
 
-	case asBC_SUBIf:
+	AS_CASE(asBC_SUBIf):
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = *(float*)(l_fp - asBC_SWORDARG1(l_bc)) - asBC_FLOATARG(l_bc+1);
 		l_bc += 3;
-		break;
+		AS_NEXT();
 
-	case asBC_MULIf:
+	AS_CASE(asBC_MULIf):
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = *(float*)(l_fp - asBC_SWORDARG1(l_bc)) * asBC_FLOATARG(l_bc+1);
 		l_bc += 3;
-		break;
+		AS_NEXT();
 
 	//-----------------------------------
-	case asBC_SetG4:
+	AS_CASE(asBC_SetG4):
 		*(asDWORD*)asBC_PTRARG(l_bc) = asBC_DWORDARG(l_bc+AS_PTR_SIZE);
 		l_bc += 2 + AS_PTR_SIZE;
-		break;
+		AS_NEXT();
 
-	case asBC_ChkRefS:
+	AS_CASE(asBC_ChkRefS):
 		{
 			// Verify if the pointer on the stack refers to a non-null value
 			// This is used to validate a reference to a handle
@@ -3453,9 +3539,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_ChkNullV:
+	AS_CASE(asBC_ChkNullV):
 		{
 			// Verify if variable (on the stack) is not null
 			asDWORD *a = *(asDWORD**)(l_fp - asBC_SWORDARG0(l_bc));
@@ -3470,9 +3556,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_CALLINTF:
+	AS_CASE(asBC_CALLINTF):
 		{
 			int i = asBC_INTARG(l_bc);
 			l_bc += 2;
@@ -3496,9 +3582,9 @@ void asCContext::ExecuteNext()
 			if( m_status != asEXECUTION_ACTIVE )
 				return;
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_iTOb:
+	AS_CASE(asBC_iTOb):
 		{
 			// *(l_fp - offset) points to an int, and will point to a byte afterwards
 
@@ -3512,9 +3598,9 @@ void asCContext::ExecuteNext()
 			bPtr[3] = 0;
 		}
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_iTOw:
+	AS_CASE(asBC_iTOw):
 		{
 			// *(l_fp - offset) points to an int, and will point to word afterwards
 
@@ -3526,9 +3612,9 @@ void asCContext::ExecuteNext()
 			wPtr[1] = 0;           // 0 the rest of the DWORD
 		}
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_SetV1:
+	AS_CASE(asBC_SetV1):
 		// TODO: This is exactly the same as SetV4. This is a left over from the time
 		//       when the bytecode instructions were more tightly packed. It can now
 		//       be removed. When removing it, make sure the value is correctly converted
@@ -3537,9 +3623,9 @@ void asCContext::ExecuteNext()
 		// The byte is already stored correctly in the argument
 		*(l_fp - asBC_SWORDARG0(l_bc)) = asBC_DWORDARG(l_bc);
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_SetV2:
+	AS_CASE(asBC_SetV2):
 		// TODO: This is exactly the same as SetV4. This is a left over from the time
 		//       when the bytecode instructions were more tightly packed. It can now
 		//       be removed. When removing it, make sure the value is correctly converted
@@ -3548,9 +3634,9 @@ void asCContext::ExecuteNext()
 		// The word is already stored correctly in the argument
 		*(l_fp - asBC_SWORDARG0(l_bc)) = asBC_DWORDARG(l_bc);
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_Cast:
+	AS_CASE(asBC_Cast):
 		// Cast the handle at the top of the stack to the type in the argument
 		{
 			asDWORD **a = (asDWORD**)*(asPWORD*)l_sp;
@@ -3582,49 +3668,49 @@ void asCContext::ExecuteNext()
 			l_sp += AS_PTR_SIZE;
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_i64TOi:
+	AS_CASE(asBC_i64TOi):
 		*(l_fp - asBC_SWORDARG0(l_bc)) = int(*(asINT64*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_uTOi64:
+	AS_CASE(asBC_uTOi64):
 		*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = asINT64(*(asUINT*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_iTOi64:
+	AS_CASE(asBC_iTOi64):
 		*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = asINT64(*(int*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_fTOi64:
+	AS_CASE(asBC_fTOi64):
 		*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = asINT64(*(float*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_dTOi64:
+	AS_CASE(asBC_dTOi64):
 		*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = asINT64(*(double*)(l_fp - asBC_SWORDARG0(l_bc)));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_fTOu64:
+	AS_CASE(asBC_fTOu64):
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = asQWORD(asINT64(*(float*)(l_fp - asBC_SWORDARG1(l_bc))));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_dTOu64:
+	AS_CASE(asBC_dTOu64):
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = asQWORD(asINT64(*(double*)(l_fp - asBC_SWORDARG0(l_bc))));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_i64TOf:
+	AS_CASE(asBC_i64TOf):
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = float(*(asINT64*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_u64TOf:
+	AS_CASE(asBC_u64TOf):
 #if defined(_MSC_VER) && _MSC_VER <= 1200 // MSVC6
 		{
 			// MSVC6 doesn't permit UINT64 to double
@@ -3638,14 +3724,14 @@ void asCContext::ExecuteNext()
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = float(*(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)));
 #endif
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_i64TOd:
+	AS_CASE(asBC_i64TOd):
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = double(*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_u64TOd:
+	AS_CASE(asBC_u64TOd):
 #if defined(_MSC_VER) && _MSC_VER <= 1200 // MSVC6
 		{
 			// MSVC6 doesn't permit UINT64 to double
@@ -3659,44 +3745,44 @@ void asCContext::ExecuteNext()
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = double(*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)));
 #endif
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_NEGi64:
+	AS_CASE(asBC_NEGi64):
 		*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = -*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_INCi64:
+	AS_CASE(asBC_INCi64):
 		++(**(asQWORD**)&m_regs.valueRegister);
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_DECi64:
+	AS_CASE(asBC_DECi64):
 		--(**(asQWORD**)&m_regs.valueRegister);
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_BNOT64:
+	AS_CASE(asBC_BNOT64):
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = ~*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_ADDi64:
+	AS_CASE(asBC_ADDi64):
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) + *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_SUBi64:
+	AS_CASE(asBC_SUBi64):
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) - *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_MULi64:
+	AS_CASE(asBC_MULi64):
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) * *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_DIVi64:
+	AS_CASE(asBC_DIVi64):
 		{
 			asINT64 divider = *(asINT64*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -3730,9 +3816,9 @@ void asCContext::ExecuteNext()
 			*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asINT64*)(l_fp - asBC_SWORDARG1(l_bc)) / divider;
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_MODi64:
+	AS_CASE(asBC_MODi64):
 		{
 			asINT64 divider = *(asINT64*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -3765,39 +3851,39 @@ void asCContext::ExecuteNext()
 			*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asINT64*)(l_fp - asBC_SWORDARG1(l_bc)) % divider;
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_BAND64:
+	AS_CASE(asBC_BAND64):
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) & *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_BOR64:
+	AS_CASE(asBC_BOR64):
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) | *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_BXOR64:
+	AS_CASE(asBC_BXOR64):
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) ^ *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_BSLL64:
+	AS_CASE(asBC_BSLL64):
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) << *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_BSRL64:
+	AS_CASE(asBC_BSRL64):
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) >> *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_BSRA64:
+	AS_CASE(asBC_BSRA64):
 		*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asINT64*)(l_fp - asBC_SWORDARG1(l_bc)) >> *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_CMPi64:
+	AS_CASE(asBC_CMPi64):
 		{
 			asINT64 i1 = *(asINT64*)(l_fp - asBC_SWORDARG0(l_bc));
 			asINT64 i2 = *(asINT64*)(l_fp - asBC_SWORDARG1(l_bc));
@@ -3806,9 +3892,9 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_CMPu64:
+	AS_CASE(asBC_CMPu64):
 		{
 			asQWORD d1 = *(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 			asQWORD d2 = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc));
@@ -3817,9 +3903,9 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_ChkNullS:
+	AS_CASE(asBC_ChkNullS):
 		{
 			// Verify if the pointer on the stack is null
 			// This is used for example when validating handles passed as function arguments
@@ -3835,9 +3921,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_ClrHi:
+	AS_CASE(asBC_ClrHi):
 #if AS_SIZEOF_BOOL == 1
 		{
 			// Clear the upper bytes, so that trash data don't interfere with boolean operations
@@ -3854,9 +3940,9 @@ void asCContext::ExecuteNext()
 		// We don't have anything to do here
 #endif
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_JitEntry:
+	AS_CASE(asBC_JitEntry):
 		{
 			if( m_currentFunction->scriptData->jitFunction )
 			{
@@ -3886,9 +3972,9 @@ void asCContext::ExecuteNext()
 			// Not a JIT resume point, treat as nop
 			l_bc += 1+AS_PTR_SIZE;
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_CallPtr:
+	AS_CASE(asBC_CallPtr):
 		{
 			// Get the function pointer from the local variable
 			asCScriptFunction *func = *(asCScriptFunction**)(l_fp - asBC_SWORDARG0(l_bc));
@@ -3963,16 +4049,16 @@ void asCContext::ExecuteNext()
 			if( m_status != asEXECUTION_ACTIVE )
 				return;
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_FuncPtr:
+	AS_CASE(asBC_FuncPtr):
 		// Push the function pointer on the stack. The pointer is in the argument
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = asBC_PTRARG(l_bc);
 		l_bc += 1+AS_PTR_SIZE;
-		break;
+		AS_NEXT();
 
-	case asBC_LoadThisR:
+	AS_CASE(asBC_LoadThisR):
 		{
 			// PshVPtr 0
 			asPWORD tmp = *(asPWORD*)l_fp;
@@ -3997,16 +4083,16 @@ void asCContext::ExecuteNext()
 			*(asPWORD*)&m_regs.valueRegister = tmp;
 			l_bc += 2;
 		}
-		break;
+		AS_NEXT();
 
 	// Push the qword value of a variable on the stack
-	case asBC_PshV8:
+	AS_CASE(asBC_PshV8):
 		l_sp -= 2;
 		*(asQWORD*)l_sp = *(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		AS_NEXT();
 
-	case asBC_DIVu:
+	AS_CASE(asBC_DIVu):
 		{
 			asUINT divider = *(asUINT*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -4023,9 +4109,9 @@ void asCContext::ExecuteNext()
 			*(asUINT*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asUINT*)(l_fp - asBC_SWORDARG1(l_bc)) / divider;
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_MODu:
+	AS_CASE(asBC_MODu):
 		{
 			asUINT divider = *(asUINT*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -4042,9 +4128,9 @@ void asCContext::ExecuteNext()
 			*(asUINT*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asUINT*)(l_fp - asBC_SWORDARG1(l_bc)) % divider;
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_DIVu64:
+	AS_CASE(asBC_DIVu64):
 		{
 			asQWORD divider = *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -4061,9 +4147,9 @@ void asCContext::ExecuteNext()
 			*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) / divider;
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_MODu64:
+	AS_CASE(asBC_MODu64):
 		{
 			asQWORD divider = *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -4080,9 +4166,9 @@ void asCContext::ExecuteNext()
 			*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) % divider;
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_LoadRObjR:
+	AS_CASE(asBC_LoadRObjR):
 		{
 			// PshVPtr x
 			asPWORD tmp = *(asPWORD*)(l_fp - asBC_SWORDARG0(l_bc));
@@ -4107,9 +4193,9 @@ void asCContext::ExecuteNext()
 			*(asPWORD*)&m_regs.valueRegister = tmp;
 			l_bc += 3;
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_LoadVObjR:
+	AS_CASE(asBC_LoadVObjR):
 		{
 			// PSF x
 			asPWORD tmp = (asPWORD)(l_fp - asBC_SWORDARG0(l_bc));
@@ -4121,9 +4207,9 @@ void asCContext::ExecuteNext()
 			*(asPWORD*)&m_regs.valueRegister = tmp;
 			l_bc += 3;
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_RefCpyV:
+	AS_CASE(asBC_RefCpyV):
 		// Same as PSF v, REFCPY
 		{
 			asCObjectType *objType = (asCObjectType*)asBC_PTRARG(l_bc);
@@ -4155,23 +4241,23 @@ void asCContext::ExecuteNext()
 			*d = s;
 		}
 		l_bc += 1+AS_PTR_SIZE;
-		break;
+		AS_NEXT();
 
-	case asBC_JLowZ:
+	AS_CASE(asBC_JLowZ):
 		if( *(asBYTE*)&m_regs.valueRegister == 0 )
 			l_bc += asBC_INTARG(l_bc) + 2;
 		else
 			l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_JLowNZ:
+	AS_CASE(asBC_JLowNZ):
 		if( *(asBYTE*)&m_regs.valueRegister != 0 )
 			l_bc += asBC_INTARG(l_bc) + 2;
 		else
 			l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_AllocMem:
+	AS_CASE(asBC_AllocMem):
 		// Allocate a buffer and store the pointer in the local variable
 		{
 			// TODO: runtime optimize: As the list buffers are going to be short lived, it may be interesting
@@ -4189,9 +4275,9 @@ void asCContext::ExecuteNext()
 			memset(*var, 0, size);
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_SetListSize:
+	AS_CASE(asBC_SetListSize):
 		{
 			// Set the size element in the buffer
 			asBYTE *var = *(asBYTE**)(l_fp - asBC_SWORDARG0(l_bc));
@@ -4203,9 +4289,9 @@ void asCContext::ExecuteNext()
 			*(asUINT*)(var+off) = size;
 		}
 		l_bc += 3;
-		break;
+		AS_NEXT();
 
-	case asBC_PshListElmnt:
+	AS_CASE(asBC_PshListElmnt):
 		{
 			// Push the pointer to the list element on the stack
 			// In essence it does the same as PSF, RDSPtr, ADDSi
@@ -4218,9 +4304,9 @@ void asCContext::ExecuteNext()
 			*(asPWORD*)l_sp = asPWORD(var+off);
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_SetListType:
+	AS_CASE(asBC_SetListType):
 		{
 			// Set the type id in the buffer
 			asBYTE *var = *(asBYTE**)(l_fp - asBC_SWORDARG0(l_bc));
@@ -4232,11 +4318,11 @@ void asCContext::ExecuteNext()
 			*(asUINT*)(var+off) = type;
 		}
 		l_bc += 3;
-		break;
+		AS_NEXT();
 
 	//------------------------------
 	// Exponent operations
-	case asBC_POWi:
+	AS_CASE(asBC_POWi):
 		{
 			bool isOverflow;
 			*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = as_powi(*(int*)(l_fp - asBC_SWORDARG1(l_bc)), *(int*)(l_fp - asBC_SWORDARG2(l_bc)), isOverflow);
@@ -4253,9 +4339,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_POWu:
+	AS_CASE(asBC_POWu):
 		{
 			bool isOverflow;
 			*(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = as_powu(*(asDWORD*)(l_fp - asBC_SWORDARG1(l_bc)), *(asDWORD*)(l_fp - asBC_SWORDARG2(l_bc)), isOverflow);
@@ -4272,9 +4358,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_POWf:
+	AS_CASE(asBC_POWf):
 		{
 			float r = powf(*(float*)(l_fp - asBC_SWORDARG1(l_bc)), *(float*)(l_fp - asBC_SWORDARG2(l_bc)));
 			*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = r;
@@ -4291,9 +4377,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_POWd:
+	AS_CASE(asBC_POWd):
 		{
 			double r = pow(*(double*)(l_fp - asBC_SWORDARG1(l_bc)), *(double*)(l_fp - asBC_SWORDARG2(l_bc)));
 			*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = r;
@@ -4310,9 +4396,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_POWdi:
+	AS_CASE(asBC_POWdi):
 		{
 			double r = pow(*(double*)(l_fp - asBC_SWORDARG1(l_bc)), *(int*)(l_fp - asBC_SWORDARG2(l_bc)));
 			*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = r;
@@ -4329,9 +4415,9 @@ void asCContext::ExecuteNext()
 			}
 			l_bc += 2;
 		}
-		break;
+		AS_NEXT();
 
-	case asBC_POWi64:
+	AS_CASE(asBC_POWi64):
 		{
 			bool isOverflow;
 			*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = as_powi64(*(asINT64*)(l_fp - asBC_SWORDARG1(l_bc)), *(asINT64*)(l_fp - asBC_SWORDARG2(l_bc)), isOverflow);
@@ -4348,9 +4434,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc += 2;
-		break;
+		AS_NEXT();
 
-	case asBC_POWu64:
+	AS_CASE(asBC_POWu64):
 		{
 			bool isOverflow;
 			*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = as_powu64(*(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)), *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc)), isOverflow);
@@ -4367,8 +4453,8 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc += 2;
-		break;
-	case asBC_Thiscall1:
+		AS_NEXT();
+	AS_CASE(asBC_Thiscall1):
 		// This instruction is a faster version of asBC_CALLSYS. It is faster because
 		// it has much less runtime overhead with determining the calling convention 
 		// and no dynamic code for loading the parameters. The instruction can only
@@ -4435,7 +4521,7 @@ void asCContext::ExecuteNext()
 				}
 			}
 		}
-		break;
+		AS_NEXT();
 
 	// Don't let the optimizer optimize for size,
 	// since it requires extra conditions and jumps
@@ -4522,6 +4608,9 @@ void asCContext::ExecuteNext()
 	}
 }
 
+#undef AS_CASE
+#undef AS_NEXT
+
 // interface
 int asCContext::SetException(const char *descr, bool allowCatch)
 {
@@ -115,6 +115,9 @@ AS_API const char * asGetLibraryOptions()
 #ifdef AS_NO_EXCEPTIONS
 		"AS_NO_EXCEPTIONS "
 #endif
+#if defined(AS_COMPUTED_GOTO) && (defined(__GNUC__) || defined(__clang__)) && !defined(AS_DEBUG)
+		"AS_COMPUTED_GOTO "
+#endif
 #ifdef WIP_16BYTE_ALIGN
 		"WIP_16BYTE_ALIGN "
 #endif
@@ -0,0 +1,272 @@
+
+/************************************************************************
+*    FILE NAME:       assetpacker.cpp
+*
+*    DESCRIPTION:     Packs the loose data files into one asset archive
+*                     the game maps at runtime. Run it from the game
+*                     folder so the paths match the ones the game loads
+*                     ex: assetpacker data.pak data --zstd
+************************************************************************/
+
+// Game lib dependencies
+#include <utilities/assetarchiveformat.h>
+
+// Compression lib dependencies
+#if defined(ASSET_ARCHIVE_LZ4)
+#include <lz4.h>
+#endif
+
+#if defined(ASSET_ARCHIVE_ZSTD)
+#include <zstd.h>
+#endif
+
+// Standard lib dependencies
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Only keep the compressed data when it's smaller than this part of the file
+    const double COMPRESSED_RATIO = 0.9;
+
+    /************************************************************************
+    *    DESC:  Read in the whole file
+    ************************************************************************/
+    bool ReadFile( const std::string & path, std::vector<char> & fileVec )
+    {
+        std::ifstream stream( path, std::ios::binary );
+        if( !stream )
+            return false;
+
+        fileVec.assign( std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() );
+
+        return !stream.bad();
+    }
+
+    /************************************************************************
+    *    DESC:  Compress the file. Returns false if the compressed
+    *           data isn't worth keeping
+    ************************************************************************/
+    bool Compress( const std::vector<char> & fileVec, NAssetArchive::ECompression compression, std::vector<char> & compressedVec )
+    {
+        if( fileVec.empty() )
+            return false;
+
+        size_t size = 0;
+
+#if defined(ASSET_ARCHIVE_LZ4)
+        if( compression == NAssetArchive::LZ4 )
+        {
+            compressedVec.resize( LZ4_compressBound( (int)fileVec.size() ) );
+            size = LZ4_compress_default( fileVec.data(), compressedVec.data(), (int)fileVec.size(), (int)compressedVec.size() );
+        }
+#endif
+
+#if defined(ASSET_ARCHIVE_ZSTD)
+        if( compression == NAssetArchive::ZSTD )
+        {
+            compressedVec.resize( ZSTD_compressBound( fileVec.size() ) );
+            size = ZSTD_compress( compressedVec.data(), compressedVec.size(), fileVec.data(), fileVec.size(), 19 );
+            if( ZSTD_isError( size ) )
+                size = 0;
+        }
+#endif
+
+        if( (size == 0) || (size > fileVec.size() * COMPRESSED_RATIO) )
+            return false;
+
+        compressedVec.resize( size );
+
+        return true;
+    }
+
+    /************************************************************************
+    *    DESC:  Pad the archive to the alignment of the next entry
+    ************************************************************************/
+    void Align( std::ofstream & stream, uint64_t & offset, uint64_t alignment )
+    {
+        static const char zeroAry[NAssetArchive::ALIGNMENT] = {};
+
+        const uint64_t padding = (alignment - (offset % alignment)) % alignment;
+        stream.write( zeroAry, padding );
+        offset += padding;
+    }
+
+    /************************************************************************
+    *    DESC:  Add the files of the folder or the file
+    ************************************************************************/
+    void AddFiles( const std::string & input, std::vector<std::string> & pathVec )
+    {
+        namespace fs = std::filesystem;
+
+        if( fs::is_directory( input ) )
+        {
+            for( auto & iter : fs::recursive_directory_iterator( input ) )
+            {
+                if( iter.is_regular_file() )
+                    pathVec.push_back( NAssetArchive::NormalizePath( iter.path().generic_string() ) );
+            }
+        }
+        else if( fs::is_regular_file( input ) )
+        {
+            pathVec.push_back( NAssetArchive::NormalizePath( input ) );
+        }
+        else
+        {
+            std::printf( "Skipping %s. It isn't a file or folder\n", input.c_str() );
+        }
+    }
+}
+
+int main( int argc, char* args[] )
+{
+    NAssetArchive::ECompression compression = NAssetArchive::NONE;
+    std::vector<std::string> inputVec;
+
+    for( int i = 2; i < argc; ++i )
+    {
+        if( std::strcmp( args[i], "--lz4" ) == 0 )
+            compression = NAssetArchive::LZ4;
+        else if( std::strcmp( args[i], "--zstd" ) == 0 )
+            compression = NAssetArchive::ZSTD;
+        else
+            inputVec.push_back( args[i] );
+    }
+
+    if( inputVec.empty() )
+    {
+        std::printf( "Usage: assetpacker <archive> <folder or file>... [--lz4 | --zstd]\n" );
+        return EXIT_FAILURE;
+    }
+
+#if !defined(ASSET_ARCHIVE_LZ4)
+    if( compression == NAssetArchive::LZ4 )
+    {
+        std::printf( "Built without LZ4. Configure with -DASSET_ARCHIVE_LZ4=ON\n" );
+        return EXIT_FAILURE;
+    }
+#endif
+
+#if !defined(ASSET_ARCHIVE_ZSTD)
+    if( compression == NAssetArchive::ZSTD )
+    {
+        std::printf( "Built without zstd. Configure with -DASSET_ARCHIVE_ZSTD=ON\n" );
+        return EXIT_FAILURE;
+    }
+#endif
+
+    const std::string archivePath = NAssetArchive::NormalizePath( args[1] );
+
+    std::vector<std::string> pathVec;
+    for( auto & iter : inputVec )
+        AddFiles( iter, pathVec );
+
+    // Keep the archive out of itself when it's written into a packed folder
+    pathVec.erase( std::remove( pathVec.begin(), pathVec.end(), archivePath ), pathVec.end() );
+
+    // Store the files in path order so the files of a folder are together
+    std::sort( pathVec.begin(), pathVec.end() );
+    pathVec.erase( std::unique( pathVec.begin(), pathVec.end() ), pathVec.end() );
+
+    std::ofstream stream( archivePath, std::ios::binary | std::ios::trunc );
+    if( !stream )
+    {
+        std::printf( "Can't create the archive (%s)\n", archivePath.c_str() );
+        return EXIT_FAILURE;
+    }
+
+    // The header is written again once the offsets are known
+    NAssetArchive::SHeader header = {};
+    header.fileId = NAssetArchive::FILE_ID;
+    header.version = NAssetArchive::VERSION;
+    header.entryCount = (uint32_t)pathVec.size();
+    header.alignment = NAssetArchive::ALIGNMENT;
+    stream.write( reinterpret_cast<const char *>(&header), sizeof(header) );
+
+    uint64_t offset = sizeof(header);
+    uint64_t fileTotal = 0;
+    int compressedCount = 0;
+
+    std::vector<NAssetArchive::SEntry> entryVec;
+    entryVec.reserve( pathVec.size() );
+    std::string pathTable;
+
+    std::vector<char> fileVec;
+    std::vector<char> compressedVec;
+
+    for( auto & iter : pathVec )
+    {
+        if( !ReadFile( iter, fileVec ) )
+        {
+            std::printf( "Can't read the file (%s)\n", iter.c_str() );
+            return EXIT_FAILURE;
+        }
+
+        Align( stream, offset, NAssetArchive::ALIGNMENT );
+
+        NAssetArchive::SEntry entry = {};
+        entry.hash = NAssetArchive::HashPath( iter );
+        entry.offset = offset;
+        entry.fileSize = fileVec.size();
+        entry.pathOffset = (uint32_t)pathTable.size();
+        entry.pathSize = (uint32_t)iter.size();
+        entry.compression = NAssetArchive::NONE;
+
+        const std::vector<char> * pStoreVec = &fileVec;
+        if( (compression != NAssetArchive::NONE) && Compress( fileVec, compression, compressedVec ) )
+        {
+            entry.compression = compression;
+            pStoreVec = &compressedVec;
+            ++compressedCount;
+        }
+
+        entry.size = pStoreVec->size();
+        stream.write( pStoreVec->data(), pStoreVec->size() );
+        offset += pStoreVec->size();
+        fileTotal += fileVec.size();
+
+        entryVec.push_back( entry );
+        pathTable += iter;
+    }
+
+    // The runtime binary searches the index by hash. Paths break the ties
+    std::sort( entryVec.begin(), entryVec.end(),
+        [&pathTable]( const NAssetArchive::SEntry & a, const NAssetArchive::SEntry & b )
+        {
+            if( a.hash != b.hash )
+                return a.hash < b.hash;
+
+            return pathTable.compare( a.pathOffset, a.pathSize, pathTable, b.pathOffset, b.pathSize ) < 0;
+        } );
+
+    Align( stream, offset, alignof(NAssetArchive::SEntry) );
+    header.indexOffset = offset;
+    stream.write( reinterpret_cast<const char *>(entryVec.data()), entryVec.size() * sizeof(NAssetArchive::SEntry) );
+    offset += entryVec.size() * sizeof(NAssetArchive::SEntry);
+
+    header.pathOffset = offset;
+    stream.write( pathTable.data(), pathTable.size() );
+    offset += pathTable.size();
+
+    stream.seekp( 0 );
+    stream.write( reinterpret_cast<const char *>(&header), sizeof(header) );
+
+    if( !stream.flush() )
+    {
+        std::printf( "Error writing the archive (%s)\n", archivePath.c_str() );
+        return EXIT_FAILURE;
+    }
+
+    std::printf( "Packed %d files (%d compressed) into %s. Files: %llu bytes, Archive: %llu bytes\n",
+        (int)entryVec.size(), compressedCount, archivePath.c_str(),
+        (unsigned long long)fileTotal, (unsigned long long)offset );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,167 @@
+
+/************************************************************************
+*    FILE NAME:       broadphasebench.cpp
+*
+*    DESCRIPTION:     Times the Box2D broad-phase on a level shaped
+*                     like the game's. A field of static pegs is loaded
+*                     and waves of balls are dropped through it
+************************************************************************/
+
+// Box2D lib dependencies
+#include <Box2D/Box2D.h>
+
+// Standard lib dependencies
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    const float STEP_TIME = 1.f / 60.f;
+    const int VELOCITY_ITERATIONS = 8;
+    const int POSITION_ITERATIONS = 3;
+
+    // Static pegs in the field, balls per wave and steps between waves
+    const int PEG_COLUMNS = 60;
+    const int BALLS_PER_WAVE = 100;
+    const int WAVE_STEPS = 20;
+
+    /************************************************************************
+    *    DESC:  Time since the start in milliseconds
+    ************************************************************************/
+    double Elapsed( std::chrono::high_resolution_clock::time_point start )
+    {
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        return std::chrono::duration<double, std::milli>( end - start ).count();
+    }
+
+    /************************************************************************
+    *    DESC:  Create the static walls and the field of pegs
+    ************************************************************************/
+    void CreateLevel( b2World & world, int pegRows )
+    {
+        const float width = PEG_COLUMNS * 2.f;
+
+        b2BodyDef bodyDef;
+        b2Body * pWalls = world.CreateBody( &bodyDef );
+
+        b2EdgeShape edge;
+        edge.Set( b2Vec2( -width * 0.5f, 0.f ), b2Vec2( width * 0.5f, 0.f ) );
+        pWalls->CreateFixture( &edge, 0.f );
+        edge.Set( b2Vec2( -width * 0.5f, 0.f ), b2Vec2( -width * 0.5f, pegRows * 2.f + 40.f ) );
+        pWalls->CreateFixture( &edge, 0.f );
+        edge.Set( b2Vec2( width * 0.5f, 0.f ), b2Vec2( width * 0.5f, pegRows * 2.f + 40.f ) );
+        pWalls->CreateFixture( &edge, 0.f );
+
+        // One body per peg like the game's level loader
+        b2CircleShape circle;
+        circle.m_radius = 0.25f;
+
+        b2PolygonShape box;
+        box.SetAsBox( 0.3f, 0.3f );
+
+        for( int row = 0; row < pegRows; ++row )
+        {
+            for( int col = 0; col < PEG_COLUMNS; ++col )
+            {
+                bodyDef.position.Set(
+                    -width * 0.5f + (col + 0.5f + (row & 1) * 0.5f) * 2.f,
+                    10.f + row * 2.f );
+                bodyDef.angle = 0.25f * (col % 4);
+
+                b2Body * pPeg = world.CreateBody( &bodyDef );
+                pPeg->CreateFixture( ((row + col) % 3 == 0) ? (b2Shape*)&box : (b2Shape*)&circle, 0.f );
+            }
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  Drop a row of balls above the pegs
+    ************************************************************************/
+    void DropWave( b2World & world, int pegRows, int wave )
+    {
+        b2BodyDef bodyDef;
+        bodyDef.type = b2_dynamicBody;
+
+        b2CircleShape circle;
+        circle.m_radius = 0.4f;
+
+        b2FixtureDef fixtureDef;
+        fixtureDef.shape = &circle;
+        fixtureDef.density = 1.f;
+        fixtureDef.restitution = 0.3f;
+
+        const float spacing = (PEG_COLUMNS * 2.f - 4.f) / BALLS_PER_WAVE;
+
+        for( int i = 0; i < BALLS_PER_WAVE; ++i )
+        {
+            bodyDef.position.Set(
+                -PEG_COLUMNS + 2.f + (i + 0.5f) * spacing + 0.1f * (wave % 5),
+                pegRows * 2.f + 14.f + (i % 7) );
+
+            world.CreateBody( &bodyDef )->CreateFixture( &fixtureDef );
+        }
+    }
+}
+
+int main( int argc, char* args[] )
+{
+    int pegRows = 60;
+    if( argc > 1 )
+        pegRows = std::max( std::atoi( args[1] ), 1 );
+
+    int waves = 20;
+    if( argc > 2 )
+        waves = std::max( std::atoi( args[2] ), 1 );
+
+    b2World world( b2Vec2( 0.f, -10.f ) );
+
+    // Level load is the static proxies plus the first step that builds their pairs
+    auto start = std::chrono::high_resolution_clock::now();
+    CreateLevel( world, pegRows );
+    world.Step( STEP_TIME, VELOCITY_ITERATIONS, POSITION_ITERATIONS );
+    const double loadTime = Elapsed( start );
+
+    std::printf( "Static proxies: %d, Balls: %d\n", world.GetProxyCount(), waves * BALLS_PER_WAVE );
+
+    double spawnTime = 0, stepTime = 0, broadphaseTime = 0, collideTime = 0;
+    const int stepCount = waves * WAVE_STEPS + 200;
+
+    for( int step = 0; step < stepCount; ++step )
+    {
+        if( (step % WAVE_STEPS == 0) && (step / WAVE_STEPS < waves) )
+        {
+            start = std::chrono::high_resolution_clock::now();
+            DropWave( world, pegRows, step / WAVE_STEPS );
+            spawnTime += Elapsed( start );
+        }
+
+        start = std::chrono::high_resolution_clock::now();
+        world.Step( STEP_TIME, VELOCITY_ITERATIONS, POSITION_ITERATIONS );
+        stepTime += Elapsed( start );
+
+        const b2Profile & profile = world.GetProfile();
+        broadphaseTime += profile.broadphase;
+        collideTime += profile.collide;
+    }
+
+    // The sum of the ball heights shows if the simulation changed
+    double checksum = 0;
+    for( b2Body * pBody = world.GetBodyList(); pBody != nullptr; pBody = pBody->GetNext() )
+        if( pBody->GetType() == b2_dynamicBody )
+            checksum += pBody->GetPosition().y;
+
+    std::printf( "%-22s %12.2f ms\n", "Level load", loadTime );
+    std::printf( "%-22s %12.2f ms\n", "Ball spawn", spawnTime );
+    std::printf( "%-22s %12.3f ms\n", "Step average", stepTime / stepCount );
+    std::printf( "%-22s %12.3f ms\n", "Broad-phase average", broadphaseTime / stepCount );
+    std::printf( "%-22s %12.3f ms\n", "Collide average", collideTime / stepCount );
+    std::printf( "%-22s %12d\n", "Tree height", world.GetTreeHeight() );
+    std::printf( "%-22s %12.2f\n", "Tree quality", world.GetTreeQuality() );
+    std::printf( "%-22s %12d\n", "Contacts", world.GetContactCount() );
+    std::printf( "%-22s %12.4f\n", "Checksum", checksum );
+
+    return EXIT_SUCCESS;
+}
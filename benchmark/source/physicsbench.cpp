@@ -0,0 +1,569 @@
+
+/************************************************************************
+*    FILE NAME:       physicsbench.cpp
+*
+*    DESCRIPTION:     Steps a 2D physics world built from the game's
+*                     physics and object data without a window or a
+*                     device. The world, body pools and shapes are the
+*                     engine's. Reports the Box2D profile and a checksum
+*                     of the published body states and the contact
+*                     lists. Run it from the game folder so the data
+*                     paths resolve. The checksum must match between
+*                     builds of the same scene
+************************************************************************/
+
+// Game lib dependencies
+#include <objectdata/objectphysicsdata2d.h>
+#include <physics/physicsworld2d.h>
+#include <utilities/xmlParser.h>
+#include <utilities/exceptionhandling.h>
+#include <utilities/threadpool.h>
+
+// Box2D lib dependencies
+#include <Box2D/Box2D.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Time of a frame of a 60 Hz display in milliseconds. The world's
+    // fixed time step decides how many steps that is
+    const float FRAME_TIME = 1000.f / 60.f;
+
+    /************************************************************************
+    *    DESC:  Hash the bytes into the checksum
+    ************************************************************************/
+    void HashBytes( uint64_t & hash, const void * pData, size_t size )
+    {
+        const unsigned char * pBytes = static_cast<const unsigned char *>(pData);
+        for( size_t i = 0; i < size; ++i )
+        {
+            hash ^= pBytes[i];
+            hash *= 0x100000001b3ULL;
+        }
+    }
+
+    // Physics world that hashes the contact lists of the step
+    // instead of sending them to the listener scripts
+    class CBenchWorld : public CPhysicsWorld2D
+    {
+    public:
+
+        uint64_t contactHash = 0xcbf29ce484222325ULL;
+        size_t contactCount = 0;
+
+    protected:
+
+        void sendContactList( const CScriptFuncHandle & handle, std::vector<CContact2D> & rContactVec ) override
+        {
+            for( auto & iter : rContactVec )
+            {
+                const float contactAry[] = { iter.normalX, iter.normalY, iter.impulse };
+                HashBytes( contactHash, contactAry, sizeof(contactAry) );
+            }
+
+            contactCount += rContactVec.size();
+        }
+    };
+
+    // An object of the object data list that has physics
+    struct SPhysicsObject
+    {
+        std::string name;
+        CObjectPhysicsData2D physicsData;
+
+        // Size of the visual in pixels. Polygons without verts are built from it
+        CSize<float> size;
+
+        // Pool of the object data at a scale of one. Holds the shared shapes
+        // NOTE: Do not free. The world owns this pointer.
+        CBodyPool2D * pBodyPool = nullptr;
+
+        // Largest extent of the fixtures in meters
+        float extent = 0;
+    };
+
+    // The objects sorted by the part they play in the patterns
+    struct SObjectRoles
+    {
+        std::vector<const SPhysicsObject *> pegVec;
+        std::vector<const SPhysicsObject *> ballVec;
+        std::vector<const SPhysicsObject *> boxVec;
+    };
+
+    // The scene the pattern is built in. Up is against the gravity
+    struct SScene
+    {
+        CPhysicsWorld2D * pWorld = nullptr;
+        b2Vec2 up;
+        b2Vec2 right;
+
+        // Bodies in the order they were created for the checksum
+        std::vector<b2Body *> bodyVec;
+
+        // Dynamic objects waiting to be dropped
+        struct SDrop
+        {
+            const SPhysicsObject * pObject;
+            b2Vec2 pos;
+        };
+        std::vector<SDrop> dropVec;
+        size_t dropIndex = 0;
+        int dropsPerWave = 0;
+        int waveFrames = 1;
+    };
+
+    /************************************************************************
+    *    DESC:  Read the width and height from the header of a png file
+    ************************************************************************/
+    CSize<float> GetPngSize( const std::string & file )
+    {
+        unsigned char header[24];
+
+        std::ifstream stream( file, std::ios::binary );
+        if( !stream.read( reinterpret_cast<char *>(header), sizeof(header) ) ||
+            (std::memcmp( header + 1, "PNG", 3 ) != 0) || (std::memcmp( header + 12, "IHDR", 4 ) != 0) )
+            throw NExcept::CCriticalException("Physics Bench Error!",
+                boost::str( boost::format("Can't read the size of the png (%s).\n\n%s\nLine: %s")
+                    % file % __FUNCTION__ % __LINE__ ));
+
+        auto bigEndian = [&header]( int offset )
+            { return (header[offset] << 24) | (header[offset+1] << 16) | (header[offset+2] << 8) | header[offset+3]; };
+
+        return CSize<float>( (float)bigEndian(16), (float)bigEndian(20) );
+    }
+
+    /************************************************************************
+    *    DESC:  Get the size of the object's visual. The size node
+    *           overrides the size of the texture
+    ************************************************************************/
+    CSize<float> GetObjectSize( const XMLNode & objectNode )
+    {
+        const XMLNode sizeNode = objectNode.getChildNode( "size" );
+        if( !sizeNode.isEmpty() )
+        {
+            CSize<float> size( std::atof( sizeNode.getAttribute( "width" ) ), std::atof( sizeNode.getAttribute( "height" ) ) );
+            if( (size.w > 0.f) && (size.h > 0.f) )
+                return size;
+        }
+
+        const XMLNode textureNode = objectNode.getChildNode( "visual" ).getChildNode( "texture" );
+        if( textureNode.isEmpty() || !textureNode.isAttributeSet( "file" ) )
+            return CSize<float>();
+
+        // Texture sequences all have the size of the first frame
+        std::string file = textureNode.getAttribute( "file" );
+        if( textureNode.isAttributeSet( "count" ) )
+            file = boost::str( boost::format(file) % 0 );
+
+        return GetPngSize( file );
+    }
+
+    /************************************************************************
+    *    DESC:  Get the largest extent of the pool's shapes in meters
+    ************************************************************************/
+    float GetExtent( const CBodyPool2D & bodyPool )
+    {
+        float extent = 0.f;
+
+        b2Transform transform;
+        transform.SetIdentity();
+
+        for( auto & iter : bodyPool.getFixtureDefVec() )
+        {
+            for( int32 i = 0; i < iter.shape->GetChildCount(); ++i )
+            {
+                b2AABB aabb;
+                iter.shape->ComputeAABB( &aabb, transform, i );
+
+                extent = std::max( extent, std::max( -aabb.lowerBound.x, -aabb.lowerBound.y ) );
+                extent = std::max( extent, std::max( aabb.upperBound.x, aabb.upperBound.y ) );
+            }
+        }
+
+        return extent;
+    }
+
+    /************************************************************************
+    *    DESC:  Create the body of the object through the world like the
+    *           physics component. The position is in meters
+    ************************************************************************/
+    b2Body * CreateObjectBody( SScene & scene, const SPhysicsObject & object, const b2Vec2 & pos )
+    {
+        b2BodyDef bodyDef;
+        bodyDef.position = pos;
+        bodyDef.userData = (void*)&object;
+
+        b2Body * pBody = scene.pWorld->createBody(
+            bodyDef, object.physicsData, *object.pBodyPool, object.size, CSize<float>(1.f, 1.f), object.name );
+
+        scene.bodyVec.push_back( pBody );
+
+        return pBody;
+    }
+
+    /************************************************************************
+    *    DESC:  Get the position in the scene. Right across and up
+    *           against the gravity from the middle of the floor
+    ************************************************************************/
+    b2Vec2 ScenePos( const SScene & scene, float across, float height )
+    {
+        return (across * scene.right) + (height * scene.up);
+    }
+
+    /************************************************************************
+    *    DESC:  Create the floor and walls the pattern is built in
+    ************************************************************************/
+    void CreateContainer( SScene & scene, float width, float height )
+    {
+        b2BodyDef bodyDef;
+        b2Body * pBody = scene.pWorld->createBody( bodyDef );
+
+        const b2Vec2 floorLeft = ScenePos( scene, -width * 0.5f, 0.f );
+        const b2Vec2 floorRight = ScenePos( scene, width * 0.5f, 0.f );
+
+        b2EdgeShape edge;
+        edge.Set( floorLeft, floorRight );
+        pBody->CreateFixture( &edge, 0.f );
+        edge.Set( floorLeft, ScenePos( scene, -width * 0.5f, height ) );
+        pBody->CreateFixture( &edge, 0.f );
+        edge.Set( floorRight, ScenePos( scene, width * 0.5f, height ) );
+        pBody->CreateFixture( &edge, 0.f );
+
+        scene.bodyVec.push_back( pBody );
+    }
+
+    /************************************************************************
+    *    DESC:  Largest extent of the objects
+    ************************************************************************/
+    float MaxExtent( const std::vector<const SPhysicsObject *> & objectVec )
+    {
+        float extent = 0.f;
+        for( auto iter : objectVec )
+            extent = std::max( extent, iter->extent );
+
+        return extent;
+    }
+
+    /************************************************************************
+    *    DESC:  Exit if the pattern has no objects to use
+    ************************************************************************/
+    void CheckRole( const std::vector<const SPhysicsObject *> & objectVec, const char * pRole )
+    {
+        if( objectVec.empty() )
+            throw NExcept::CCriticalException("Physics Bench Error!",
+                boost::str( boost::format("The object data has no %s for the pattern.\n\n%s\nLine: %s")
+                    % pRole % __FUNCTION__ % __LINE__ ));
+    }
+
+    /************************************************************************
+    *    DESC:  Peg board of static pegs with the balls dropped in waves
+    ************************************************************************/
+    void BuildPachinko( SScene & scene, const SObjectRoles & roles, int bodyCount )
+    {
+        CheckRole( roles.pegVec, "static circles for pegs" );
+        CheckRole( roles.ballVec, "dynamic circles for balls" );
+
+        const float ball = 2.f * MaxExtent( roles.ballVec );
+        const float spacing = 2.f * MaxExtent( roles.pegVec ) + (2.5f * ball);
+        const int columns = std::max( 10, (int)std::sqrt( (float)bodyCount ) );
+        const int rows = 12;
+        const float width = columns * spacing;
+        const float height = (rows + 6) * spacing;
+
+        CreateContainer( scene, width, height );
+
+        for( int row = 0; row < rows; ++row )
+        {
+            const int count = columns - (row & 1);
+            for( int col = 0; col < count; ++col )
+            {
+                const float across = -width * 0.5f + (col + 0.5f + ((row & 1) * 0.5f)) * spacing;
+                CreateObjectBody( scene, *roles.pegVec[(row + col) % roles.pegVec.size()], ScenePos( scene, across, (row + 3) * spacing ) );
+            }
+        }
+
+        // Drop a row of balls between the walls every wave
+        const int perRow = std::max( 1, (int)((width - ball) / (ball * 1.25f)) );
+        for( int i = 0; i < bodyCount; ++i )
+        {
+            const float across = -width * 0.5f + ball + (i % perRow) * (ball * 1.25f) + (0.05f * ball * (i / perRow % 5));
+            scene.dropVec.push_back( { roles.ballVec[i % roles.ballVec.size()], ScenePos( scene, across, height - ball ) } );
+        }
+
+        scene.dropsPerWave = perRow;
+        scene.waveFrames = 15;
+    }
+
+    /************************************************************************
+    *    DESC:  Pyramid of boxes on the floor
+    ************************************************************************/
+    void BuildStack( SScene & scene, const SObjectRoles & roles, int bodyCount )
+    {
+        CheckRole( roles.boxVec, "dynamic polygons for boxes" );
+
+        const float box = 2.f * MaxExtent( roles.boxVec );
+        const int base = (int)std::ceil( (std::sqrt( 8.f * bodyCount + 1.f ) - 1.f) * 0.5f );
+        const float width = (base + 4) * box;
+
+        CreateContainer( scene, width, (base + 2) * box );
+
+        int created = 0;
+        for( int row = 0; (row < base) && (created < bodyCount); ++row )
+        {
+            for( int col = 0; (col < base - row) && (created < bodyCount); ++col, ++created )
+            {
+                const float across = (-(base - row - 1) * 0.5f + col) * box;
+                CreateObjectBody( scene, *roles.boxVec[created % roles.boxVec.size()], ScenePos( scene, across, (row + 0.5f) * box ) );
+            }
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  Grid of balls and boxes dropped into a box at once
+    ************************************************************************/
+    void BuildBalls( SScene & scene, const SObjectRoles & roles, int bodyCount )
+    {
+        std::vector<const SPhysicsObject *> objectVec( roles.ballVec );
+        objectVec.insert( objectVec.end(), roles.boxVec.begin(), roles.boxVec.end() );
+        CheckRole( objectVec, "dynamic objects" );
+
+        const float spacing = 2.5f * MaxExtent( objectVec );
+        const int columns = std::max( 4, (int)std::sqrt( (float)bodyCount ) );
+        const int rows = (bodyCount + columns - 1) / columns;
+        const float width = (columns + 1) * spacing;
+
+        CreateContainer( scene, width, (rows + 2) * spacing );
+
+        for( int i = 0; i < bodyCount; ++i )
+        {
+            const int row = i / columns;
+            const float across = -width * 0.5f + ((i % columns) + 1 + ((row & 1) * 0.25f)) * spacing;
+            CreateObjectBody( scene, *objectVec[i % objectVec.size()], ScenePos( scene, across, (row + 1) * spacing ) );
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  Load the objects that have physics from the object data list.
+    *           Their shapes are built in the world's body pools
+    ************************************************************************/
+    void LoadObjects( const std::string & filePath, CPhysicsWorld2D & world, std::vector<SPhysicsObject> & objectVec )
+    {
+        const XMLNode node = XMLNode::openFileHelper( filePath.c_str(), "objectDataList2D" );
+        const XMLNode listNode = node.getChildNode( "objectList" );
+
+        for( int i = 0; i < listNode.nChildNode( "object" ); ++i )
+        {
+            const XMLNode objectNode = listNode.getChildNode( "object", i );
+            if( objectNode.getChildNode( "physics" ).isEmpty() )
+                continue;
+
+            objectVec.emplace_back();
+            SPhysicsObject & rObject = objectVec.back();
+            rObject.name = objectNode.getAttribute( "name" );
+            rObject.physicsData.loadFromNode( objectNode );
+            rObject.size = GetObjectSize( objectNode );
+
+            const CObjectPhysicsData2D & physicsData = rObject.physicsData;
+            if( !physicsData.isActive() || (physicsData.getBodyType() == b2BodyType(-1)) )
+                continue;
+
+            // Polygons without points are built from the size of the visual
+            for( auto & iter : physicsData.getFixtureVec() )
+                if( (iter.m_shape == b2Shape::e_polygon) && iter.m_vertVec.empty() && ((rObject.size.w <= 0.f) || (rObject.size.h <= 0.f)) )
+                    throw NExcept::CCriticalException("Physics Bench Error!",
+                        boost::str( boost::format("Polygon fixture needs the size of the object (%s).\n\n%s\nLine: %s")
+                            % rObject.name % __FUNCTION__ % __LINE__ ));
+
+            rObject.pBodyPool = &world.getBodyPool( filePath, rObject.name, 1.f, 1.f, physicsData.getPoolSize() );
+            rObject.pBodyPool->createShapes(
+                physicsData, rObject.size, CSize<float>(1.f, 1.f), 1.f / world.getPixelsPerMeter(), rObject.name );
+
+            rObject.extent = GetExtent( *rObject.pBodyPool );
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  Sort the objects by the part they can play in the patterns
+    *           Sensors and objects without shapes are left out
+    ************************************************************************/
+    SObjectRoles SortRoles( const std::vector<SPhysicsObject> & objectVec )
+    {
+        SObjectRoles roles;
+
+        for( auto & iter : objectVec )
+        {
+            const auto & fixtureVec = iter.physicsData.getFixtureVec();
+            if( (iter.pBodyPool == nullptr) || fixtureVec.empty() || fixtureVec.front().m_sensor || (iter.extent <= 0.f) )
+                continue;
+
+            const b2BodyType type = iter.physicsData.getBodyType();
+            const b2Shape::Type shape = fixtureVec.front().m_shape;
+
+            if( (type == b2_staticBody) && (shape == b2Shape::e_circle) )
+                roles.pegVec.push_back( &iter );
+
+            else if( (type == b2_dynamicBody) && (shape == b2Shape::e_circle) )
+                roles.ballVec.push_back( &iter );
+
+            else if( (type == b2_dynamicBody) && (shape == b2Shape::e_polygon) )
+                roles.boxVec.push_back( &iter );
+        }
+
+        return roles;
+    }
+
+    /************************************************************************
+    *    DESC:  Checksum of the states the world published for the sprites
+    *           and the velocities of the bodies in creation order
+    ************************************************************************/
+    uint64_t BodyChecksum( SScene & scene )
+    {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+
+        for( auto pBody : scene.bodyVec )
+        {
+            const CPhysicsWorld2D::SBodyState & state = *scene.pWorld->getBodyState( pBody );
+
+            const float stateAry[] = {
+                state.prevTransform.p.x, state.prevTransform.p.y,
+                state.transform.p.x, state.transform.p.y, state.transform.q.s, state.transform.q.c, state.angle,
+                pBody->GetLinearVelocity().x, pBody->GetLinearVelocity().y, pBody->GetAngularVelocity() };
+
+            HashBytes( hash, stateAry, sizeof(stateAry) );
+            HashBytes( hash, &state.awake, sizeof(state.awake) );
+        }
+
+        return hash;
+    }
+}
+
+int main( int argc, char* args[] )
+{
+    const std::string pattern = (argc > 1) ? args[1] : "pachinko";
+    const int bodyCount = (argc > 2) ? std::max( std::atoi( args[2] ), 1 ) : 1000;
+    const int frameCount = (argc > 3) ? std::max( std::atoi( args[3] ), 1 ) : 600;
+    const int threadCount = (argc > 4) ? std::max( std::atoi( args[4] ), 0 ) : 0;
+    const std::string physicsFile = (argc > 5) ? args[5] : "data/objects/2d/physics/gamePhysics.cfg";
+    const std::string objectFile = (argc > 6) ? args[6] : "data/objects/2d/objectDataList/level1List.lst";
+
+    try
+    {
+        // The world checks for the thread pool when it loads the threaded settings
+        if( threadCount > 0 )
+            CThreadPool::Instance().init( threadCount, threadCount );
+
+        CBenchWorld world;
+        world.loadFromNode( XMLNode::openFileHelper( physicsFile.c_str(), "physics2d" ) );
+        world.setActive( true );
+        world.EnableContactListener();
+
+        SScene scene;
+        scene.pWorld = &world;
+        scene.up = -world.getWorld().GetGravity();
+        if( scene.up.Normalize() < b2_epsilon )
+            scene.up.Set( 0.f, 1.f );
+        scene.right.Set( scene.up.y, -scene.up.x );
+
+        std::vector<SPhysicsObject> objectVec;
+        LoadObjects( objectFile, world, objectVec );
+        const SObjectRoles roles = SortRoles( objectVec );
+
+        if( pattern == "pachinko" )
+            BuildPachinko( scene, roles, bodyCount );
+        else if( pattern == "stack" )
+            BuildStack( scene, roles, bodyCount );
+        else if( pattern == "balls" )
+            BuildBalls( scene, roles, bodyCount );
+        else
+            throw NExcept::CCriticalException("Physics Bench Error!",
+                boost::str( boost::format("Unknown pattern (%s). Use pachinko, stack or balls.\n\n%s\nLine: %s")
+                    % pattern % __FUNCTION__ % __LINE__ ));
+
+        std::printf( "Pattern: %s, Bodies: %d, Frames: %d, Threads: %d, Parallel islands: %s, Threaded: %s, Wide solver: %s\n",
+            pattern.c_str(), bodyCount, frameCount, threadCount,
+            world.isParallelIslands() ? "on" : "off",
+            world.isThreaded() ? "on" : "off",
+            world.getWorld().GetWideContactSolver() ? "on" : "off" );
+
+        b2Profile total = {};
+        double stepTime = 0;
+
+        for( int frame = 0; frame < frameCount; ++frame )
+        {
+            // Drop the next wave of bodies
+            if( (frame % scene.waveFrames) == 0 )
+            {
+                for( int i = 0; (i < scene.dropsPerWave) && (scene.dropIndex < scene.dropVec.size()); ++i, ++scene.dropIndex )
+                    CreateObjectBody( scene, *scene.dropVec[scene.dropIndex].pObject, scene.dropVec[scene.dropIndex].pos );
+            }
+
+            // Finish the step if it runs on a job so the frame covers all of it
+            const auto start = std::chrono::high_resolution_clock::now();
+            world.fixedTimeStepElapsed( FRAME_TIME );
+            world.syncStep();
+            stepTime += std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - start ).count();
+
+            // The profile is of the last step of the frame
+            const b2Profile & profile = world.getWorld().GetProfile();
+            total.step += profile.step;
+            total.collide += profile.collide;
+            total.solve += profile.solve;
+            total.solveInit += profile.solveInit;
+            total.solveVelocity += profile.solveVelocity;
+            total.solvePosition += profile.solvePosition;
+            total.broadphase += profile.broadphase;
+            total.solveTOI += profile.solveTOI;
+        }
+
+        int awakeCount = 0;
+        for( auto pBody : scene.bodyVec )
+            if( pBody->IsAwake() && (pBody->GetType() != b2_staticBody) )
+                ++awakeCount;
+
+        std::printf( "%-16s %12s %12s\n", "Phase", "Total ms", "Frame ms" );
+
+        const std::pair<const char *, float> phaseAry[] = {
+            { "step", total.step },
+            { "collide", total.collide },
+            { "solve", total.solve },
+            { "solveInit", total.solveInit },
+            { "solveVelocity", total.solveVelocity },
+            { "solvePosition", total.solvePosition },
+            { "broadphase", total.broadphase },
+            { "solveTOI", total.solveTOI } };
+
+        for( auto & iter : phaseAry )
+            std::printf( "%-16s %12.2f %12.4f\n", iter.first, iter.second, iter.second / frameCount );
+
+        std::printf( "%-16s %12.2f %12.4f\n", "wall", stepTime, stepTime / frameCount );
+        std::printf( "Bodies: %d, Awake: %d, Contacts: %d, Listed contacts: %d\n",
+            (int)scene.bodyVec.size(), awakeCount, world.getWorld().GetContactCount(), (int)world.contactCount );
+
+        uint64_t checksum = BodyChecksum( scene );
+        HashBytes( checksum, &world.contactHash, sizeof(world.contactHash) );
+        std::printf( "Checksum: %016llx\n", (unsigned long long)checksum );
+    }
+    catch( NExcept::CCriticalException & ex )
+    {
+        std::printf( "%s\n%s\n", ex.getErrorTitle().c_str(), ex.getErrorMsg().c_str() );
+        return EXIT_FAILURE;
+    }
+
+    CThreadPool::Instance().stop();
+
+    return EXIT_SUCCESS;
+}
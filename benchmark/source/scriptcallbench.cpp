@@ -0,0 +1,180 @@
+
+/************************************************************************
+*    FILE NAME:       scriptcallbench.cpp
+*
+*    DESCRIPTION:     Compares the per call overhead of script bindings
+*                     registered with the generic calling convention
+*                     against the native calling convention
+************************************************************************/
+
+// Game lib dependencies
+#include <common/point.h>
+
+// AngelScript lib dependencies
+#include <angelscript.h>
+#include <autowrapper/aswrappedcall.h>
+
+// Standard lib dependencies
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace
+{
+    /************************************************************************
+    *    DESC:  Object the script calls into
+    ************************************************************************/
+    class CBenchObj
+    {
+    public:
+
+        void inc()
+        { ++m_count; }
+
+        float add( float a, float b )
+        { return a + b; }
+
+        void setPos( const CPoint<float> & pos )
+        { m_pos = pos; }
+
+        CPoint<float> getPos() const
+        { return m_pos; }
+
+        int m_count = 0;
+        CPoint<float> m_pos;
+    };
+
+    CBenchObj bench;
+
+    // Each loop is run for both conventions. The baseline is the empty loop
+    const char * SCRIPT_SOURCE =
+        "void baseline(int count) { for( int i = 0; i < count; ++i ) {} }\n"
+        "void incGeneric(int count) { for( int i = 0; i < count; ++i ) bench.incGeneric(); }\n"
+        "void incNative(int count) { for( int i = 0; i < count; ++i ) bench.incNative(); }\n"
+        "void addGeneric(int count) { float f = 0; for( int i = 0; i < count; ++i ) f = bench.addGeneric(f, 1); }\n"
+        "void addNative(int count) { float f = 0; for( int i = 0; i < count; ++i ) f = bench.addNative(f, 1); }\n"
+        "void posGeneric(int count) { CPoint p; for( int i = 0; i < count; ++i ) { bench.setPosGeneric(p); p = bench.getPosGeneric(); } }\n"
+        "void posNative(int count) { CPoint p; for( int i = 0; i < count; ++i ) { bench.setPosNative(p); p = bench.getPosNative(); } }\n";
+
+    /************************************************************************
+    *    DESC:  Print the engine messages
+    ************************************************************************/
+    void MessageCallback( const asSMessageInfo * pMsg, void * pParam )
+    {
+        std::printf( "%s (%d, %d): %s\n", pMsg->section, pMsg->row, pMsg->col, pMsg->message );
+    }
+
+    /************************************************************************
+    *    DESC:  Exit if the engine returned an error
+    ************************************************************************/
+    void Check( int value, const char * pWhat )
+    {
+        if( value < 0 )
+        {
+            std::printf( "Error %d: %s\n", value, pWhat );
+            std::exit( EXIT_FAILURE );
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  Run the script function and return the time in nanoseconds
+    ************************************************************************/
+    double Run( asIScriptContext * pContext, asIScriptModule * pModule, const char * pFuncName, int count )
+    {
+        asIScriptFunction * pFunc = pModule->GetFunctionByName( pFuncName );
+        if( pFunc == nullptr )
+            Check( asNO_FUNCTION, pFuncName );
+
+        Check( pContext->Prepare( pFunc ), pFuncName );
+        Check( pContext->SetArgDWord( 0, count ), pFuncName );
+
+        const auto start = std::chrono::high_resolution_clock::now();
+
+        if( pContext->Execute() != asEXECUTION_FINISHED )
+            Check( asERROR, pFuncName );
+
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        return std::chrono::duration<double, std::nano>( end - start ).count();
+    }
+}
+
+int main( int argc, char* args[] )
+{
+    int count = 5000000;
+    if( argc > 1 )
+        count = std::max( std::atoi( args[1] ), 1 );
+
+    const bool native = (std::strstr( asGetLibraryOptions(), "AS_MAX_PORTABILITY" ) == nullptr);
+
+    asIScriptEngine * pEngine = asCreateScriptEngine();
+    Check( pEngine->SetMessageCallback( asFUNCTION(MessageCallback), nullptr, asCALL_CDECL ), "Message callback" );
+
+    Check( pEngine->RegisterObjectType( "CPoint", sizeof(CPoint<float>), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<CPoint<float>>() | asOBJ_APP_CLASS_ALLFLOATS ), "CPoint" );
+    Check( pEngine->RegisterObjectProperty( "CPoint", "float x", asOFFSET(CPoint<float>, x) ), "CPoint x" );
+    Check( pEngine->RegisterObjectProperty( "CPoint", "float y", asOFFSET(CPoint<float>, y) ), "CPoint y" );
+    Check( pEngine->RegisterObjectProperty( "CPoint", "float z", asOFFSET(CPoint<float>, z) ), "CPoint z" );
+
+    Check( pEngine->RegisterObjectType( "CBenchObj", 0, asOBJ_REF | asOBJ_NOCOUNT ), "CBenchObj" );
+    Check( pEngine->RegisterObjectMethod( "CBenchObj", "void incGeneric()",                     WRAP_MFN(CBenchObj, inc),    asCALL_GENERIC ), "incGeneric" );
+    Check( pEngine->RegisterObjectMethod( "CBenchObj", "float addGeneric(float, float)",        WRAP_MFN(CBenchObj, add),    asCALL_GENERIC ), "addGeneric" );
+    Check( pEngine->RegisterObjectMethod( "CBenchObj", "void setPosGeneric(const CPoint &in)",  WRAP_MFN(CBenchObj, setPos), asCALL_GENERIC ), "setPosGeneric" );
+    Check( pEngine->RegisterObjectMethod( "CBenchObj", "CPoint getPosGeneric() const",          WRAP_MFN(CBenchObj, getPos), asCALL_GENERIC ), "getPosGeneric" );
+
+    // Fall back to the generic wrappers so the script still builds
+    if( native )
+    {
+        Check( pEngine->RegisterObjectMethod( "CBenchObj", "void incNative()",                    asMETHOD(CBenchObj, inc),    asCALL_THISCALL ), "incNative" );
+        Check( pEngine->RegisterObjectMethod( "CBenchObj", "float addNative(float, float)",       asMETHOD(CBenchObj, add),    asCALL_THISCALL ), "addNative" );
+        Check( pEngine->RegisterObjectMethod( "CBenchObj", "void setPosNative(const CPoint &in)", asMETHOD(CBenchObj, setPos), asCALL_THISCALL ), "setPosNative" );
+        Check( pEngine->RegisterObjectMethod( "CBenchObj", "CPoint getPosNative() const",         asMETHOD(CBenchObj, getPos), asCALL_THISCALL ), "getPosNative" );
+    }
+    else
+    {
+        std::printf( "AngelScript was built with AS_MAX_PORTABILITY. Native results use the generic wrappers.\n" );
+
+        Check( pEngine->RegisterObjectMethod( "CBenchObj", "void incNative()",                    WRAP_MFN(CBenchObj, inc),    asCALL_GENERIC ), "incNative" );
+        Check( pEngine->RegisterObjectMethod( "CBenchObj", "float addNative(float, float)",       WRAP_MFN(CBenchObj, add),    asCALL_GENERIC ), "addNative" );
+        Check( pEngine->RegisterObjectMethod( "CBenchObj", "void setPosNative(const CPoint &in)", WRAP_MFN(CBenchObj, setPos), asCALL_GENERIC ), "setPosNative" );
+        Check( pEngine->RegisterObjectMethod( "CBenchObj", "CPoint getPosNative() const",         WRAP_MFN(CBenchObj, getPos), asCALL_GENERIC ), "getPosNative" );
+    }
+
+    Check( pEngine->RegisterGlobalProperty( "CBenchObj bench", &bench ), "bench" );
+
+    asIScriptModule * pModule = pEngine->GetModule( "bench", asGM_ALWAYS_CREATE );
+    Check( pModule->AddScriptSection( "bench", SCRIPT_SOURCE ), "Script section" );
+    Check( pModule->Build(), "Script build" );
+
+    asIScriptContext * pContext = pEngine->CreateContext();
+
+    // Warm up the caches before timing
+    Run( pContext, pModule, "baseline", count );
+
+    const double baseline = Run( pContext, pModule, "baseline", count );
+
+    std::printf( "Calls per test: %d\n", count );
+    std::printf( "%-24s %12s %12s %8s\n", "Binding", "Generic ns", "Native ns", "Speedup" );
+
+    const char * testAry[][3] = {
+        { "void inc()",                "incGeneric", "incNative" },
+        { "float add(float, float)",   "addGeneric", "addNative" },
+        { "setPos() + getPos()",       "posGeneric", "posNative" } };
+
+    for( auto & iter : testAry )
+    {
+        // The pos test makes two calls per loop
+        const double calls = (std::strcmp( iter[1], "posGeneric" ) == 0) ? count * 2.0 : count;
+
+        const double generic = std::max( Run( pContext, pModule, iter[1], count ) - baseline, 0.0 ) / calls;
+        const double native = std::max( Run( pContext, pModule, iter[2], count ) - baseline, 0.0 ) / calls;
+
+        std::printf( "%-24s %12.2f %12.2f %7.2fx\n", iter[0], generic, native, (native > 0.0) ? generic / native : 0.0 );
+    }
+
+    pContext->Release();
+    pEngine->ShutDownAndRelease();
+
+    return EXIT_SUCCESS;
+}
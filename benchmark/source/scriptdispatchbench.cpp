@@ -0,0 +1,212 @@
+
+/************************************************************************
+*    FILE NAME:       scriptdispatchbench.cpp
+*
+*    DESCRIPTION:     Times the byte code interpreter on loops shaped
+*                     like the game scripts. Build the angelscript lib
+*                     with and without AS_COMPUTED_GOTO to compare the
+*                     dispatch. The checksums must match between builds
+************************************************************************/
+
+// AngelScript lib dependencies
+#include <angelscript.h>
+#include <scriptstdstring/scriptstdstring.h>
+#include <scriptarray/scriptarray.h>
+#include <scriptmath/scriptmath.h>
+
+// Standard lib dependencies
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+    // Each function returns a checksum of the work it did
+    const char * SCRIPT_SOURCE =
+        "class CBall\n"
+        "{\n"
+        "    float x = 0, y = 0, vx = 1.5f, vy = -2.0f;\n"
+        "    bool active = true;\n"
+        "    void update( float elapsed )\n"
+        "    {\n"
+        "        vy += 9.8f * elapsed;\n"
+        "        x += vx * elapsed;\n"
+        "        y += vy * elapsed;\n"
+        "        if( y > 100 ) { y = 100; vy = -vy * 0.5f; }\n"
+        "        if( x < 0 || x > 50 ) vx = -vx;\n"
+        "    }\n"
+        "}\n"
+        "\n"
+        "double intLoop( int count )\n"
+        "{\n"
+        "    int sum = 0;\n"
+        "    for( int i = 0; i < count; ++i )\n"
+        "    {\n"
+        "        if( (i & 3) == 0 ) sum += i; else sum -= 1;\n"
+        "    }\n"
+        "    return sum;\n"
+        "}\n"
+        "\n"
+        "double floatTimer( int count )\n"
+        "{\n"
+        "    double total = 0;\n"
+        "    for( int i = 0; i < count / 100; ++i )\n"
+        "    {\n"
+        "        float time = 1.0f;\n"
+        "        do\n"
+        "        {\n"
+        "            time -= 0.01f;\n"
+        "            if( time < 0 ) total += 1; else total += time * 0.5f;\n"
+        "        }\n"
+        "        while( time > 0 );\n"
+        "    }\n"
+        "    return total;\n"
+        "}\n"
+        "\n"
+        "double objects( int count )\n"
+        "{\n"
+        "    array<CBall@> ballAry;\n"
+        "    for( int i = 0; i < 50; ++i ) ballAry.insertLast( CBall() );\n"
+        "    for( int i = 0; i < count / 50; ++i )\n"
+        "    {\n"
+        "        for( uint b = 0; b < ballAry.length(); ++b )\n"
+        "            if( ballAry[b].active )\n"
+        "                ballAry[b].update( 0.016f );\n"
+        "    }\n"
+        "    double sum = 0;\n"
+        "    for( uint b = 0; b < ballAry.length(); ++b ) sum += ballAry[b].x + ballAry[b].y;\n"
+        "    return sum;\n"
+        "}\n"
+        "\n"
+        "double arrays( int count )\n"
+        "{\n"
+        "    array<int> valAry( 256 );\n"
+        "    for( int i = 0; i < count; ++i )\n"
+        "        valAry[i & 255] += i % 7;\n"
+        "    double sum = 0;\n"
+        "    for( uint i = 0; i < valAry.length(); ++i ) sum += valAry[i];\n"
+        "    return sum;\n"
+        "}\n"
+        "\n"
+        "double strings( int count )\n"
+        "{\n"
+        "    string str;\n"
+        "    double sum = 0;\n"
+        "    for( int i = 0; i < count / 10; ++i )\n"
+        "    {\n"
+        "        str = \"ball_\" + (i % 10);\n"
+        "        if( str == \"ball_3\" ) sum += str.length();\n"
+        "    }\n"
+        "    return sum;\n"
+        "}\n"
+        "\n"
+        "double states( int count )\n"
+        "{\n"
+        "    int state = 0;\n"
+        "    double sum = 0;\n"
+        "    for( int i = 0; i < count; ++i )\n"
+        "    {\n"
+        "        switch( state )\n"
+        "        {\n"
+        "            case 0: state = 1; sum += 1; break;\n"
+        "            case 1: state = 2; sum += 2; break;\n"
+        "            case 2: state = 3; sum -= 1; break;\n"
+        "            default: state = 0; sum += sqrt( float(i & 15) );\n"
+        "        }\n"
+        "    }\n"
+        "    return sum;\n"
+        "}\n";
+
+    /************************************************************************
+    *    DESC:  Print the engine messages
+    ************************************************************************/
+    void MessageCallback( const asSMessageInfo * pMsg, void * pParam )
+    {
+        std::printf( "%s (%d, %d): %s\n", pMsg->section, pMsg->row, pMsg->col, pMsg->message );
+    }
+
+    /************************************************************************
+    *    DESC:  Exit if the engine returned an error
+    ************************************************************************/
+    void Check( int value, const char * pWhat )
+    {
+        if( value < 0 )
+        {
+            std::printf( "Error %d: %s\n", value, pWhat );
+            std::exit( EXIT_FAILURE );
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  Run the script function and return the time in milliseconds
+    ************************************************************************/
+    double Run( asIScriptContext * pContext, asIScriptModule * pModule, const char * pFuncName, int count, double & checksum )
+    {
+        asIScriptFunction * pFunc = pModule->GetFunctionByName( pFuncName );
+        if( pFunc == nullptr )
+            Check( asNO_FUNCTION, pFuncName );
+
+        Check( pContext->Prepare( pFunc ), pFuncName );
+        Check( pContext->SetArgDWord( 0, count ), pFuncName );
+
+        const auto start = std::chrono::high_resolution_clock::now();
+
+        if( pContext->Execute() != asEXECUTION_FINISHED )
+            Check( asERROR, pFuncName );
+
+        const auto end = std::chrono::high_resolution_clock::now();
+
+        checksum = pContext->GetReturnDouble();
+
+        return std::chrono::duration<double, std::milli>( end - start ).count();
+    }
+}
+
+int main( int argc, char* args[] )
+{
+    int count = 2000000;
+    if( argc > 1 )
+        count = std::max( std::atoi( args[1] ), 100 );
+
+    const bool threaded = (std::strstr( asGetLibraryOptions(), "AS_COMPUTED_GOTO" ) != nullptr);
+
+    asIScriptEngine * pEngine = asCreateScriptEngine();
+    Check( pEngine->SetMessageCallback( asFUNCTION(MessageCallback), nullptr, asCALL_CDECL ), "Message callback" );
+
+    // Same as the script manager so the byte code matches the game
+    Check( pEngine->SetEngineProperty( asEP_BUILD_WITHOUT_LINE_CUES, true ), "Line cues" );
+
+    RegisterStdString( pEngine );
+    RegisterScriptArray( pEngine, true );
+    RegisterScriptMath( pEngine );
+
+    asIScriptModule * pModule = pEngine->GetModule( "bench", asGM_ALWAYS_CREATE );
+    Check( pModule->AddScriptSection( "bench", SCRIPT_SOURCE ), "Script section" );
+    Check( pModule->Build(), "Script build" );
+
+    asIScriptContext * pContext = pEngine->CreateContext();
+
+    std::printf( "Iterations per test: %d, Dispatch: %s\n", count, threaded ? "computed goto" : "switch" );
+    std::printf( "%-12s %12s %20s\n", "Test", "ms", "Checksum" );
+
+    const char * testAry[] = { "intLoop", "floatTimer", "objects", "arrays", "strings", "states" };
+
+    for( auto iter : testAry )
+    {
+        double checksum;
+
+        // Warm up the caches before timing. Keep the best of the runs
+        double best = Run( pContext, pModule, iter, count, checksum );
+        for( int i = 0; i < 3; ++i )
+            best = std::min( best, Run( pContext, pModule, iter, count, checksum ) );
+
+        std::printf( "%-12s %12.2f %20.4f\n", iter, best, checksum );
+    }
+
+    pContext->Release();
+    pEngine->ShutDownAndRelease();
+
+    return EXIT_SUCCESS;
+}
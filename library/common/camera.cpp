@@ -14,6 +14,7 @@
 
 // Standard lib dependencies
 #include <cstring>
+#include <limits>
 #include <cstdlib>
 
 /************************************************************************
@@ -396,6 +397,42 @@ bool CCamera::inViewX( const CPoint<float> & transPos, const float radius )
     return true;
 }
 
+/************************************************************************
+*    DESC:  Get the area the culling keeps in view. Returns false if it can't
+*           be defined by a rect, either not culling or a perspective projection
+*           NOTE: Radius of the objects is not included
+************************************************************************/
+bool CCamera::getCullRect( CRect<float> & rect ) const
+{
+    // The perspective view area changes with the distance of the object
+    if( (m_cullType == ECullType::_NULL_) || (m_projType != EProjectionType::ORTHOGRAPHIC) )
+        return false;
+
+    if( (m_scale.x == 0.f) || (m_scale.y == 0.f) )
+        return false;
+
+    const auto & rSizeHalf = CSettings::Instance().getDefaultSizeHalf();
+
+    // Inverse of the inView checks
+    rect.x1 = (-getTransPos().x - rSizeHalf.w) / m_scale.x;
+    rect.x2 = (-getTransPos().x + rSizeHalf.w) / m_scale.x;
+    rect.y1 = (-getTransPos().y - rSizeHalf.h) / m_scale.y;
+    rect.y2 = (-getTransPos().y + rSizeHalf.h) / m_scale.y;
+
+    if( m_cullType == ECullType::CULL_Y_ONLY )
+    {
+        rect.x1 = std::numeric_limits<float>::lowest();
+        rect.x2 = std::numeric_limits<float>::max();
+    }
+    else if( m_cullType == ECullType::CULL_X_ONLY )
+    {
+        rect.y1 = std::numeric_limits<float>::lowest();
+        rect.y2 = std::numeric_limits<float>::max();
+    }
+
+    return true;
+}
+
 /************************************************************************
 *    DESC:  Handle the recording of the command buffers based on culling
 ************************************************************************/
@@ -12,6 +12,7 @@
 // Game lib dependencies
 #include <utilities/matrix.h>
 #include <common/worldvalue.h>
+#include <common/rect.h>
 
 // Vulkan lib dependencies
 #include <system/vulkan.h>
@@ -90,6 +91,11 @@ public:
     // Check if the raduis is in the view frustrum of the X
     bool inViewX( const CPoint<float> & transPos, const float radius );
 
+    // Get the area the culling keeps in view. Returns false if it can't be
+    // defined by a rect, either not culling or a perspective projection
+    // NOTE: Radius of the objects is not included
+    bool getCullRect( CRect<float> & rect ) const;
+
     // Handle the recording of the command buffers based on culling
     void recordCommandBuffer( uint32_t index, VkCommandBuffer cmdBuffer, std::vector<iNode *> & m_pNodeVec );
 
@@ -136,6 +136,13 @@ enum class ECullType
     CULL_Y_ONLY
 };
 
+enum class EActivityPolicy
+{
+    ALWAYS,
+    IN_VIEW,
+    DISTANCE
+};
+
 namespace NOffset
 {
     enum EOffset
@@ -21,6 +21,9 @@ CObject::CObject() :
     m_parameters(VISIBLE),
     m_scale(1,1,1)
 {
+    // All objects start out sharing the same empty map
+    static const std::shared_ptr<const scriptFuncMap_t> spEmptyMap( new scriptFuncMap_t );
+    m_spScriptFunctionMap = spEmptyMap;
 }
 
 CObject::~CObject()
@@ -257,36 +260,58 @@ void CObject::copyTransform( const CObject * pObject )
         setCropOffset( pObject->m_cropOffset );
 }
 
+/************************************************************************
+*    DESC:  Reset the transform back to that of a newly created object
+************************************************************************/
+void CObject::resetTransform()
+{
+    m_parameters.remove( TRANSLATE | ROTATE | SCALE | CENTER_POINT | CROP_OFFSET | PHYSICS_TRANSFORM | WAS_TRANSFORMED );
+    m_parameters.add( VISIBLE | TRANSFORM );
+
+    m_pos.clear();
+    m_rot.clear();
+    m_scale.set( 1, 1, 1 );
+    m_centerPos.clear();
+    m_cropOffset.clear();
+}
+
 /************************************************************************
 *    DESC:  Load the transform data from node
 ************************************************************************/
 void CObject::loadTransFromNode( const XMLNode & node )
 {
-    bool loadedFlag;
+    CTransformData transData;
+    transData.loadFromNode( node );
+
+    applyTransData( transData );
+}
 
+/************************************************************************
+*    DESC:  Apply the transform data compiled from a node
+************************************************************************/
+void CObject::applyTransData( const CTransformData & transData )
+{
     // Set if visible. Is visible by default
-    if( node.isAttributeSet( "visible" ) )
-        setVisible( std::strcmp( node.getAttribute("visible"), "true" ) == 0 );
+    if( transData.m_parameters.isSet( CTransformData::VISIBLE_SET ) )
+        setVisible( transData.m_parameters.isSet( CTransformData::VISIBLE ) );
 
-    CPoint<float> pos = NParseHelper::LoadPosition( node, loadedFlag );
-    if( loadedFlag )
-        setPos( pos );
+    if( transData.m_parameters.isSet( CTransformData::POSITION ) )
+        setPos( transData.m_pos );
 
-    CPoint<float> rot = NParseHelper::LoadRotation( node, loadedFlag );
-    if( loadedFlag )
-        setRot( rot );
+    if( transData.m_parameters.isSet( CTransformData::ROTATION ) )
+        setRot( transData.m_rot, false );
 
-    CPoint<float> scale = NParseHelper::LoadScale( node, loadedFlag );
-    if( loadedFlag )
-        setScale( scale );
+    if( transData.m_parameters.isSet( CTransformData::SCALE ) )
+        setScale( transData.m_scale );
     
-    CPoint<float> centerPos = NParseHelper::LoadCenterPos( node, loadedFlag );
-    if( loadedFlag )
-        setCenterPos( centerPos );
+    if( transData.m_parameters.isSet( CTransformData::CENTER_POS ) )
+        setCenterPos( transData.m_centerPos );
     
-    CDynamicOffset dynamicOffset = NParseHelper::LoadDynamicOffset( node, loadedFlag );
-    if( loadedFlag )
+    if( transData.m_parameters.isSet( CTransformData::DYNAMIC_OFFSET ) )
+    {
+        CDynamicOffset dynamicOffset( transData.m_dynamicOffset );
         setPos( dynamicOffset.getPos() );
+    }
 }
 
 /************************************************************************
@@ -434,9 +459,13 @@ void CObject::forceTransform()
 ************************************************************************/
 void CObject::removeScriptFunction( const std::string & scriptFuncId )
 {
-    auto iter = m_scriptFunctionMap.find( scriptFuncId );
-    if( iter != m_scriptFunctionMap.end() )
-        m_scriptFunctionMap.erase( iter );
+    if( m_spScriptFunctionMap->find( scriptFuncId ) != m_spScriptFunctionMap->end() )
+    {
+        // Copy the map before changing it because it may be shared
+        auto spScriptFunctionMap = std::make_shared<scriptFuncMap_t>( *m_spScriptFunctionMap );
+        spScriptFunctionMap->erase( scriptFuncId );
+        m_spScriptFunctionMap = spScriptFunctionMap;
+    }
 }
 
 /************************************************************************
@@ -450,16 +479,21 @@ void CObject::addScriptFunction(
     const bool forceUpdate,
     const bool overwrite )
 {
-    auto iter = m_scriptFunctionMap.find( scriptFuncId );
-    if( iter != m_scriptFunctionMap.end() )
+    // Copy the map before changing it because it may be shared
+    auto spScriptFunctionMap = std::make_shared<scriptFuncMap_t>( *m_spScriptFunctionMap );
+
+    auto iter = spScriptFunctionMap->find( scriptFuncId );
+    if( iter != spScriptFunctionMap->end() )
     {
         if( !overwrite )
             NGenFunc::PostDebugMsg( boost::str( boost::format("WARNING: Add script function already exists (%s).") %scriptFuncId ) );
-        m_scriptFunctionMap.erase( iter );
+        spScriptFunctionMap->erase( iter );
     }
 
-    m_scriptFunctionMap.emplace( 
+    spScriptFunctionMap->emplace( 
         std::piecewise_construct, std::forward_as_tuple(scriptFuncId), std::forward_as_tuple(group, funcName, prepareOnInit, forceUpdate) );
+
+    m_spScriptFunctionMap = spScriptFunctionMap;
 }
 
 /************************************************************************
@@ -467,7 +501,10 @@ void CObject::addScriptFunction(
 ************************************************************************/
 void CObject::loadScriptFromNode( const XMLNode & node, const std::string & group )
 {
-    NParseHelper::initScriptFunctions( node, m_scriptFunctionMap, group );
+    // Copy the map before changing it because it may be shared
+    auto spScriptFunctionMap = std::make_shared<scriptFuncMap_t>( *m_spScriptFunctionMap );
+    NParseHelper::initScriptFunctions( node, *spScriptFunctionMap, group );
+    m_spScriptFunctionMap = spScriptFunctionMap;
 }
 
 /************************************************************************
@@ -475,9 +512,12 @@ void CObject::loadScriptFromNode( const XMLNode & node, const std::string & grou
 ************************************************************************/
 void CObject::prepareOnInit()
 {
-    for( auto & iter : m_scriptFunctionMap )
+    // Hold a reference in case a script changes the map
+    const auto spScriptFunctionMap( m_spScriptFunctionMap );
+
+    for( auto & iter : *spScriptFunctionMap )
         if( iter.second.prepareOnInit )
-            prepare( iter.first );
+            prepareScriptFunc( iter.second );
 }
 
 /************************************************************************
@@ -485,15 +525,10 @@ void CObject::prepareOnInit()
 ************************************************************************/
 bool CObject::prepare( const std::string & scriptFuncId )
 {
-    auto iter = m_scriptFunctionMap.find( scriptFuncId );
-    if( iter != m_scriptFunctionMap.end() )
+    auto iter = m_spScriptFunctionMap->find( scriptFuncId );
+    if( iter != m_spScriptFunctionMap->end() )
     {
-        m_scriptComponent.prepare( iter->second.group, iter->second.funcName, {this} );
-
-        // Allow the script to execute and return it's context to the queue
-        // for the scripts that don't animate
-        if( iter->second.forceUpdate )
-            m_scriptComponent.update( true );
+        prepareScriptFunc( iter->second );
 
         return true;
     }
@@ -501,13 +536,26 @@ bool CObject::prepare( const std::string & scriptFuncId )
     return false;
 }
 
+/************************************************************************
+*    DESC:  Prepare the script function to run
+************************************************************************/
+void CObject::prepareScriptFunc( const CScriptPrepareFunc & scriptFunc )
+{
+    m_scriptComponent.prepare( scriptFunc.funcHandle, {this} );
+
+    // Allow the script to execute and return it's context to the queue
+    // for the scripts that don't animate
+    if( scriptFunc.forceUpdate )
+        m_scriptComponent.update( true );
+}
+
 /************************************************************************
 *    DESC:  Stop the script and recycle the context
 ************************************************************************/
 bool CObject::stopAndRecycle( const std::string & scriptFuncId )
 {
-    auto iter = m_scriptFunctionMap.find( scriptFuncId );
-    if( iter != m_scriptFunctionMap.end() )
+    auto iter = m_spScriptFunctionMap->find( scriptFuncId );
+    if( iter != m_spScriptFunctionMap->end() )
     {
         m_scriptComponent.stopAndRecycle( iter->second.funcName );
 
@@ -522,8 +570,8 @@ bool CObject::stopAndRecycle( const std::string & scriptFuncId )
 ************************************************************************/
 bool CObject::stopAndRestart( const std::string & scriptFuncId )
 {
-    auto iter = m_scriptFunctionMap.find( scriptFuncId );
-    if( iter != m_scriptFunctionMap.end() )
+    auto iter = m_spScriptFunctionMap->find( scriptFuncId );
+    if( iter != m_spScriptFunctionMap->end() )
     {
         m_scriptComponent.stopAndRestart( iter->second.group, iter->second.funcName, {this} );
 
@@ -542,8 +590,22 @@ bool CObject::stopAndRestart( const std::string & scriptFuncId )
 ************************************************************************/
 void CObject::copyScriptFunctions( const std::map<std::string, CScriptPrepareFunc> & scriptFunctionMap )
 {
+    // Copy the map before changing it because it may be shared
+    auto spScriptFunctionMap = std::make_shared<scriptFuncMap_t>( *m_spScriptFunctionMap );
+
     for( auto & iter : scriptFunctionMap )
-        m_scriptFunctionMap.emplace( iter );
+        spScriptFunctionMap->emplace( iter );
+
+    m_spScriptFunctionMap = spScriptFunctionMap;
+}
+
+/************************************************************************
+*    DESC:  Share the script function map
+*           It's copied if this object changes it
+************************************************************************/
+void CObject::shareScriptFunctions( const std::shared_ptr<const scriptFuncMap_t> & spScriptFunctionMap )
+{
+    m_spScriptFunctionMap = spScriptFunctionMap;
 }
 
 /************************************************************************
@@ -551,5 +613,5 @@ void CObject::copyScriptFunctions( const std::map<std::string, CScriptPrepareFun
 ************************************************************************/
 bool CObject::hasScriptFunctions()
 {
-    return !m_scriptFunctionMap.empty();
+    return !m_spScriptFunctionMap->empty();
 }
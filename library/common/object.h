@@ -13,12 +13,14 @@
 #include <utilities/matrix.h>
 #include <script/scriptcomponent.h>
 #include <script/scriptpreparefunc.h>
+#include <common/transformdata.h>
 
 // Standard lib dependencies
 #include <cstdint>
 #include <string>
 #include <map>
 #include <tuple>
+#include <memory>
 
 // Forward declaration(s)
 struct XMLNode;
@@ -65,6 +67,9 @@ public:
     // Load the transform data from node
     void loadTransFromNode( const XMLNode & node );
 
+    // Apply the transform data compiled from a node
+    void applyTransData( const CTransformData & transData );
+
     // Set/Get the object's position
     void setPos( const CPoint<float> & position );
     void setPos( float x = 0, float y = 0, float z = 0 );
@@ -132,6 +137,9 @@ public: // transform related members
     
     // Copy the transform to the passed in object
     void copyTransform( const CObject * pObject );
+
+    // Reset the transform back to that of a newly created object
+    void resetTransform();
     
     // Get the parameters
     CBitmask<uint16_t> & getParameters();
@@ -176,6 +184,9 @@ public: // script related members
     // Copy over the script functions
     void copyScriptFunctions( const std::map<std::string, CScriptPrepareFunc> & scriptFunctionMap );
 
+    // Share the script function map. It's copied if this object changes it
+    void shareScriptFunctions( const std::shared_ptr<const scriptFuncMap_t> & spScriptFunctionMap );
+
 protected: // transform related members
 
     // Transform the object in local space
@@ -192,6 +203,9 @@ protected: // script related members
     // Load the script functions from node and add them to the map
     void loadScriptFromNode( const XMLNode & node, const std::string & group );
 
+    // Prepare the script function to run
+    void prepareScriptFunc( const CScriptPrepareFunc & scriptFunc );
+
 protected:
     
     // Bitmask settings to record if the object needs to be transformed
@@ -225,5 +239,6 @@ protected: // transform related members
     CScriptComponent m_scriptComponent;
     
     // Script function map. Execute scripts with an id
-    std::map<const std::string, CScriptPrepareFunc> m_scriptFunctionMap;
+    // NOTE: Can be shared so it's copied before it is changed
+    std::shared_ptr<const scriptFuncMap_t> m_spScriptFunctionMap;
 };
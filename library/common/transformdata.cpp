@@ -0,0 +1,58 @@
+
+/************************************************************************
+*    FILE NAME:       transformdata.cpp
+*
+*    DESCRIPTION:     Transform data loaded from an XML node. Compiled
+*                     once so objects can copy it without parsing
+************************************************************************/
+
+// Physical component dependency
+#include <common/transformdata.h>
+
+// Game lib dependencies
+#include <common/defs.h>
+#include <utilities/xmlParser.h>
+#include <utilities/xmlparsehelper.h>
+
+// Standard lib dependencies
+#include <cstring>
+
+/************************************************************************
+*    DESC:  Load the transform data from node
+************************************************************************/
+void CTransformData::loadFromNode( const XMLNode & node )
+{
+    bool loadedFlag;
+
+    // Set if visible. Is visible by default
+    if( node.isAttributeSet( "visible" ) )
+    {
+        m_parameters.add( VISIBLE_SET );
+
+        if( std::strcmp( node.getAttribute("visible"), "true" ) == 0 )
+            m_parameters.add( VISIBLE );
+    }
+
+    m_pos = NParseHelper::LoadPosition( node, loadedFlag );
+    if( loadedFlag )
+        m_parameters.add( POSITION );
+
+    m_rot = NParseHelper::LoadRotation( node, loadedFlag );
+    if( loadedFlag )
+    {
+        m_parameters.add( ROTATION );
+        m_rot *= defs_DEG_TO_RAD;
+    }
+
+    m_scale = NParseHelper::LoadScale( node, loadedFlag );
+    if( loadedFlag )
+        m_parameters.add( SCALE );
+
+    m_centerPos = NParseHelper::LoadCenterPos( node, loadedFlag );
+    if( loadedFlag )
+        m_parameters.add( CENTER_POS );
+
+    m_dynamicOffset = NParseHelper::LoadDynamicOffset( node, loadedFlag );
+    if( loadedFlag )
+        m_parameters.add( DYNAMIC_OFFSET );
+}
@@ -0,0 +1,60 @@
+
+/************************************************************************
+*    FILE NAME:       transformdata.h
+*
+*    DESCRIPTION:     Transform data loaded from an XML node. Compiled
+*                     once so objects can copy it without parsing
+************************************************************************/
+
+#pragma once
+
+// Game lib dependencies
+#include <common/point.h>
+#include <common/dynamicoffset.h>
+#include <utilities/bitmask.h>
+
+// Standard lib dependencies
+#include <cstdint>
+
+// Forward declaration(s)
+struct XMLNode;
+
+class CTransformData
+{
+public:
+
+    enum
+    {
+        NONE            = 0x00,
+        VISIBLE_SET     = 0x01,
+        VISIBLE         = 0x02,
+        POSITION        = 0x04,
+        ROTATION        = 0x08,
+        SCALE           = 0x10,
+        CENTER_POS      = 0x20,
+        DYNAMIC_OFFSET  = 0x40
+    };
+
+    // Load the transform data from node
+    void loadFromNode( const XMLNode & node );
+
+public:
+
+    // Bitmask of the loaded parameters
+    CBitmask<uint8_t> m_parameters;
+
+    // Position
+    CPoint<float> m_pos;
+
+    // Rotation stored in radians
+    CPoint<float> m_rot;
+
+    // Scale
+    CPoint<float> m_scale;
+
+    // The center point
+    CPoint<float> m_centerPos;
+
+    // Dynamic offset. Resolved when applied
+    CDynamicOffset m_dynamicOffset;
+};
@@ -758,13 +758,13 @@ void CMenu::onTransOut( const SDL_Event & rEvent )
 ************************************************************************/
 bool CMenu::prepare( const std::string & scriptFuncId, uint type, int code )
 {
-    auto iter = m_scriptFunctionMap.find( scriptFuncId );
-    if( iter != m_scriptFunctionMap.end() )
+    auto iter = m_spScriptFunctionMap->find( scriptFuncId );
+    if( iter != m_spScriptFunctionMap->end() )
     {
         if( scriptFuncId == "event" )
-            m_scriptComponent.prepare( iter->second.group, iter->second.funcName, {this, type, code} );
+            m_scriptComponent.prepare( iter->second.funcHandle, {this, type, code} );
         else
-            m_scriptComponent.prepare( iter->second.group, iter->second.funcName, {this} );
+            m_scriptComponent.prepare( iter->second.funcHandle, {this} );
         
         // Force an update
         if( iter->second.forceUpdate )
@@ -661,13 +661,13 @@ void CUIControl::prepareControlScriptFunction( EControlState controlState, uint
         break;
     };
 
-    auto iter = m_scriptFunctionMap.find( scriptFuncMapKey );
-    if( iter != m_scriptFunctionMap.end() )
+    auto iter = m_spScriptFunctionMap->find( scriptFuncMapKey );
+    if( iter != m_spScriptFunctionMap->end() )
     {
         if( controlState == EControlState::EVENT )
-            m_scriptComponent.prepare( iter->second.group, iter->second.funcName, {this, type, code} );
+            m_scriptComponent.prepare( iter->second.funcHandle, {this, type, code} );
         else
-            m_scriptComponent.prepare( iter->second.group, iter->second.funcName, {this} );
+            m_scriptComponent.prepare( iter->second.funcHandle, {this} );
         
         // Force an update
         if( iter->second.forceUpdate )
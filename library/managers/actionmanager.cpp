@@ -11,6 +11,7 @@
 // Game lib dependencies
 #include <utilities/genfunc.h>
 #include <gui/uidefs.h>
+#include <script/scriptscheduler.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
@@ -859,6 +860,9 @@ void CActionMgr::queueEvent( const SDL_Event & rEvent )
 {
     m_eventQueue.emplace_back( rEvent );
 
+    // Wake up the scripts waiting on this event
+    CScriptScheduler::Instance().signalEvent( rEvent.type );
+
     if( rEvent.type == SDL_EVENT_MOUSE_MOTION )
     {
         m_mouseAbsolutePos.x = rEvent.motion.x;
@@ -8,8 +8,29 @@
 // Physical component dependency
 #include <node/inode.h>
 
+// Game lib dependencies
+#include <node/nodearena.h>
+
+// Standard lib dependencies
+#include <new>
+
 std::atomic<handle16_t> iNode::m_hAtomicIter = defs_DEFAULT_HANDLE;
 
+// Header placed in front of each node to know where it was allocated from
+class CNodeAllocHeader
+{
+public:
+
+    // Arena the node was allocated from. nullptr if from the heap
+    CNodeArena * pArena;
+
+    // Size of the allocation including this header
+    size_t size;
+};
+
+// Size of the header rounded up to keep the node aligned
+const size_t NODE_HEADER_SIZE = (sizeof(CNodeAllocHeader) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
 // Dummy reuseable variables
 float dummyRadius = 0.f;
 CSize<float> dummySize;
@@ -30,6 +51,54 @@ iNode::iNode( uint8_t nodeId, uint8_t parentId ) :
 iNode::~iNode()
 {}
 
+/************************************************************************
+*    DESC:  Allocate the node from the heap
+************************************************************************/
+void * iNode::operator new( size_t size )
+{
+    auto pHeader = static_cast<CNodeAllocHeader *>(::operator new( size + NODE_HEADER_SIZE ));
+    pHeader->pArena = nullptr;
+    pHeader->size = size + NODE_HEADER_SIZE;
+
+    return reinterpret_cast<char *>(pHeader) + NODE_HEADER_SIZE;
+}
+
+/************************************************************************
+*    DESC:  Allocate the node from an arena
+************************************************************************/
+void * iNode::operator new( size_t size, CNodeArena & rArena )
+{
+    auto pHeader = static_cast<CNodeAllocHeader *>(rArena.allocate( size + NODE_HEADER_SIZE ));
+    pHeader->pArena = &rArena;
+    pHeader->size = size + NODE_HEADER_SIZE;
+
+    return reinterpret_cast<char *>(pHeader) + NODE_HEADER_SIZE;
+}
+
+/************************************************************************
+*    DESC:  Free the node back to where it was allocated from
+************************************************************************/
+void iNode::operator delete( void * pMem )
+{
+    if( pMem != nullptr )
+    {
+        auto pHeader = reinterpret_cast<CNodeAllocHeader *>(static_cast<char *>(pMem) - NODE_HEADER_SIZE);
+
+        if( pHeader->pArena != nullptr )
+            pHeader->pArena->free( pHeader, pHeader->size );
+        else
+            ::operator delete( pHeader );
+    }
+}
+
+/************************************************************************
+*    DESC:  Only called if the constructor throws when using an arena
+************************************************************************/
+void iNode::operator delete( void * pMem, CNodeArena & rArena )
+{
+    iNode::operator delete( pMem );
+}
+
 /***************************************************************************
 *    DESC:  Only called after node creation to indicate head node
 ****************************************************************************/
@@ -22,6 +22,7 @@
 #include <system/vulkan.h>
 
 // Forward declaration(s)
+class CNodeArena;
 class CSprite;
 class CCamera;
 class CObject;
@@ -39,6 +40,14 @@ public:
     // Destructor
     virtual ~iNode();
 
+    // Allocate the node from the heap or an arena
+    static void * operator new( size_t size );
+    static void * operator new( size_t size, CNodeArena & rArena );
+
+    // Free the node back to where it was allocated from
+    static void operator delete( void * pMem );
+    static void operator delete( void * pMem, CNodeArena & rArena );
+
     // Only called after node creation with all it's children
     virtual void init();
 
@@ -54,8 +63,9 @@ public:
     virtual bool addNode( iNode * pNode )
     { return false; }
     
-    // Push back node into vector
-    virtual void pushBackNode( iNode * pNode ){}
+    // Push back node into vector. Returns false if the node can't have children
+    virtual bool pushBackNode( iNode * pNode )
+    { return false; }
 
     // Find the parent
     // NOTE: This is a recursive function
@@ -73,6 +83,10 @@ public:
     handle16_t getHandle() const
     { return m_handle; }
 
+    // Assign a new handle. Used when a pooled node is reused
+    void newHandle()
+    { m_handle = m_hAtomicIter++; }
+
     // Get the user id number
     int getId() const
     { return m_userId; }
@@ -59,20 +59,19 @@ bool CNode::addNode( iNode * pNode )
 
     // Add the node
     if( pParentNode != nullptr )
-        pParentNode->pushBackNode( pNode );
+        return pParentNode->pushBackNode( pNode );
 
-    else
-        return false;
-
-    return true;
+    return false;
 }
 
 /************************************************************************
 *    DESC:  Push back node into vector
 ************************************************************************/
-void CNode::pushBackNode( iNode * pNode )
+bool CNode::pushBackNode( iNode * pNode )
 {
     m_nodeVec.push_back( pNode );
+
+    return true;
 }
 
 /************************************************************************
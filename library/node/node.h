@@ -49,8 +49,8 @@ public:
     // NOTE: This is a recursive function
     iNode * findChild( const uint16_t childId ) override;
     
-    // Push back node into vector
-    void pushBackNode( iNode * pNode ) override;
+    // Push back node into vector. Returns false if the node can't have children
+    bool pushBackNode( iNode * pNode ) override;
 
 protected:
 
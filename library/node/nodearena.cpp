@@ -0,0 +1,149 @@
+
+/************************************************************************
+*    FILE NAME:       nodearena.cpp
+*
+*    DESCRIPTION:     Arena the strategy allocates it's nodes from.
+*                     Memory is carved out of large blocks and freed
+*                     memory is kept on free lists by size. All the
+*                     blocks are released in one reset
+************************************************************************/
+
+// Physical component dependency
+#include <node/nodearena.h>
+
+// Game lib dependencies
+#include <utilities/exceptionhandling.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <new>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CNodeArena::CNodeArena( size_t blockSize ) :
+    m_blockSize( align(blockSize) ),
+    m_pCurBlock( nullptr ),
+    m_blockOffset( 0 ),
+    m_allocCount( 0 ),
+    m_reservedSize( 0 )
+{
+}
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CNodeArena::~CNodeArena()
+{
+    for( auto iter : m_pBlockVec )
+        ::operator delete( iter );
+}
+
+/************************************************************************
+*    DESC:  Round the size up to the alignment
+************************************************************************/
+size_t CNodeArena::align( size_t size )
+{
+    const size_t alignment = alignof(std::max_align_t);
+
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+/************************************************************************
+*    DESC:  Allocate memory from the arena
+************************************************************************/
+void * CNodeArena::allocate( size_t size )
+{
+    size = align( size );
+
+    ++m_allocCount;
+
+    // Reuse freed memory of the same size
+    auto iter = m_freeListMap.find( size );
+    if( (iter != m_freeListMap.end()) && (iter->second != nullptr) )
+    {
+        void * pMem = iter->second;
+        iter->second = *static_cast<void **>(pMem);
+
+        return pMem;
+    }
+
+    // Allocations bigger than a block get a block of their own
+    if( size > m_blockSize )
+    {
+        char * pBlock = static_cast<char *>(::operator new( size ));
+        m_pBlockVec.push_back( pBlock );
+        m_reservedSize += size;
+
+        return pBlock;
+    }
+
+    // Start a new block if this one is used up
+    if( (m_pCurBlock == nullptr) || (m_blockOffset + size > m_blockSize) )
+    {
+        m_pCurBlock = static_cast<char *>(::operator new( m_blockSize ));
+        m_pBlockVec.push_back( m_pCurBlock );
+        m_reservedSize += m_blockSize;
+        m_blockOffset = 0;
+    }
+
+    void * pMem = m_pCurBlock + m_blockOffset;
+    m_blockOffset += size;
+
+    return pMem;
+}
+
+/************************************************************************
+*    DESC:  Return memory to the arena
+************************************************************************/
+void CNodeArena::free( void * pMem, size_t size )
+{
+    if( pMem != nullptr )
+    {
+        // Push it on the front of the free list for this size
+        void *& pHead = m_freeListMap[ align(size) ];
+        *static_cast<void **>(pMem) = pHead;
+        pHead = pMem;
+
+        --m_allocCount;
+    }
+}
+
+/************************************************************************
+*    DESC:  Release all the blocks at once
+*           NOTE: Only allowed when all the allocations have been freed
+************************************************************************/
+void CNodeArena::reset()
+{
+    if( m_allocCount > 0 )
+        throw NExcept::CCriticalException("Node Arena Error!",
+            boost::str( boost::format("Arena reset with allocations still in use (%d).\n\n%s\nLine: %s")
+                % m_allocCount % __FUNCTION__ % __LINE__ ));
+
+    for( auto iter : m_pBlockVec )
+        ::operator delete( iter );
+
+    m_pBlockVec.clear();
+    m_freeListMap.clear();
+    m_pCurBlock = nullptr;
+    m_blockOffset = 0;
+    m_reservedSize = 0;
+}
+
+/************************************************************************
+*    DESC:  Get the number of allocations not yet freed
+************************************************************************/
+size_t CNodeArena::getAllocCount() const
+{
+    return m_allocCount;
+}
+
+/************************************************************************
+*    DESC:  Get the number of bytes held in blocks
+************************************************************************/
+size_t CNodeArena::getReservedSize() const
+{
+    return m_reservedSize;
+}
@@ -0,0 +1,74 @@
+
+/************************************************************************
+*    FILE NAME:       nodearena.h
+*
+*    DESCRIPTION:     Arena the strategy allocates it's nodes from.
+*                     Memory is carved out of large blocks and freed
+*                     memory is kept on free lists by size. All the
+*                     blocks are released in one reset
+************************************************************************/
+
+#pragma once
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <cstddef>
+#include <vector>
+#include <map>
+
+class CNodeArena : boost::noncopyable
+{
+public:
+
+    // Constructor
+    CNodeArena( size_t blockSize = 64 * 1024 );
+
+    // Destructor
+    virtual ~CNodeArena();
+
+    // Allocate memory from the arena
+    void * allocate( size_t size );
+
+    // Return memory to the arena
+    void free( void * pMem, size_t size );
+
+    // Release all the blocks at once
+    // NOTE: Only allowed when all the allocations have been freed
+    void reset();
+
+    // Get the number of allocations not yet freed
+    size_t getAllocCount() const;
+
+    // Get the number of bytes held in blocks
+    size_t getReservedSize() const;
+
+private:
+
+    // Round the size up to the alignment
+    static size_t align( size_t size );
+
+private:
+
+    // Size of the blocks to carve allocations out of
+    const size_t m_blockSize;
+
+    // Blocks of memory
+    std::vector<char *> m_pBlockVec;
+
+    // Block allocations are carved out of
+    char * m_pCurBlock;
+
+    // Offset into the current block
+    size_t m_blockOffset;
+
+    // Free lists by allocation size
+    std::map<size_t, void *> m_freeListMap;
+
+    // Number of allocations not yet freed
+    size_t m_allocCount;
+
+    // Number of bytes held in blocks
+    size_t m_reservedSize;
+};
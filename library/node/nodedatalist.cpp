@@ -24,8 +24,10 @@ CNodeDataList::CNodeDataList(
     const XMLNode & xmlNode,
     const std::string & _defGroup,
     const std::string & _defObjName,
-    int userId ) :
-        m_idCounter(defs_DEFAULT_NODE_ID)
+    int userId,
+    int poolSize ) :
+        m_idCounter(defs_DEFAULT_NODE_ID),
+        m_poolSize(poolSize)
 {
     std::string defGroup(_defGroup), defObjName(_defObjName), nodeName;
 
@@ -46,6 +48,10 @@ CNodeDataList::CNodeDataList(
     if( xmlNode.isAttributeSet( "id" ) )
         userId = std::atoi(xmlNode.getAttribute( "id" ));
 
+    // Get the number of destroyed nodes to park for reuse
+    if( xmlNode.isAttributeSet( "poolSize" ) )
+        m_poolSize = std::atoi(xmlNode.getAttribute( "poolSize" ));
+
     // Make sure user id doesn't exceed the value of a 16 bit integer
     if( userId < INT16_MIN || userId > INT16_MAX )
         throw NExcept::CCriticalException("Node Data List Error!",
@@ -70,7 +76,9 @@ CNodeDataList::CNodeDataList(
 ************************************************************************/
 CNodeDataList::CNodeDataList(
     const std::string & group,
-    const std::string & objName )
+    const std::string & objName ) :
+        m_idCounter(defs_DEFAULT_NODE_ID),
+        m_poolSize(0)
 {
     m_dataVec.emplace_back( group, objName );
 }
@@ -110,3 +118,11 @@ const std::vector<CNodeData> & CNodeDataList::getData() const
 {
     return m_dataVec;
 }
+
+/************************************************************************
+*    DESC:  Get the max number of nodes to park for reuse
+************************************************************************/
+int CNodeDataList::getPoolSize() const
+{
+    return m_poolSize;
+}
@@ -28,7 +28,8 @@ public:
         const XMLNode & xmlNode,
         const std::string & _defGroup,
         const std::string & _defObjName,
-        int userId = defs_DEFAULT_ID );
+        int userId = defs_DEFAULT_ID,
+        int poolSize = 0 );
 
     // Constructor for dynamic node data generation for sprite creation
     CNodeDataList(
@@ -41,6 +42,9 @@ public:
     // Get the node data
     const std::vector<CNodeData> & getData() const;
 
+    // Get the max number of nodes to park for reuse
+    int getPoolSize() const;
+
 private:
     
     // Load the node data recursively
@@ -55,6 +59,9 @@ private:
     
     // id counter
     int m_idCounter;
+
+    // Max number of destroyed nodes to park for reuse
+    int m_poolSize;
     
     // Vector of the node data
     std::vector<CNodeData> m_dataVec;
@@ -18,21 +18,37 @@
 #include <node/uicontrolnode.h>
 #include <node/nodedata.h>
 #include <node/inode.h>
+#include <node/nodearena.h>
 #include <gui/uimeter.h>
 #include <gui/uiprogressbar.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
 
+// Standard lib dependencies
+#include <utility>
+
 namespace NNodeFactory
 {
     // Declare the function prototypes
-    iNode * CreateUIControlNode( const CNodeData & rNodeData );
+    iNode * CreateUIControlNode( const CNodeData & rNodeData, CNodeArena * pArena );
+
+    /************************************************************************
+    *    DESC:  Allocate the node from the arena if there is one
+    ************************************************************************/
+    template <typename T, typename... Args>
+    iNode * Allocate( CNodeArena * pArena, Args &&... args )
+    {
+        if( pArena != nullptr )
+            return new( *pArena ) T( std::forward<Args>(args)... );
+
+        return new T( std::forward<Args>(args)... );
+    }
     
     /************************************************************************
     *    DESC:  Create the node from the node data list
     ************************************************************************/
-    iNode * Create( const CNodeData & rNodeData )
+    iNode * Create( const CNodeData & rNodeData, CNodeArena * pArena )
     {
         iNode * pNode(nullptr);
 
@@ -40,17 +56,17 @@ namespace NNodeFactory
         if( rNodeData.getNodeType() == ENodeType::SPRITE )
         {
             if( rNodeData.hasChildrenNodes() )
-                pNode = new CSpriteNode( rNodeData );
+                pNode = Allocate<CSpriteNode>( pArena, rNodeData );
             else
-                pNode = new CSpriteLeafNode( rNodeData );
+                pNode = Allocate<CSpriteLeafNode>( pArena, rNodeData );
         }
         else if( rNodeData.getNodeType() == ENodeType::OBJECT )
         {
-            pNode = new CObjectNode( rNodeData );
+            pNode = Allocate<CObjectNode>( pArena, rNodeData );
         }
         else if( rNodeData.getNodeType() == ENodeType::UI_CONTROL )
         {
-            pNode = CreateUIControlNode( rNodeData );
+            pNode = CreateUIControlNode( rNodeData, pArena );
         }
         else
         {
@@ -65,7 +81,7 @@ namespace NNodeFactory
     /************************************************************************
     *    DESC:  Create the UI Control node
     ************************************************************************/
-    iNode * CreateUIControlNode( const CNodeData & rNodeData )
+    iNode * CreateUIControlNode( const CNodeData & rNodeData, CNodeArena * pArena )
     {
         std::unique_ptr<CUIControl> upControl;
         iNode * pNode(nullptr);
@@ -86,9 +102,9 @@ namespace NNodeFactory
         }
 
         if( rNodeData.hasChildrenNodes() )
-            pNode = new CUIControlNode( std::move(upControl), rNodeData );
+            pNode = Allocate<CUIControlNode>( pArena, std::move(upControl), rNodeData );
         else
-            pNode = new CUIControlLeafNode( std::move(upControl), rNodeData );
+            pNode = Allocate<CUIControlLeafNode>( pArena, std::move(upControl), rNodeData );
 
         return pNode;
     }
@@ -9,9 +9,11 @@
 // Forward declaration(s)
 class iNode;
 class CNodeData;
+class CNodeArena;
 
 namespace NNodeFactory
 {
     // Create the control
-    iNode * Create( const CNodeData & rNodeData );
+    // NOTE: Allocated from the heap if no arena is passed in
+    iNode * Create( const CNodeData & rNodeData, CNodeArena * pArena = nullptr );
 };
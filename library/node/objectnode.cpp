@@ -30,11 +30,11 @@ CObjectNode::CObjectNode( const CNodeData & rNodeData ) :
     if( !rNodeData.getNodeName().empty() )
         m_crcUserId = NGenFunc::CalcCRC16( rNodeData.getNodeName() );
 
-    // Load the transforms from XML node
-    CObject::loadTransFromNode( rNodeData.getXMLNode() );
+    // Load the transforms from the compiled node data
+    CObject::applyTransData( rNodeData.getTransData() );
 
-    // Load the script functions
-    CObject::loadScriptFromNode( rNodeData.getXMLNode(), rNodeData.getGroup() );
+    // Share the compiled script functions
+    CObject::shareScriptFunctions( rNodeData.getScriptFunctions() );
 
     // Prepare any script functions that are flagged to prepareOnInit
     CObject::prepareOnInit();
@@ -48,7 +48,7 @@ CObjectNode::~CObjectNode()
 ****************************************************************************/
 void CObjectNode::init()
 {
-    iNode::init();
+    CRenderNode::init();
 
     calcSize(this, m_size);
 
@@ -31,80 +31,76 @@ CRenderNode::~CRenderNode()
 {}
 
 /***************************************************************************
-*    DESC:  Update the nodes.
+*    DESC:  Only called after node creation with all it's children
 ****************************************************************************/
-void CRenderNode::update()
+void CRenderNode::init()
 {
-    update( this );
+    iNode::init();
+
+    // Build the depth first array of the children
+    m_flatNodeVec.clear();
+    flatten( this );
 }
 
-void CRenderNode::update( iNode * pNode )
-    {
-    if( pNode != nullptr )
+/***************************************************************************
+*    DESC:  Add the children to the depth first array
+*           NOTE: This is a recursive function
+****************************************************************************/
+void CRenderNode::flatten( iNode * pNode )
+{
+    iNode * pNextNode;
+    auto nodeIter = pNode->getNodeIter();
+
+    do
     {
-        iNode * pNextNode;
-        auto nodeIter = pNode->getNodeIter();
+        // get the next node
+        pNextNode = pNode->next(nodeIter);
 
-        do
+        if( pNextNode != nullptr )
         {
-            // get the next node
-            pNextNode = pNode->next(nodeIter);
-
-            if( pNextNode != nullptr )
-            {
-                // Update the children
-                if( pNextNode->getType() == ENodeType::SPRITE )
-                {
-                    pNextNode->getSprite()->physicsUpdate();
-                    pNextNode->getSprite()->update();
-                }
-                else if( pNextNode->getType() == ENodeType::UI_CONTROL )
-                {
-                    pNextNode->getControl()->update();
-                }
-                
-                // Call a recursive function again
-                update( pNextNode );
-            }
+            m_flatNodeVec.emplace_back( pNextNode, pNode );
+
+            // Call a recursive function again
+            flatten( pNextNode );
         }
-        while( pNextNode != nullptr );
     }
+    while( pNextNode != nullptr );
 }
 
 /***************************************************************************
-*    DESC:  Translate the nodes
+*    DESC:  Update the nodes.
 ****************************************************************************/
-void CRenderNode::transform()
+void CRenderNode::update()
 {
-    transform( this );
+    for( auto & iter : m_flatNodeVec )
+    {
+        // Update the children
+        if( iter.pNode->getType() == ENodeType::SPRITE )
+        {
+            iter.pNode->getSprite()->physicsUpdate();
+            iter.pNode->getSprite()->update();
+        }
+        else if( iter.pNode->getType() == ENodeType::UI_CONTROL )
+        {
+            iter.pNode->getControl()->update();
+        }
+    }
 }
 
-void CRenderNode::transform( iNode * pNode )
+/***************************************************************************
+*    DESC:  Translate the nodes
+*           NOTE: Parents are always ahead of their children in the array
+****************************************************************************/
+void CRenderNode::transform()
 {
-    if( pNode != nullptr )
+    for( auto & iter : m_flatNodeVec )
     {
-        iNode * pNextNode;
-        auto nodeIter = pNode->getNodeIter();
-
-        do
-        {
-            // get the next node
-            pNextNode = pNode->next(nodeIter);
-
-            if( pNextNode != nullptr )
-            {
-                // Transform the object
-                if( pNextNode->getType() == ENodeType::UI_CONTROL )
-                    pNextNode->getControl()->transform( *pNode->getObject() );
-                    
-                else
-                    pNextNode->getObject()->transform( *pNode->getObject() );
-
-                // Call a recursive function again
-                transform( pNextNode );
-            }
-        }
-        while( pNextNode != nullptr );
+        // Transform the object
+        if( iter.pNode->getType() == ENodeType::UI_CONTROL )
+            iter.pNode->getControl()->transform( *iter.pParent->getObject() );
+            
+        else
+            iter.pNode->getObject()->transform( *iter.pParent->getObject() );
     }
 }
 
@@ -114,35 +110,14 @@ void CRenderNode::transform( iNode * pNode )
 ****************************************************************************/
 void CRenderNode::recordCommandBuffer( uint32_t index, VkCommandBuffer cmdBuffer, const CCamera & camera )
 {
-    recordCommandBuffer( this, index, cmdBuffer, camera );
-}
-
-void CRenderNode::recordCommandBuffer( iNode * pNode, uint32_t index, VkCommandBuffer cmdBuffer, const CCamera & camera )
-{
-    if( pNode != nullptr )
+    for( auto & iter : m_flatNodeVec )
     {
-        iNode * pNextNode;
-        auto nodeIter = pNode->getNodeIter();
-
-        do
-        {
-            // get the next node
-            pNextNode = pNode->next(nodeIter);
-
-            if( pNextNode != nullptr )
-            {
-                // Record the command buffer
-                if( pNextNode->getType() == ENodeType::SPRITE )
-                    pNextNode->getSprite()->recordCommandBuffer( index, cmdBuffer, camera );
-
-                else if( pNextNode->getType() == ENodeType::UI_CONTROL )
-                    pNextNode->getControl()->recordCommandBuffer( index, cmdBuffer, camera );
+        // Record the command buffer
+        if( iter.pNode->getType() == ENodeType::SPRITE )
+            iter.pNode->getSprite()->recordCommandBuffer( index, cmdBuffer, camera );
 
-                // Call a recursive function again
-                recordCommandBuffer( pNextNode, index, cmdBuffer, camera );
-            }
-        }
-        while( pNextNode != nullptr );
+        else if( iter.pNode->getType() == ENodeType::UI_CONTROL )
+            iter.pNode->getControl()->recordCommandBuffer( index, cmdBuffer, camera );
     }
 }
 
@@ -152,31 +127,10 @@ void CRenderNode::recordCommandBuffer( iNode * pNode, uint32_t index, VkCommandB
 ****************************************************************************/
 void CRenderNode::destroyPhysics()
 {
-    destroyPhysics( this );
-}
-
-void CRenderNode::destroyPhysics( iNode * pNode )
-{
-    if( pNode != nullptr )
+    for( auto & iter : m_flatNodeVec )
     {
-        iNode * pNextNode;
-        auto nodeIter = pNode->getNodeIter();
-
-        do
-        {
-            // get the next node
-            pNextNode = pNode->next(nodeIter);
-
-            if( pNextNode != nullptr )
-            {
-                // If this is a sprite, destroy the physics
-                if( pNextNode->getType() == ENodeType::SPRITE )
-                    pNextNode->getSprite()->destroyPhysics();
-                
-                // Call a recursive function again
-                destroyPhysics( pNextNode );
-            }
-        }
-        while( pNextNode != nullptr );
+        // If this is a sprite, destroy the physics
+        if( iter.pNode->getType() == ENodeType::SPRITE )
+            iter.pNode->getSprite()->destroyPhysics();
     }
 }
\ No newline at end of file
@@ -13,6 +13,24 @@
 
 // Standard lib dependencies
 #include <string>
+#include <vector>
+
+// Entry of the depth first array of the nodes under the head node
+class CFlatNode
+{
+public:
+
+    CFlatNode( iNode * pNod, iNode * pPar ) :
+        pNode(pNod),
+        pParent(pPar)
+    {}
+
+    // The node
+    iNode * pNode;
+
+    // The parent of the node
+    iNode * pParent;
+};
 
 class CRenderNode : public CNode
 {
@@ -23,6 +41,9 @@ public:
 
     // Destructor
     virtual ~CRenderNode();
+
+    // Only called after node creation with all it's children
+    virtual void init() override;
     
     // Update the nodes
     virtual void update() override;
@@ -39,15 +60,13 @@ public:
     
 private:
     
-    // Update the nodes
-    void update( iNode * pNode );
-    
-    // Update the nodes recursive function
-    void transform( iNode * pNode );
-    
-    // Record command buffer recursive function
-    void recordCommandBuffer( iNode * pNode, uint32_t index, VkCommandBuffer cmdBuffer, const CCamera & camera );
+    // Add the children to the depth first array
+    // NOTE: This is a recursive function
+    void flatten( iNode * pNode );
 
-    // Destroy the physics
-    void destroyPhysics( iNode * pNode );
+private:
+
+    // Depth first array of the nodes under the head node
+    // NOTE: Built when the head node is initialized
+    std::vector<CFlatNode> m_flatNodeVec;
 };
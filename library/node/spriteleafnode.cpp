@@ -31,8 +31,8 @@ CSpriteLeafNode::CSpriteLeafNode( const CNodeData & rNodeData ) :
     if( !rNodeData.getNodeName().empty() )
         m_crcUserId = NGenFunc::CalcCRC16( rNodeData.getNodeName() );
 
-    // Load the rest from XML node
-    CSprite::load( rNodeData.getXMLNode() );
+    // Load the rest from the compiled node data
+    CSprite::load( rNodeData );
 
     // Init the physics
     CSprite::initPhysics();
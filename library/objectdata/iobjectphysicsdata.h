@@ -131,6 +131,10 @@ public:
     // Is sleeping allowed?
     virtual bool allowSleep() const
     { return true; }
+
+    // Get the max number of destroyed bodies parked for reuse
+    virtual int getPoolSize() const
+    { return 0; }
     
 private:
     
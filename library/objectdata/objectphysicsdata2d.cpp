@@ -28,7 +28,8 @@ CObjectPhysicsData2D::CObjectPhysicsData2D() :
     m_angularDamping(0),
     m_fixedRotation(false),
     m_bullet(false),
-    m_sleepingAllowed(true)
+    m_sleepingAllowed(true),
+    m_poolSize(0)
 {
 }
 
@@ -54,6 +55,10 @@ void CObjectPhysicsData2D::loadFromNode( const XMLNode & objectNode )
         if( physicsNode.isAttributeSet( "world" ) )
             m_world = physicsNode.getAttribute( "world" );
 
+        // Destroyed bodies are parked for reuse by objects spawned at a high rate
+        if( physicsNode.isAttributeSet( "poolSize" ) )
+            m_poolSize = std::atoi( physicsNode.getAttribute( "poolSize" ) );
+
         // The body of the physics sprite used for physics
         const XMLNode bodyNode = physicsNode.getChildNode( "body" );
         if( !bodyNode.isEmpty() )
@@ -273,4 +278,13 @@ bool CObjectPhysicsData2D::isActive() const
 bool CObjectPhysicsData2D::isBullet() const
 {
     return m_bullet;
+}
+
+
+/************************************************************************
+*    DESC:  Get the max number of destroyed bodies parked for reuse
+************************************************************************/
+int CObjectPhysicsData2D::getPoolSize() const
+{
+    return m_poolSize;
 }
\ No newline at end of file
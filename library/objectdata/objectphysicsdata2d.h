@@ -53,6 +53,9 @@ public:
     // Is this body a bullet
     bool isBullet() const override;
 
+    // Get the max number of destroyed bodies parked for reuse
+    int getPoolSize() const override;
+
 private:
 
     // The name of the physics world
@@ -72,6 +75,9 @@ private:
 
     // Is sleeping allowed
     bool m_sleepingAllowed;
+
+    // Max number of destroyed bodies parked for reuse
+    int m_poolSize;
     
     // vector of fixtures
     std::vector<CFixture> m_fixtureVec;
@@ -0,0 +1,307 @@
+
+/************************************************************************
+*    FILE NAME:       bodypool2d.cpp
+*
+*    DESCRIPTION:     Pool of parked physics bodies created from the
+*                     same object data. Holds the shapes of the object's
+*                     fixtures so they are built once and shared
+************************************************************************/
+
+// Physical component dependency
+#include <physics/bodypool2d.h>
+
+// Game lib dependencies
+#include <objectdata/iobjectphysicsdata.h>
+#include <utilities/exceptionhandling.h>
+
+// Box2D lib dependencies
+#include <Box2D/Box2D.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <algorithm>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CBodyPool2D::CBodyPool2D( int maxSize ) :
+    m_maxSize( std::max( maxSize, 0 ) )
+{
+    if( m_maxSize > 0 )
+        m_pParkedVec.reserve( m_maxSize );
+}
+
+
+/************************************************************************
+*    DESC:  Get a parked body. Returns nullptr if there is nothing parked
+************************************************************************/
+b2Body * CBodyPool2D::reuse()
+{
+    b2Body * pBody(nullptr);
+
+    if( !m_pParkedVec.empty() )
+    {
+        pBody = m_pParkedVec.back();
+        m_pParkedVec.pop_back();
+    }
+
+    return pBody;
+}
+
+
+/************************************************************************
+*    DESC:  Park the body for reuse. Returns false if the pool is full
+************************************************************************/
+bool CBodyPool2D::park( b2Body * pBody )
+{
+    if( m_pParkedVec.size() >= m_maxSize )
+        return false;
+
+    m_pParkedVec.push_back( pBody );
+
+    return true;
+}
+
+
+/************************************************************************
+*    DESC:  Add the shape of the fixture
+************************************************************************/
+void CBodyPool2D::addShape( std::unique_ptr<b2Shape> && upShape, const CFixture & fixture )
+{
+    b2FixtureDef f;
+    f.shape = upShape.get();
+    f.friction = fixture.m_friction;
+    f.density = fixture.m_density;
+    f.restitution = fixture.m_restitution;
+    f.filter = fixture.m_filter;
+    f.isSensor = fixture.m_sensor;
+
+    m_upShapeVec.push_back( std::move(upShape) );
+    m_fixtureDefVec.push_back( f );
+}
+
+
+/************************************************************************
+*    DESC:  Build the shapes of the object's fixtures
+************************************************************************/
+void CBodyPool2D::createShapes(
+    const iObjectPhysicsData & physicsData,
+    const CSize<float> & objectSize,
+    const CSize<float> & scale,
+    float pixelsToMeters,
+    const std::string & name )
+{
+    // Apply scale to the size and divide by 2
+    const CSize<float> size = objectSize * scale * 0.5f;
+
+    for( auto & iter : physicsData.getFixtureVec() )
+    {
+        // Create the shape
+        if( iter.m_shape == b2Shape::e_circle )
+            addShape( createCircularShape( iter, scale, pixelsToMeters ), iter );
+
+        else if( iter.m_shape == b2Shape::e_edge )
+            addShape( createEdgeShape( iter, size, scale, pixelsToMeters, name ), iter );
+
+        else if( iter.m_shape == b2Shape::e_polygon )
+            addShape( createPolygonShape( iter, size, scale, pixelsToMeters ), iter );
+
+        else if( iter.m_shape == b2Shape::e_chain )
+            addShape( createChainShape( iter, size, scale, pixelsToMeters, name ), iter );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Create the fixtures of the shared shapes on the body
+************************************************************************/
+void CBodyPool2D::createFixtures( b2Body * pBody, void * pUserData, const std::string & name ) const
+{
+    for( auto & iter : m_fixtureDefVec )
+    {
+        b2FixtureDef f = iter;
+        f.userData = pUserData;
+
+        if( pBody->CreateFixture( &f ) == nullptr )
+            throw NExcept::CCriticalException("Physics Fixture error!",
+                boost::str( boost::format("Failed to create fixture (%s).\n\n%s\nLine: %s")
+                    % name % __FUNCTION__ % __LINE__ ));
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Create the circular shape
+************************************************************************/
+std::unique_ptr<b2Shape> CBodyPool2D::createCircularShape( const CFixture & fixture, const CSize<float> & scale, float pixelsToMeters )
+{
+    std::unique_ptr<b2CircleShape> upShape( new b2CircleShape );
+    upShape->m_radius = fixture.m_radius * scale.w * pixelsToMeters;
+
+    return upShape;
+}
+
+
+/************************************************************************
+*    DESC:  Create the edge shape
+*           NOTE: An edge is a line segment of two points
+*                 This is no different then making a polygon from points
+************************************************************************/
+std::unique_ptr<b2Shape> CBodyPool2D::createEdgeShape(
+    const CFixture & fixture, const CSize<float> & size, const CSize<float> & scale, float pixelsToMeters, const std::string & name )
+{
+    // Do a sanity check because we need two points to define an edge
+    if( fixture.m_vertVec.size() != 2 )
+        throw NExcept::CCriticalException("Physics Edge Fixture error!",
+            boost::str( boost::format("Physics object has incorrect number of points defined (%d/%s).\n\n%s\nLine: %s")
+                % fixture.m_vertVec.size() % name % __FUNCTION__ % __LINE__ ));
+
+    // Convert the points to world location in meters
+    std::vector<b2Vec2> pointVec;
+    convertPoints( pointVec, fixture, size, scale, pixelsToMeters );
+
+    // These points must exist if this is to work. Use "at()" for bounds checking)
+    std::unique_ptr<b2EdgeShape> upShape( new b2EdgeShape );
+    upShape->Set( pointVec.at(0), pointVec.at(1) );
+
+    return upShape;
+}
+
+
+/************************************************************************
+*    DESC:  Create the polygon shape
+************************************************************************/
+std::unique_ptr<b2Shape> CBodyPool2D::createPolygonShape(
+    const CFixture & fixture, const CSize<float> & size, const CSize<float> & scale, float pixelsToMeters )
+{
+    std::vector<b2Vec2> pointVec;
+
+    // Is this polygon shape defined by a vector of points?
+    if( !fixture.m_vertVec.empty() )
+    {
+        // Convert the points to world location in meters
+        convertPoints( pointVec, fixture, size, scale, pixelsToMeters );
+    }
+    // If vector points are not supplied, build a square based on the object size
+    else
+    {
+        pointVec.reserve( 4 );
+
+        // Bottom and left mod have their signs flipped so that a positive mod always means
+        // expansion of the side, and a negative mod always means a contraction of the side
+        const float topMod = fixture.m_topMod * scale.h;
+        const float bottomMod = -fixture.m_bottomMod * scale.h;
+        const float leftMod = -fixture.m_leftMod * scale.w;
+        const float rightMod = fixture.m_rightMod * scale.w;
+
+        // Convert to meters
+        // Box2D polygons are defined using Counter Clockwise Winding (CCW)
+        pointVec.emplace_back(
+            (-size.w + leftMod) * pixelsToMeters,
+            (size.h + topMod) * pixelsToMeters );
+
+        pointVec.emplace_back(
+            (-size.w + leftMod) * pixelsToMeters,
+            (-size.h + bottomMod) * pixelsToMeters );
+
+        pointVec.emplace_back(
+            (size.w + rightMod) * pixelsToMeters,
+            (-size.h + bottomMod) * pixelsToMeters );
+
+        pointVec.emplace_back(
+            (size.w + rightMod) * pixelsToMeters,
+            (size.h + topMod) * pixelsToMeters );
+    }
+
+    std::unique_ptr<b2PolygonShape> upShape( new b2PolygonShape );
+    upShape->Set( pointVec.data(), pointVec.size() );
+
+    return upShape;
+}
+
+
+/************************************************************************
+*    DESC:  Create the chain shape
+************************************************************************/
+std::unique_ptr<b2Shape> CBodyPool2D::createChainShape(
+    const CFixture & fixture, const CSize<float> & size, const CSize<float> & scale, float pixelsToMeters, const std::string & name )
+{
+    // Do a sanity check because we need more then 1 point to define a chain
+    if( fixture.m_vertVec.size() > 1 )
+        throw NExcept::CCriticalException("Physics Edge Fixture error!",
+            boost::str( boost::format("Physics object has incorrect number of points defined (%d/%s).\n\n%s\nLine: %s")
+                % fixture.m_vertVec.size() % name % __FUNCTION__ % __LINE__ ));
+
+    // Convert the points to world location in meters
+    std::vector<b2Vec2> pointVec;
+    convertPoints( pointVec, fixture, size, scale, pixelsToMeters );
+
+    std::unique_ptr<b2ChainShape> upShape( new b2ChainShape );
+    if( fixture.m_chainLoop )
+        upShape->CreateLoop( pointVec.data(), pointVec.size() );
+    else
+        upShape->CreateChain( pointVec.data(), pointVec.size() );
+
+    return upShape;
+}
+
+
+/************************************************************************
+*    DESC:  Convert the points to world location in meters
+************************************************************************/
+void CBodyPool2D::convertPoints(
+    std::vector<b2Vec2> & polyPointVec,
+    const CFixture & fixture,
+    const CSize<float> & size,
+    const CSize<float> & scale,
+    float pixelsToMeters )
+{
+    polyPointVec.reserve( fixture.m_vertVec.size() );
+
+    // Convert to meters and world coordinates
+    // Box2D polygons are defined using Counter Clockwise Winding (CCW)
+    for( auto & iter : fixture.m_vertVec )
+    {
+        polyPointVec.emplace_back(
+            ((iter.x * scale.w) - size.w) * pixelsToMeters,
+            ((iter.y * scale.h) - size.h) * pixelsToMeters );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Have the shapes been added
+************************************************************************/
+bool CBodyPool2D::hasShapes() const
+{
+    return !m_fixtureDefVec.empty();
+}
+
+
+/************************************************************************
+*    DESC:  Get the fixture definitions of the shared shapes
+************************************************************************/
+const std::vector<b2FixtureDef> & CBodyPool2D::getFixtureDefVec() const
+{
+    return m_fixtureDefVec;
+}
+
+
+/************************************************************************
+*    DESC:  Get the number of parked bodies
+************************************************************************/
+size_t CBodyPool2D::getParkedCount() const
+{
+    return m_pParkedVec.size();
+}
+
+
+/************************************************************************
+*    DESC:  Get the max number of parked bodies
+************************************************************************/
+size_t CBodyPool2D::getMaxSize() const
+{
+    return m_maxSize;
+}
@@ -0,0 +1,111 @@
+
+/************************************************************************
+*    FILE NAME:       bodypool2d.h
+*
+*    DESCRIPTION:     Pool of parked physics bodies created from the
+*                     same object data. Holds the shapes of the object's
+*                     fixtures so they are built once and shared
+************************************************************************/
+
+#pragma once
+
+// Game lib dependencies
+#include <common/size.h>
+
+// Box2D lib dependencies
+#include <Box2D/Collision/Shapes/b2Shape.h>
+#include <Box2D/Dynamics/b2Fixture.h>
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+// Forward declaration(s)
+class b2Body;
+class CFixture;
+class iObjectPhysicsData;
+
+class CBodyPool2D : boost::noncopyable
+{
+public:
+
+    // Constructor
+    CBodyPool2D( int maxSize );
+
+    // Get a parked body. Returns nullptr if there is nothing parked
+    b2Body * reuse();
+
+    // Park the body for reuse. Returns false if the pool is full
+    bool park( b2Body * pBody );
+
+    // Add the shape of the fixture
+    void addShape( std::unique_ptr<b2Shape> && upShape, const CFixture & fixture );
+
+    // Build the shapes of the object's fixtures. The size and scale are in pixels
+    void createShapes(
+        const iObjectPhysicsData & physicsData,
+        const CSize<float> & objectSize,
+        const CSize<float> & scale,
+        float pixelsToMeters,
+        const std::string & name );
+
+    // Create the fixtures of the shared shapes on the body
+    void createFixtures( b2Body * pBody, void * pUserData, const std::string & name ) const;
+
+    // Have the shapes been added
+    bool hasShapes() const;
+
+    // Get the fixture definitions of the shared shapes
+    const std::vector<b2FixtureDef> & getFixtureDefVec() const;
+
+    // Get the number of parked bodies
+    size_t getParkedCount() const;
+
+    // Get the max number of parked bodies
+    size_t getMaxSize() const;
+
+private:
+
+    // Create the circular shape
+    std::unique_ptr<b2Shape> createCircularShape( const CFixture & fixture, const CSize<float> & scale, float pixelsToMeters );
+
+    // Create the edge shape
+    std::unique_ptr<b2Shape> createEdgeShape(
+        const CFixture & fixture, const CSize<float> & size, const CSize<float> & scale, float pixelsToMeters, const std::string & name );
+
+    // Create the polygon shape
+    std::unique_ptr<b2Shape> createPolygonShape(
+        const CFixture & fixture, const CSize<float> & size, const CSize<float> & scale, float pixelsToMeters );
+
+    // Create the chain shape
+    std::unique_ptr<b2Shape> createChainShape(
+        const CFixture & fixture, const CSize<float> & size, const CSize<float> & scale, float pixelsToMeters, const std::string & name );
+
+    // Convert the points to world location in meters
+    void convertPoints(
+        std::vector<b2Vec2> & polyPointVec,
+        const CFixture & fixture,
+        const CSize<float> & size,
+        const CSize<float> & scale,
+        float pixelsToMeters );
+
+private:
+
+    // Max number of parked bodies
+    size_t m_maxSize;
+
+    // Parked bodies
+    // NOTE: The world owns these bodies. Do Not Delete!
+    std::vector<b2Body *> m_pParkedVec;
+
+    // Shapes of the fixtures in meters
+    std::vector<std::unique_ptr<b2Shape>> m_upShapeVec;
+
+    // Fixture definitions pointing to the shapes
+    std::vector<b2FixtureDef> m_fixtureDefVec;
+};
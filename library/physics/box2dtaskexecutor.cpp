@@ -0,0 +1,79 @@
+
+/************************************************************************
+*    FILE NAME:       box2dtaskexecutor.cpp
+*
+*    DESCRIPTION:     Box2D task executor that solves the islands of
+*                     the world's step on the thread pool
+************************************************************************/
+
+// Physical component dependency
+#include <physics/box2dtaskexecutor.h>
+
+// Game lib dependencies
+#include <utilities/threadpool.h>
+
+// Standard lib dependencies
+#include <thread>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CBox2DTaskExecutor::CBox2DTaskExecutor()
+{
+}
+
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CBox2DTaskExecutor::~CBox2DTaskExecutor()
+{
+}
+
+
+/************************************************************************
+*    DESC:  The number of workers to solve the islands on, including
+*           the calling thread
+************************************************************************/
+int32 CBox2DTaskExecutor::GetWorkerCount()
+{
+    return (int32)CThreadPool::Instance().threadCount() + 1;
+}
+
+
+/************************************************************************
+*    DESC:  Run the island solve task on the thread pool and the calling thread.
+*           The calling thread takes any worker slots the jobs haven't
+*           started so it never waits on a job stuck in the queue, like
+*           when the step itself is running on a job
+*           NOTE: The worker count is the one the world sized its worker
+*                 memory with, not the current thread pool size
+************************************************************************/
+void CBox2DTaskExecutor::Run( b2Task * task, int32 workerCount )
+{
+    auto pRun = std::make_shared<STaskRun>();
+    pRun->pTask = task;
+    pRun->count = workerCount;
+
+    for( int32 i = 1; i < pRun->count; ++i )
+        CThreadPool::Instance().post( &CBox2DTaskExecutor::runTaskSlots, pRun );
+
+    runTaskSlots( pRun );
+
+    while( pRun->done.load() < pRun->count )
+        std::this_thread::yield();
+}
+
+
+/************************************************************************
+*    DESC:  Execute the worker slots of the task run that are not taken yet
+************************************************************************/
+void CBox2DTaskExecutor::runTaskSlots( std::shared_ptr<STaskRun> pRun )
+{
+    int32 slot;
+    while( (slot = pRun->next.fetch_add(1)) < pRun->count )
+    {
+        pRun->pTask->Execute( slot );
+        pRun->done.fetch_add(1);
+    }
+}
@@ -0,0 +1,58 @@
+
+/************************************************************************
+*    FILE NAME:       box2dtaskexecutor.h
+*
+*    DESCRIPTION:     Box2D task executor that solves the islands of
+*                     the world's step on the thread pool
+************************************************************************/
+
+#pragma once
+
+// Box2D lib dependencies
+#include <Box2D/Dynamics/b2WorldCallbacks.h>
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <atomic>
+#include <memory>
+
+class CBox2DTaskExecutor : public b2TaskExecutor, boost::noncopyable
+{
+public:
+
+    // Get the instance of the singleton class
+    static CBox2DTaskExecutor & Instance()
+    {
+        static CBox2DTaskExecutor taskExecutor;
+        return taskExecutor;
+    }
+
+    // The number of workers to solve the islands on, including the calling thread
+    int32 GetWorkerCount() override;
+
+    // Run the island solve task on the thread pool and the calling thread
+    void Run( b2Task * task, int32 workerCount ) override;
+
+private:
+
+    // Worker slots of a task run. Shared with the jobs because a job
+    // can start after the run is done
+    struct STaskRun
+    {
+        b2Task * pTask = nullptr;
+        int32 count = 0;
+        std::atomic<int32> next{0};
+        std::atomic<int32> done{0};
+    };
+
+    // Constructor
+    CBox2DTaskExecutor();
+
+    // Destructor
+    virtual ~CBox2DTaskExecutor();
+
+    // Execute the worker slots of the task run that are not taken yet
+    static void runTaskSlots( std::shared_ptr<STaskRun> pRun );
+};
@@ -0,0 +1,162 @@
+
+/************************************************************************
+*    FILE NAME:       bullettaskscheduler.cpp
+*
+*    DESCRIPTION:     Bullet task scheduler that runs the parallel loops
+*                     of the multithreaded world on the thread pool
+************************************************************************/
+
+// Physical component dependency
+#include <physics/bullettaskscheduler.h>
+
+// Game lib dependencies
+#include <utilities/threadpool.h>
+
+// Standard lib dependencies
+#include <algorithm>
+#include <thread>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CBulletTaskScheduler::CBulletTaskScheduler() :
+    btITaskScheduler( "ThreadPool" ),
+    m_numThreads(1)
+{
+}
+
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CBulletTaskScheduler::~CBulletTaskScheduler()
+{
+}
+
+
+/************************************************************************
+*    DESC:  Make this the task scheduler of Bullet
+*           NOTE: Bullet requires this to be called from the main thread
+************************************************************************/
+void CBulletTaskScheduler::install()
+{
+    // Bullet indexes its per thread data by the order threads first use it.
+    // Any pool thread can pick up a chunk so all of them need a slot
+    m_numThreads = getMaxNumThreads();
+
+    if( btGetTaskScheduler() != this )
+        btSetTaskScheduler( this );
+}
+
+
+/************************************************************************
+*    DESC:  Get the max number of threads. The thread pool plus the
+*           calling thread
+************************************************************************/
+int CBulletTaskScheduler::getMaxNumThreads() const
+{
+    const int threadCount = (int)CThreadPool::Instance().threadCount() + 1;
+
+    return std::min( threadCount, (int)BT_MAX_THREAD_COUNT );
+}
+
+
+/************************************************************************
+*    DESC:  Set-Get the number of threads that work on a loop
+************************************************************************/
+void CBulletTaskScheduler::setNumThreads( int numThreads )
+{
+    m_numThreads = std::clamp( numThreads, 1, getMaxNumThreads() );
+}
+
+int CBulletTaskScheduler::getNumThreads() const
+{
+    return m_numThreads;
+}
+
+
+/************************************************************************
+*    DESC:  Run the loop in chunks of the grain size on the threads
+************************************************************************/
+void CBulletTaskScheduler::parallelFor( int iBegin, int iEnd, int grainSize, const btIParallelForBody & body )
+{
+    if( iBegin >= iEnd )
+        return;
+
+    auto pRun = std::make_shared<SLoopRun>();
+    pRun->pForBody = &body;
+    pRun->begin = iBegin;
+    pRun->end = iEnd;
+    pRun->grainSize = std::max( grainSize, 1 );
+    pRun->count = (iEnd - iBegin + pRun->grainSize - 1) / pRun->grainSize;
+
+    run( pRun );
+}
+
+
+/************************************************************************
+*    DESC:  Run the sum in chunks of the grain size on the threads
+*           The chunk sums are added in order so the result doesn't
+*           depend on the threads
+************************************************************************/
+btScalar CBulletTaskScheduler::parallelSum( int iBegin, int iEnd, int grainSize, const btIParallelSumBody & body )
+{
+    if( iBegin >= iEnd )
+        return btScalar(0);
+
+    auto pRun = std::make_shared<SLoopRun>();
+    pRun->pSumBody = &body;
+    pRun->begin = iBegin;
+    pRun->end = iEnd;
+    pRun->grainSize = std::max( grainSize, 1 );
+    pRun->count = (iEnd - iBegin + pRun->grainSize - 1) / pRun->grainSize;
+    pRun->sumVec.resize( pRun->count, btScalar(0) );
+
+    run( pRun );
+
+    btScalar sum(0);
+    for( auto iter : pRun->sumVec )
+        sum += iter;
+
+    return sum;
+}
+
+
+/************************************************************************
+*    DESC:  Run the chunks on the threads and wait for them to finish
+*           The calling thread works on the chunks too so a loop started
+*           from a pool job can't wait on jobs queued behind it
+************************************************************************/
+void CBulletTaskScheduler::run( const std::shared_ptr<SLoopRun> & pRun )
+{
+    const int jobCount = std::min( m_numThreads, pRun->count ) - 1;
+
+    for( int i = 0; i < jobCount; ++i )
+        CThreadPool::Instance().post( &CBulletTaskScheduler::runChunks, pRun );
+
+    runChunks( pRun );
+
+    while( pRun->done.load() < pRun->count )
+        std::this_thread::yield();
+}
+
+
+/************************************************************************
+*    DESC:  Execute the chunks of the loop that are not taken yet
+************************************************************************/
+void CBulletTaskScheduler::runChunks( std::shared_ptr<SLoopRun> pRun )
+{
+    int chunk;
+    while( (chunk = pRun->next.fetch_add(1)) < pRun->count )
+    {
+        const int begin = pRun->begin + (chunk * pRun->grainSize);
+        const int end = std::min( begin + pRun->grainSize, pRun->end );
+
+        if( pRun->pSumBody != nullptr )
+            pRun->sumVec[chunk] = pRun->pSumBody->sumLoop( begin, end );
+        else
+            pRun->pForBody->forLoop( begin, end );
+
+        pRun->done.fetch_add(1);
+    }
+}
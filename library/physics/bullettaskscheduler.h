@@ -0,0 +1,83 @@
+
+/************************************************************************
+*    FILE NAME:       bullettaskscheduler.h
+*
+*    DESCRIPTION:     Bullet task scheduler that runs the parallel loops
+*                     of the multithreaded world on the thread pool
+************************************************************************/
+
+#pragma once
+
+// Bullet Physics lib dependencies
+#include <LinearMath/btThreads.h>
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class CBulletTaskScheduler : public btITaskScheduler, boost::noncopyable
+{
+public:
+
+    // Get the instance of the singleton class
+    static CBulletTaskScheduler & Instance()
+    {
+        static CBulletTaskScheduler taskScheduler;
+        return taskScheduler;
+    }
+
+    // Make this the task scheduler of Bullet
+    // NOTE: Bullet requires this to be called from the main thread
+    void install();
+
+    // Get the max number of threads. The thread pool plus the calling thread
+    int getMaxNumThreads() const override;
+
+    // Set-Get the number of threads that work on a loop
+    void setNumThreads( int numThreads ) override;
+    int getNumThreads() const override;
+
+    // Run the loop in chunks of the grain size on the threads
+    void parallelFor( int iBegin, int iEnd, int grainSize, const btIParallelForBody & body ) override;
+
+    // Run the sum in chunks of the grain size on the threads
+    btScalar parallelSum( int iBegin, int iEnd, int grainSize, const btIParallelSumBody & body ) override;
+
+private:
+
+    // Chunks of a loop. Shared with the jobs because a job
+    // can start after the loop is done
+    struct SLoopRun
+    {
+        const btIParallelForBody * pForBody = nullptr;
+        const btIParallelSumBody * pSumBody = nullptr;
+        int begin = 0;
+        int end = 0;
+        int grainSize = 1;
+        int count = 0;
+        std::vector<btScalar> sumVec;
+        std::atomic<int> next{0};
+        std::atomic<int> done{0};
+    };
+
+    // Constructor
+    CBulletTaskScheduler();
+
+    // Destructor
+    virtual ~CBulletTaskScheduler();
+
+    // Run the chunks on the threads and wait for them to finish
+    void run( const std::shared_ptr<SLoopRun> & pRun );
+
+    // Execute the chunks of the loop that are not taken yet
+    static void runChunks( std::shared_ptr<SLoopRun> pRun );
+
+private:
+
+    // Number of threads that work on a loop
+    int m_numThreads;
+};
@@ -0,0 +1,26 @@
+
+/************************************************************************
+*    FILE NAME:       contact2d.h
+*
+*    DESCRIPTION:     Contact between two fixtures saved during the
+*                     physics step and sent to the script as a list
+************************************************************************/
+
+#pragma once
+
+class CContact2D
+{
+public:
+
+    // User data of the fixtures
+    void * pUserDataA;
+    void * pUserDataB;
+
+    // World normal of the contact pointing from A to B
+    float normalX;
+    float normalY;
+
+    // Largest normal impulse of the first solve after the contact began.
+    // Zero for end contacts and sensors
+    float impulse;
+};
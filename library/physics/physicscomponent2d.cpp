@@ -26,6 +26,9 @@
 // Box2D lib dependencies
 #include <Box2D/Box2D.h>
 
+// Standard lib dependencies
+#include <algorithm>
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
@@ -62,10 +65,7 @@ CPhysicsComponent2D::~CPhysicsComponent2D()
 void CPhysicsComponent2D::init( const CSprite & sprite )
 {
     if( sprite.getObjectData().getPhysicsData().isActive() )
-    {
         createBody( sprite );
-        createFixture( sprite );
-    }
 }
 
 /************************************************************************
@@ -77,14 +77,15 @@ void CPhysicsComponent2D::destroy()
 
     if( m_pBody != nullptr )
     {
-        m_pWorld->destroyBody( m_pBody );
+        m_pWorld->destroyBody( m_pBody, *m_pBodyPool );
         m_pBody = nullptr;
+        m_pState = nullptr;
     }
 }
 
 
 /************************************************************************
-*    DESC:  Create the body
+*    DESC:  Create the body with the fixtures of the shapes shared in the pool
 ************************************************************************/
 void CPhysicsComponent2D::createBody( const CSprite & sprite )
 {
@@ -92,262 +93,34 @@ void CPhysicsComponent2D::createBody( const CSprite & sprite )
 
     if( physicsData.getBodyType() != b2BodyType(-1) )
     {
-        // Fill in the body structure
+        // The world fills in the rest of the body structure from the physics data
         b2BodyDef bodyDef;
-        bodyDef.type = physicsData.getBodyType();
-        bodyDef.linearDamping = physicsData.getLinearDamping();
-        bodyDef.angularDamping = physicsData.getAngularDamping();
-        bodyDef.fixedRotation = physicsData.isRotationFixed();
         bodyDef.position.Set( sprite.getPos().getX() * PIXELS_TO_METERS, sprite.getPos().getY() * PIXELS_TO_METERS );
         bodyDef.angle = -sprite.getRot().getZ();
         bodyDef.userData = (void*)&sprite;
-        bodyDef.bullet = physicsData.isBullet();
-        bodyDef.allowSleep = physicsData.allowSleep();
-
-        // Create the body
-        m_pBody = m_pWorld->createBody( bodyDef );
-    }
-}
 
+        // The shapes are scaled by the sprite so the pool is of the object data and scale
+        const iObjectData & objectData = sprite.getObjectData();
+        m_pBodyPool = &m_pWorld->getBodyPool(
+            objectData.getGroup(),
+            objectData.getName(),
+            sprite.getScale().getX(),
+            sprite.getScale().getY(),
+            physicsData.getPoolSize() );
 
-/************************************************************************
-*    DESC:  Create the fixture
-************************************************************************/
-void CPhysicsComponent2D::createFixture( const CSprite & sprite )
-{
-    const auto & fixture = sprite.getObjectData().getPhysicsData().getFixtureVec();
+        // Object data holds size as int so need to convert it to a float
+        const CSize<float> objectSize = sprite.getVisualComponent()->getSize();
+        const CSize<float> scale( sprite.getScale().getX(), sprite.getScale().getY() );
 
-    for( auto & iter : fixture )
-    {
-        // Create the fixture
-        if( iter.m_shape == b2Shape::e_circle )
-            createCircularShapeFixture( sprite, iter );
+        // Create the body or revive a parked one
+        m_pBody = m_pWorld->createBody( bodyDef, physicsData, *m_pBodyPool, objectSize, scale, objectData.getName() );
+        m_pState = m_pWorld->getBodyState( m_pBody );
 
-        else if( iter.m_shape == b2Shape::e_edge )
-            createEdgeShapeFixture( sprite, iter );
+        // NOTE: The fixture list is in the reverse order they were created
+        for( b2Fixture * pFixture = m_pBody->GetFixtureList(); pFixture != nullptr; pFixture = pFixture->GetNext() )
+            m_fixtureVec.push_back( pFixture );
 
-        else if( iter.m_shape == b2Shape::e_polygon )
-            createPolygonShapeFixture( sprite, iter );
-
-        else if( iter.m_shape == b2Shape::e_chain )
-            createChainShapeFixture( sprite, iter );
-    }
-}
-
-
-/************************************************************************
-*    DESC:  Create the circular shape fixture
-************************************************************************/
-void CPhysicsComponent2D::createCircularShapeFixture( const CSprite & sprite, const CFixture & fixture )
-{
-    b2CircleShape shape;
-    shape.m_radius = fixture.m_radius * sprite.getScale().getX() * PIXELS_TO_METERS;
-
-    b2FixtureDef f;
-    f.shape = &shape;
-    f.friction = fixture.m_friction;
-    f.density = fixture.m_density;
-    f.restitution = fixture.m_restitution;
-    f.filter = fixture.m_filter;
-    f.isSensor = fixture.m_sensor;
-    f.userData = (void*)&sprite;
-
-    auto pFixture = m_pBody->CreateFixture( &f );
-    if( pFixture == nullptr )
-        throw NExcept::CCriticalException("Physics Edge Fixture error!",
-                boost::str( boost::format("Failed to create fixture (%s).\n\n%s\nLine: %s")
-                    % sprite.getObjectData().getName() % __FUNCTION__ % __LINE__ ));
-
-    pFixture->SetFilterData( fixture.m_filter );
-    m_fixtureVec.push_back( pFixture );
-}
-
-
-/************************************************************************
-*    DESC:  Create the edge shape fixture
-*           NOTE: An edge is a line segment of two points
-*                 This is no different then making a polygon from points
-************************************************************************/
-void CPhysicsComponent2D::createEdgeShapeFixture( const CSprite & sprite, const CFixture & fixture )
-{
-    // Do a sanity check because we need two points to define an edge
-    if( fixture.m_vertVec.size() != 2 )
-        throw NExcept::CCriticalException("Physics Edge Fixture error!",
-            boost::str( boost::format("Physics object has incorrect number of points defined (%d/%s).\n\n%s\nLine: %s")
-                % fixture.m_vertVec.size() % sprite.getObjectData().getName() % __FUNCTION__ % __LINE__ ));
-
-    // Apply scale to the size and divide by 2
-    // Object data holds size as int so need to convert it to a float
-    const CSize<float> objectSize = sprite.getVisualComponent()->getSize();
-    const CSize<float> scale( sprite.getScale().getX(), sprite.getScale().getY() );
-    const CSize<float> size = objectSize * scale * 0.5f;
-
-    // Convert the points to world location in meters
-    std::vector<b2Vec2> pointVec;
-    convertPoints( pointVec, fixture, size, scale );
-
-    // These points must exist if this is to work. Use "at()" for bounds checking)
-    b2EdgeShape shape;
-    shape.Set( pointVec.at(0), pointVec.at(1) );
-
-    b2FixtureDef f;
-    f.shape = &shape;
-    f.friction = fixture.m_friction;
-    f.density = fixture.m_density;
-    f.restitution = fixture.m_restitution;
-    f.filter = fixture.m_filter;
-    f.isSensor = fixture.m_sensor;
-    f.userData = (void*)&sprite;
-
-    auto pFixture = m_pBody->CreateFixture( &f );
-    if( pFixture == nullptr )
-        throw NExcept::CCriticalException("Physics Edge Fixture error!",
-                boost::str( boost::format("Failed to create fixture (%s).\n\n%s\nLine: %s")
-                    % sprite.getObjectData().getName() % __FUNCTION__ % __LINE__ ));
-
-    pFixture->SetFilterData( fixture.m_filter );
-    m_fixtureVec.push_back( pFixture );
-}
-
-
-/************************************************************************
-*    DESC:  Create the polygon shape fixture
-************************************************************************/
-void CPhysicsComponent2D::createPolygonShapeFixture( const CSprite & sprite, const CFixture & fixture )
-{
-    std::vector<b2Vec2> pointVec;
-
-    // Apply scale to the size and divide by 2
-    // Object data holds size as int so need to convert it to a float
-    const CSize<float> objectSize = sprite.getVisualComponent()->getSize();
-    const CSize<float> scale( sprite.getScale().getX(), sprite.getScale().getY() );
-    const CSize<float> size = objectSize * scale * 0.5f;
-
-    // Is this polygon shape defined by a vector of points?
-    if( !fixture.m_vertVec.empty() )
-    {
-        // Convert the points to world location in meters
-        convertPoints( pointVec, fixture, size, scale );
-    }
-	// If vector points are not supplied, build a square based on the object size
-    else
-    {
-        pointVec.reserve( 4 );
-
-        // Bottom and left mod have their signs flipped so that a positive mod always means
-        // expansion of the side, and a negative mod always means a contraction of the side
-        const float topMod = fixture.m_topMod * scale.h;
-        const float bottomMod = -fixture.m_bottomMod * scale.h;
-        const float leftMod = -fixture.m_leftMod * scale.w;
-        const float rightMod = fixture.m_rightMod * scale.w;
-
-        // Convert to meters
-        // Box2D polygons are defined using Counter Clockwise Winding (CCW)
-        pointVec.emplace_back(
-            (-size.w + leftMod) * PIXELS_TO_METERS,
-            (size.h + topMod) * PIXELS_TO_METERS );
-
-        pointVec.emplace_back(
-            (-size.w + leftMod) * PIXELS_TO_METERS,
-            (-size.h + bottomMod) * PIXELS_TO_METERS );
-
-        pointVec.emplace_back(
-            (size.w + rightMod) * PIXELS_TO_METERS,
-            (-size.h + bottomMod) * PIXELS_TO_METERS );
-
-        pointVec.emplace_back(
-            (size.w + rightMod) * PIXELS_TO_METERS,
-            (size.h + topMod) * PIXELS_TO_METERS );
-    }
-
-    b2PolygonShape shape;
-    shape.Set( pointVec.data(), pointVec.size() );
-
-    b2FixtureDef f;
-    f.shape = &shape;
-    f.friction = fixture.m_friction;
-    f.density = fixture.m_density;
-    f.restitution = fixture.m_restitution;
-    f.filter = fixture.m_filter;
-    f.isSensor = fixture.m_sensor;
-    f.userData = (void*)&sprite;
-
-    auto pFixture = m_pBody->CreateFixture( &f );
-    if( pFixture == nullptr )
-        throw NExcept::CCriticalException("Physics Edge Fixture error!",
-                boost::str( boost::format("Failed to create fixture (%s).\n\n%s\nLine: %s")
-                    % sprite.getObjectData().getName() % __FUNCTION__ % __LINE__ ));
-
-    pFixture->SetFilterData( fixture.m_filter );
-    m_fixtureVec.push_back( pFixture );
-}
-
-
-/************************************************************************
-*    DESC:  Create the chain shape fixture
-************************************************************************/
-void CPhysicsComponent2D::createChainShapeFixture( const CSprite & sprite, const CFixture & fixture )
-{
-    // Do a sanity check because we need more then 1 point to define a chain
-    if( fixture.m_vertVec.size() > 1 )
-        throw NExcept::CCriticalException("Physics Edge Fixture error!",
-            boost::str( boost::format("Physics object has incorrect number of points defined (%d/%s).\n\n%s\nLine: %s")
-                % fixture.m_vertVec.size() % sprite.getObjectData().getName() % __FUNCTION__ % __LINE__ ));
-
-    // Apply scale to the size and divide by 2
-    // Object data holds size as int so need to convert it to a float
-    const CSize<float> objectSize = sprite.getVisualComponent()->getSize();
-    const CSize<float> scale( sprite.getScale().getX(), sprite.getScale().getY() );
-    const CSize<float> size = objectSize * scale * 0.5f;
-
-    // Convert the points to world location in meters
-    std::vector<b2Vec2> pointVec;
-    convertPoints( pointVec, fixture, size, scale );
-
-    b2ChainShape shape;
-    if( fixture.m_chainLoop )
-        shape.CreateLoop( pointVec.data(), pointVec.size() );
-    else
-        shape.CreateChain( pointVec.data(), pointVec.size() );
-
-    b2FixtureDef f;
-    f.shape = &shape;
-    f.friction = fixture.m_friction;
-    f.density = fixture.m_density;
-    f.restitution = fixture.m_restitution;
-    f.filter = fixture.m_filter;
-    f.isSensor = fixture.m_sensor;
-    f.userData = (void*)&sprite;
-
-    auto pFixture = m_pBody->CreateFixture( &f );
-    if( pFixture == nullptr )
-        throw NExcept::CCriticalException("Physics Edge Fixture error!",
-                boost::str( boost::format("Failed to create fixture (%s).\n\n%s\nLine: %s")
-                    % sprite.getObjectData().getName() % __FUNCTION__ % __LINE__ ));
-
-    pFixture->SetFilterData( fixture.m_filter );
-    m_fixtureVec.push_back( pFixture );
-}
-
-
-/************************************************************************
-*    DESC:  Convert the points to world location in meters
-************************************************************************/
-void CPhysicsComponent2D::convertPoints(
-    std::vector<b2Vec2> & polyPointVec,
-    const CFixture & fixture,
-    const CSize<float> & size,
-    const CSize<float> & scale )
-{
-    polyPointVec.reserve( fixture.m_vertVec.size() );
-
-    // Convert to meters and world coordinates
-    // Box2D polygons are defined using Counter Clockwise Winding (CCW)
-    for( auto & iter : fixture.m_vertVec )
-    {
-        polyPointVec.emplace_back(
-            ((iter.x * scale.w) - size.w) * PIXELS_TO_METERS,
-            ((iter.y * scale.h) - size.h) * PIXELS_TO_METERS );
+        std::reverse( m_fixtureVec.begin(), m_fixtureVec.end() );
     }
 }
 
@@ -361,13 +134,39 @@ void CPhysicsComponent2D::update( CSprite * pSprite )
     {
         CStatCounter::Instance().incPhysicsObjectsCounter();
 
-        if( (BODY_TYPE > b2_staticBody) && m_pBody->IsAwake() )
+        // Read the state published after the step. The body
+        // may be in the middle of a step running on a job
+        const CPhysicsWorld2D::SBodyState & state = *m_pState;
+        const bool awake = state.awake;
+
+        // Update once more after the body falls asleep so it lands on its final transform
+        if( (BODY_TYPE > b2_staticBody) && (awake || m_wasAwake) )
         {
-            const b2Vec2 & pos = m_pBody->GetPosition();
-            const float angle = m_pBody->GetAngle();
+            b2Vec2 pos = state.transform.p;
+            float angle = state.angle;
+
+            // Interpolate from the transform before the last step by the time left over
+            const float ratio = m_pWorld->getTimeRatio();
+            if( awake && (ratio < 1.f) )
+            {
+                const b2Transform & prev = state.prevTransform;
+                pos = prev.p + ratio * (pos - prev.p);
+
+                // Rotate the short way around but keep the body's angle which isn't wrapped
+                float angleDelta = state.transform.q.GetAngle() - prev.q.GetAngle();
+                if( angleDelta > b2_pi )
+                    angleDelta -= 2.f * b2_pi;
+                else if( angleDelta < -b2_pi )
+                    angleDelta += 2.f * b2_pi;
+
+                angle -= angleDelta * (1.f - ratio);
+            }
+
             pSprite->setPos( pos.x * METERS_TO_PIXELS, pos.y * METERS_TO_PIXELS );
             pSprite->setRot( 0, 0, angle, false );
         }
+
+        m_wasAwake = awake;
     }
 }
 
@@ -379,13 +178,22 @@ void CPhysicsComponent2D::setTransform( float x, float y, float angle, bool rese
 {
     if( m_pBody != nullptr )
     {
-        m_pBody->SetTransform( b2Vec2( x * PIXELS_TO_METERS, y * PIXELS_TO_METERS ), angle );
-
-        if( resetVelocity )
-        {
-            m_pBody->SetLinearVelocity( b2Vec2(0,0) );
-            m_pBody->SetAngularVelocity( 0 );
-        }
+        const b2Vec2 pos( x * PIXELS_TO_METERS, y * PIXELS_TO_METERS );
+
+        m_pWorld->runCommand(
+            [this, pBody = m_pBody, pos, angle, resetVelocity]()
+            {
+                pBody->SetTransform( pos, angle );
+
+                // Don't interpolate from where the body was
+                m_pWorld->resetBodyState( pBody );
+
+                if( resetVelocity )
+                {
+                    pBody->SetLinearVelocity( b2Vec2(0,0) );
+                    pBody->SetAngularVelocity( 0 );
+                }
+            } );
     }
 }
 
@@ -396,7 +204,10 @@ void CPhysicsComponent2D::setTransform( float x, float y, float angle, bool rese
 void CPhysicsComponent2D::setLinearVelocity( float x, float y )
 {
     if( m_pBody != nullptr )
-        m_pBody->SetLinearVelocity( b2Vec2( x * PIXELS_TO_METERS, y * PIXELS_TO_METERS ) );
+    {
+        const b2Vec2 velocity( x * PIXELS_TO_METERS, y * PIXELS_TO_METERS );
+        m_pWorld->runCommand( [pBody = m_pBody, velocity]() { pBody->SetLinearVelocity( velocity ); } );
+    }
 }
 
 
@@ -406,7 +217,7 @@ void CPhysicsComponent2D::setLinearVelocity( float x, float y )
 void CPhysicsComponent2D::setAngularVelocity( float value )
 {
     if( m_pBody != nullptr )
-        m_pBody->SetAngularVelocity( value );
+        m_pWorld->runCommand( [pBody = m_pBody, value]() { pBody->SetAngularVelocity( value ); } );
 }
 
 
@@ -416,7 +227,7 @@ void CPhysicsComponent2D::setAngularVelocity( float value )
 void CPhysicsComponent2D::applyAngularImpulse( float value, bool wake )
 {
     if( m_pBody != nullptr )
-        m_pBody->ApplyAngularImpulse( value, wake );
+        m_pWorld->runCommand( [pBody = m_pBody, value, wake]() { pBody->ApplyAngularImpulse( value, wake ); } );
 }
 
 
@@ -425,6 +236,9 @@ void CPhysicsComponent2D::applyAngularImpulse( float value, bool wake )
 ************************************************************************/
 b2Body * CPhysicsComponent2D::getBody()
 {
+    // The body can't be used while it's stepping on a job
+    m_pWorld->syncStep();
+
     // Do a sanity check because we need more then 1 point to define a chain
     if( m_pBody == nullptr )
         throw NExcept::CCriticalException("Acess To Null Body!",
@@ -459,13 +273,16 @@ bool CPhysicsComponent2D::isBodyTypeDynamic()
 void CPhysicsComponent2D::setActive(bool value)
 {
     if( m_pBody != nullptr )
-        m_pBody->SetActive(value);
+        m_pWorld->runCommand( [pBody = m_pBody, value]() { pBody->SetActive(value); } );
 }
 
 bool CPhysicsComponent2D::isActive()
 {
     if( m_pBody != nullptr )
+    {
+        m_pWorld->syncStep();
         return m_pBody->IsActive();
+    }
 
     return false;
 }
@@ -477,13 +294,14 @@ bool CPhysicsComponent2D::isActive()
 void CPhysicsComponent2D::setAwake(bool value)
 {
     if( m_pBody != nullptr )
-        m_pBody->SetAwake(value);
+        m_pWorld->runCommand( [pBody = m_pBody, value]() { pBody->SetAwake(value); } );
 }
 
 bool CPhysicsComponent2D::isAwake()
 {
-    if( m_pBody == nullptr )
-        return m_pBody->IsAwake();
+    // Awake as of the last step
+    if( m_pBody != nullptr )
+        return m_pState->awake;
     
     return false;
 }
@@ -495,13 +313,16 @@ bool CPhysicsComponent2D::isAwake()
 void CPhysicsComponent2D::setFixedRotation(bool value)
 {
     if( m_pBody != nullptr )
-        m_pBody->SetFixedRotation(value);
+        m_pWorld->runCommand( [pBody = m_pBody, value]() { pBody->SetFixedRotation(value); } );
 }
 
 bool CPhysicsComponent2D::isFixedRotation()
 {
-    if( m_pBody == nullptr )
+    if( m_pBody != nullptr )
+    {
+        m_pWorld->syncStep();
         return m_pBody->IsFixedRotation();
+    }
     
     return false;
 }
@@ -513,13 +334,16 @@ bool CPhysicsComponent2D::isFixedRotation()
 void CPhysicsComponent2D::setSleepingAllowed(bool value)
 {
     if( m_pBody != nullptr )
-        m_pBody->SetSleepingAllowed(value);
+        m_pWorld->runCommand( [pBody = m_pBody, value]() { pBody->SetSleepingAllowed(value); } );
 }
 
 bool CPhysicsComponent2D::isSleepingAllowed()
 {
-    if( m_pBody == nullptr )
+    if( m_pBody != nullptr )
+    {
+        m_pWorld->syncStep();
         return m_pBody->IsSleepingAllowed();
+    }
     
     return false;
 }
@@ -539,13 +363,20 @@ void CPhysicsComponent2D::setContactFilter(uint16_t categoryBits, uint16_t maskB
 
         if( fixtureIndex < 0 )
         {
-            for( auto iter : m_fixtureVec )
-                iter->SetFilterData(filter);
+            m_pWorld->runCommand(
+                [fixtureVec = m_fixtureVec, filter]()
+                {
+                    for( auto iter : fixtureVec )
+                        iter->SetFilterData(filter);
+                } );
         }
         else
         {
             if( fixtureIndex < static_cast<int>(m_fixtureVec.size()) )
-                m_fixtureVec.at(fixtureIndex)->SetFilterData(filter);
+            {
+                b2Fixture * pFixture = m_fixtureVec.at(fixtureIndex);
+                m_pWorld->runCommand( [pFixture, filter]() { pFixture->SetFilterData(filter); } );
+            }
             else
                 NGenFunc::PostDebugMsg( "WARNING: Contact filtering out of range!" );
         }
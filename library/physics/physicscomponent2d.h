@@ -12,6 +12,7 @@
 
 // Game lib dependencies
 #include <common/size.h>
+#include <physics/physicsworld2d.h>
 
 // Box2D lib dependencies
 #include <Box2D/Dynamics/b2Body.h>
@@ -21,14 +22,14 @@
 
 // Standard lib dependencies
 #include <vector>
+#include <memory>
 
 // Forward declaration(s)
 class iObjectData;
 class CSprite;
-class CPhysicsWorld2D;
 class b2Body;
-class CFixture;
 class b2Fixture;
+class CBodyPool2D;
 
 class CPhysicsComponent2D : public iPhysicsComponent, boost::noncopyable
 {
@@ -92,31 +93,9 @@ public:
 
 private:
 
-    // Create the body
+    // Create the body with the fixtures of the shapes shared in the pool
     void createBody( const CSprite & sprite );
 
-    // Create the fixture
-    void createFixture( const CSprite & sprite );
-
-    // Create the circular shape fixture
-    void createCircularShapeFixture( const CSprite & sprite, const CFixture & fixture );
-
-    // Create the edge shape fixture
-    void createEdgeShapeFixture( const CSprite & sprite, const CFixture & fixture );
-
-    // Create the polygon shape fixture
-    void createPolygonShapeFixture( const CSprite & sprite, const CFixture & fixture );
-
-    // Create the chain shape fixture
-    void createChainShapeFixture( const CSprite & sprite, const CFixture & fixture );
-    
-    // Convert the points to world location in meters
-    void convertPoints(
-        std::vector<b2Vec2> & polyPointVec,
-        const CFixture & fixture,
-        const CSize<float> & size,
-        const CSize<float> & scale );
-
 private:
     
     // Body type
@@ -126,6 +105,10 @@ private:
     // NOTE: If we own this pointer, we'll need to free it
     b2Body * m_pBody = nullptr;
 
+    // Parked bodies and shared shapes of the object data
+    // NOTE: Do not free. The world owns this pointer.
+    CBodyPool2D * m_pBodyPool = nullptr;
+
     // vector list of fixtures
     // NOTE: If we DON't own this pointer!
     std::vector<b2Fixture *> m_fixtureVec;
@@ -137,4 +120,11 @@ private:
     // Pointer to the world
     // NOTE: Do not free. We don't own this pointer.
     CPhysicsWorld2D * m_pWorld;
+
+    // State of the body published by the world after the step
+    // NOTE: Do not free. The world owns this pointer.
+    const CPhysicsWorld2D::SBodyState * m_pState = nullptr;
+
+    // Was the body awake the last update
+    bool m_wasAwake = false;
 };
@@ -124,6 +124,8 @@ void CPhysicsComponent3D::init( const CSprite & sprite )
             m_pWorld->addRigidBody( m_upRigidBody.get(), collisionGroup, collisionMask );
         else
             m_pWorld->addRigidBody( m_upRigidBody.get() );
+
+        m_pState = m_pWorld->getBodyState( m_upRigidBody.get() );
     }
 }
 
@@ -132,11 +134,13 @@ void CPhysicsComponent3D::init( const CSprite & sprite )
  ************************************************************************/
 void CPhysicsComponent3D::update( CSprite * pSprite )
 {
-    if( isActive() && m_upRigidBody->isActive() )
+    // Read the state published after the step. The body
+    // may be in the middle of a step running on a job
+    if( (m_pState != nullptr) && m_pState->active )
     {
-        // Get the transform
-        btTransform trans;
-        m_upRigidBody->getMotionState()->getWorldTransform(trans);
+        // Get the transform. With a fixed time step Bullet sets the motion state
+        // to the transform interpolated between the last two steps
+        const btTransform & trans = m_pState->transform;
         
         pSprite->getParameters().add( CObject::ROTATE | CObject::PHYSICS_TRANSFORM );
     
@@ -180,7 +184,10 @@ bool CPhysicsComponent3D::isActive()
 void CPhysicsComponent3D::addBody()
 {
     if( m_upRigidBody != nullptr )
+    {
         m_pWorld->addRigidBody( m_upRigidBody.get() );
+        m_pState = m_pWorld->getBodyState( m_upRigidBody.get() );
+    }
 }
 
 /************************************************************************
@@ -189,7 +196,10 @@ void CPhysicsComponent3D::addBody()
 void CPhysicsComponent3D::removeBody()
 {
     if( m_upRigidBody != nullptr )
+    {
         m_pWorld->removeRigidBody( m_upRigidBody.get() );
+        m_pState = nullptr;
+    }
 }
 
 /************************************************************************
@@ -198,7 +208,10 @@ void CPhysicsComponent3D::removeBody()
 void CPhysicsComponent3D::setLinearVelocity( const CPoint<float> & vec )
 {
     if( m_upRigidBody != nullptr )
-        m_upRigidBody->setLinearVelocity( btVector3( vec.x, vec.y, vec.z ) );
+    {
+        const btVector3 velocity( vec.x, vec.y, vec.z );
+        m_pWorld->runCommand( [pBody = m_upRigidBody.get(), velocity]() { pBody->setLinearVelocity( velocity ); } );
+    }
 }
 
 /************************************************************************
@@ -207,7 +220,10 @@ void CPhysicsComponent3D::setLinearVelocity( const CPoint<float> & vec )
 void CPhysicsComponent3D::setAngularVelocity( const CPoint<float> & vec )
 {
     if( m_upRigidBody != nullptr )
-        m_upRigidBody->setAngularVelocity( btVector3( vec.x, vec.y, vec.z ) );
+    {
+        const btVector3 velocity( vec.x, vec.y, vec.z );
+        m_pWorld->runCommand( [pBody = m_upRigidBody.get(), velocity]() { pBody->setAngularVelocity( velocity ); } );
+    }
 }
 
 /************************************************************************
@@ -216,5 +232,5 @@ void CPhysicsComponent3D::setAngularVelocity( const CPoint<float> & vec )
 void CPhysicsComponent3D::setRestitution( const float rest )
 {
     if( m_upRigidBody != nullptr )
-        m_upRigidBody->setRestitution( rest );
+        m_pWorld->runCommand( [pBody = m_upRigidBody.get(), rest]() { pBody->setRestitution( rest ); } );
 }
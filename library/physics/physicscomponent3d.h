@@ -12,6 +12,7 @@
 
 // Game lib dependencies
 #include <common/point.h>
+#include <physics/physicsworld3d.h>
 
 // Boost lib dependencies
 #include <boost/noncopyable.hpp>
@@ -22,8 +23,6 @@
 // Forward declaration(s)
 class iObjectData;
 class CSprite;
-class CPhysicsWorld3D;
-class btRigidBody;
 
 class CPhysicsComponent3D : public iPhysicsComponent, boost::noncopyable
 {
@@ -69,4 +68,8 @@ private:
 
     // Rigid body safe pointer
     std::unique_ptr<btRigidBody> m_upRigidBody;
+
+    // State of the body published by the world after the step
+    // NOTE: Do not free. The world owns this pointer.
+    const CPhysicsWorld3D::SBodyState * m_pState = nullptr;
 };
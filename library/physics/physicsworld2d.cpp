@@ -11,8 +11,11 @@
 // Game lib dependencies
 #include <utilities/xmlParser.h>
 #include <utilities/highresolutiontimer.h>
-#include <utilities/mathfunc.h>
 #include <utilities/exceptionhandling.h>
+#include <utilities/threadpool.h>
+#include <utilities/genfunc.h>
+#include <objectdata/iobjectphysicsdata.h>
+#include <physics/box2dtaskexecutor.h>
 #include <script/scriptmanager.h>
 
 // Boost lib dependencies
@@ -20,6 +23,7 @@
 
 // Standard lib dependencies
 #include <cstring>
+#include <algorithm>
 
 // SDL lib dependencies
 #include <SDL3/SDL.h>
@@ -34,6 +38,11 @@ CPhysicsWorld2D::CPhysicsWorld2D() :
     m_stepTime(0),
     m_stepTimeSec(0),
     m_timeRatio(0),
+    m_maxSubSteps(4),
+    m_stepTimeRatio(0),
+    m_threaded(false),
+    m_stepping(false),
+    m_parallelIslands(false),
     m_velStepCount(6),
     m_posStepCount(2)
 {
@@ -46,6 +55,10 @@ CPhysicsWorld2D::CPhysicsWorld2D() :
 ************************************************************************/
 CPhysicsWorld2D::~CPhysicsWorld2D()
 {
+    // The job can't be left stepping a destroyed world
+    if( m_stepping )
+        m_stepFuture.wait();
+
     // Clear out any listeners if they were set
     m_world.SetDestructionListener(nullptr);
     m_world.SetContactListener(nullptr);
@@ -65,6 +78,16 @@ void CPhysicsWorld2D::loadFromNode( const XMLNode & node )
     {
         if( settingsNode.isAttributeSet( "active" ) )
             m_active = ( std::strcmp(settingsNode.getAttribute( "active" ), "true") == 0 );
+
+        if( settingsNode.isAttributeSet( "threaded" ) )
+            setThreaded( std::strcmp(settingsNode.getAttribute( "threaded" ), "true") == 0 );
+
+        if( settingsNode.isAttributeSet( "parallelIslands" ) )
+            setParallelIslands( std::strcmp(settingsNode.getAttribute( "parallelIslands" ), "true") == 0 );
+
+        // Solve the contacts several at a time with SIMD
+        if( settingsNode.isAttributeSet( "wideSolver" ) )
+            m_world.SetWideContactSolver( std::strcmp(settingsNode.getAttribute( "wideSolver" ), "true") == 0 );
     }
 
     // Get the world's gravity, if any are set
@@ -85,6 +108,9 @@ void CPhysicsWorld2D::loadFromNode( const XMLNode & node )
         m_velStepCount = std::atoi( steppingNode.getAttribute( "velocity" ) );
         m_posStepCount = std::atoi( steppingNode.getAttribute( "position" ) );
 
+        if( steppingNode.isAttributeSet( "maxSubSteps" ) )
+            setMaxSubSteps( std::atoi( steppingNode.getAttribute( "maxSubSteps" ) ) );
+
         float fps = std::atof( steppingNode.getAttribute( "fps" ) );
 
         // If the number is negative, get the current refresh rate
@@ -112,24 +138,12 @@ void CPhysicsWorld2D::loadFromNode( const XMLNode & node )
     // Load the group and script for the begin contact listener
     XMLNode beginContactNode = node.getChildNode( "beginContactListener" );
     if( !beginContactNode.isEmpty() )
-    {
-        std::string group = beginContactNode.getAttribute( "group" );
-        std::string script = beginContactNode.getAttribute( "script" );
-
-        if( !group.empty() && !script.empty() )
-            m_beginContactTuple = {group, script};
-    }
+        loadContactListener( beginContactNode, m_beginContact );
 
     // Load the group and script for the end contact listener
     XMLNode endContactNode = node.getChildNode( "endContactListener" );
     if( !endContactNode.isEmpty() )
-    {
-        std::string group = endContactNode.getAttribute( "group" );
-        std::string script = endContactNode.getAttribute( "script" );
-
-        if( !group.empty() && !script.empty() )
-            m_endContactTuple = {group, script};
-    }
+        loadContactListener( endContactNode, m_endContact );
 
     // Load the group and script for the delete fixture listener
     XMLNode deleteFixtureNode = node.getChildNode( "deleteFixtureListener" );
@@ -139,10 +153,10 @@ void CPhysicsWorld2D::loadFromNode( const XMLNode & node )
         std::string script = deleteFixtureNode.getAttribute( "script" );
 
         if( !group.empty() && !script.empty() )
-            m_deleteFixtureTuple = {group, script};
+            m_deleteFixtureHandle.set( group, script );
     }
 
-    // Load the group and script for the delete fixture listener
+    // Load the group and script for the delete joint listener
     XMLNode deleteJointNode = node.getChildNode( "deleteJointListener" );
     if( !deleteJointNode.isEmpty() )
     {
@@ -150,21 +164,47 @@ void CPhysicsWorld2D::loadFromNode( const XMLNode & node )
         std::string script = deleteJointNode.getAttribute( "script" );
 
         if( !group.empty() && !script.empty() )
-            m_deleteFixtureTuple = {group, script};
+            m_deleteJointHandle.set( group, script );
     }
 }
 
 
+/************************************************************************
+*    DESC:  Load the group, script and contact settings of the listener
+************************************************************************/
+void CPhysicsWorld2D::loadContactListener( const XMLNode & node, SContactListener & rListener )
+{
+    std::string group = node.getAttribute( "group" );
+    std::string script = node.getAttribute( "script" );
+
+    if( !group.empty() && !script.empty() )
+        rListener.handle.set( group, script );
+
+    // Send the contacts of the step as a list in one call
+    if( node.isAttributeSet( "batch" ) )
+        rListener.batch = ( std::strcmp(node.getAttribute( "batch" ), "true") == 0 );
+
+    // Only send contacts with fixtures in these categories
+    if( node.isAttributeSet( "categoryBits" ) )
+        rListener.categoryBits = std::atoi( node.getAttribute( "categoryBits" ) );
+}
+
+
 /************************************************************************
 *    DESC:  Get the world
 ************************************************************************/
 const b2World & CPhysicsWorld2D::getWorld() const
 {
+    if( m_stepping )
+        m_stepFuture.wait();
+
     return m_world;
 }
 
 b2World & CPhysicsWorld2D::getWorld()
 {
+    syncStep();
+
     return m_world;
 }
 
@@ -175,6 +215,8 @@ b2World & CPhysicsWorld2D::getWorld()
 ************************************************************************/
 b2Body * CPhysicsWorld2D::createBody( const b2BodyDef & pDef )
 {
+    syncStep();
+
     // NOTE: Class doesn't not own the data. Do Not Delete!
     b2Body * pBody = m_world.CreateBody( &pDef );
 
@@ -183,7 +225,12 @@ b2Body * CPhysicsWorld2D::createBody( const b2BodyDef & pDef )
             boost::str( boost::format("Error creating physics body.\n\n%s\nLine: %s")
                 % __FUNCTION__ % __LINE__ ));
 
-    m_pBodySet.insert( pBody );
+    SBodyState & rState = m_pBodyMap[pBody];
+    rState.stepPrevTransform = pBody->GetTransform();
+    rState.prevTransform = rState.stepPrevTransform;
+    rState.transform = rState.stepPrevTransform;
+    rState.angle = pBody->GetAngle();
+    rState.awake = pBody->IsAwake();
 
     return pBody;
 }
@@ -195,16 +242,178 @@ b2Body * CPhysicsWorld2D::createBody( const b2BodyDef & pDef )
 ************************************************************************/
 void CPhysicsWorld2D::destroyBody( b2Body * pBody )
 {
-    auto iter = m_pBodySet.find( pBody );
+    // Sends the events of the step while the sprite of the body
+    // is still around and runs the commands queued for the body
+    syncStep();
+
+    auto iter = m_pBodyMap.find( pBody );
 
-    if( iter != m_pBodySet.end() )
+    if( iter != m_pBodyMap.end() )
     {
+        std::vector<void *> pUserDataVec;
+        for( b2Fixture * pFixture = pBody->GetFixtureList(); pFixture != nullptr; pFixture = pFixture->GetNext() )
+        {
+            if( pFixture->GetUserData() != nullptr )
+                pUserDataVec.push_back( pFixture->GetUserData() );
+        }
+
         // Destroy the body
         m_world.DestroyBody( pBody );
 
-        // Remove the body from the set
-        m_pBodySet.erase( iter );
+        // Destroying the body ends its contacts. Don't keep them
+        // for the list because the sprite is going away
+        if( !pUserDataVec.empty() )
+            eraseContacts( m_endContact, pUserDataVec );
+
+        // Remove the body from the map
+        m_pBodyMap.erase( iter );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Create the body by reviving one parked in the pool
+************************************************************************/
+b2Body * CPhysicsWorld2D::createBody( const b2BodyDef & def, CBodyPool2D & rPool )
+{
+    syncStep();
+
+    b2Body * pBody = rPool.reuse();
+
+    if( pBody == nullptr )
+        return createBody( def );
+
+    // Start from the definition like a new body
+    pBody->SetTransform( def.position, def.angle );
+    pBody->SetLinearDamping( def.linearDamping );
+    pBody->SetAngularDamping( def.angularDamping );
+    pBody->SetGravityScale( def.gravityScale );
+    pBody->SetFixedRotation( def.fixedRotation );
+    pBody->SetBullet( def.bullet );
+    pBody->SetSleepingAllowed( def.allowSleep );
+    pBody->SetLinearVelocity( def.linearVelocity );
+    pBody->SetAngularVelocity( def.angularVelocity );
+    pBody->SetUserData( def.userData );
+
+    // The fixture list is in the reverse order of the definitions. The
+    // filter and sensor could have been changed on the last use
+    const auto & fixtureDefVec = rPool.getFixtureDefVec();
+    size_t index = fixtureDefVec.size();
+
+    for( b2Fixture * pFixture = pBody->GetFixtureList(); (pFixture != nullptr) && (index > 0); pFixture = pFixture->GetNext() )
+    {
+        const b2FixtureDef & rFixtureDef = fixtureDefVec[--index];
+        pFixture->SetUserData( def.userData );
+        pFixture->SetSensor( rFixtureDef.isSensor );
+        pFixture->SetFilterData( rFixtureDef.filter );
+    }
+
+    // Put the body back into the broadphase
+    pBody->SetActive( true );
+    pBody->SetAwake( def.awake );
+
+    m_pBodyMap[pBody];
+    resetBodyState( pBody );
+
+    return pBody;
+}
+
+
+/************************************************************************
+*    DESC:  Destroy the body by parking it in the pool. The body is
+*           destroyed if the pool is full
+************************************************************************/
+void CPhysicsWorld2D::destroyBody( b2Body * pBody, CBodyPool2D & rPool )
+{
+    syncStep();
+
+    auto iter = m_pBodyMap.find( pBody );
+
+    if( iter != m_pBodyMap.end() )
+    {
+        if( !rPool.park( pBody ) )
+        {
+            destroyBody( pBody );
+            return;
+        }
+
+        std::vector<void *> pUserDataVec;
+        for( b2Fixture * pFixture = pBody->GetFixtureList(); pFixture != nullptr; pFixture = pFixture->GetNext() )
+        {
+            if( pFixture->GetUserData() != nullptr )
+                pUserDataVec.push_back( pFixture->GetUserData() );
+        }
+
+        // Pull the body out of the broadphase. This ends its contacts
+        // without the destruction listener being called for the fixtures
+        pBody->SetActive( false );
+
+        if( !pUserDataVec.empty() )
+            eraseContacts( m_endContact, pUserDataVec );
+
+        // The sprite is going away
+        pBody->SetUserData( nullptr );
+        for( b2Fixture * pFixture = pBody->GetFixtureList(); pFixture != nullptr; pFixture = pFixture->GetNext() )
+            pFixture->SetUserData( nullptr );
+
+        m_pBodyMap.erase( iter );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Create the body of the object's physics data from the pool.
+*           A parked body is revived with its fixtures. A new body gets
+*           fixtures of the pool's shapes, which are built on first use
+************************************************************************/
+b2Body * CPhysicsWorld2D::createBody(
+    b2BodyDef def,
+    const iObjectPhysicsData & physicsData,
+    CBodyPool2D & rPool,
+    const CSize<float> & size,
+    const CSize<float> & scale,
+    const std::string & name )
+{
+    // Fill in the body structure
+    def.type = physicsData.getBodyType();
+    def.linearDamping = physicsData.getLinearDamping();
+    def.angularDamping = physicsData.getAngularDamping();
+    def.fixedRotation = physicsData.isRotationFixed();
+    def.bullet = physicsData.isBullet();
+    def.allowSleep = physicsData.allowSleep();
+
+    b2Body * pBody = createBody( def, rPool );
+
+    if( pBody->GetFixtureList() == nullptr )
+    {
+        if( !rPool.hasShapes() )
+            rPool.createShapes( physicsData, size, scale, 1.f / m_pixelsPerMeter, name );
+
+        rPool.createFixtures( pBody, def.userData, name );
+    }
+
+    return pBody;
+}
+
+
+/************************************************************************
+*    DESC:  Get the body pool of the object data and scale. Made on first use
+*           NOTE: Found without building a key so spawning doesn't allocate
+************************************************************************/
+CBodyPool2D & CPhysicsWorld2D::getBodyPool(
+    const std::string & group, const std::string & name, float scaleX, float scaleY, int maxSize )
+{
+    auto iter = m_bodyPoolMap.find( SBodyPoolKeyRef{group, name, scaleX, scaleY} );
+
+    if( iter == m_bodyPoolMap.end() )
+    {
+        iter = m_bodyPoolMap.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(SBodyPoolKey{group, name, scaleX, scaleY}),
+            std::forward_as_tuple(maxSize) ).first;
     }
+
+    return iter->second;
 }
 
 
@@ -212,21 +421,68 @@ void CPhysicsWorld2D::destroyBody( b2Body * pBody )
 *    DESC:  Perform fixed time step physics simulation
 ************************************************************************/
 void CPhysicsWorld2D::fixedTimeStep()
+{
+    fixedTimeStepElapsed( CHighResTimer::Instance().getElapsedTime() );
+}
+
+void CPhysicsWorld2D::fixedTimeStepElapsed( float elapsedTime )
 {
     if( m_active )
     {
-        // Increment the timer
-        m_timer += CHighResTimer::Instance().getElapsedTime();
+        if( m_threaded )
+            startStepJob( &CPhysicsWorld2D::stepFixed, elapsedTime );
+        else
+            finishStep( stepFixed( elapsedTime ) );
+    }
+}
 
-        if( m_timer > m_stepTime )
-        {
-            m_timer = NMathFunc::Modulus( m_timer, m_stepTime );
 
-            // Begin the physics world step
-            m_world.Step( m_stepTimeSec, m_velStepCount, m_posStepCount );
-        }
+/************************************************************************
+*    DESC:  Step the world at a fixed time step
+*           Returns the number of steps
+************************************************************************/
+int CPhysicsWorld2D::stepFixed( float elapsedTime )
+{
+    int stepCount = 0;
+
+    // Accumulate the frame time
+    m_timer += elapsedTime;
+
+    // Limit how far behind the simulation can catch up in one frame so a slow
+    // frame doesn't make the next one slower. Time over the limit is dropped
+    const float maxTime = m_stepTime * m_maxSubSteps;
+    if( m_timer > maxTime )
+        m_timer = maxTime;
+
+    while( m_timer >= m_stepTime )
+    {
+        m_timer -= m_stepTime;
+
+        // The sprites are interpolated from the transforms before the last step
+        if( m_timer < m_stepTime )
+            savePrevTransforms();
+
+        // Begin the physics world step
+        m_world.Step( m_stepTimeSec, m_velStepCount, m_posStepCount );
+        m_impulseIndexMap.clear();
+        ++stepCount;
+    }
+
+    m_stepTimeRatio = m_timer / m_stepTime;
+
+    return stepCount;
+}
+
 
-        m_timeRatio = m_timer / m_stepTime;
+/************************************************************************
+*    DESC:  Save the transforms of the moving bodies before the last step
+************************************************************************/
+void CPhysicsWorld2D::savePrevTransforms()
+{
+    for( auto & iter : m_pBodyMap )
+    {
+        if( iter.first->GetType() != b2_staticBody )
+            iter.second.stepPrevTransform = iter.first->GetTransform();
     }
 }
 
@@ -237,8 +493,86 @@ void CPhysicsWorld2D::variableTimeStep()
 {
     if( m_active )
     {
-        // Begin the physics world step
-        m_world.Step( CHighResTimer::Instance().getElapsedTime() / 1000.f, m_velStepCount, m_posStepCount );
+        if( m_threaded )
+            startStepJob( &CPhysicsWorld2D::stepVariable, CHighResTimer::Instance().getElapsedTime() );
+        else
+            finishStep( stepVariable( CHighResTimer::Instance().getElapsedTime() ) );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Step the world at a variable time step
+************************************************************************/
+int CPhysicsWorld2D::stepVariable( float elapsedTime )
+{
+    // Begin the physics world step
+    m_world.Step( elapsedTime / 1000.f, m_velStepCount, m_posStepCount );
+    m_impulseIndexMap.clear();
+
+    // Nothing to interpolate. The sprites use the current transforms
+    m_stepTimeRatio = 1.f;
+
+    return 1;
+}
+
+
+/************************************************************************
+*    DESC:  Start the step on a job after finishing the last one
+*           The sprites show the last step while this one runs
+************************************************************************/
+void CPhysicsWorld2D::startStepJob( int (CPhysicsWorld2D::*stepFunc)(float), float elapsedTime )
+{
+    if( m_stepping )
+        syncStep();
+    else
+        finishStep( 0 );
+
+    m_stepping = true;
+    m_stepFuture = CThreadPool::Instance().post( stepFunc, this, elapsedTime );
+}
+
+
+/************************************************************************
+*    DESC:  Finish the step. Publish the body states, send the
+*           listener events and run the queued commands
+************************************************************************/
+void CPhysicsWorld2D::finishStep( int stepCount )
+{
+    if( stepCount > 0 )
+        publishBodyStates();
+
+    m_timeRatio = m_stepTimeRatio;
+
+    for( auto & iter : m_listenerEventVec )
+        prepareListener( *iter.pHandle, iter.pVoidA, iter.pVoidB );
+
+    m_listenerEventVec.clear();
+
+    sendContacts( m_beginContact );
+    sendContacts( m_endContact );
+
+    runCommands();
+}
+
+
+/************************************************************************
+*    DESC:  Copy the states of the moving bodies for the sprites
+************************************************************************/
+void CPhysicsWorld2D::publishBodyStates()
+{
+    for( auto & iter : m_pBodyMap )
+    {
+        b2Body * pBody = iter.first;
+
+        if( pBody->GetType() != b2_staticBody )
+        {
+            SBodyState & rState = iter.second;
+            rState.prevTransform = rState.stepPrevTransform;
+            rState.transform = pBody->GetTransform();
+            rState.angle = pBody->GetAngle();
+            rState.awake = pBody->IsAwake();
+        }
     }
 }
 
@@ -272,6 +606,17 @@ void CPhysicsWorld2D::setFPS( float fps )
 }
 
 
+/************************************************************************
+*    DESC:  Set the max number of steps a fixed time step can catch up
+*           in one frame
+************************************************************************/
+void CPhysicsWorld2D::setMaxSubSteps( int value )
+{
+    if( value > 0 )
+        m_maxSubSteps = value;
+}
+
+
 /************************************************************************
 *    DESC:  The the time ratio
 ************************************************************************/
@@ -281,6 +626,132 @@ float CPhysicsWorld2D::getTimeRatio() const
 }
 
 
+/************************************************************************
+*    DESC:  Get the published state of the body
+*           NOTE: The pointer stays valid until the body is destroyed
+************************************************************************/
+CPhysicsWorld2D::SBodyState * CPhysicsWorld2D::getBodyState( b2Body * pBody )
+{
+    auto iter = m_pBodyMap.find( pBody );
+    if( iter != m_pBodyMap.end() )
+        return &iter->second;
+
+    return nullptr;
+}
+
+
+/************************************************************************
+*    DESC:  Reset the published state of the body to its current transform
+*           NOTE: Only call when the world isn't stepping
+************************************************************************/
+void CPhysicsWorld2D::resetBodyState( b2Body * pBody )
+{
+    auto iter = m_pBodyMap.find( pBody );
+    if( iter != m_pBodyMap.end() )
+    {
+        SBodyState & rState = iter->second;
+        rState.stepPrevTransform = pBody->GetTransform();
+        rState.prevTransform = rState.stepPrevTransform;
+        rState.transform = rState.stepPrevTransform;
+        rState.angle = pBody->GetAngle();
+        rState.awake = pBody->IsAwake();
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Set-Get stepping the world on a job while the frame is
+*           updated and rendered. Needs the thread pool
+************************************************************************/
+void CPhysicsWorld2D::setThreaded( bool value )
+{
+    // Finish the last step before changing how the world is stepped
+    syncStep();
+
+    if( value && (!CThreadPool::Instance().isActive() || (CThreadPool::Instance().threadCount() == 0)) )
+    {
+        NGenFunc::PostDebugMsg( "WARNING: No thread pool to step the physics world on!" );
+        value = false;
+    }
+
+    m_threaded = value;
+}
+
+bool CPhysicsWorld2D::isThreaded() const
+{
+    return m_threaded;
+}
+
+
+/************************************************************************
+*    DESC:  Set-Get solving the islands of the step on the thread pool.
+*           The results are the same as solving them one at a time
+************************************************************************/
+void CPhysicsWorld2D::setParallelIslands( bool value )
+{
+    // The world can't change executors in the middle of a step
+    syncStep();
+
+    if( value && (!CThreadPool::Instance().isActive() || (CThreadPool::Instance().threadCount() == 0)) )
+    {
+        NGenFunc::PostDebugMsg( "WARNING: No thread pool to solve the physics islands on!" );
+        value = false;
+    }
+
+    m_parallelIslands = value;
+
+    if( value )
+        m_world.SetTaskExecutor(&CBox2DTaskExecutor::Instance());
+    else
+        m_world.SetTaskExecutor(nullptr);
+}
+
+bool CPhysicsWorld2D::isParallelIslands() const
+{
+    return m_parallelIslands;
+}
+
+
+/************************************************************************
+*    DESC:  Run a command that changes a body. Queued while the world is
+*           stepping on a job and run before the next step
+************************************************************************/
+void CPhysicsWorld2D::runCommand( std::function<void()> && command )
+{
+    if( m_stepping )
+        m_commandVec.push_back( std::move(command) );
+    else
+        command();
+}
+
+
+/************************************************************************
+*    DESC:  Run the queued commands
+************************************************************************/
+void CPhysicsWorld2D::runCommands()
+{
+    for( auto & iter : m_commandVec )
+        iter();
+
+    m_commandVec.clear();
+}
+
+
+/************************************************************************
+*    DESC:  Finish the step running on a job so the bodies can be used
+************************************************************************/
+void CPhysicsWorld2D::syncStep()
+{
+    if( m_stepping )
+    {
+        const int stepCount = m_stepFuture.get();
+        m_stepping = false;
+
+        finishStep( stepCount );
+    }
+}
+
+
 /************************************************************************
 *    DESC:  Set the activity of the physics world
 ************************************************************************/
@@ -313,6 +784,8 @@ double CPhysicsWorld2D::getPixelsPerMeter() const
 ************************************************************************/
 void CPhysicsWorld2D::EnableContactListener( bool enable )
 {
+    syncStep();
+
     if( enable )
         m_world.SetContactListener(this);
     else
@@ -321,6 +794,8 @@ void CPhysicsWorld2D::EnableContactListener( bool enable )
 
 void CPhysicsWorld2D::EnableDestructionListener( bool enable )
 {
+    syncStep();
+
     if( enable )
         m_world.SetDestructionListener(this);
     else
@@ -333,37 +808,123 @@ void CPhysicsWorld2D::EnableDestructionListener( bool enable )
 ************************************************************************/
 void CPhysicsWorld2D::BeginContact(b2Contact* contact)
 {
-    void * pVoidA = contact->GetFixtureA()->GetUserData();
-    void * pVoidB = contact->GetFixtureB()->GetUserData();
+    contactEvent( m_beginContact, contact, true );
+}
+
+
+/************************************************************************
+*    DESC:  Called when two fixtures cease to touch
+************************************************************************/
+void CPhysicsWorld2D::EndContact(b2Contact* contact)
+{
+    contactEvent( m_endContact, contact, false );
+}
+
 
-    if( (pVoidA != nullptr) && (pVoidB != nullptr) && !std::get<0>(m_beginContactTuple).empty() )
+/************************************************************************
+*    DESC:  Called after the solver with the contact impulse
+************************************************************************/
+void CPhysicsWorld2D::PostSolve(b2Contact* contact, const b2ContactImpulse* impulse)
+{
+    if( !m_impulseIndexMap.empty() )
     {
-        // Can't pass as void * so just doing a typecast to avoid an error.
-        // The type doesn't really matter and avoinding adding a CSprite dependancy.
-        CScriptMgr::Instance().prepare(
-            std::get<0>(m_beginContactTuple), std::get<1>(m_beginContactTuple), {(char *)pVoidA, (char *)pVoidB});
+        auto iter = m_impulseIndexMap.find( contact );
+        if( iter != m_impulseIndexMap.end() )
+        {
+            // Keep the impulse of the first solve. That's the impact
+            float & rImpulse = m_beginContact.contactVec[iter->second].impulse;
+            for( int32 i = 0; i < impulse->count; ++i )
+                rImpulse = std::max( rImpulse, impulse->normalImpulses[i] );
+
+            m_impulseIndexMap.erase( iter );
+        }
     }
 }
 
 
 /************************************************************************
-*    DESC:  Called when two fixtures cease to touch
+*    DESC:  Send or save the contact for the listener
 ************************************************************************/
-void CPhysicsWorld2D::EndContact(b2Contact* contact)
+void CPhysicsWorld2D::contactEvent( SContactListener & rListener, b2Contact * contact, bool saveImpulse )
 {
-    void * pVoidA = contact->GetFixtureA()->GetUserData();
-    void * pVoidB = contact->GetFixtureB()->GetUserData();
+    const b2Fixture * pFixtureA = contact->GetFixtureA();
+    const b2Fixture * pFixtureB = contact->GetFixtureB();
+    void * pVoidA = pFixtureA->GetUserData();
+    void * pVoidB = pFixtureB->GetUserData();
+
+    if( (pVoidA == nullptr) || (pVoidB == nullptr) || rListener.handle.isEmpty() )
+        return;
 
-    if( (pVoidA != nullptr) && (pVoidB != nullptr) && !std::get<0>(m_endContactTuple).empty() )
+    // Filter out the contacts the listener doesn't care about
+    if( ((pFixtureA->GetFilterData().categoryBits | pFixtureB->GetFilterData().categoryBits) & rListener.categoryBits) == 0 )
+        return;
+
+    if( rListener.batch )
+    {
+        // Not set if the contact has no points
+        b2WorldManifold worldManifold;
+        worldManifold.normal.SetZero();
+        contact->GetWorldManifold( &worldManifold );
+
+        // Sensors aren't solved so there's no impulse to wait for
+        if( saveImpulse && !pFixtureA->IsSensor() && !pFixtureB->IsSensor() )
+            m_impulseIndexMap.emplace( contact, rListener.contactVec.size() );
+
+        rListener.contactVec.push_back( {pVoidA, pVoidB, worldManifold.normal.x, worldManifold.normal.y, 0.f} );
+    }
+    else
     {
-        // Can't pass as void * so just doing a typecast to avoid an error.
-        // The type doesn't really matter and avoinding adding a CSprite dependancy.
-        CScriptMgr::Instance().prepare(
-            std::get<0>(m_endContactTuple), std::get<1>(m_endContactTuple), {(char *)pVoidA, (char *)pVoidB});
+        listenerEvent( rListener.handle, pVoidA, pVoidB );
     }
 }
 
 
+/************************************************************************
+*    DESC:  Send the contacts saved during the step as a list.
+*           The list sent last time is reused so the one the script
+*           has stays valid until the next step finishes
+************************************************************************/
+void CPhysicsWorld2D::sendContacts( SContactListener & rListener )
+{
+    if( !rListener.contactVec.empty() )
+    {
+        rListener.sentContactVec.swap( rListener.contactVec );
+        rListener.contactVec.clear();
+
+        sendContactList( rListener.handle, rListener.sentContactVec );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Send the contacts of the step as a list to the listener script
+************************************************************************/
+void CPhysicsWorld2D::sendContactList( const CScriptFuncHandle & handle, std::vector<CContact2D> & rContactVec )
+{
+    CScriptMgr::Instance().prepare( handle, {&rContactVec} );
+}
+
+
+/************************************************************************
+*    DESC:  Remove the saved contacts with the user data
+************************************************************************/
+void CPhysicsWorld2D::eraseContacts( SContactListener & rListener, const std::vector<void *> & pUserDataVec )
+{
+    auto & rContactVec = rListener.contactVec;
+
+    rContactVec.erase(
+        std::remove_if(
+            rContactVec.begin(),
+            rContactVec.end(),
+            [&pUserDataVec](const CContact2D & rContact)
+            {
+                return (std::find(pUserDataVec.begin(), pUserDataVec.end(), rContact.pUserDataA) != pUserDataVec.end()) ||
+                       (std::find(pUserDataVec.begin(), pUserDataVec.end(), rContact.pUserDataB) != pUserDataVec.end());
+            } ),
+        rContactVec.end() );
+}
+
+
 /************************************************************************
 *    DESC:  Called when any fixture is about to be destroyed
 ************************************************************************/
@@ -371,11 +932,8 @@ void CPhysicsWorld2D::SayGoodbye(b2Fixture* fixture)
 {
     void * pVoid = fixture->GetUserData();
 
-    if( (pVoid != nullptr) && !std::get<0>(m_deleteFixtureTuple).empty() )
-        // Can't pass as void * so just doing a typecast to avoid an error.
-        // The type doesn't really matter and avoinding adding a CSprite dependancy.
-        CScriptMgr::Instance().prepare(
-            std::get<0>(m_deleteFixtureTuple), std::get<1>(m_deleteFixtureTuple), {(char *)pVoid});
+    if( (pVoid != nullptr) && !m_deleteFixtureHandle.isEmpty() )
+        listenerEvent( m_deleteFixtureHandle, pVoid );
 }
 
 
@@ -386,9 +944,33 @@ void CPhysicsWorld2D::SayGoodbye(b2Joint* joint)
 {
     void * pVoid = joint->GetUserData();
 
-    if( (pVoid != nullptr) && !std::get<0>(m_deleteJointTuple).empty() )
-        // Can't pass as void * so just doing a typecast to avoid an error.
-        // The type doesn't really matter and avoinding adding a CSprite dependancy.
-        CScriptMgr::Instance().prepare(
-            std::get<0>(m_deleteJointTuple), std::get<1>(m_deleteJointTuple), {(char *)pVoid});
+    if( (pVoid != nullptr) && !m_deleteJointHandle.isEmpty() )
+        listenerEvent( m_deleteJointHandle, pVoid );
+}
+
+
+/************************************************************************
+*    DESC:  Call the listener script or save it for after the step.
+*           The scripts can't be prepared from the job
+************************************************************************/
+void CPhysicsWorld2D::listenerEvent( const CScriptFuncHandle & handle, void * pVoidA, void * pVoidB )
+{
+    if( m_stepping )
+        m_listenerEventVec.push_back( {&handle, pVoidA, pVoidB} );
+    else
+        prepareListener( handle, pVoidA, pVoidB );
+}
+
+
+/************************************************************************
+*    DESC:  Prepare the listener script to run
+************************************************************************/
+void CPhysicsWorld2D::prepareListener( const CScriptFuncHandle & handle, void * pVoidA, void * pVoidB )
+{
+    // Can't pass as void * so just doing a typecast to avoid an error.
+    // The type doesn't really matter and avoinding adding a CSprite dependancy.
+    if( pVoidB != nullptr )
+        CScriptMgr::Instance().prepare( handle, {(char *)pVoidA, (char *)pVoidB} );
+    else
+        CScriptMgr::Instance().prepare( handle, {(char *)pVoidA} );
 }
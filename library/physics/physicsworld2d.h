@@ -10,19 +10,43 @@
 // Game lib dependencies
 #include <Box2D/Box2D.h>
 #include <common/point.h>
+#include <common/size.h>
+#include <physics/contact2d.h>
+#include <physics/bodypool2d.h>
+#include <script/scriptfunchandle.h>
 
 // Standard lib dependencies
 #include <string>
+#include <unordered_map>
+#include <map>
 #include <tuple>
-#include <unordered_set>
+#include <vector>
+#include <functional>
+#include <future>
 
 // Forward declaration(s)
 struct XMLNode;
+class iObjectPhysicsData;
 
 class CPhysicsWorld2D : public b2ContactListener, b2DestructionListener
 {
 public:
 
+    // State of the body published after the step for the sprite
+    struct SBodyState
+    {
+        // Transform before the last step. Only used by the step
+        b2Transform stepPrevTransform;
+
+        // Transforms before and after the last step and the body angle which isn't wrapped
+        b2Transform prevTransform;
+        b2Transform transform;
+        float angle = 0.f;
+
+        // Is the body awake
+        bool awake = false;
+    };
+
     // Constructor
     CPhysicsWorld2D();
 
@@ -40,8 +64,28 @@ public:
     b2Body * createBody( const b2BodyDef & pDef );
     void destroyBody( b2Body * pBody );
 
-    // Perform fixed time step physics simulation
+    // Create the body by reviving one parked in the pool and destroy
+    // the body by parking it. Parked bodies are inactive
+    b2Body * createBody( const b2BodyDef & def, CBodyPool2D & rPool );
+    void destroyBody( b2Body * pBody, CBodyPool2D & rPool );
+
+    // Create the body of the object's physics data from the pool. The def has the
+    // position, angle and user data. The size and scale of the object are in pixels
+    b2Body * createBody(
+        b2BodyDef def,
+        const iObjectPhysicsData & physicsData,
+        CBodyPool2D & rPool,
+        const CSize<float> & size,
+        const CSize<float> & scale,
+        const std::string & name );
+
+    // Get the body pool of the object data and scale. Made on first use
+    CBodyPool2D & getBodyPool(
+        const std::string & group, const std::string & name, float scaleX, float scaleY, int maxSize );
+
+    // Perform fixed time step physics simulation of the frame's or the passed in elapsed time
     void fixedTimeStep();
+    void fixedTimeStepElapsed( float elapsedTime );
     
     // Perform variable time step physics simulation
     void variableTimeStep();
@@ -52,9 +96,34 @@ public:
     // Set the fps to run the simulation at
     void setFPS( float fps );
 
+    // Set the max number of steps a fixed time step can catch up in one frame
+    void setMaxSubSteps( int value );
+
     // The the time ratio
     float getTimeRatio() const;
 
+    // Get the published state of the body
+    // NOTE: The pointer stays valid until the body is destroyed
+    SBodyState * getBodyState( b2Body * pBody );
+
+    // Reset the published state of the body to its current transform
+    void resetBodyState( b2Body * pBody );
+
+    // Set-Get stepping the world on a job while the frame is updated and rendered
+    void setThreaded( bool value );
+    bool isThreaded() const;
+
+    // Set-Get solving the islands of the step on the thread pool
+    void setParallelIslands( bool value );
+    bool isParallelIslands() const;
+
+    // Run a command that changes a body. Queued while the world is stepping
+    // on a job and run before the next step
+    void runCommand( std::function<void()> && command );
+
+    // Finish the step running on a job so the bodies can be used
+    void syncStep();
+
     // Set-Get the activity of the physics world
     void setActive( bool value );
     bool isActive() const;
@@ -66,6 +135,11 @@ public:
     void EnableContactListener( bool enable = true );
     void EnableDestructionListener( bool enable = true );
 
+protected:
+
+    // Send the contacts of the step as a list to the listener script
+    virtual void sendContactList( const CScriptFuncHandle & handle, std::vector<CContact2D> & rContactVec );
+
 private:
 
     // Called when two fixtures begin to touch
@@ -74,12 +148,101 @@ private:
     // Called when two fixtures cease to touch
     void EndContact(b2Contact* contact) override;
 
+    // Called after the solver with the contact impulse
+    void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override;
+
     // Called when any fixture is about to be destroyed
     void SayGoodbye(b2Fixture* fixture) override;
     
     // Called when any joint is about to be destroyed
     void SayGoodbye(b2Joint* joint) override;
 
+    // Save the transforms of the moving bodies before the last step
+    void savePrevTransforms();
+
+    // Step the world at a fixed or variable time step. Returns the number of steps
+    int stepFixed( float elapsedTime );
+    int stepVariable( float elapsedTime );
+
+    // Start the step on a job after finishing the last one
+    void startStepJob( int (CPhysicsWorld2D::*stepFunc)(float), float elapsedTime );
+
+    // Finish the step. Publish the body states, send the listener
+    // events and run the queued commands
+    void finishStep( int stepCount );
+
+    // Copy the states of the moving bodies for the sprites
+    void publishBodyStates();
+
+    // Run the queued commands
+    void runCommands();
+
+    // Call the listener script or save it for after the step
+    void listenerEvent( const CScriptFuncHandle & handle, void * pVoidA, void * pVoidB = nullptr );
+
+    // Prepare the listener script to run
+    void prepareListener( const CScriptFuncHandle & handle, void * pVoidA, void * pVoidB );
+
+    // Contact listener. Contacts are sent one pair per call or saved
+    // during the step and sent as a list in one call
+    struct SContactListener
+    {
+        CScriptFuncHandle handle;
+
+        // Send the contacts as a list
+        bool batch = false;
+
+        // Only contacts where a fixture has one of these category bits are sent
+        uint16 categoryBits = 0xFFFF;
+
+        // Contacts saved during the step and the ones sent to the script
+        std::vector<CContact2D> contactVec;
+        std::vector<CContact2D> sentContactVec;
+    };
+
+    // Load the group, script and contact settings of the listener
+    void loadContactListener( const XMLNode & node, SContactListener & rListener );
+
+    // Send or save the contact for the listener
+    void contactEvent( SContactListener & rListener, b2Contact * contact, bool saveImpulse );
+
+    // Send the contacts saved during the step as a list
+    void sendContacts( SContactListener & rListener );
+
+    // Remove the saved contacts with the user data
+    void eraseContacts( SContactListener & rListener, const std::vector<void *> & pUserDataVec );
+
+    // Key of the body pools. The shapes are scaled by the sprite so
+    // the pool is of the object data and scale
+    struct SBodyPoolKey
+    {
+        std::string group;
+        std::string name;
+        float scaleX;
+        float scaleY;
+    };
+
+    // Key to find a pool with without copying the names
+    struct SBodyPoolKeyRef
+    {
+        const std::string & group;
+        const std::string & name;
+        float scaleX;
+        float scaleY;
+    };
+
+    // Compares the keys and the key references
+    struct CBodyPoolKeyLess
+    {
+        using is_transparent = void;
+
+        template<typename T1, typename T2>
+        bool operator()( const T1 & a, const T2 & b ) const
+        {
+            return std::tie( a.group, a.name, a.scaleX, a.scaleY ) < std::tie( b.group, b.name, b.scaleX, b.scaleY );
+        }
+    };
+
 private:
 
     // Box2D world
@@ -88,9 +251,12 @@ private:
     // World focus point
     CPoint<int> m_focus;
 
-    // All bodies that are handled by this physics world
+    // All bodies that are handled by this physics world and their published state
     // NOTE: Class doesn't not own the data. Do Not Delete!
-    std::unordered_set<b2Body *> m_pBodySet;
+    std::unordered_map<b2Body *, SBodyState> m_pBodyMap;
+
+    // Parked bodies and shared shapes of the object data
+    std::map<SBodyPoolKey, CBodyPool2D, CBodyPoolKeyLess> m_bodyPoolMap;
 
     // If we're actively running simulations
     bool m_active;
@@ -98,7 +264,7 @@ private:
     // If we're going to start a step this frame
     bool m_beginStep;
 
-    // Timer to let us know when to do another step
+    // Accumulated time not simulated yet
     float m_timer;
 
     // The ammount of time to simulate in milliseconds
@@ -110,6 +276,40 @@ private:
     // The ratio of time between steps
     float m_timeRatio;
 
+    // Max number of steps a fixed time step can catch up in one frame
+    int m_maxSubSteps;
+
+    // Time ratio of the step. Published to m_timeRatio after the step
+    float m_stepTimeRatio;
+
+    // Step the world on a job while the frame is updated and rendered
+    bool m_threaded;
+
+    // Is a step running on a job
+    bool m_stepping;
+
+    // Solve the islands of the step on the thread pool
+    bool m_parallelIslands;
+
+    // The step running on a job
+    std::future<int> m_stepFuture;
+
+    // Commands queued while the world is stepping
+    std::vector<std::function<void()>> m_commandVec;
+
+    // Listener events saved during the step on a job
+    struct SListenerEvent
+    {
+        const CScriptFuncHandle * pHandle;
+        void * pVoidA;
+        void * pVoidB;
+    };
+
+    std::vector<SListenerEvent> m_listenerEventVec;
+
+    // Saved begin contacts waiting on the impulse of the step's solve
+    std::unordered_map<b2Contact *, size_t> m_impulseIndexMap;
+
     // The number of velocity and position steps to calculate
     int m_velStepCount;
     int m_posStepCount;
@@ -118,8 +318,8 @@ private:
     float m_pixelsPerMeter;
 
     // Listener members
-    std::tuple<std::string, std::string> m_beginContactTuple;
-    std::tuple<std::string, std::string> m_endContactTuple;
-    std::tuple<std::string, std::string> m_deleteFixtureTuple;
-    std::tuple<std::string, std::string> m_deleteJointTuple;
+    SContactListener m_beginContact;
+    SContactListener m_endContact;
+    CScriptFuncHandle m_deleteFixtureHandle;
+    CScriptFuncHandle m_deleteJointHandle;
 };
@@ -9,27 +9,38 @@
 #include <physics/physicsworld3d.h>
 
 // Game lib dependencies
+#include <physics/bullettaskscheduler.h>
 #include <utilities/xmlParser.h>
 #include <utilities/highresolutiontimer.h>
-#include <utilities/mathfunc.h>
+#include <utilities/threadpool.h>
+#include <utilities/genfunc.h>
+#include <utilities/exceptionhandling.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
 
 // Standard lib dependencies
 #include <cstring>
+#include <algorithm>
 
 /************************************************************************
  *    DESC:  Constructor
  ************************************************************************/
 CPhysicsWorld3D::CPhysicsWorld3D() :
-m_colDisp( &m_defColConf ),
-m_world( &m_colDisp, &m_broadphase, &m_conSolv, &m_defColConf ),
+m_multithreaded(false),
 m_active(false),
 m_timer(0),
 m_stepTime(0),
 m_stepTimeSec(0),
-m_timeRatio(0)
+m_timeRatio(0),
+m_maxSubSteps(4),
+m_stepTimeRatio(0),
+m_threaded(false),
+m_stepping(false)
 {
     // Init with default values
-    m_world.setGravity( btVector3(0.f, -10.f, 0.f) );
+    createWorld( std::make_unique<btDbvtBroadphase>() );
+    m_upWorld->setGravity( btVector3(0.f, -10.f, 0.f) );
     setFPS(30);
 }
 
@@ -38,6 +49,9 @@ m_timeRatio(0)
  ************************************************************************/
 CPhysicsWorld3D::~CPhysicsWorld3D()
 {
+    // The job can't be left stepping a destroyed world
+    if( m_stepping )
+        m_stepFuture.wait();
 }
 
 /************************************************************************
@@ -45,6 +59,14 @@ CPhysicsWorld3D::~CPhysicsWorld3D()
  ************************************************************************/
 void CPhysicsWorld3D::loadFromNode( const XMLNode & node )
 {
+    // The world is recreated from the settings so it can't have bodies yet
+    if( !m_pBodyMap.empty() )
+        throw NExcept::CCriticalException("Physics World 3D Load Error!",
+            boost::str( boost::format("Physics world 3D can't be loaded after bodies are added.\n\n%s\nLine: %s")
+                % __FUNCTION__ % __LINE__ ));
+
+    int threadCount = 0;
+
     // Get the world's settings, if any are set
     XMLNode settingsNode = node.getChildNode( "settings" );
     if( !settingsNode.isEmpty() )
@@ -54,8 +76,35 @@ void CPhysicsWorld3D::loadFromNode( const XMLNode & node )
             if( std::strcmp(settingsNode.getAttribute( "active" ), "true") == 0 )
                 m_active = true;
         }
+
+        if( settingsNode.isAttributeSet( "threaded" ) )
+            setThreaded( std::strcmp(settingsNode.getAttribute( "threaded" ), "true") == 0 );
+
+        if( settingsNode.isAttributeSet( "multithreaded" ) )
+            m_multithreaded = ( std::strcmp(settingsNode.getAttribute( "multithreaded" ), "true") == 0 );
+
+        // Number of threads working on the parallel loops. Zero is the thread pool plus the stepping thread
+        if( settingsNode.isAttributeSet( "threadCount" ) )
+            threadCount = std::atoi( settingsNode.getAttribute( "threadCount" ) );
+    }
+
+    if( m_multithreaded && (!CThreadPool::Instance().isActive() || (CThreadPool::Instance().threadCount() == 0)) )
+    {
+        NGenFunc::PostDebugMsg( "WARNING: No thread pool for the multithreaded physics world!" );
+        m_multithreaded = false;
     }
 
+    #if !BT_THREADSAFE
+    if( m_multithreaded )
+        NGenFunc::PostDebugMsg( "WARNING: Bullet isn't built with BT_THREADSAFE. The multithreaded physics world runs on one thread!" );
+    #endif
+
+    // Create the world with the broadphase of the settings
+    createWorld( createBroadphase( node.getChildNode( "broadphase" ) ) );
+
+    if( m_multithreaded && (threadCount > 0) )
+        CBulletTaskScheduler::Instance().setNumThreads( threadCount );
+
     // Get the world's gravity, if any are set
     XMLNode gravityNode = node.getChildNode( "gravity" );
     if( !gravityNode.isEmpty() )
@@ -64,13 +113,101 @@ void CPhysicsWorld3D::loadFromNode( const XMLNode & node )
         float y = std::atof( gravityNode.getAttribute( "y" ) );
         float z = std::atof( gravityNode.getAttribute( "z" ) );
 
-        m_world.setGravity( btVector3(x, y, z) );
+        m_upWorld->setGravity( btVector3(x, y, z) );
     }
 
     // Get the stepping which determins how accurate the physics are
     XMLNode steppingNode = node.getChildNode( "stepping" );
     if( !steppingNode.isEmpty() )
+    {
         setFPS( std::atof( steppingNode.getAttribute( "fps" ) ) );
+
+        if( steppingNode.isAttributeSet( "maxSubSteps" ) )
+            setMaxSubSteps( std::atoi( steppingNode.getAttribute( "maxSubSteps" ) ) );
+
+        // Constraint solver iterations per step
+        if( steppingNode.isAttributeSet( "iterations" ) )
+            m_upWorld->getSolverInfo().m_numIterations = std::max( std::atoi( steppingNode.getAttribute( "iterations" ) ), 1 );
+    }
+}
+
+/************************************************************************
+ *    DESC:  Create the broadphase from the node
+ *           Defaults to the dynamic AABB tree
+ ************************************************************************/
+std::unique_ptr<btBroadphaseInterface> CPhysicsWorld3D::createBroadphase( const XMLNode & node )
+{
+    if( node.isEmpty() || !node.isAttributeSet( "type" ) || (std::strcmp(node.getAttribute( "type" ), "dbvt") == 0) )
+        return std::make_unique<btDbvtBroadphase>();
+
+    if( std::strcmp(node.getAttribute( "type" ), "axisSweep") == 0 )
+    {
+        // Sweep and prune needs the bounds of the world
+        XMLNode minNode = node.getChildNode( "min" );
+        XMLNode maxNode = node.getChildNode( "max" );
+        if( minNode.isEmpty() || maxNode.isEmpty() )
+            throw NExcept::CCriticalException("Physics World 3D Load Error!",
+                boost::str( boost::format("Axis sweep broadphase needs the min and max of the world.\n\n%s\nLine: %s")
+                    % __FUNCTION__ % __LINE__ ));
+
+        const btVector3 worldMin(
+            std::atof( minNode.getAttribute( "x" ) ),
+            std::atof( minNode.getAttribute( "y" ) ),
+            std::atof( minNode.getAttribute( "z" ) ) );
+
+        const btVector3 worldMax(
+            std::atof( maxNode.getAttribute( "x" ) ),
+            std::atof( maxNode.getAttribute( "y" ) ),
+            std::atof( maxNode.getAttribute( "z" ) ) );
+
+        unsigned short maxProxies = 16384;
+        if( node.isAttributeSet( "maxProxies" ) )
+            maxProxies = std::clamp( std::atoi( node.getAttribute( "maxProxies" ) ), 2, 32766 );
+
+        return std::make_unique<btAxisSweep3>( worldMin, worldMax, maxProxies );
+    }
+
+    throw NExcept::CCriticalException("Physics World 3D Load Error!",
+        boost::str( boost::format("Unknown broadphase type (%s).\n\n%s\nLine: %s")
+            % node.getAttribute( "type" ) % __FUNCTION__ % __LINE__ ));
+}
+
+/************************************************************************
+ *    DESC:  Create the world with the broadphase. Multithreaded if set
+ ************************************************************************/
+void CPhysicsWorld3D::createWorld( std::unique_ptr<btBroadphaseInterface> && upBroadphase )
+{
+    // Free the old world before the parts it uses
+    m_upWorld.reset();
+    m_upConSolv.reset();
+    m_upSolverPool.reset();
+    m_upColDisp.reset();
+
+    m_upBroadphase = std::move( upBroadphase );
+
+    if( m_multithreaded )
+    {
+        // Bullet's per thread data is sized when the parts are created
+        CBulletTaskScheduler::Instance().install();
+        const int maxThreads = CBulletTaskScheduler::Instance().getMaxNumThreads();
+
+        // Each island is solved by one of the pooled solvers. Large islands are
+        // split into batches for the multithreaded solver
+        m_upColDisp = std::make_unique<btCollisionDispatcherMt>( &m_defColConf );
+        m_upSolverPool = std::make_unique<btConstraintSolverPoolMt>( maxThreads );
+        m_upConSolv = std::make_unique<btSequentialImpulseConstraintSolverMt>();
+
+        m_upWorld = std::make_unique<btDiscreteDynamicsWorldMt>(
+            m_upColDisp.get(), m_upBroadphase.get(), m_upSolverPool.get(), m_upConSolv.get(), &m_defColConf );
+    }
+    else
+    {
+        m_upColDisp = std::make_unique<btCollisionDispatcher>( &m_defColConf );
+        m_upConSolv = std::make_unique<btSequentialImpulseConstraintSolver>();
+
+        m_upWorld = std::make_unique<btDiscreteDynamicsWorld>(
+            m_upColDisp.get(), m_upBroadphase.get(), m_upConSolv.get(), &m_defColConf );
+    }
 }
 
 /************************************************************************
@@ -78,7 +215,10 @@ void CPhysicsWorld3D::loadFromNode( const XMLNode & node )
  ************************************************************************/
 const btDiscreteDynamicsWorld & CPhysicsWorld3D::getWorld() const
 {
-    return m_world;
+    if( m_stepping )
+        m_stepFuture.wait();
+
+    return *m_upWorld;
 }
 
 /************************************************************************
@@ -86,7 +226,10 @@ const btDiscreteDynamicsWorld & CPhysicsWorld3D::getWorld() const
  ************************************************************************/
 void CPhysicsWorld3D::addRigidBody( btRigidBody * pBody )
 {
-    m_world.addRigidBody( pBody );
+    syncStep();
+
+    m_upWorld->addRigidBody( pBody );
+    addBodyState( pBody );
 }
 
 /************************************************************************
@@ -94,7 +237,10 @@ void CPhysicsWorld3D::addRigidBody( btRigidBody * pBody )
  ************************************************************************/
 void CPhysicsWorld3D::addRigidBody( btRigidBody * pBody, short filterGroup, short mask )
 {
-    m_world.addRigidBody( pBody, filterGroup, mask );
+    syncStep();
+
+    m_upWorld->addRigidBody( pBody, filterGroup, mask );
+    addBodyState( pBody );
 }
 
 /************************************************************************
@@ -102,7 +248,21 @@ void CPhysicsWorld3D::addRigidBody( btRigidBody * pBody, short filterGroup, shor
  ************************************************************************/
 void CPhysicsWorld3D::removeRigidBody( btRigidBody * pBody )
 {
-    m_world.removeRigidBody( pBody );
+    // Runs the commands queued for the body
+    syncStep();
+
+    m_upWorld->removeRigidBody( pBody );
+    m_pBodyMap.erase( pBody );
+}
+
+/************************************************************************
+ *    DESC:  Add the body to the published states
+ ************************************************************************/
+void CPhysicsWorld3D::addBodyState( btRigidBody * pBody )
+{
+    SBodyState & rState = m_pBodyMap[pBody];
+    pBody->getMotionState()->getWorldTransform( rState.transform );
+    rState.active = pBody->isActive();
 }
 
 /************************************************************************
@@ -112,19 +272,36 @@ void CPhysicsWorld3D::fixedTimeStep()
 {
     if( m_active )
     {
-        // Increment the timer
-        m_timer += CHighResTimer::Instance().getElapsedTime();
-
-        if( m_timer > m_stepTime )
-        {
-            m_timer = NMathFunc::Modulus( m_timer, m_stepTime );
+        if( m_threaded )
+            startStepJob( &CPhysicsWorld3D::stepFixed, CHighResTimer::Instance().getElapsedTime() );
+        else
+            finishStep( stepFixed( CHighResTimer::Instance().getElapsedTime() ) );
+    }
+}
 
-            // Begin the physics world step - same as m_stepTime / 1000.0f
-            m_world.stepSimulation( m_stepTimeSec, 1, m_stepTimeSec );
-        }
+/************************************************************************
+ *    DESC:  Step the world at a fixed time step
+ *           Returns the number of steps
+ ************************************************************************/
+int CPhysicsWorld3D::stepFixed( float elapsedTime )
+{
+    // Bullet keeps its own accumulator and runs up to the max sub steps. The motion
+    // states get the transforms interpolated between the last two steps by the time
+    // left over, which is what the physics component reads.
+    const int stepCount = m_upWorld->stepSimulation( elapsedTime / 1000.f, m_maxSubSteps, m_stepTimeSec );
 
-        m_timeRatio = m_timer / m_stepTime;
+    // Track the left over time the same way for the time ratio
+    m_timer += elapsedTime;
+    if( m_timer >= m_stepTime )
+    {
+        const int steps = static_cast<int>( m_timer / m_stepTime );
+        m_timer -= steps * m_stepTime;
     }
+
+    m_stepTimeRatio = m_timer / m_stepTime;
+
+    // The motion states are interpolated even when no step was taken
+    return std::max( stepCount, 1 );
 }
 
 /************************************************************************
@@ -134,8 +311,82 @@ void CPhysicsWorld3D::variableTimeStep()
 {
     if( m_active )
     {
-        auto elapsedTime = CHighResTimer::Instance().getElapsedTime() / 1000.f;
-        m_world.stepSimulation( elapsedTime, 1, elapsedTime );
+        if( m_threaded )
+            startStepJob( &CPhysicsWorld3D::stepVariable, CHighResTimer::Instance().getElapsedTime() );
+        else
+            finishStep( stepVariable( CHighResTimer::Instance().getElapsedTime() ) );
+    }
+}
+
+/************************************************************************
+ *    DESC:  Step the world at a variable time step
+ ************************************************************************/
+int CPhysicsWorld3D::stepVariable( float elapsedTime )
+{
+    elapsedTime /= 1000.f;
+    m_upWorld->stepSimulation( elapsedTime, 1, elapsedTime );
+
+    // Nothing to interpolate. The sprites use the current transforms
+    m_stepTimeRatio = 1.f;
+
+    return 1;
+}
+
+/************************************************************************
+ *    DESC:  Start the step on a job after finishing the last one
+ *           The sprites show the last step while this one runs
+ ************************************************************************/
+void CPhysicsWorld3D::startStepJob( int (CPhysicsWorld3D::*stepFunc)(float), float elapsedTime )
+{
+    if( m_stepping )
+        syncStep();
+    else
+        finishStep( 0 );
+
+    m_stepping = true;
+    m_stepFuture = CThreadPool::Instance().post( stepFunc, this, elapsedTime );
+}
+
+/************************************************************************
+ *    DESC:  Finish the step. Publish the body states and run the
+ *           queued commands
+ ************************************************************************/
+void CPhysicsWorld3D::finishStep( int stepCount )
+{
+    if( stepCount > 0 )
+        publishBodyStates();
+
+    m_timeRatio = m_stepTimeRatio;
+
+    for( auto & iter : m_commandVec )
+        iter();
+
+    m_commandVec.clear();
+}
+
+/************************************************************************
+ *    DESC:  Copy the states of the bodies for the sprites
+ ************************************************************************/
+void CPhysicsWorld3D::publishBodyStates()
+{
+    for( auto & iter : m_pBodyMap )
+    {
+        iter.first->getMotionState()->getWorldTransform( iter.second.transform );
+        iter.second.active = iter.first->isActive();
+    }
+}
+
+/************************************************************************
+ *    DESC:  Finish the step running on a job so the bodies can be used
+ ************************************************************************/
+void CPhysicsWorld3D::syncStep()
+{
+    if( m_stepping )
+    {
+        const int stepCount = m_stepFuture.get();
+        m_stepping = false;
+
+        finishStep( stepCount );
     }
 }
 
@@ -156,6 +407,16 @@ void CPhysicsWorld3D::setFPS( float fps )
     }
 }
 
+/************************************************************************
+ *    DESC:  Set the max number of steps a fixed time step can catch up
+ *           in one frame
+ ************************************************************************/
+void CPhysicsWorld3D::setMaxSubSteps( int value )
+{
+    if( value > 0 )
+        m_maxSubSteps = value;
+}
+
 /************************************************************************
  *    DESC:  The the time ratio
  ************************************************************************/
@@ -164,6 +425,54 @@ float CPhysicsWorld3D::getTimeRatio() const
     return m_timeRatio;
 }
 
+/************************************************************************
+ *    DESC:  Get the published state of the body
+ *           NOTE: The pointer stays valid until the body is removed
+ ************************************************************************/
+const CPhysicsWorld3D::SBodyState * CPhysicsWorld3D::getBodyState( btRigidBody * pBody ) const
+{
+    auto iter = m_pBodyMap.find( pBody );
+    if( iter != m_pBodyMap.end() )
+        return &iter->second;
+
+    return nullptr;
+}
+
+/************************************************************************
+ *    DESC:  Set-Get stepping the world on a job while the frame is
+ *           updated and rendered. Needs the thread pool
+ ************************************************************************/
+void CPhysicsWorld3D::setThreaded( bool value )
+{
+    // Finish the last step before changing how the world is stepped
+    syncStep();
+
+    if( value && (!CThreadPool::Instance().isActive() || (CThreadPool::Instance().threadCount() == 0)) )
+    {
+        NGenFunc::PostDebugMsg( "WARNING: No thread pool to step the physics world on!" );
+        value = false;
+    }
+
+    m_threaded = value;
+}
+
+bool CPhysicsWorld3D::isThreaded() const
+{
+    return m_threaded;
+}
+
+/************************************************************************
+ *    DESC:  Run a command that changes a body. Queued while the world is
+ *           stepping on a job and run before the next step
+ ************************************************************************/
+void CPhysicsWorld3D::runCommand( std::function<void()> && command )
+{
+    if( m_stepping )
+        m_commandVec.push_back( std::move(command) );
+    else
+        command();
+}
+
 /************************************************************************
  *    DESC:  Set the activity of the physics world
  ************************************************************************/
@@ -179,3 +488,11 @@ bool CPhysicsWorld3D::isActive() const
 {
     return m_active;
 }
+
+/************************************************************************
+ *    DESC:  Is the world Bullet's multithreaded world
+ ************************************************************************/
+bool CPhysicsWorld3D::isMultithreaded() const
+{
+    return m_multithreaded;
+}
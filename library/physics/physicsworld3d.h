@@ -10,10 +10,20 @@
 // Bullet Physics lib dependencies
 #include <btBulletDynamicsCommon.h>
 #include <btBulletCollisionCommon.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 
 // Game lib dependencies
 #include <common/point.h>
 
+// Standard lib dependencies
+#include <unordered_map>
+#include <vector>
+#include <functional>
+#include <future>
+#include <memory>
+
 // Forward declaration(s)
 struct XMLNode;
 
@@ -21,6 +31,16 @@ class CPhysicsWorld3D
 {
 public:
 
+    // State of the body published after the step for the sprite
+    struct SBodyState
+    {
+        // Transform from the motion state
+        btTransform transform;
+
+        // Is the body active
+        bool active = false;
+    };
+
     // Constructor
     CPhysicsWorld3D();
 
@@ -51,21 +71,72 @@ public:
     // Set the fps to run the simulation at
     void setFPS( float fps );
 
+    // Set the max number of steps a fixed time step can catch up in one frame
+    void setMaxSubSteps( int value );
+
     // The the time ratio
     float getTimeRatio() const;
 
+    // Get the published state of the body
+    // NOTE: The pointer stays valid until the body is removed
+    const SBodyState * getBodyState( btRigidBody * pBody ) const;
+
+    // Set-Get stepping the world on a job while the frame is updated and rendered
+    void setThreaded( bool value );
+    bool isThreaded() const;
+
+    // Run a command that changes a body. Queued while the world is stepping
+    // on a job and run before the next step
+    void runCommand( std::function<void()> && command );
+
+    // Finish the step running on a job so the bodies can be used
+    void syncStep();
+
     // Set-Get the activity of the physics world
     void setActive( bool value );
     bool isActive() const;
 
+    // Is the world Bullet's multithreaded world
+    bool isMultithreaded() const;
+
+private:
+
+    // Create the world with the broadphase. Multithreaded if set
+    void createWorld( std::unique_ptr<btBroadphaseInterface> && upBroadphase );
+
+    // Create the broadphase from the node
+    std::unique_ptr<btBroadphaseInterface> createBroadphase( const XMLNode & node );
+
+    // Step the world at a fixed or variable time step. Returns the number of steps
+    int stepFixed( float elapsedTime );
+    int stepVariable( float elapsedTime );
+
+    // Start the step on a job after finishing the last one
+    void startStepJob( int (CPhysicsWorld3D::*stepFunc)(float), float elapsedTime );
+
+    // Finish the step. Publish the body states and run the queued commands
+    void finishStep( int stepCount );
+
+    // Copy the states of the bodies for the sprites
+    void publishBodyStates();
+
+    // Add the body to the published states
+    void addBodyState( btRigidBody * pBody );
+
 private:
 
     // Bullet Physics world members
+    // NOTE: The world is declared last so it's destroyed first
     btDefaultCollisionConfiguration m_defColConf;
-    btDbvtBroadphase m_broadphase;
-    btSequentialImpulseConstraintSolver m_conSolv;
-    btCollisionDispatcher m_colDisp;
-    btDiscreteDynamicsWorld m_world;
+    std::unique_ptr<btBroadphaseInterface> m_upBroadphase;
+    std::unique_ptr<btCollisionDispatcher> m_upColDisp;
+    std::unique_ptr<btConstraintSolverPoolMt> m_upSolverPool;
+    std::unique_ptr<btConstraintSolver> m_upConSolv;
+    std::unique_ptr<btDiscreteDynamicsWorld> m_upWorld;
+
+    // Use Bullet's multithreaded world. The islands are solved and the
+    // contacts are found in parallel on the thread pool
+    bool m_multithreaded;
 
     // If we're actively running simulations
     bool m_active;
@@ -73,7 +144,7 @@ private:
     // If we're going to start a step this frame
     bool m_beginStep;
 
-    // Timer to let us know when to do another step
+    // Accumulated time not simulated yet
     float m_timer;
 
     // The ammount of time to simulate in milliseconds
@@ -84,4 +155,26 @@ private:
 
     // The ratio of time between steps
     float m_timeRatio;
+
+    // Max number of steps a fixed time step can catch up in one frame
+    int m_maxSubSteps;
+
+    // All bodies that are handled by this physics world and their published state
+    // NOTE: Class doesn't not own the data. Do Not Delete!
+    std::unordered_map<btRigidBody *, SBodyState> m_pBodyMap;
+
+    // Time ratio of the step. Published to m_timeRatio after the step
+    float m_stepTimeRatio;
+
+    // Step the world on a job while the frame is updated and rendered
+    bool m_threaded;
+
+    // Is a step running on a job
+    bool m_stepping;
+
+    // The step running on a job
+    std::future<int> m_stepFuture;
+
+    // Commands queued while the world is stepping
+    std::vector<std::function<void()>> m_commandVec;
 };
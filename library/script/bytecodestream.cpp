@@ -3,6 +3,8 @@
 *    FILE NAME:       bytecodestream.cpp
 *
 *    DESCRIPTION:     Class for loading and saving AngelScript byte code
+*                     The whole file is buffered so AngelScript's many
+*                     small reads and writes don't each go to the file
 ************************************************************************/
 
 // Physical component dependency
@@ -10,10 +12,14 @@
 
 // Game lib dependencies
 #include <utilities/exceptionhandling.h>
+#include <utilities/genfunc.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
 
+// Standard lib dependencies
+#include <cstring>
+
 // SDL lib dependencies
 #include <SDL3/SDL.h>
 
@@ -22,11 +28,25 @@
 ************************************************************************/
 CByteCodeStream::CByteCodeStream( const std::string & file, const std::string & mode )
 {
-    // Open file for reading
-    m_scpFile.reset( SDL_IOFromFile( file.c_str(), mode.c_str() ) );
-    if( m_scpFile.isNull() )
-        throw NExcept::CCriticalException("AngelScript File Open Error!",
-            boost::str( boost::format("Error Opening file (%s).\n\n%s\nLine: %s") % file % __FUNCTION__ % __LINE__ ));
+    // Read the whole file in one go
+    if( mode.find('r') != std::string::npos )
+    {
+        m_bufferVec = NGenFunc::FileToVec( file );
+    }
+    // Open the file now so an error is caught before the byte code is saved
+    else
+    {
+        m_scpFile.reset( SDL_IOFromFile( file.c_str(), mode.c_str() ) );
+        if( m_scpFile.isNull() )
+            throw NExcept::CCriticalException("AngelScript File Open Error!",
+                boost::str( boost::format("Error Opening file (%s).\n\n%s\nLine: %s") % file % __FUNCTION__ % __LINE__ ));
+    }
+}
+
+CByteCodeStream::CByteCodeStream( std::vector<char> && bufferVec, const size_t offset ) :
+    m_bufferVec( std::move(bufferVec) ),
+    m_readPos( offset )
+{
 }
 
 
@@ -35,32 +55,55 @@ CByteCodeStream::CByteCodeStream( const std::string & file, const std::string &
 ************************************************************************/
 CByteCodeStream::~CByteCodeStream()
 {
+    flush();
 }
 
 /************************************************************************
-*    DESC:  Write the byte code to the file
+*    DESC:  Write the byte code to the buffer
 ************************************************************************/
 int CByteCodeStream::Write( const void *ptr, asUINT sizeInBytes ) 
 {
     if( sizeInBytes > 0 )
     {
-        if( SDL_WriteIO( m_scpFile.get(), ptr, sizeInBytes ) == 0 )
-            return -1;
+        const char * pData = static_cast<const char *>(ptr);
+        m_bufferVec.insert( m_bufferVec.end(), pData, pData + sizeInBytes );
     }
 
     return 0;
 }
 
 /************************************************************************
-*    DESC:  Read the byte code from the file
+*    DESC:  Read the byte code from the buffer
 ************************************************************************/
 int CByteCodeStream::Read( void *ptr, asUINT sizeInBytes ) 
 { 
     if( sizeInBytes > 0 )
     {
-        if( SDL_ReadIO( m_scpFile.get(), ptr, sizeInBytes ) == 0 )
+        if( m_readPos + sizeInBytes > m_bufferVec.size() )
             return -1;
+
+        std::memcpy( ptr, m_bufferVec.data() + m_readPos, sizeInBytes );
+        m_readPos += sizeInBytes;
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+/************************************************************************
+*    DESC:  Write the buffer out to the file
+************************************************************************/
+bool CByteCodeStream::flush()
+{
+    bool result = true;
+
+    if( !m_scpFile.isNull() )
+    {
+        if( !m_bufferVec.empty() )
+            result = (SDL_WriteIO( m_scpFile.get(), m_bufferVec.data(), m_bufferVec.size() ) == m_bufferVec.size());
+
+        m_scpFile.reset();
+        m_bufferVec.clear();
+    }
+
+    return result;
+}
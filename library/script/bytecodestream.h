@@ -3,6 +3,8 @@
 *    FILE NAME:       bytecodestream.h
 *
 *    DESCRIPTION:     Class for loading and saving AngelScript byte code
+*                     The whole file is buffered so AngelScript's many
+*                     small reads and writes don't each go to the file
 ************************************************************************/
 
 #pragma once
@@ -15,6 +17,8 @@
 
 // Standard lib dependencies
 #include <string>
+#include <vector>
+#include <cstddef>
 
 // Forward declaration(s)
 struct SDL_IOStream;
@@ -26,17 +30,29 @@ public:
     // Constructor
     CByteCodeStream( const std::string & file, const std::string & mode );
 
+    // Constructor for reading from a buffer already in memory
+    CByteCodeStream( std::vector<char> && bufferVec, const size_t offset = 0 );
+
     // Destructor
     virtual ~CByteCodeStream();
  
-    // Write the byte code to the file
+    // Write the byte code to the buffer
     int Write( const void *ptr, asUINT sizeInBytes ) override;
 
-    // Read the byte code from the file
+    // Read the byte code from the buffer
     int Read( void *ptr, asUINT sizeInBytes ) override;
 
+    // Write the buffer out to the file
+    bool flush();
+
 private:
 
-    // Scoped file handle pointer
+    // Scoped file handle pointer. Only kept open for writing
     NSmart::scoped_SDL_filehandle_ptr<SDL_IOStream> m_scpFile;
+
+    // The buffered byte code
+    std::vector<char> m_bufferVec;
+
+    // Read position in the buffer
+    size_t m_readPos = 0;
 };
@@ -12,11 +12,11 @@
 #include <managers/actionmanager.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
 #include <common/sensor.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
-#include <autowrapper/aswrappedcall.h>
 
 namespace NScriptActionManager
 {
@@ -71,9 +71,9 @@ namespace NScriptActionManager
         Throw( pEngine->RegisterObjectType("CSensor", sizeof(CSensor), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<CSensor>() | asOBJ_APP_CLASS_ALLFLOATS ) );
 
         // Register the object constructor
-        Throw( pEngine->RegisterObjectBehaviour("CSensor", asBEHAVE_CONSTRUCT, "void f()",                   WRAP_OBJ_LAST(SensorConstructor),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CSensor", asBEHAVE_CONSTRUCT, "void f(const CSensor & in)", WRAP_OBJ_LAST(SensorCopyConstructor), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CSensor", asBEHAVE_DESTRUCT,  "void f()",                   WRAP_OBJ_LAST(SensorDestructor),      asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectBehaviour("CSensor", asBEHAVE_CONSTRUCT, "void f()",                   SCRIPT_OBJ_LAST(SensorConstructor)) );
+        Throw( pEngine->RegisterObjectBehaviour("CSensor", asBEHAVE_CONSTRUCT, "void f(const CSensor & in)", SCRIPT_OBJ_LAST(SensorCopyConstructor)) );
+        Throw( pEngine->RegisterObjectBehaviour("CSensor", asBEHAVE_DESTRUCT,  "void f()",                   SCRIPT_OBJ_LAST(SensorDestructor)) );
 
         // Register property
         Throw( pEngine->RegisterObjectProperty("CSensor", "float v1", asOFFSET(CSensor, v1)) );
@@ -84,37 +84,37 @@ namespace NScriptActionManager
         Throw( pEngine->RegisterObjectProperty("CSensor", "float v6", asOFFSET(CSensor, v6)) );
 
         // assignment operator
-        Throw( pEngine->RegisterObjectMethod("CSensor", "CSensor & opAssign(const CSensor & in)", WRAP_MFN_PR(CSensor, operator =, (const CSensor &), CSensor &),       asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSensor", "CSensor & opAssign(const CSensor & in)", SCRIPT_MFN_PR(CSensor, operator =, (const CSensor &), CSensor &)) );
         
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "const CEvent & pollEvent()",                               WRAP_MFN(CActionMgr, pollEvent),                 asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasAction(const CEvent &in, string &in, uint)",       WRAP_OBJ_LAST(WasAction1),                       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "uint wasAction(const CEvent &in, string &in)",             WRAP_OBJ_LAST(WasAction2),                       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "void enableAction(bool value = true)",                     WRAP_MFN(CActionMgr, enableAction),              asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool isAction()",                                          WRAP_MFN(CActionMgr, isAction),                  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "void load(string &in)",                                    WRAP_MFN(CActionMgr, loadActionFromXML),         asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasActionEvent(string &in, int actionPress = 1)",     WRAP_MFN(CActionMgr, wasActionEvent),            asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasGameEvent(uint type, int code = 0)",               WRAP_MFN(CActionMgr, wasGameEvent),              asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasKeyboardEvent(string &in, int actionPress = 1)",   WRAP_MFN(CActionMgr, wasKeyboardEvent),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasMouseBtnEvent(string &in, int actionPress = 1)",   WRAP_MFN(CActionMgr, wasMouseBtnEvent),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasGamepadBtnEvent(string &in, int actionPress = 1)", WRAP_MFN(CActionMgr, wasGamepadBtnEvent),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasEvent(uint)",                                      WRAP_MFN(CActionMgr, wasEvent),                  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "const CPoint & getMouseAbsolutePos()",                     WRAP_MFN(CActionMgr, getMouseAbsolutePos),       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "const CPoint & getMouseRelativePos()",                     WRAP_MFN(CActionMgr, getMouseRelativePos),       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "const CPoint & getControllerPosLeft()",                    WRAP_MFN(CActionMgr, getControllerPosLeft),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "const CPoint & getControllerPosRight()",                   WRAP_MFN(CActionMgr, getControllerPosRight),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasLastDeviceGamepad()",                              WRAP_MFN(CActionMgr, wasLastDeviceGamepad),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasLastDeviceKeyboard()",                             WRAP_MFN(CActionMgr, wasLastDeviceKeyboard),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasLastDeviceMouse()",                                WRAP_MFN(CActionMgr, wasLastDeviceMouse),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool isQueueEmpty()",                                      WRAP_MFN(CActionMgr, isQueueEmpty),              asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "void saveToFile()",                                        WRAP_MFN(CActionMgr, saveToFile),                asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "void resetKeyBindingsToDefault()",                         WRAP_MFN(CActionMgr, resetKeyBindingsToDefault), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "string getDeviceActionStr(int, string &in, bool &out)",    WRAP_MFN(CActionMgr, getDeviceActionStr),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "string resetAction(int, string &in, int, bool &out)",      WRAP_MFN(CActionMgr, resetAction),               asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "void resetLastUsedDevice()",                               WRAP_MFN(CActionMgr, resetLastUsedDevice),       asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "const CEvent & pollEvent()",                               SCRIPT_MFN(CActionMgr, pollEvent)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasAction(const CEvent &in, string &in, uint)",       SCRIPT_OBJ_LAST(WasAction1)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "uint wasAction(const CEvent &in, string &in)",             SCRIPT_OBJ_LAST(WasAction2)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "void enableAction(bool value = true)",                     SCRIPT_MFN(CActionMgr, enableAction)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool isAction()",                                          SCRIPT_MFN(CActionMgr, isAction)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "void load(string &in)",                                    SCRIPT_MFN(CActionMgr, loadActionFromXML)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasActionEvent(string &in, int actionPress = 1)",     SCRIPT_MFN(CActionMgr, wasActionEvent)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasGameEvent(uint type, int code = 0)",               SCRIPT_MFN(CActionMgr, wasGameEvent)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasKeyboardEvent(string &in, int actionPress = 1)",   SCRIPT_MFN(CActionMgr, wasKeyboardEvent)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasMouseBtnEvent(string &in, int actionPress = 1)",   SCRIPT_MFN(CActionMgr, wasMouseBtnEvent)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasGamepadBtnEvent(string &in, int actionPress = 1)", SCRIPT_MFN(CActionMgr, wasGamepadBtnEvent)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasEvent(uint)",                                      SCRIPT_MFN(CActionMgr, wasEvent)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "const CPoint & getMouseAbsolutePos()",                     SCRIPT_MFN(CActionMgr, getMouseAbsolutePos)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "const CPoint & getMouseRelativePos()",                     SCRIPT_MFN(CActionMgr, getMouseRelativePos)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "const CPoint & getControllerPosLeft()",                    SCRIPT_MFN(CActionMgr, getControllerPosLeft)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "const CPoint & getControllerPosRight()",                   SCRIPT_MFN(CActionMgr, getControllerPosRight)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasLastDeviceGamepad()",                              SCRIPT_MFN(CActionMgr, wasLastDeviceGamepad)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasLastDeviceKeyboard()",                             SCRIPT_MFN(CActionMgr, wasLastDeviceKeyboard)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool wasLastDeviceMouse()",                                SCRIPT_MFN(CActionMgr, wasLastDeviceMouse)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "bool isQueueEmpty()",                                      SCRIPT_MFN(CActionMgr, isQueueEmpty)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "void saveToFile()",                                        SCRIPT_MFN(CActionMgr, saveToFile)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "void resetKeyBindingsToDefault()",                         SCRIPT_MFN(CActionMgr, resetKeyBindingsToDefault)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "string getDeviceActionStr(int, string &in, bool &out)",    SCRIPT_MFN(CActionMgr, getDeviceActionStr)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "string resetAction(int, string &in, int, bool &out)",      SCRIPT_MFN(CActionMgr, resetAction)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "void resetLastUsedDevice()",                               SCRIPT_MFN(CActionMgr, resetLastUsedDevice)) );
 
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "uint enumerateButtonEvents(uint &out, int &out, int &out, uint startIndex = 0)", WRAP_MFN(CActionMgr, enumerateButtonEvents), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "uint enumerateMouseWheelEvents(uint &out, int &out, int &out, uint &out, uint startIndex = 0)", WRAP_MFN(CActionMgr, enumerateMouseWheelEvents), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CActionMgr", "uint enumerateTouchFingerEvents(uint &out, int64 &out, int64 &out, float &out, float &out, float &out, float &out, float &out, uint startIndex = 0)", WRAP_MFN(CActionMgr, enumerateTouchFingerEvents), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "uint enumerateButtonEvents(uint &out, int &out, int &out, uint startIndex = 0)", SCRIPT_MFN(CActionMgr, enumerateButtonEvents)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "uint enumerateMouseWheelEvents(uint &out, int &out, int &out, uint &out, uint startIndex = 0)", SCRIPT_MFN(CActionMgr, enumerateMouseWheelEvents)) );
+        Throw( pEngine->RegisterObjectMethod("CActionMgr", "uint enumerateTouchFingerEvents(uint &out, int64 &out, int64 &out, float &out, float &out, float &out, float &out, float &out, uint startIndex = 0)", SCRIPT_MFN(CActionMgr, enumerateTouchFingerEvents)) );
         
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CActionMgr ActionMgr", &CActionMgr::Instance()) );
@@ -0,0 +1,65 @@
+
+/************************************************************************
+*    FILE NAME:       scriptaot.cpp
+*
+*    DESCRIPTION:     Script functions compiled ahead of time to C++.
+*                     The generated code adds its functions to this
+*                     registry when the game starts
+************************************************************************/
+
+// Physical component dependency
+#include <script/scriptaot.h>
+
+// Standard lib dependencies
+#include <map>
+#include <string>
+#include <utility>
+
+namespace NScriptAot
+{
+    /************************************************************************
+    *    DESC:  Get the map of compiled functions by module and declaration
+    *           NOTE: Function static so it exists before any generated
+    *                 code adds to it during static init
+    ************************************************************************/
+    std::map< std::pair<std::string, std::string>, const SFunction * > & GetFuncMap()
+    {
+        static std::map< std::pair<std::string, std::string>, const SFunction * > funcMap;
+        return funcMap;
+    }
+
+    /************************************************************************
+    *    DESC:  Add the compiled functions. Called by the generated code at static init
+    ************************************************************************/
+    bool Add( const SFunction * pFuncArray, size_t count )
+    {
+        auto & funcMap = GetFuncMap();
+
+        for( size_t i = 0; i < count; ++i )
+            funcMap[ std::make_pair( pFuncArray[i].pModule, pFuncArray[i].pDecl ) ] = &pFuncArray[i];
+
+        return true;
+    }
+
+    /************************************************************************
+    *    DESC:  Find the compiled function. Returns nullptr if there is none
+    ************************************************************************/
+    const SFunction * Find( const std::string & module, const std::string & decl )
+    {
+        auto & funcMap = GetFuncMap();
+
+        auto iter = funcMap.find( std::make_pair( module, decl ) );
+        if( iter != funcMap.end() )
+            return iter->second;
+
+        return nullptr;
+    }
+
+    /************************************************************************
+    *    DESC:  Are there any compiled functions
+    ************************************************************************/
+    bool Empty()
+    {
+        return GetFuncMap().empty();
+    }
+}
@@ -0,0 +1,65 @@
+
+/************************************************************************
+*    FILE NAME:       scriptaot.h
+*
+*    DESCRIPTION:     Script functions compiled ahead of time to C++.
+*                     The generated code adds its functions to this
+*                     registry when the game starts
+************************************************************************/
+
+#pragma once
+
+// AngelScript lib dependencies
+#include <angelscript.h>
+
+// Standard lib dependencies
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <string>
+
+// Hand the instruction at this byte code position back to the interpreter
+#define SCRIPT_AOT_EXIT( pos ) \
+    { pRegs->programPointer = l_bc + (pos); pRegs->stackPointer = l_sp; pRegs->valueRegister = l_reg; return; }
+
+namespace NScriptAot
+{
+    // Script function compiled to C++
+    struct SFunction
+    {
+        // Module and declaration of the script function
+        const char * pModule;
+        const char * pDecl;
+
+        // Hash of the byte code the C++ was generated from
+        uint32_t hash;
+
+        // The compiled function
+        asJITFunction pFunc;
+    };
+
+    // Add the compiled functions. Called by the generated code at static init
+    bool Add( const SFunction * pFuncArray, size_t count );
+
+    // Find the compiled function. Returns nullptr if there is none
+    const SFunction * Find( const std::string & module, const std::string & decl );
+
+    // Are there any compiled functions
+    bool Empty();
+
+    // Get the float or double from the bits written out by the generator
+    inline float ToFloat( asDWORD bits )
+    {
+        float value;
+        std::memcpy( &value, &bits, sizeof(value) );
+        return value;
+    }
+
+    inline double ToDouble( asQWORD bits )
+    {
+        double value;
+        std::memcpy( &value, &bits, sizeof(value) );
+        return value;
+    }
+}
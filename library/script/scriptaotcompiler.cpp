@@ -0,0 +1,617 @@
+
+/************************************************************************
+*    FILE NAME:       scriptaotcompiler.cpp
+*
+*    DESCRIPTION:     AngelScript JIT compiler interface that hooks up
+*                     the script functions compiled ahead of time to
+*                     C++ and generates that C++ from the byte code
+************************************************************************/
+
+// Physical component dependency
+#include <script/scriptaotcompiler.h>
+
+// Game lib dependencies
+#include <utilities/exceptionhandling.h>
+#include <script/scriptaot.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <fstream>
+#include <filesystem>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CScriptAotCompiler::CScriptAotCompiler() :
+    m_generateCounter(0)
+{
+}
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CScriptAotCompiler::~CScriptAotCompiler()
+{
+}
+
+/************************************************************************
+*    DESC:  Hook up the compiled function. Called by the engine when a
+*           module is built or loaded
+************************************************************************/
+int CScriptAotCompiler::CompileFunction( asIScriptFunction * pFunction, asJITFunction * pOutput )
+{
+    asUINT length(0);
+    asDWORD * pByteCode = pFunction->GetByteCode( &length );
+    const char * pModule = pFunction->GetModuleName();
+    if( (pByteCode == nullptr) || (pModule == nullptr) )
+        return asERROR;
+
+    const std::string decl = pFunction->GetDeclaration( true, true, false );
+    const uint32_t hash = hashByteCode( pByteCode, length );
+
+    if( !m_generateModule.empty() && (m_generateModule == pModule) )
+        generate( pFunction, decl, hash );
+
+    // Only use the compiled function if it was generated from the same byte code
+    // Anything else is left to the interpreter
+    const NScriptAot::SFunction * pAotFunc = NScriptAot::Find( pModule, decl );
+    if( (pAotFunc == nullptr) || (pAotFunc->hash != hash) )
+        return asERROR;
+
+    // Number the entries the compiled function resumes from. The interpreter skips the rest
+    std::vector<asUINT> entryVec;
+    getEntries( pByteCode, length, entryVec );
+
+    for( size_t i = 0; i < entryVec.size(); ++i )
+        asBC_PTRARG( pByteCode + entryVec[i] ) = asPWORD(i + 1);
+
+    *pOutput = pAotFunc->pFunc;
+
+    return asSUCCESS;
+}
+
+/************************************************************************
+*    DESC:  Release the compiled function
+*           NOTE: Compiled functions are linked in so there's nothing to free
+************************************************************************/
+void CScriptAotCompiler::ReleaseJITFunction( asJITFunction func )
+{
+}
+
+/************************************************************************
+*    DESC:  Generate C++ for the functions of the module as they are compiled
+************************************************************************/
+void CScriptAotCompiler::beginGenerate( const std::string & module )
+{
+    m_generateModule = module;
+    m_functionCode.clear();
+    m_tableCode.clear();
+    m_generateCounter = 0;
+}
+
+/************************************************************************
+*    DESC:  Write the generated C++ to file
+************************************************************************/
+void CScriptAotCompiler::endGenerate( const std::string & filePath )
+{
+    const std::filesystem::path path( filePath );
+    if( path.has_parent_path() )
+        std::filesystem::create_directories( path.parent_path() );
+
+    std::ofstream file( filePath, std::ios::out | std::ios::trunc );
+    if( !file.is_open() )
+        throw NExcept::CCriticalException("Script AOT Save Error!",
+            boost::str( boost::format("Error opening file to write compiled scripts (%s).\n\n%s\nLine: %s")
+                % filePath % __FUNCTION__ % __LINE__ ));
+
+    file << "\n// Generated from the \"" << m_generateModule << "\" script group. Do not edit.\n"
+         << "// Functions are only used if the scripts compile to the same byte code.\n\n"
+         << "#include <script/scriptaot.h>\n\n"
+         << "#if defined(__GNUC__)\n"
+         << "#pragma GCC diagnostic ignored \"-Wunused-label\"\n"
+         << "#endif\n\n"
+         << "namespace\n{\n"
+         << m_functionCode;
+
+    if( m_generateCounter > 0 )
+        file << "const NScriptAot::SFunction aotFuncArray[] =\n{\n"
+             << m_tableCode
+             << "};\n\n"
+             << "const bool aotAdded = NScriptAot::Add( aotFuncArray, sizeof(aotFuncArray) / sizeof(aotFuncArray[0]) );\n";
+
+    file << "}\n";
+
+    if( file.fail() )
+        throw NExcept::CCriticalException("Script AOT Save Error!",
+            boost::str( boost::format("Error writing compiled scripts (%s).\n\n%s\nLine: %s")
+                % filePath % __FUNCTION__ % __LINE__ ));
+
+    m_generateModule.clear();
+    m_functionCode.clear();
+    m_tableCode.clear();
+}
+
+/************************************************************************
+*    DESC:  Generate the C++ function for the script function
+************************************************************************/
+void CScriptAotCompiler::generate( asIScriptFunction * pFunction, const std::string & decl, uint32_t hash )
+{
+    asUINT length(0);
+    asDWORD * pByteCode = pFunction->GetByteCode( &length );
+
+    // Nothing to do if the function can't be resumed in C++
+    std::vector<asUINT> entryVec;
+    getEntries( pByteCode, length, entryVec );
+    if( entryVec.empty() )
+        return;
+
+    // Translate all the instructions first to collect the jump labels
+    std::set<asUINT> labelSet( entryVec.begin(), entryVec.end() );
+    std::vector<std::string> codeVec;
+    std::vector<bool> translatedVec;
+
+    for( asUINT pos = 0; pos < length; pos += asBCTypeSize[asBCInfo[*(asBYTE*)(pByteCode + pos)].type] )
+    {
+        std::string code;
+        translatedVec.push_back( translate( pByteCode + pos, pos, code, labelSet ) );
+        codeVec.push_back( code );
+    }
+
+    const std::string name = boost::str( boost::format("aotFunc%d") % m_generateCounter++ );
+
+    std::string & out = m_functionCode;
+    out += boost::str( boost::format("// %s\nvoid %s( asSVMRegisters * pRegs, asPWORD jitArg )\n{\n") % decl % name );
+    out += "    asDWORD * l_bc = pRegs->programPointer;\n";
+    out += "    asDWORD * l_fp = pRegs->stackFramePointer;\n";
+    out += "    asDWORD * l_sp = pRegs->stackPointer;\n";
+    out += "    asQWORD l_reg = pRegs->valueRegister;\n\n";
+
+    // The program pointer is on the entry so step back to the start of the byte code
+    out += "    switch( jitArg )\n    {\n";
+    for( size_t i = 0; i < entryVec.size(); ++i )
+        out += boost::str( boost::format("        case %d: l_bc -= %d; goto bc%d;\n") % (i + 1) % entryVec[i] % entryVec[i] );
+    out += "        default: pRegs->programPointer += 1 + AS_PTR_SIZE; return;\n    }\n\n";
+
+    // Code that can't be reached isn't written out. The interpreter takes
+    // over at the first instruction that isn't translated
+    bool reachable(false);
+    asUINT pos(0);
+
+    for( size_t i = 0; i < codeVec.size(); ++i )
+    {
+        const asBYTE op = *(asBYTE*)(pByteCode + pos);
+
+        if( labelSet.find( pos ) != labelSet.end() )
+        {
+            out += boost::str( boost::format("bc%d:\n") % pos );
+            reachable = true;
+        }
+
+        if( reachable )
+        {
+            if( translatedVec[i] )
+            {
+                if( !codeVec[i].empty() )
+                    out += "    " + codeVec[i] + "\n";
+
+                if( op == asBC_JMP )
+                    reachable = false;
+            }
+            else
+            {
+                out += boost::str( boost::format("    SCRIPT_AOT_EXIT( %d )\n") % pos );
+                reachable = false;
+            }
+        }
+
+        pos += asBCTypeSize[asBCInfo[op].type];
+    }
+
+    out += "}\n\n";
+
+    // Escape the declaration for the string literal
+    std::string declStr;
+    for( char ch : decl )
+    {
+        if( (ch == '\\') || (ch == '"') )
+            declStr += '\\';
+        declStr += ch;
+    }
+
+    m_tableCode += boost::str( boost::format("    { \"%s\", \"%s\", 0x%08Xu, %s },\n") % m_generateModule % declStr % hash % name );
+}
+
+/************************************************************************
+*    DESC:  Get the byte code positions of the JIT entries the C++ can
+*           resume from. Entries followed by an instruction the
+*           interpreter needs to run are left out
+************************************************************************/
+void CScriptAotCompiler::getEntries( asDWORD * pByteCode, asUINT length, std::vector<asUINT> & entryVec ) const
+{
+    std::string code;
+    std::set<asUINT> labelSet;
+
+    for( asUINT pos = 0; pos < length; pos += asBCTypeSize[asBCInfo[*(asBYTE*)(pByteCode + pos)].type] )
+    {
+        if( *(asBYTE*)(pByteCode + pos) == asBC_JitEntry )
+        {
+            const asUINT next = pos + asBCTypeSize[asBCInfo[asBC_JitEntry].type];
+
+            if( (next < length) &&
+                (*(asBYTE*)(pByteCode + next) != asBC_JitEntry) &&
+                translate( pByteCode + next, next, code, labelSet ) )
+            {
+                entryVec.push_back( pos );
+            }
+        }
+    }
+}
+
+/************************************************************************
+*    DESC:  Hash the parts of the byte code the generated C++ depends on
+*           NOTE: Instructions run by the interpreter only add their op
+*                 code. Pointers are read from the live byte code so
+*                 they are left out too
+************************************************************************/
+uint32_t CScriptAotCompiler::hashByteCode( asDWORD * pByteCode, asUINT length ) const
+{
+    // FNV-1a. The byte code positions depend on the size of a pointer
+    uint32_t hash = 2166136261u ^ AS_PTR_SIZE;
+
+    std::string code;
+    std::set<asUINT> labelSet;
+
+    for( asUINT pos = 0; pos < length; )
+    {
+        asDWORD * pInstr = pByteCode + pos;
+        const asBYTE op = *(asBYTE*)pInstr;
+        const asUINT size = asBCTypeSize[asBCInfo[op].type];
+
+        if( translate( pInstr, pos, code, labelSet ) )
+        {
+            const bool ptrArg =
+                (op == asBC_JitEntry) || (op == asBC_PshGPtr) || (op == asBC_PshG4) ||
+                (op == asBC_LdGRdR4) || (op == asBC_CpyVtoG4) || (op == asBC_CpyGtoV4) ||
+                (op == asBC_SetG4) || (op == asBC_LDG) || (op == asBC_PGA);
+
+            for( asUINT i = 0; i < size; ++i )
+            {
+                if( !ptrArg || (i == 0) || (i > AS_PTR_SIZE) )
+                    hash = (hash ^ pInstr[i]) * 16777619u;
+            }
+        }
+        else
+        {
+            hash = (hash ^ op) * 16777619u;
+        }
+
+        pos += size;
+    }
+
+    return hash;
+}
+
+/************************************************************************
+*    DESC:  Translate the instruction to C++. Returns false if the
+*           interpreter needs to run it
+*           NOTE: Each translation does what asCContext::ExecuteNext
+*                 does for the instruction. Calls, returns, objects and
+*                 anything that can raise an exception are left to the
+*                 interpreter. Math that would raise an exception hands
+*                 the instruction back so the interpreter raises it
+************************************************************************/
+bool CScriptAotCompiler::translate( asDWORD * pInstr, asUINT pos, std::string & code, std::set<asUINT> & labelSet ) const
+{
+    const asBYTE op = *(asBYTE*)pInstr;
+    const asUINT size = asBCTypeSize[asBCInfo[op].type];
+
+    // Stack variable of the type at the offset
+    auto var = []( const char * type, int offset )
+    {
+        if( offset < 0 )
+            return boost::str( boost::format("*(%s*)(l_fp + %d)") % type % -offset );
+
+        return boost::str( boost::format("*(%s*)(l_fp - %d)") % type % offset );
+    };
+
+    // Address of the stack variable at the offset
+    auto addr = []( int offset )
+    {
+        if( offset < 0 )
+            return boost::str( boost::format("(l_fp + %d)") % -offset );
+
+        return boost::str( boost::format("(l_fp - %d)") % offset );
+    };
+
+    // Only read the arguments the instruction has. The last instruction can be at the end of the byte code
+    const int arg0 = asBC_SWORDARG0(pInstr);
+    const int arg1 = (size > 1) ? asBC_SWORDARG1(pInstr) : 0;
+    const int arg2 = (size > 1) ? asBC_SWORDARG2(pInstr) : 0;
+    const asDWORD dword1 = (size > 1) ? pInstr[1] : 0;
+    const asDWORD dword2 = (size > 2) ? pInstr[2] : 0;
+    const std::string exitStr = boost::str( boost::format("SCRIPT_AOT_EXIT( %d )") % pos );
+
+    // Jump to a relative position if the condition is true
+    auto jump = [&]( const char * condition )
+    {
+        const asUINT target = pos + size + int(dword1);
+        labelSet.insert( target );
+
+        if( condition == nullptr )
+            return boost::str( boost::format("goto bc%d;") % target );
+
+        return boost::str( boost::format("if( %s ) goto bc%d;") % condition % target );
+    };
+
+    // Compare two values and set the register to -1, 0 or 1
+    auto compare = [&]( const char * type, const std::string & value1, const std::string & value2 )
+    {
+        return boost::str( boost::format("{ %1% v1 = %2%; %1% v2 = %3%; *(int*)&l_reg = (v1 == v2) ? 0 : ((v1 < v2) ? -1 : 1); }")
+            % type % value1 % value2 );
+    };
+
+    // Do the math on two variables and store the result in a third
+    auto math = [&]( const char * type, const char * oper )
+    {
+        return boost::str( boost::format("%s = %s %s %s;") % var(type, arg0) % var(type, arg1) % oper % var(type, arg2) );
+    };
+
+    // Math with a constant value
+    auto mathConst = [&]( const char * type, const char * oper, const std::string & value )
+    {
+        return boost::str( boost::format("%s = %s %s %s;") % var(type, arg0) % var(type, arg1) % oper % value );
+    };
+
+    // Division that hands back to the interpreter if it would raise an exception
+    auto divide = [&]( const char * type, const std::string & result, const std::string & overflow )
+    {
+        std::string check = "d == 0";
+        if( !overflow.empty() )
+            check += boost::str( boost::format(" || (d == -1 && %s == %s)") % var(type, arg1) % overflow );
+
+        return boost::str( boost::format("{ %s d = %s; if( %s ) %s %s = %s; }")
+            % type % var(type, arg2) % check % exitStr % var(type, arg0) % result );
+    };
+
+    const std::string intConst = boost::str( boost::format("asDWORD(0x%08Xu)") % dword1 );
+    const std::string intConst1 = boost::str( boost::format("asDWORD(0x%08Xu)") % dword2 );
+    const std::string floatConst = boost::str( boost::format("NScriptAot::ToFloat(0x%08Xu)") % dword1 );
+    const std::string floatConst1 = boost::str( boost::format("NScriptAot::ToFloat(0x%08Xu)") % dword2 );
+    const std::string qwordConst = boost::str( boost::format("asQWORD(0x%016Xull)") % ((asQWORD(dword2) << 32) | dword1) );
+    const std::string ptrArg = boost::str( boost::format("asBC_PTRARG(l_bc + %d)") % pos );
+
+    code.clear();
+
+    switch( op )
+    {
+        // The entry and suspend only matter to the interpreter
+        case asBC_JitEntry:
+            break;
+
+        case asBC_SUSPEND:
+            code = "if( pRegs->doProcessSuspend ) " + exitStr;
+            break;
+
+        // Stack
+        case asBC_PopPtr:
+            code = "l_sp += AS_PTR_SIZE;";
+            break;
+
+        case asBC_PshC4:
+            code = "--l_sp; *l_sp = " + intConst + ";";
+            break;
+
+        case asBC_PshV4:
+            code = "--l_sp; *l_sp = " + var("asDWORD", arg0) + ";";
+            break;
+
+        case asBC_PshC8:
+            code = "l_sp -= 2; *(asQWORD*)l_sp = " + qwordConst + ";";
+            break;
+
+        case asBC_PshV8:
+            code = "l_sp -= 2; *(asQWORD*)l_sp = " + var("asQWORD", arg0) + ";";
+            break;
+
+        case asBC_PSF:
+            code = "l_sp -= AS_PTR_SIZE; *(asPWORD*)l_sp = asPWORD" + addr(arg0) + ";";
+            break;
+
+        case asBC_PshVPtr:
+            code = "l_sp -= AS_PTR_SIZE; *(asPWORD*)l_sp = " + var("asPWORD", arg0) + ";";
+            break;
+
+        case asBC_PshNull:
+            code = "l_sp -= AS_PTR_SIZE; *(asPWORD*)l_sp = 0;";
+            break;
+
+        case asBC_PshG4:
+            code = "--l_sp; *l_sp = *(asDWORD*)" + ptrArg + ";";
+            break;
+
+        case asBC_PshGPtr:
+            code = "l_sp -= AS_PTR_SIZE; *(asPWORD*)l_sp = *(asPWORD*)" + ptrArg + ";";
+            break;
+
+        case asBC_PGA:
+            code = "l_sp -= AS_PTR_SIZE; *(asPWORD*)l_sp = " + ptrArg + ";";
+            break;
+
+        // Jumps and tests of the register
+        case asBC_JMP:    code = jump( nullptr ); break;
+        case asBC_JZ:     code = jump( "*(int*)&l_reg == 0" ); break;
+        case asBC_JNZ:    code = jump( "*(int*)&l_reg != 0" ); break;
+        case asBC_JS:     code = jump( "*(int*)&l_reg < 0" ); break;
+        case asBC_JNS:    code = jump( "*(int*)&l_reg >= 0" ); break;
+        case asBC_JP:     code = jump( "*(int*)&l_reg > 0" ); break;
+        case asBC_JNP:    code = jump( "*(int*)&l_reg <= 0" ); break;
+        case asBC_JLowZ:  code = jump( "*(asBYTE*)&l_reg == 0" ); break;
+        case asBC_JLowNZ: code = jump( "*(asBYTE*)&l_reg != 0" ); break;
+
+        // The boolean is in the lower byte and the rest of the register is cleared
+        case asBC_TZ:  code = "l_reg = (*(int*)&l_reg == 0) ? 1 : 0;"; break;
+        case asBC_TNZ: code = "l_reg = (*(int*)&l_reg != 0) ? 1 : 0;"; break;
+        case asBC_TS:  code = "l_reg = (*(int*)&l_reg < 0) ? 1 : 0;"; break;
+        case asBC_TNS: code = "l_reg = (*(int*)&l_reg >= 0) ? 1 : 0;"; break;
+        case asBC_TP:  code = "l_reg = (*(int*)&l_reg > 0) ? 1 : 0;"; break;
+        case asBC_TNP: code = "l_reg = (*(int*)&l_reg <= 0) ? 1 : 0;"; break;
+
+        case asBC_NOT:
+            code = var("asDWORD", arg0) + " = (" + var("asBYTE", arg0) + " == 0) ? 1 : 0;";
+            break;
+
+        case asBC_ClrHi:
+            code = "l_reg &= ~asQWORD(0xFFFFFF00);";
+            break;
+
+        // Negate. Done unsigned so the overflow wraps like the interpreter
+        case asBC_NEGi:   code = var("asDWORD", arg0) + " = 0u - " + var("asDWORD", arg0) + ";"; break;
+        case asBC_NEGf:   code = var("float", arg0) + " = -" + var("float", arg0) + ";"; break;
+        case asBC_NEGd:   code = var("double", arg0) + " = -" + var("double", arg0) + ";"; break;
+        case asBC_NEGi64: code = var("asQWORD", arg0) + " = 0u - " + var("asQWORD", arg0) + ";"; break;
+
+        // Increment the value pointed to by the register
+        case asBC_INCi8:  code = "++(**(asBYTE**)&l_reg);"; break;
+        case asBC_DECi8:  code = "--(**(asBYTE**)&l_reg);"; break;
+        case asBC_INCi16: code = "++(**(asWORD**)&l_reg);"; break;
+        case asBC_DECi16: code = "--(**(asWORD**)&l_reg);"; break;
+        case asBC_INCi:   code = "++(**(asDWORD**)&l_reg);"; break;
+        case asBC_DECi:   code = "--(**(asDWORD**)&l_reg);"; break;
+        case asBC_INCi64: code = "++(**(asQWORD**)&l_reg);"; break;
+        case asBC_DECi64: code = "--(**(asQWORD**)&l_reg);"; break;
+        case asBC_INCf:   code = "++(**(float**)&l_reg);"; break;
+        case asBC_DECf:   code = "--(**(float**)&l_reg);"; break;
+        case asBC_INCd:   code = "++(**(double**)&l_reg);"; break;
+        case asBC_DECd:   code = "--(**(double**)&l_reg);"; break;
+
+        case asBC_IncVi: code = "++" + var("asDWORD", arg0) + ";"; break;
+        case asBC_DecVi: code = "--" + var("asDWORD", arg0) + ";"; break;
+
+        // Bits
+        case asBC_BNOT:   code = var("asDWORD", arg0) + " = ~" + var("asDWORD", arg0) + ";"; break;
+        case asBC_BAND:   code = math( "asDWORD", "&" ); break;
+        case asBC_BOR:    code = math( "asDWORD", "|" ); break;
+        case asBC_BXOR:   code = math( "asDWORD", "^" ); break;
+        case asBC_BSLL:   code = math( "asDWORD", "<<" ); break;
+        case asBC_BSRL:   code = math( "asDWORD", ">>" ); break;
+        case asBC_BSRA:   code = var("int", arg0) + " = " + var("int", arg1) + " >> " + var("asDWORD", arg2) + ";"; break;
+        case asBC_BNOT64: code = var("asQWORD", arg0) + " = ~" + var("asQWORD", arg0) + ";"; break;
+        case asBC_BAND64: code = math( "asQWORD", "&" ); break;
+        case asBC_BOR64:  code = math( "asQWORD", "|" ); break;
+        case asBC_BXOR64: code = math( "asQWORD", "^" ); break;
+        case asBC_BSLL64: code = var("asQWORD", arg0) + " = " + var("asQWORD", arg1) + " << " + var("asDWORD", arg2) + ";"; break;
+        case asBC_BSRL64: code = var("asQWORD", arg0) + " = " + var("asQWORD", arg1) + " >> " + var("asDWORD", arg2) + ";"; break;
+        case asBC_BSRA64: code = var("asINT64", arg0) + " = " + var("asINT64", arg1) + " >> " + var("asDWORD", arg2) + ";"; break;
+
+        // Comparisons
+        case asBC_CMPi:   code = compare( "int", var("int", arg0), var("int", arg1) ); break;
+        case asBC_CMPu:   code = compare( "asDWORD", var("asDWORD", arg0), var("asDWORD", arg1) ); break;
+        case asBC_CMPf:   code = compare( "float", var("float", arg0), var("float", arg1) ); break;
+        case asBC_CMPd:   code = compare( "double", var("double", arg0), var("double", arg1) ); break;
+        case asBC_CMPi64: code = compare( "asINT64", var("asINT64", arg0), var("asINT64", arg1) ); break;
+        case asBC_CMPu64: code = compare( "asQWORD", var("asQWORD", arg0), var("asQWORD", arg1) ); break;
+        case asBC_CmpPtr: code = compare( "asPWORD", var("asPWORD", arg0), var("asPWORD", arg1) ); break;
+        case asBC_CMPIi:  code = compare( "int", var("int", arg0), "int(" + intConst + ")" ); break;
+        case asBC_CMPIu:  code = compare( "asDWORD", var("asDWORD", arg0), intConst ); break;
+        case asBC_CMPIf:  code = compare( "float", var("float", arg0), floatConst ); break;
+
+        // Variables, the register and globals
+        case asBC_SetV1:
+        case asBC_SetV2:
+        case asBC_SetV4:    code = var("asDWORD", arg0) + " = " + intConst + ";"; break;
+        case asBC_SetV8:    code = var("asQWORD", arg0) + " = " + qwordConst + ";"; break;
+        case asBC_CpyVtoV4: code = var("asDWORD", arg0) + " = " + var("asDWORD", arg1) + ";"; break;
+        case asBC_CpyVtoV8: code = var("asQWORD", arg0) + " = " + var("asQWORD", arg1) + ";"; break;
+        case asBC_CpyVtoR4: code = "*(asDWORD*)&l_reg = " + var("asDWORD", arg0) + ";"; break;
+        case asBC_CpyVtoR8: code = "l_reg = " + var("asQWORD", arg0) + ";"; break;
+        case asBC_CpyRtoV4: code = var("asDWORD", arg0) + " = *(asDWORD*)&l_reg;"; break;
+        case asBC_CpyRtoV8: code = var("asQWORD", arg0) + " = l_reg;"; break;
+        case asBC_ClrVPtr:  code = var("asPWORD", arg0) + " = 0;"; break;
+        case asBC_CpyVtoG4: code = "*(asDWORD*)" + ptrArg + " = " + var("asDWORD", arg0) + ";"; break;
+        case asBC_CpyGtoV4: code = var("asDWORD", arg0) + " = *(asDWORD*)" + ptrArg + ";"; break;
+        case asBC_LdGRdR4:  code = "*(asPWORD*)&l_reg = " + ptrArg + "; " + var("asDWORD", arg0) + " = **(asDWORD**)&l_reg;"; break;
+        case asBC_SetG4:
+            code = boost::str( boost::format("*(asDWORD*)%s = asDWORD(0x%08Xu);") % ptrArg % pInstr[1 + AS_PTR_SIZE] );
+            break;
+        case asBC_LDG:      code = "*(asPWORD*)&l_reg = " + ptrArg + ";"; break;
+        case asBC_LDV:      code = "*(asDWORD**)&l_reg = " + addr(arg0) + ";"; break;
+
+        // Write to and read from the address in the register
+        case asBC_WRTV1: code = "**(asBYTE**)&l_reg = " + var("asBYTE", arg0) + ";"; break;
+        case asBC_WRTV2: code = "**(asWORD**)&l_reg = " + var("asWORD", arg0) + ";"; break;
+        case asBC_WRTV4: code = "**(asDWORD**)&l_reg = " + var("asDWORD", arg0) + ";"; break;
+        case asBC_WRTV8: code = "**(asQWORD**)&l_reg = " + var("asQWORD", arg0) + ";"; break;
+        case asBC_RDR1:  code = var("asDWORD", arg0) + " = **(asBYTE**)&l_reg;"; break;
+        case asBC_RDR2:  code = var("asDWORD", arg0) + " = **(asWORD**)&l_reg;"; break;
+        case asBC_RDR4:  code = var("asDWORD", arg0) + " = **(asDWORD**)&l_reg;"; break;
+        case asBC_RDR8:  code = var("asQWORD", arg0) + " = **(asQWORD**)&l_reg;"; break;
+
+        // Type conversions
+        case asBC_iTOf:   code = var("float", arg0) + " = float(" + var("int", arg0) + ");"; break;
+        case asBC_fTOi:   code = var("int", arg0) + " = int(" + var("float", arg0) + ");"; break;
+        case asBC_uTOf:   code = var("float", arg0) + " = float(" + var("asDWORD", arg0) + ");"; break;
+        case asBC_fTOu:   code = var("asDWORD", arg0) + " = asUINT(int(" + var("float", arg0) + "));"; break;
+        case asBC_sbTOi:  code = var("int", arg0) + " = " + var("signed char", arg0) + ";"; break;
+        case asBC_swTOi:  code = var("int", arg0) + " = " + var("short", arg0) + ";"; break;
+        case asBC_ubTOi:  code = var("asDWORD", arg0) + " = " + var("asBYTE", arg0) + ";"; break;
+        case asBC_uwTOi:  code = var("asDWORD", arg0) + " = " + var("asWORD", arg0) + ";"; break;
+        case asBC_iTOb:   code = var("asDWORD", arg0) + " = asBYTE(" + var("asDWORD", arg0) + ");"; break;
+        case asBC_iTOw:   code = var("asDWORD", arg0) + " = asWORD(" + var("asDWORD", arg0) + ");"; break;
+        case asBC_dTOi:   code = var("int", arg0) + " = int(" + var("double", arg1) + ");"; break;
+        case asBC_dTOu:   code = var("asDWORD", arg0) + " = asUINT(int(" + var("double", arg1) + "));"; break;
+        case asBC_dTOf:   code = var("float", arg0) + " = float(" + var("double", arg1) + ");"; break;
+        case asBC_iTOd:   code = var("double", arg0) + " = double(" + var("int", arg1) + ");"; break;
+        case asBC_uTOd:   code = var("double", arg0) + " = double(" + var("asUINT", arg1) + ");"; break;
+        case asBC_fTOd:   code = var("double", arg0) + " = double(" + var("float", arg1) + ");"; break;
+        case asBC_i64TOi: code = var("int", arg0) + " = int(" + var("asINT64", arg1) + ");"; break;
+        case asBC_uTOi64: code = var("asINT64", arg0) + " = asINT64(" + var("asUINT", arg1) + ");"; break;
+        case asBC_iTOi64: code = var("asINT64", arg0) + " = asINT64(" + var("int", arg1) + ");"; break;
+        case asBC_fTOi64: code = var("asINT64", arg0) + " = asINT64(" + var("float", arg1) + ");"; break;
+        case asBC_dTOi64: code = var("asINT64", arg0) + " = asINT64(" + var("double", arg0) + ");"; break;
+        case asBC_fTOu64: code = var("asQWORD", arg0) + " = asQWORD(asINT64(" + var("float", arg1) + "));"; break;
+        case asBC_dTOu64: code = var("asQWORD", arg0) + " = asQWORD(asINT64(" + var("double", arg0) + "));"; break;
+        case asBC_i64TOf: code = var("float", arg0) + " = float(" + var("asINT64", arg1) + ");"; break;
+        case asBC_u64TOf: code = var("float", arg0) + " = float(" + var("asQWORD", arg1) + ");"; break;
+        case asBC_i64TOd: code = var("double", arg0) + " = double(" + var("asINT64", arg0) + ");"; break;
+        case asBC_u64TOd: code = var("double", arg0) + " = double(" + var("asQWORD", arg0) + ");"; break;
+
+        // Math. Integer math is done unsigned so the overflow wraps like the interpreter
+        case asBC_ADDi:   code = math( "asDWORD", "+" ); break;
+        case asBC_SUBi:   code = math( "asDWORD", "-" ); break;
+        case asBC_MULi:   code = math( "asDWORD", "*" ); break;
+        case asBC_DIVi:   code = divide( "int", var("int", arg1) + " / d", "int(0x80000000u)" ); break;
+        case asBC_MODi:   code = divide( "int", var("int", arg1) + " % d", "int(0x80000000u)" ); break;
+        case asBC_DIVu:   code = divide( "asDWORD", var("asDWORD", arg1) + " / d", "" ); break;
+        case asBC_MODu:   code = divide( "asDWORD", var("asDWORD", arg1) + " % d", "" ); break;
+        case asBC_ADDi64: code = math( "asQWORD", "+" ); break;
+        case asBC_SUBi64: code = math( "asQWORD", "-" ); break;
+        case asBC_MULi64: code = math( "asQWORD", "*" ); break;
+        case asBC_DIVi64: code = divide( "asINT64", var("asINT64", arg1) + " / d", "(asINT64(1) << 63)" ); break;
+        case asBC_MODi64: code = divide( "asINT64", var("asINT64", arg1) + " % d", "(asINT64(1) << 63)" ); break;
+        case asBC_DIVu64: code = divide( "asQWORD", var("asQWORD", arg1) + " / d", "" ); break;
+        case asBC_MODu64: code = divide( "asQWORD", var("asQWORD", arg1) + " % d", "" ); break;
+        case asBC_ADDf:   code = math( "float", "+" ); break;
+        case asBC_SUBf:   code = math( "float", "-" ); break;
+        case asBC_MULf:   code = math( "float", "*" ); break;
+        case asBC_DIVf:   code = divide( "float", var("float", arg1) + " / d", "" ); break;
+        case asBC_MODf:   code = divide( "float", "std::fmod(" + var("float", arg1) + ", d)", "" ); break;
+        case asBC_ADDd:   code = math( "double", "+" ); break;
+        case asBC_SUBd:   code = math( "double", "-" ); break;
+        case asBC_MULd:   code = math( "double", "*" ); break;
+        case asBC_DIVd:   code = divide( "double", var("double", arg1) + " / d", "" ); break;
+        case asBC_MODd:   code = divide( "double", "std::fmod(" + var("double", arg1) + ", d)", "" ); break;
+        case asBC_ADDIi:  code = mathConst( "asDWORD", "+", intConst1 ); break;
+        case asBC_SUBIi:  code = mathConst( "asDWORD", "-", intConst1 ); break;
+        case asBC_MULIi:  code = mathConst( "asDWORD", "*", intConst1 ); break;
+        case asBC_ADDIf:  code = mathConst( "float", "+", floatConst1 ); break;
+        case asBC_SUBIf:  code = mathConst( "float", "-", floatConst1 ); break;
+        case asBC_MULIf:  code = mathConst( "float", "*", floatConst1 ); break;
+
+        default:
+            return false;
+    }
+
+    return true;
+}
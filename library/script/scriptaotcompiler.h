@@ -0,0 +1,71 @@
+
+/************************************************************************
+*    FILE NAME:       scriptaotcompiler.h
+*
+*    DESCRIPTION:     AngelScript JIT compiler interface that hooks up
+*                     the script functions compiled ahead of time to
+*                     C++ and generates that C++ from the byte code
+************************************************************************/
+
+#pragma once
+
+// AngelScript lib dependencies
+#include <angelscript.h>
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <string>
+#include <vector>
+#include <set>
+#include <cstdint>
+
+class CScriptAotCompiler : public asIJITCompiler, boost::noncopyable
+{
+public:
+
+    // Constructor
+    CScriptAotCompiler();
+
+    // Destructor
+    virtual ~CScriptAotCompiler();
+
+    // Hook up the compiled function. Called by the engine when a module is built or loaded
+    int CompileFunction( asIScriptFunction * pFunction, asJITFunction * pOutput ) override;
+
+    // Release the compiled function
+    void ReleaseJITFunction( asJITFunction func ) override;
+
+    // Generate C++ for the functions of the module as they are compiled
+    void beginGenerate( const std::string & module );
+
+    // Write the generated C++ to file
+    void endGenerate( const std::string & filePath );
+
+private:
+
+    // Generate the C++ function for the script function
+    void generate( asIScriptFunction * pFunction, const std::string & decl, uint32_t hash );
+
+    // Translate the instruction to C++. Returns false if the interpreter needs to run it
+    bool translate( asDWORD * pInstr, asUINT pos, std::string & code, std::set<asUINT> & labelSet ) const;
+
+    // Get the byte code positions of the JIT entries the C++ can resume from
+    void getEntries( asDWORD * pByteCode, asUINT length, std::vector<asUINT> & entryVec ) const;
+
+    // Hash the parts of the byte code the generated C++ depends on
+    uint32_t hashByteCode( asDWORD * pByteCode, asUINT length ) const;
+
+private:
+
+    // Module C++ is being generated for
+    std::string m_generateModule;
+
+    // Generated function definitions and table entries
+    std::string m_functionCode;
+    std::string m_tableCode;
+
+    // Number of generated functions
+    int m_generateCounter;
+};
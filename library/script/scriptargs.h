@@ -0,0 +1,54 @@
+
+/************************************************************************
+*    FILE NAME:       scriptargs.h
+*
+*    DESCRIPTION:     Fixed capacity script argument pack kept inline
+*                     so passing arguments doesn't allocate
+************************************************************************/
+
+#pragma once
+
+// Game lib dependencies
+#include <script/scriptparam.h>
+#include <utilities/exceptionhandling.h>
+
+// Standard lib dependencies
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+
+class CScriptArgs
+{
+public:
+
+    // Max number of arguments a script function can be passed
+    static constexpr size_t MAX_ARGS = 4;
+
+    // Constructors
+    CScriptArgs() {}
+
+    CScriptArgs( std::initializer_list<CScriptParam> paramLst )
+    {
+        if( paramLst.size() > MAX_ARGS )
+            throw NExcept::CCriticalException( "Script Argument Error!", "Too many arguments passed to the script function." );
+
+        for( auto & iter : paramLst )
+            m_paramAry[m_count++] = iter;
+    }
+
+    // Get the number of arguments
+    size_t size() const
+    { return m_count; }
+
+    // Get the argument
+    const CScriptParam & operator[]( size_t index ) const
+    { return m_paramAry[index]; }
+
+private:
+
+    // The arguments
+    std::array<CScriptParam, MAX_ARGS> m_paramAry;
+
+    // Number of arguments
+    size_t m_count = 0;
+};
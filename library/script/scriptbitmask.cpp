@@ -12,10 +12,10 @@
 #include <utilities/bitmask.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
-#include <autowrapper/aswrappedcall.h>
 
 namespace NScriptBitmask
 {
@@ -31,14 +31,14 @@ namespace NScriptBitmask
         // Register type
         Throw( pEngine->RegisterObjectType(  "CBitmask", 0, asOBJ_REF|asOBJ_NOCOUNT) );
 
-        Throw( pEngine->RegisterObjectMethod("CBitmask", "void add(uint)",             WRAP_MFN(CBitmask<int>, add),             asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CBitmask", "void remove(uint)",          WRAP_MFN(CBitmask<int>, remove),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CBitmask", "void removeAllExcept(uint)", WRAP_MFN(CBitmask<int>, removeAllExcept), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CBitmask", "void clear()",               WRAP_MFN(CBitmask<int>, clear),           asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CBitmask", "bool isEmpty()",             WRAP_MFN(CBitmask<int>, isEmpty),         asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CBitmask", "bool isSet(uint)",           WRAP_MFN(CBitmask<int>, isSet),           asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CBitmask", "bool areAllSet(uint)",       WRAP_MFN(CBitmask<int>, areAllSet),       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CBitmask", "int getIncluding(uint)",     WRAP_MFN(CBitmask<int>, getIncluding),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CBitmask", "int getExcluding(uint)",     WRAP_MFN(CBitmask<int>, getExcluding),    asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CBitmask", "void add(uint)",             SCRIPT_MFN(CBitmask<int>, add)) );
+        Throw( pEngine->RegisterObjectMethod("CBitmask", "void remove(uint)",          SCRIPT_MFN(CBitmask<int>, remove)) );
+        Throw( pEngine->RegisterObjectMethod("CBitmask", "void removeAllExcept(uint)", SCRIPT_MFN(CBitmask<int>, removeAllExcept)) );
+        Throw( pEngine->RegisterObjectMethod("CBitmask", "void clear()",               SCRIPT_MFN(CBitmask<int>, clear)) );
+        Throw( pEngine->RegisterObjectMethod("CBitmask", "bool isEmpty()",             SCRIPT_MFN(CBitmask<int>, isEmpty)) );
+        Throw( pEngine->RegisterObjectMethod("CBitmask", "bool isSet(uint)",           SCRIPT_MFN(CBitmask<int>, isSet)) );
+        Throw( pEngine->RegisterObjectMethod("CBitmask", "bool areAllSet(uint)",       SCRIPT_MFN(CBitmask<int>, areAllSet)) );
+        Throw( pEngine->RegisterObjectMethod("CBitmask", "int getIncluding(uint)",     SCRIPT_MFN(CBitmask<int>, getIncluding)) );
+        Throw( pEngine->RegisterObjectMethod("CBitmask", "int getExcluding(uint)",     SCRIPT_MFN(CBitmask<int>, getExcluding)) );
     }
 }
@@ -0,0 +1,309 @@
+
+/************************************************************************
+*    FILE NAME:       scriptbytecodecache.cpp
+*
+*    DESCRIPTION:     Cache of script group byte code keyed on a hash of
+*                     the sources, the engine version and the registered
+*                     interface. Stale byte code is rebuilt from the sources
+************************************************************************/
+
+// Physical component dependency
+#include <script/scriptbytecodecache.h>
+
+// Game lib dependencies
+#include <script/bytecodestream.h>
+#include <utilities/genfunc.h>
+
+// AngelScript lib dependencies
+#include <angelscript.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <cstring>
+
+// SDL lib dependencies
+#include <SDL3/SDL.h>
+
+namespace
+{
+    // Header saved in front of the cached byte code
+    const char CACHE_ID[4] = {'A','S','B','C'};
+    const uint32_t CACHE_FORMAT = 1;
+    const size_t HEADER_SIZE = sizeof(CACHE_ID) + sizeof(CACHE_FORMAT) + sizeof(uint64_t);
+
+    // FNV-1a
+    const uint64_t HASH_START = 14695981039346656037ull;
+
+    uint64_t Hash( uint64_t hash, const void * pData, size_t size )
+    {
+        const unsigned char * pByte = static_cast<const unsigned char *>(pData);
+
+        for( size_t i = 0; i < size; ++i )
+            hash = (hash ^ pByte[i]) * 1099511628211ull;
+
+        return hash;
+    }
+
+    uint64_t Hash( uint64_t hash, const char * pStr )
+    {
+        // Include the terminator so "ab" + "c" doesn't hash the same as "a" + "bc"
+        if( pStr != nullptr )
+            return Hash( hash, pStr, std::strlen(pStr) + 1 );
+
+        return Hash( hash, "", 1 );
+    }
+}
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CScriptByteCodeCache::CScriptByteCodeCache( const std::string & path ) :
+    m_path( path )
+{
+    if( !m_path.empty() && (m_path.back() != '/') )
+        m_path += '/';
+}
+
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CScriptByteCodeCache::~CScriptByteCodeCache()
+{
+    // Let any background reads finish before going away
+    for( auto & iter : m_preloadMap )
+        iter.second.wait();
+}
+
+
+/************************************************************************
+*    DESC:  Read the scripts and cached byte code of the group on a background thread
+************************************************************************/
+void CScriptByteCodeCache::preload( const std::string & group, const std::vector<std::string> & fileVec )
+{
+    if( m_preloadMap.find( group ) == m_preloadMap.end() )
+        m_preloadMap.emplace( group, std::async( std::launch::async, &CScriptByteCodeCache::read, getCacheFile( group ), fileVec ) );
+}
+
+
+/************************************************************************
+*    DESC:  Get the scripts and cached byte code of the group
+*           Waits on a preload in progress
+************************************************************************/
+CScriptByteCodeCache::CGroupData CScriptByteCodeCache::getGroupData(
+    const std::string & group, const std::vector<std::string> & fileVec )
+{
+    auto iter = m_preloadMap.find( group );
+    if( iter != m_preloadMap.end() )
+    {
+        std::future<CGroupData> preload = std::move( iter->second );
+        m_preloadMap.erase( iter );
+
+        // Rethrows anything that went wrong on the background thread
+        return preload.get();
+    }
+
+    return read( getCacheFile( group ), fileVec );
+}
+
+
+/************************************************************************
+*    DESC:  Load the cached byte code into the module
+*           Returns false if it's missing or stale
+************************************************************************/
+bool CScriptByteCodeCache::load(
+    asIScriptModule * pScriptModule,
+    CGroupData & groupData,
+    const uint64_t engineHash,
+    const bool stripDebugInfo )
+{
+    if( groupData.cacheVec.size() < HEADER_SIZE )
+        return false;
+
+    // Check the header
+    const char * pHeader = groupData.cacheVec.data();
+    uint32_t format;
+    uint64_t key;
+    std::memcpy( &format, pHeader + sizeof(CACHE_ID), sizeof(format) );
+    std::memcpy( &key, pHeader + sizeof(CACHE_ID) + sizeof(format), sizeof(key) );
+
+    if( (std::memcmp( pHeader, CACHE_ID, sizeof(CACHE_ID) ) != 0) ||
+        (format != CACHE_FORMAT) ||
+        (key != getKey( groupData, engineHash, stripDebugInfo )) )
+        return false;
+
+    // Read the byte code right out of the buffer
+    CByteCodeStream byteCode( std::move(groupData.cacheVec), HEADER_SIZE );
+
+    return (pScriptModule->LoadByteCode( &byteCode ) >= 0);
+}
+
+
+/************************************************************************
+*    DESC:  Save the byte code of the module to the cache
+*           NOTE: A failed save only means the group is built next time
+************************************************************************/
+void CScriptByteCodeCache::save(
+    asIScriptModule * pScriptModule,
+    const std::string & group,
+    const CGroupData & groupData,
+    const uint64_t engineHash,
+    const bool stripDebugInfo )
+{
+    SDL_CreateDirectory( m_path.c_str() );
+
+    const std::string cacheFile = getCacheFile( group );
+    const uint64_t key = getKey( groupData, engineHash, stripDebugInfo );
+
+    try
+    {
+        CByteCodeStream byteCode( cacheFile, "wb" );
+        byteCode.Write( CACHE_ID, sizeof(CACHE_ID) );
+        byteCode.Write( &CACHE_FORMAT, sizeof(CACHE_FORMAT) );
+        byteCode.Write( &key, sizeof(key) );
+
+        if( (pScriptModule->SaveByteCode( &byteCode, stripDebugInfo ) < 0) || !byteCode.flush() )
+            NGenFunc::PostDebugMsg( boost::str( boost::format("Error caching script byte code (%s).") % cacheFile ) );
+    }
+    catch( ... )
+    {
+        NGenFunc::PostDebugMsg( boost::str( boost::format("Error opening script byte code cache (%s).") % cacheFile ) );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Hash the engine version, the properties that change the
+*           byte code and the registered interface so the cache is
+*           rebuilt when any of them change
+************************************************************************/
+uint64_t CScriptByteCodeCache::hashEngine( asIScriptEngine * pEngine )
+{
+    uint64_t hash = Hash( HASH_START, asGetLibraryVersion() );
+    hash = Hash( hash, asGetLibraryOptions() );
+
+    // Properties that change the byte code. The JIT entries are only
+    // in it when the ahead of time code is hooked up
+    for( auto property : { asEP_INCLUDE_JIT_INSTRUCTIONS, asEP_OPTIMIZE_BYTECODE, asEP_BUILD_WITHOUT_LINE_CUES } )
+    {
+        const asPWORD value = pEngine->GetEngineProperty( property );
+        hash = Hash( hash, &value, sizeof(value) );
+    }
+
+    for( asUINT i = 0; i < pEngine->GetObjectTypeCount(); ++i )
+    {
+        asITypeInfo * pType = pEngine->GetObjectTypeByIndex( i );
+        hash = Hash( hash, pType->GetNamespace() );
+        hash = Hash( hash, pType->GetName() );
+
+        const asDWORD flags = pType->GetFlags();
+        hash = Hash( hash, &flags, sizeof(flags) );
+
+        for( asUINT j = 0; j < pType->GetBehaviourCount(); ++j )
+        {
+            asEBehaviours behaviour;
+            asIScriptFunction * pFunc = pType->GetBehaviourByIndex( j, &behaviour );
+            hash = Hash( hash, &behaviour, sizeof(behaviour) );
+            hash = Hash( hash, pFunc->GetDeclaration( true, true, true ) );
+        }
+
+        for( asUINT j = 0; j < pType->GetFactoryCount(); ++j )
+            hash = Hash( hash, pType->GetFactoryByIndex( j )->GetDeclaration( true, true, true ) );
+
+        for( asUINT j = 0; j < pType->GetMethodCount(); ++j )
+            hash = Hash( hash, pType->GetMethodByIndex( j )->GetDeclaration( true, true, true ) );
+
+        for( asUINT j = 0; j < pType->GetPropertyCount(); ++j )
+            hash = Hash( hash, pType->GetPropertyDeclaration( j, true ) );
+    }
+
+    for( asUINT i = 0; i < pEngine->GetGlobalFunctionCount(); ++i )
+        hash = Hash( hash, pEngine->GetGlobalFunctionByIndex( i )->GetDeclaration( true, true, true ) );
+
+    for( asUINT i = 0; i < pEngine->GetGlobalPropertyCount(); ++i )
+    {
+        const char * pName = nullptr;
+        const char * pNameSpace = nullptr;
+        int typeId = 0;
+        pEngine->GetGlobalPropertyByIndex( i, &pName, &pNameSpace, &typeId );
+        hash = Hash( hash, pNameSpace );
+        hash = Hash( hash, pName );
+        hash = Hash( hash, pEngine->GetTypeDeclaration( typeId, true ) );
+    }
+
+    for( asUINT i = 0; i < pEngine->GetEnumCount(); ++i )
+    {
+        asITypeInfo * pEnum = pEngine->GetEnumByIndex( i );
+        hash = Hash( hash, pEnum->GetNamespace() );
+        hash = Hash( hash, pEnum->GetName() );
+
+        for( asUINT j = 0; j < pEnum->GetEnumValueCount(); ++j )
+        {
+            int value;
+            hash = Hash( hash, pEnum->GetEnumValueByIndex( j, &value ) );
+            hash = Hash( hash, &value, sizeof(value) );
+        }
+    }
+
+    for( asUINT i = 0; i < pEngine->GetFuncdefCount(); ++i )
+        hash = Hash( hash, pEngine->GetFuncdefByIndex( i )->GetFuncdefSignature()->GetDeclaration( true, true, true ) );
+
+    for( asUINT i = 0; i < pEngine->GetTypedefCount(); ++i )
+    {
+        asITypeInfo * pTypedef = pEngine->GetTypedefByIndex( i );
+        hash = Hash( hash, pTypedef->GetName() );
+        hash = Hash( hash, pEngine->GetTypeDeclaration( pTypedef->GetTypedefTypeId(), true ) );
+    }
+
+    return hash;
+}
+
+
+/************************************************************************
+*    DESC:  Read the scripts and cached byte code
+*           NOTE: Can be called from a background thread
+************************************************************************/
+CScriptByteCodeCache::CGroupData CScriptByteCodeCache::read(
+    const std::string & cacheFile, const std::vector<std::string> & fileVec )
+{
+    CGroupData groupData;
+    groupData.sourceVec.reserve( fileVec.size() );
+    groupData.sourceHash = HASH_START;
+
+    for( auto & iter : fileVec )
+    {
+        groupData.sourceVec.emplace_back( NGenFunc::FileToVec( iter, NGenFunc::TERMINATE ) );
+
+        // The file path is the script section name so it's part of the hash
+        groupData.sourceHash = Hash( groupData.sourceHash, iter.c_str() );
+        groupData.sourceHash = Hash( groupData.sourceHash, groupData.sourceVec.back().data(), groupData.sourceVec.back().size() );
+    }
+
+    if( SDL_GetPathInfo( cacheFile.c_str(), nullptr ) )
+        groupData.cacheVec = NGenFunc::FileToVec( cacheFile );
+
+    return groupData;
+}
+
+
+/************************************************************************
+*    DESC:  Get the file path of the cached byte code
+************************************************************************/
+std::string CScriptByteCodeCache::getCacheFile( const std::string & group ) const
+{
+    return m_path + group + ".bin";
+}
+
+
+/************************************************************************
+*    DESC:  Get the key the cached byte code is saved with
+************************************************************************/
+uint64_t CScriptByteCodeCache::getKey( const CGroupData & groupData, const uint64_t engineHash, const bool stripDebugInfo )
+{
+    // Stripped byte code has no line numbers for the script errors and the profiler
+    const uint64_t hash = Hash( groupData.sourceHash, &engineHash, sizeof(engineHash) );
+
+    return Hash( hash, &stripDebugInfo, sizeof(stripDebugInfo) );
+}
@@ -0,0 +1,93 @@
+
+/************************************************************************
+*    FILE NAME:       scriptbytecodecache.h
+*
+*    DESCRIPTION:     Cache of script group byte code keyed on a hash of
+*                     the sources, the engine version and the registered
+*                     interface. Stale byte code is rebuilt from the sources
+************************************************************************/
+
+#pragma once
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <string>
+#include <vector>
+#include <map>
+#include <future>
+#include <cstdint>
+
+// Forward declaration(s)
+class asIScriptEngine;
+class asIScriptModule;
+
+class CScriptByteCodeCache : boost::noncopyable
+{
+public:
+
+    // The scripts of a group and the byte code cached for them
+    class CGroupData
+    {
+    public:
+
+        // File contents of the scripts
+        std::vector< std::vector<char> > sourceVec;
+
+        // Cached byte code file contents. Empty if not cached
+        std::vector<char> cacheVec;
+
+        // Hash of the script files
+        uint64_t sourceHash = 0;
+    };
+
+    // Constructor
+    CScriptByteCodeCache( const std::string & path );
+
+    // Destructor
+    ~CScriptByteCodeCache();
+
+    // Read the scripts and cached byte code of the group on a background thread
+    void preload( const std::string & group, const std::vector<std::string> & fileVec );
+
+    // Get the scripts and cached byte code of the group. Waits on a preload in progress
+    CGroupData getGroupData( const std::string & group, const std::vector<std::string> & fileVec );
+
+    // Load the cached byte code into the module. Returns false if it's missing or stale
+    bool load(
+        asIScriptModule * pScriptModule,
+        CGroupData & groupData,
+        const uint64_t engineHash,
+        const bool stripDebugInfo );
+
+    // Save the byte code of the module to the cache
+    void save(
+        asIScriptModule * pScriptModule,
+        const std::string & group,
+        const CGroupData & groupData,
+        const uint64_t engineHash,
+        const bool stripDebugInfo );
+
+    // Hash the engine version, the byte code properties and the registered interface
+    static uint64_t hashEngine( asIScriptEngine * pEngine );
+
+private:
+
+    // Read the scripts and cached byte code
+    static CGroupData read( const std::string & cacheFile, const std::vector<std::string> & fileVec );
+
+    // Get the file path of the cached byte code
+    std::string getCacheFile( const std::string & group ) const;
+
+    // Get the key the cached byte code is saved with
+    static uint64_t getKey( const CGroupData & groupData, const uint64_t engineHash, const bool stripDebugInfo );
+
+private:
+
+    // Folder the byte code is cached in
+    std::string m_path;
+
+    // Groups being read on a background thread
+    std::map< const std::string, std::future<CGroupData> > m_preloadMap;
+};
@@ -0,0 +1,38 @@
+
+/************************************************************************
+*    FILE NAME:       scriptcallconv.h
+*
+*    DESCRIPTION:     Macros for registering functions with AngelScript.
+*                     The generic wrappers are used unless the native
+*                     calling convention is asked for and supported
+************************************************************************/
+
+#pragma once
+
+// AngelScript lib dependencies
+#include <angelscript.h>
+#include <autowrapper/aswrappedcall.h>
+
+// The engine only has native calling conventions for some platforms
+// NOTE: Use benchmark/scriptcallbench to see which is faster for the platform
+#if defined(SCRIPT_NATIVE_CALLS) && \
+    (defined(AS_MAX_PORTABILITY) || !(defined(__x86_64__) || defined(_M_X64)))
+    #undef SCRIPT_NATIVE_CALLS
+#endif
+
+// Each macro expands to the function pointer and the calling convention
+#if defined(SCRIPT_NATIVE_CALLS)
+    #define SCRIPT_FN(name)                      asFUNCTION(name), asCALL_CDECL
+    #define SCRIPT_FN_PR(name, params, ret)      asFUNCTIONPR(name, params, ret), asCALL_CDECL
+    #define SCRIPT_OBJ_LAST(name)                asFUNCTION(name), asCALL_CDECL_OBJLAST
+    #define SCRIPT_OBJ_FIRST(name)               asFUNCTION(name), asCALL_CDECL_OBJFIRST
+    #define SCRIPT_MFN(cls, name)                asMETHOD(cls, name), asCALL_THISCALL
+    #define SCRIPT_MFN_PR(cls, name, params, r)  asMETHODPR(cls, name, params, r), asCALL_THISCALL
+#else
+    #define SCRIPT_FN(name)                      WRAP_FN(name), asCALL_GENERIC
+    #define SCRIPT_FN_PR(name, params, ret)      WRAP_FN_PR(name, params, ret), asCALL_GENERIC
+    #define SCRIPT_OBJ_LAST(name)                WRAP_OBJ_LAST(name), asCALL_GENERIC
+    #define SCRIPT_OBJ_FIRST(name)               WRAP_OBJ_FIRST(name), asCALL_GENERIC
+    #define SCRIPT_MFN(cls, name)                WRAP_MFN(cls, name), asCALL_GENERIC
+    #define SCRIPT_MFN_PR(cls, name, params, r)  WRAP_MFN_PR(cls, name, params, r), asCALL_GENERIC
+#endif
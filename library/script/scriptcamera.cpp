@@ -12,10 +12,10 @@
 #include <common/camera.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
-#include <autowrapper/aswrappedcall.h>
 
 namespace NScriptCamera
 {
@@ -128,33 +128,33 @@ namespace NScriptCamera
         // Register type
         Throw( pEngine->RegisterObjectType(  "CCamera", 0, asOBJ_REF|asOBJ_NOCOUNT) );
         
-        Throw( pEngine->RegisterObjectMethod("CCamera", "void setPos(CPoint &in)",                             WRAP_OBJ_LAST(SetPos1), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CCamera", "void setPos(float x = 0, float y = 0, float z = 0)",  WRAP_OBJ_LAST(SetPos2), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "void setPos(CPoint &in)",                             SCRIPT_OBJ_LAST(SetPos1)) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "void setPos(float x = 0, float y = 0, float z = 0)",  SCRIPT_OBJ_LAST(SetPos2)) );
         
-        Throw( pEngine->RegisterObjectMethod("CCamera", "void incPos(CPoint & in)",                            WRAP_OBJ_LAST(IncPos1), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CCamera", "void incPos(float x = 0, float y = 0, float z = 0)",  WRAP_OBJ_LAST(IncPos2), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "void incPos(CPoint & in)",                            SCRIPT_OBJ_LAST(IncPos1)) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "void incPos(float x = 0, float y = 0, float z = 0)",  SCRIPT_OBJ_LAST(IncPos2)) );
         
-        Throw( pEngine->RegisterObjectMethod("CCamera", "CPoint getPos() const",                                WRAP_OBJ_LAST(GetPos),  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "CPoint getPos() const",                                SCRIPT_OBJ_LAST(GetPos)) );
 
-        Throw( pEngine->RegisterObjectMethod("CCamera", "void setRot(CPoint &in, bool convertToRadians = true)", WRAP_OBJ_LAST(SetRot1), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CCamera", "void setRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", WRAP_OBJ_LAST(SetRot2), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "void setRot(CPoint &in, bool convertToRadians = true)", SCRIPT_OBJ_LAST(SetRot1)) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "void setRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", SCRIPT_OBJ_LAST(SetRot2)) );
         
-        Throw( pEngine->RegisterObjectMethod("CCamera", "void incRot(CPoint &in, bool convertToRadians = true)", WRAP_OBJ_LAST(IncRot1), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CCamera", "void incRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", WRAP_OBJ_LAST(IncRot2), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "void incRot(CPoint &in, bool convertToRadians = true)", SCRIPT_OBJ_LAST(IncRot1)) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "void incRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", SCRIPT_OBJ_LAST(IncRot2)) );
         
-        Throw( pEngine->RegisterObjectMethod("CCamera", "const CPoint & getRot() const",                         WRAP_OBJ_LAST(GetRot),    asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "const CPoint & getRot() const",                         SCRIPT_OBJ_LAST(GetRot)) );
         
-        Throw( pEngine->RegisterObjectMethod("CCamera", "void setScale(CPoint & in)",                            WRAP_OBJ_LAST(SetScale1), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CCamera", "void setScale(float x = 1, float y = 1, float z = 1)",  WRAP_OBJ_LAST(SetScale2), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "void setScale(CPoint & in)",                            SCRIPT_OBJ_LAST(SetScale1)) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "void setScale(float x = 1, float y = 1, float z = 1)",  SCRIPT_OBJ_LAST(SetScale2)) );
         
-        Throw( pEngine->RegisterObjectMethod("CCamera", "void incScale(CPoint & in)",                            WRAP_OBJ_LAST(IncScale1), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CCamera", "void incScale(float x = 1, float y = 1, float z = 1)",  WRAP_OBJ_LAST(IncScale2), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "void incScale(CPoint & in)",                            SCRIPT_OBJ_LAST(IncScale1)) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "void incScale(float x = 1, float y = 1, float z = 1)",  SCRIPT_OBJ_LAST(IncScale2)) );
 
-        Throw( pEngine->RegisterObjectMethod("CCamera", "const CPoint & getScale() const",                       WRAP_OBJ_LAST(GetScale),   asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "const CPoint & getScale() const",                       SCRIPT_OBJ_LAST(GetScale)) );
 
-        Throw( pEngine->RegisterObjectMethod("CCamera", "CPoint toOrthoCoord(const CPoint & in)",                WRAP_OBJ_LAST(ToOrthoCoord1),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CCamera", "CPoint toOrthoCoord(const int, const int)",             WRAP_OBJ_LAST(ToOrthoCoord2),   asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "CPoint toOrthoCoord(const CPoint & in)",                SCRIPT_OBJ_LAST(ToOrthoCoord1)) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "CPoint toOrthoCoord(const int, const int)",             SCRIPT_OBJ_LAST(ToOrthoCoord2)) );
         
-        Throw( pEngine->RegisterObjectMethod("CCamera", "void transform()",                                      WRAP_OBJ_LAST(Transform), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CCamera", "void transform()",                                      SCRIPT_OBJ_LAST(Transform)) );
     }
 }
\ No newline at end of file
@@ -12,10 +12,10 @@
 #include <managers/cameramanager.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
-#include <autowrapper/aswrappedcall.h>
 
 namespace NScriptCameraManager
 {
@@ -31,14 +31,14 @@ namespace NScriptCameraManager
         // Register type
         Throw( pEngine->RegisterObjectType( "CCameraMgr", 0, asOBJ_REF|asOBJ_NOCOUNT) );
 
-        Throw( pEngine->RegisterObjectMethod("CCameraMgr", "CCamera & getDefault()",               WRAP_MFN(CCameraMgr, getDefault),              asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CCameraMgr", "CCamera & get(string &in)",            WRAP_MFN(CCameraMgr, get),                     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CCameraMgr", "void addToTransList(string &in)",      WRAP_MFN(CCameraMgr, addToTransList),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CCameraMgr", "void removeFromTransList(string &in)", WRAP_MFN(CCameraMgr, removeFromTransList),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CCameraMgr", "void transform()",                     WRAP_MFN(CCameraMgr, transform),               asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CCameraMgr", "void clear()",                         WRAP_MFN(CCameraMgr, clear),                   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CCameraMgr", "void clearTransList()",                WRAP_MFN(CCameraMgr, clearTransList),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CCameraMgr", "void rebuildProjectionMatrix()",       WRAP_MFN(CCameraMgr, rebuildProjectionMatrix), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CCameraMgr", "CCamera & getDefault()",               SCRIPT_MFN(CCameraMgr, getDefault)) );
+        Throw( pEngine->RegisterObjectMethod("CCameraMgr", "CCamera & get(string &in)",            SCRIPT_MFN(CCameraMgr, get)) );
+        Throw( pEngine->RegisterObjectMethod("CCameraMgr", "void addToTransList(string &in)",      SCRIPT_MFN(CCameraMgr, addToTransList)) );
+        Throw( pEngine->RegisterObjectMethod("CCameraMgr", "void removeFromTransList(string &in)", SCRIPT_MFN(CCameraMgr, removeFromTransList)) );
+        Throw( pEngine->RegisterObjectMethod("CCameraMgr", "void transform()",                     SCRIPT_MFN(CCameraMgr, transform)) );
+        Throw( pEngine->RegisterObjectMethod("CCameraMgr", "void clear()",                         SCRIPT_MFN(CCameraMgr, clear)) );
+        Throw( pEngine->RegisterObjectMethod("CCameraMgr", "void clearTransList()",                SCRIPT_MFN(CCameraMgr, clearTransList)) );
+        Throw( pEngine->RegisterObjectMethod("CCameraMgr", "void rebuildProjectionMatrix()",       SCRIPT_MFN(CCameraMgr, rebuildProjectionMatrix)) );
         
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CCameraMgr CameraMgr", &CCameraMgr::Instance()) );
@@ -10,6 +10,7 @@
 
 // Game lib dependencies
 #include <script/scriptmanager.h>
+#include <script/scriptfunchandle.h>
 #include <utilities/exceptionhandling.h>
 #include <utilities/statcounter.h>
 
@@ -41,9 +42,16 @@ CScriptComponent::~CScriptComponent()
 void CScriptComponent::prepare(
     const std::string & group,
     const std::string & funcName,
-    const std::vector<CScriptParam> & paramVec )
+    const CScriptArgs & args )
 {
-    CScriptMgr::Instance().prepare( group, funcName, m_pContextVec, paramVec );
+    CScriptMgr::Instance().prepare( group, funcName, m_pContextVec, args );
+}
+
+void CScriptComponent::prepare(
+    const CScriptFuncHandle & funcHandle,
+    const CScriptArgs & args )
+{
+    CScriptMgr::Instance().prepare( funcHandle, m_pContextVec, args );
 }
 
 /************************************************************************
@@ -63,6 +71,23 @@ bool CScriptComponent::isActive()
     return !m_pContextVec.empty();
 }
 
+/************************************************************************
+*    DESC:  Are all the running scripts parallel safe
+************************************************************************/
+bool CScriptComponent::isParallel() const
+{
+    if( m_pContextVec.empty() )
+        return false;
+
+    for( auto iter : m_pContextVec )
+    {
+        if( !CScriptMgr::Instance().isParallel( iter ) )
+            return false;
+    }
+
+    return true;
+}
+
 /************************************************************************
 *    DESC:  Reset the contexts and recycle
 ************************************************************************/
@@ -111,11 +136,11 @@ void CScriptComponent::stopAndRecycle( const std::string & funcName )
 *    DESC:  Stop a function if it is being called and restart it
 ************************************************************************/
 void CScriptComponent::stopAndRestart(
-    const std::string & group, const std::string & funcName, const std::vector<CScriptParam> & paramVec )
+    const std::string & group, const std::string & funcName, const CScriptArgs & args )
 {
     // Try to stop and recycle the function if it is active
     stopAndRecycle( funcName );
 
     // Prepare the script function to run
-    prepare( group, funcName, paramVec );
+    prepare( group, funcName, args );
 }
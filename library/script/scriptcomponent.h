@@ -8,7 +8,7 @@
 #pragma once
 
 // Game lib dependencies
-#include <script/scriptparam.h>
+#include <script/scriptargs.h>
 
 // Boost lib dependencies
 #include <boost/noncopyable.hpp>
@@ -19,6 +19,7 @@
 
 // Forward declaration(s)
 class asIScriptContext;
+class CScriptFuncHandle;
 
 class CScriptComponent : boost::noncopyable
 {
@@ -34,7 +35,11 @@ public:
     void prepare(
         const std::string & group,
         const std::string & funcName,
-        const std::vector<CScriptParam> & paramVec = std::vector<CScriptParam>() );
+        const CScriptArgs & args = CScriptArgs() );
+
+    void prepare(
+        const CScriptFuncHandle & funcHandle,
+        const CScriptArgs & args = CScriptArgs() );
 
     // Update the script
     void update( const bool forcedUpdate = false );
@@ -49,11 +54,14 @@ public:
     void stopAndRestart(
         const std::string & group,
         const std::string & funcName,
-        const std::vector<CScriptParam> & paramVec = std::vector<CScriptParam>() );
+        const CScriptArgs & args = CScriptArgs() );
 
     // Is this component active?
     bool isActive();
 
+    // Are all the running scripts parallel safe
+    bool isParallel() const;
+
 private:
 
     // dynamic context vector
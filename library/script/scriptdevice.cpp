@@ -12,11 +12,11 @@
 #include <system/device.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
 #include <utilities/exceptionhandling.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
-#include <autowrapper/aswrappedcall.h>
 
 namespace NScriptDevice
 {
@@ -39,6 +39,16 @@ namespace NScriptDevice
         }
     }
     
+    /************************************************************************
+    *    DESC:  Render and collect script garbage while the GPU is busy
+    ************************************************************************/
+    void Render( CDevice & rDevice )
+    {
+        rDevice.render();
+
+        CScriptMgr::Instance().collectGarbage();
+    }
+    
     /************************************************************************
     *    DESC:  Register global functions
     ************************************************************************/
@@ -51,15 +61,15 @@ namespace NScriptDevice
         // Register type
         Throw( pEngine->RegisterObjectType( "CDevice", 0, asOBJ_REF|asOBJ_NOCOUNT) );
         
-        Throw( pEngine->RegisterObjectMethod("CDevice", "void create(string &in)",                        WRAP_OBJ_LAST(Create),                     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CDevice", "void destroy()",                                 WRAP_MFN(CDevice, destroy),                asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CDevice", "void deleteCommandPoolGroup(string &in)",        WRAP_MFN(CDevice, deleteCommandPoolGroup), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CDevice", "void waitForIdle()",                             WRAP_MFN(CDevice, waitForIdle),            asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CDevice", "void showWindow(bool visible = true)",           WRAP_MFN(CDevice, showWindow),             asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CDevice", "void render()",                                  WRAP_MFN(CDevice, render),                 asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CDevice", "void changeResolution(CSize & in, bool)",        WRAP_MFN(CDevice, changeResolution),       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CDevice", "void setFullScreen(bool)",                       WRAP_MFN(CDevice, setFullScreen),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CDevice", "void setClearColor(float, float, float, float)", WRAP_MFN(CDevice, setClearColor),          asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CDevice", "void create(string &in)",                        SCRIPT_OBJ_LAST(Create)) );
+        Throw( pEngine->RegisterObjectMethod("CDevice", "void destroy()",                                 SCRIPT_MFN(CDevice, destroy)) );
+        Throw( pEngine->RegisterObjectMethod("CDevice", "void deleteCommandPoolGroup(string &in)",        SCRIPT_MFN(CDevice, deleteCommandPoolGroup)) );
+        Throw( pEngine->RegisterObjectMethod("CDevice", "void waitForIdle()",                             SCRIPT_MFN(CDevice, waitForIdle)) );
+        Throw( pEngine->RegisterObjectMethod("CDevice", "void showWindow(bool visible = true)",           SCRIPT_MFN(CDevice, showWindow)) );
+        Throw( pEngine->RegisterObjectMethod("CDevice", "void render()",                                  SCRIPT_OBJ_LAST(Render)) );
+        Throw( pEngine->RegisterObjectMethod("CDevice", "void changeResolution(CSize & in, bool)",        SCRIPT_MFN(CDevice, changeResolution)) );
+        Throw( pEngine->RegisterObjectMethod("CDevice", "void setFullScreen(bool)",                       SCRIPT_MFN(CDevice, setFullScreen)) );
+        Throw( pEngine->RegisterObjectMethod("CDevice", "void setClearColor(float, float, float, float)", SCRIPT_MFN(CDevice, setClearColor)) );
 
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CDevice Device", &CDevice::Instance()) );
@@ -11,10 +11,10 @@
 // Game lib dependencies
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
-#include <autowrapper/aswrappedcall.h>
 #include <scriptarray/scriptarray.h>
 
 // SDL lib dependencies
@@ -144,12 +144,12 @@ namespace NScriptEvent
         Throw( pEngine->RegisterObjectProperty("CTextEditingEvent", "uint windowID",       asOFFSET(SDL_TextEditingEvent, windowID)) );
         Throw( pEngine->RegisterObjectProperty("CTextEditingEvent", "int start",           asOFFSET(SDL_TextEditingEvent, start)) );
         Throw( pEngine->RegisterObjectProperty("CTextEditingEvent", "int length",          asOFFSET(SDL_TextEditingEvent, length)) );
-        Throw( pEngine->RegisterObjectMethod("CTextEditingEvent", "const string & getStr()", WRAP_OBJ_LAST(GetTextEditingString), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CTextEditingEvent", "const string & getStr()", SCRIPT_OBJ_LAST(GetTextEditingString)) );
 
         Throw( pEngine->RegisterObjectProperty("CTextInputEvent", "uint type",             asOFFSET(SDL_TextInputEvent, type)) );
         Throw( pEngine->RegisterObjectProperty("CTextInputEvent", "uint timestamp",        asOFFSET(SDL_TextInputEvent, timestamp)) );
         Throw( pEngine->RegisterObjectProperty("CTextInputEvent", "uint windowID",         asOFFSET(SDL_TextInputEvent, windowID)) );
-        Throw( pEngine->RegisterObjectMethod("CTextInputEvent", "const string & getStr()", WRAP_OBJ_LAST(GetTextInputString), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CTextInputEvent", "const string & getStr()", SCRIPT_OBJ_LAST(GetTextInputString)) );
 
         Throw( pEngine->RegisterObjectProperty("CMouseMotionEvent", "uint type",           asOFFSET(SDL_MouseMotionEvent, type)) );
         Throw( pEngine->RegisterObjectProperty("CMouseMotionEvent", "uint timestamp",      asOFFSET(SDL_MouseMotionEvent, timestamp)) );
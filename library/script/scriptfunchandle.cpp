@@ -0,0 +1,75 @@
+
+/************************************************************************
+*    FILE NAME:       scriptfunchandle.cpp
+*
+*    DESCRIPTION:     Handle to a script function. The function is looked
+*                     up the first time it's needed and kept until the
+*                     script groups change
+************************************************************************/
+
+// Physical component dependency
+#include <script/scriptfunchandle.h>
+
+// Game lib dependencies
+#include <script/scriptmanager.h>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CScriptFuncHandle::CScriptFuncHandle()
+{
+}
+
+CScriptFuncHandle::CScriptFuncHandle( const std::string & group, const std::string & funcName ) :
+    m_group( group ),
+    m_funcName( funcName )
+{
+}
+
+/************************************************************************
+*    DESC:  Set the group and function
+************************************************************************/
+void CScriptFuncHandle::set( const std::string & group, const std::string & funcName )
+{
+    m_group = group;
+    m_funcName = funcName;
+    m_pFunc = nullptr;
+    m_generation = 0;
+}
+
+/************************************************************************
+*    DESC:  Get the function. Only looked up again if the script groups changed
+************************************************************************/
+asIScriptFunction * CScriptFuncHandle::get() const
+{
+    const uint32_t generation = CScriptMgr::Instance().getGroupGeneration();
+
+    if( m_generation != generation )
+    {
+        m_pFunc = CScriptMgr::Instance().getPtrToFunc( m_group, m_funcName );
+        m_generation = generation;
+    }
+
+    return m_pFunc;
+}
+
+/************************************************************************
+*    DESC:  Get the group and function name
+************************************************************************/
+const std::string & CScriptFuncHandle::getGroup() const
+{
+    return m_group;
+}
+
+const std::string & CScriptFuncHandle::getFuncName() const
+{
+    return m_funcName;
+}
+
+/************************************************************************
+*    DESC:  Is there a function to get
+************************************************************************/
+bool CScriptFuncHandle::isEmpty() const
+{
+    return m_funcName.empty();
+}
@@ -0,0 +1,49 @@
+
+/************************************************************************
+*    FILE NAME:       scriptfunchandle.h
+*
+*    DESCRIPTION:     Handle to a script function. The function is looked
+*                     up the first time it's needed and kept until the
+*                     script groups change
+************************************************************************/
+
+#pragma once
+
+// Standard lib dependencies
+#include <string>
+#include <cstdint>
+
+// Forward declaration(s)
+class asIScriptFunction;
+
+class CScriptFuncHandle
+{
+public:
+
+    // Constructors
+    CScriptFuncHandle();
+    CScriptFuncHandle( const std::string & group, const std::string & funcName );
+
+    // Set the group and function
+    void set( const std::string & group, const std::string & funcName );
+
+    // Get the function. Only looked up again if the script groups changed
+    asIScriptFunction * get() const;
+
+    // Get the group and function name
+    const std::string & getGroup() const;
+    const std::string & getFuncName() const;
+
+    // Is there a function to get
+    bool isEmpty() const;
+
+private:
+
+    // Group and name of the function
+    std::string m_group;
+    std::string m_funcName;
+
+    // Cached function and the script group generation it was looked up in
+    mutable asIScriptFunction * m_pFunc = nullptr;
+    mutable uint32_t m_generation = 0;
+};
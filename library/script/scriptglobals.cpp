@@ -7,16 +7,20 @@
 
 // Physical component dependency
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
 
 // Game lib dependencies
 #include <utilities/highresolutiontimer.h>
 #include <utilities/genfunc.h>
 #include <utilities/exceptionhandling.h>
 #include <script/scriptmanager.h>
+#include <script/scriptscheduler.h>
 #include <common/size.h>
 
 // Standard lib dependencies
 #include <random>
+#include <thread>
+#include <chrono>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
@@ -27,7 +31,6 @@
 // AngelScript lib dependencies
 #include <angelscript.h>
 #include <scriptarray/scriptarray.h>
-#include <autowrapper/aswrappedcall.h>
 
 namespace NScriptGlobals
 {
@@ -79,6 +82,85 @@ namespace NScriptGlobals
         if( ctx )
             ctx->Suspend();
     }
+
+    /************************************************************************
+    *    DESC:  Suspend the script until the time in milliseconds is up
+    *           The context is not resumed until then
+    ************************************************************************/
+    void WaitMs( float time )
+    {
+        asIScriptContext * pContext = asGetActiveContext();
+        if( pContext )
+        {
+            // Scripts spawned by thread just hold up their thread
+            if( !CScriptScheduler::Instance().isSchedulerThread() )
+            {
+                std::this_thread::sleep_for( std::chrono::duration<float, std::milli>( time ) );
+                return;
+            }
+
+            CScriptScheduler::Instance().waitMs( pContext, time );
+            pContext->Suspend();
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  Suspend the script for the number of frames
+    ************************************************************************/
+    void WaitFrames( uint32_t frames )
+    {
+        asIScriptContext * pContext = asGetActiveContext();
+        if( pContext )
+        {
+            if( !CScriptScheduler::Instance().isSchedulerThread() )
+            {
+                pContext->SetException( "WaitFrames can't be used by a script spawned by thread" );
+                return;
+            }
+
+            CScriptScheduler::Instance().waitFrames( pContext, frames );
+            pContext->Suspend();
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  Suspend the script until the event type is queued
+    ************************************************************************/
+    void WaitEvent( uint32_t type )
+    {
+        asIScriptContext * pContext = asGetActiveContext();
+        if( pContext )
+        {
+            if( !CScriptScheduler::Instance().isSchedulerThread() )
+            {
+                pContext->SetException( "WaitEvent can't be used by a script spawned by thread" );
+                return;
+            }
+
+            CScriptScheduler::Instance().waitEvent( pContext, type );
+            pContext->Suspend();
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  Suspend the script until the spawned script is done
+    *           Returns right away if the spawned script is not running
+    ************************************************************************/
+    void WaitUntil( uint32_t spawnId )
+    {
+        asIScriptContext * pContext = asGetActiveContext();
+        if( pContext )
+        {
+            if( !CScriptScheduler::Instance().isSchedulerThread() )
+            {
+                pContext->SetException( "WaitUntil can't be used by a script spawned by thread" );
+                return;
+            }
+
+            if( CScriptScheduler::Instance().waitUntil( pContext, spawnId ) )
+                pContext->Suspend();
+        }
+    }
     
     
     /************************************************************************
@@ -132,14 +214,14 @@ namespace NScriptGlobals
 
     /************************************************************************
     *    DESC:  Spawn Wrapper
-    *    PARAM: const std::string & funcName, const std::string & group
+    *    PARAM: uint return; const std::string & funcName, const std::string & group
     ************************************************************************/
     void Spawn( asIScriptGeneric * pScriptGen )
     {
         const std::string *funcName = reinterpret_cast<std::string*>(pScriptGen->GetArgAddress(0));
         const std::string *group = reinterpret_cast<std::string*>(pScriptGen->GetArgAddress(1));
 
-        CScriptMgr::Instance().prepareSpawn( *funcName, *group );
+        pScriptGen->SetReturnDWord( CScriptMgr::Instance().prepareSpawn( *funcName, *group ) );
     }
 
     /************************************************************************
@@ -163,14 +245,18 @@ namespace NScriptGlobals
 
         Throw( pEngine->RegisterGlobalFunction("int RandInt(int, int)", asFUNCTION(RandInt), asCALL_GENERIC) );
         Throw( pEngine->RegisterGlobalFunction("float RandFloat(float, float)", asFUNCTION(RandFloat), asCALL_GENERIC) );
-        Throw( pEngine->RegisterGlobalFunction("void Print(string &in)", WRAP_FN(NGenFunc::PostDebugMsg), asCALL_GENERIC) );
+        Throw( pEngine->RegisterGlobalFunction("void Print(string &in)", SCRIPT_FN(NGenFunc::PostDebugMsg)) );
         Throw( pEngine->RegisterGlobalFunction("void Suspend()", asFUNCTION(Suspend), asCALL_GENERIC) );
-        Throw( pEngine->RegisterGlobalFunction("int UniformRandomInt(int startRange, int endRange, int seed = 0)", WRAP_FN(NGenFunc::UniformRandomInt), asCALL_GENERIC ) );
-        Throw( pEngine->RegisterGlobalFunction("float UniformRandomFloat(float startRange, float endRange, int seed = 0)", WRAP_FN(NGenFunc::UniformRandomFloat), asCALL_GENERIC ) );
+        Throw( pEngine->RegisterGlobalFunction("void WaitMs(float)", SCRIPT_FN(WaitMs)) );
+        Throw( pEngine->RegisterGlobalFunction("void WaitFrames(uint)", SCRIPT_FN(WaitFrames)) );
+        Throw( pEngine->RegisterGlobalFunction("void WaitEvent(uint)", SCRIPT_FN(WaitEvent)) );
+        Throw( pEngine->RegisterGlobalFunction("void WaitUntil(uint)", SCRIPT_FN(WaitUntil)) );
+        Throw( pEngine->RegisterGlobalFunction("int UniformRandomInt(int startRange, int endRange, int seed = 0)", SCRIPT_FN(NGenFunc::UniformRandomInt) ) );
+        Throw( pEngine->RegisterGlobalFunction("float UniformRandomFloat(float startRange, float endRange, int seed = 0)", SCRIPT_FN(NGenFunc::UniformRandomFloat) ) );
         // The DispatchEvent function has 4 parameters and because they are not defined here, they only return garbage
         // AngelScript is not allowing the other two voided pointers
         Throw( pEngine->RegisterGlobalFunction("int DispatchEvent(int type, int code = 0)", asFUNCTION(DispatchEvent), asCALL_GENERIC) );
-        Throw( pEngine->RegisterGlobalFunction("void Spawn(string &in, string &in = '')", asFUNCTION(Spawn), asCALL_GENERIC) );
+        Throw( pEngine->RegisterGlobalFunction("uint Spawn(string &in, string &in = '')", asFUNCTION(Spawn), asCALL_GENERIC) );
         Throw( pEngine->RegisterGlobalFunction("void SpawnByThread(string &in, string &in = '')", asFUNCTION(SpawnByThread), asCALL_GENERIC) );
         
         Throw( pEngine->RegisterGlobalFunction("array<CSize> @ GetScreenResolutions()", asFUNCTION(GetScreenResolutions), asCALL_GENERIC) );
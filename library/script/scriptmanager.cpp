@@ -14,7 +14,17 @@
 #include <utilities/statcounter.h>
 #include <utilities/settings.h>
 #include <utilities/threadpool.h>
+#include <utilities/highresolutiontimer.h>
 #include <script/bytecodestream.h>
+#include <script/scriptbytecodecache.h>
+#include <script/scriptaot.h>
+#include <script/scriptaotcompiler.h>
+#include <script/scriptcallconv.h>
+#include <script/scriptscheduler.h>
+#include <script/scriptparallel.h>
+#include <script/scriptfunchandle.h>
+#include <script/scriptprofiler.h>
+#include <script/scriptmemorypool.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
@@ -22,11 +32,23 @@
 // AngelScript lib dependencies
 #include <angelscript.h>
 
+// Standard lib dependencies
+#include <cstring>
+#include <algorithm>
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
 CScriptMgr::CScriptMgr()
 {
+    // Script objects, arrays and contexts are allocated from size class pools.
+    // This needs to be done before anything is allocated by the engine
+    if( CSettings::Instance().getScriptMemoryPool() )
+        NScriptMemoryPool::Install( CSettings::Instance().getScriptMemoryPoolDebug() );
+
+    // Parallel safe scripts are run on the thread pool
+    asPrepareMultithread();
+
     // Create the script engine
     scpEngine.reset( asCreateScriptEngine(ANGELSCRIPT_VERSION) );
     if( scpEngine.isNull() )
@@ -36,14 +58,43 @@ CScriptMgr::CScriptMgr()
                 % __FUNCTION__ % __LINE__ ));
     }
 
+#if defined(SCRIPT_NATIVE_CALLS)
+    // The bindings are registered with the native calling convention which the engine needs to support
+    if( std::strstr( asGetLibraryOptions(), "AS_MAX_PORTABILITY" ) != nullptr )
+        throw NExcept::CCriticalException("Error Creating AngelScript Engine!",
+            boost::str( boost::format("AngelScript library was built without native calling conventions. Turn off SCRIPT_NATIVE_CALLS.\n\n%s\nLine: %s")
+                % __FUNCTION__ % __LINE__ ));
+#endif
+
+    // Create the scheduler on this thread. Scripts can only wait on the thread that updates them
+    CScriptScheduler::Instance();
+
     // We don't use call backs for every line execution so set this property to not build with line cues
     scpEngine->SetEngineProperty(asEP_BUILD_WITHOUT_LINE_CUES, true);
 
+    // Garbage is collected after the render instead of whenever a script creates an object
+    if( CSettings::Instance().getScriptGCBudget() > 0.0 )
+        scpEngine->SetEngineProperty(asEP_AUTO_GARBAGE_COLLECT, false);
+
     // Set the message callback to print the messages that the engine gives in case of errors
     if( scpEngine->SetMessageCallback(asMETHOD(CScriptMgr, messageCallback), this, asCALL_THISCALL) < 0 )
     throw NExcept::CCriticalException("Error Creating AngelScript Engine!",
         boost::str( boost::format("AngelScript message callback could not be created.\n\n%s\nLine: %s")
             % __FUNCTION__ % __LINE__ ));
+
+    // Hook up the scripts compiled ahead of time to C++ or generate them.
+    // The byte code needs the JIT entries for either
+    if( !NScriptAot::Empty() || CSettings::Instance().getSaveAotCode() )
+    {
+        m_upAotCompiler.reset( new CScriptAotCompiler );
+
+        scpEngine->SetEngineProperty(asEP_INCLUDE_JIT_INSTRUCTIONS, true);
+        scpEngine->SetJITCompiler(m_upAotCompiler.get());
+    }
+
+    // Cache the byte code of the groups to skip building them on start up
+    if( !CSettings::Instance().getByteCodeCache().empty() )
+        m_upByteCodeCache.reset( new CScriptByteCodeCache( CSettings::Instance().getByteCodeCache() ) );
 }
 
 
@@ -57,10 +108,15 @@ CScriptMgr::~CScriptMgr()
 
 /************************************************************************
 *    DESC:  Derived class loading of class specific data
-*           NOTE: This function is used to save script byte code
+*           NOTE: This function is used to save script byte code and
+*                 the C++ of the scripts compiled ahead of time
 ************************************************************************/
 void CScriptMgr::loadUniqueData( const XMLNode & node, const std::string & group )
 {
+    // Sprites running only scripts from parallel safe groups are updated on the thread pool
+    if( node.isAttributeSet("parallel") && (std::strcmp( node.getAttribute("parallel"), "true" ) == 0) )
+        m_parallelGroupSet.insert( group );
+
     if( node.isAttributeSet("byteCodeFile") )
     {
         // Make sure it's not an empty path
@@ -87,7 +143,7 @@ void CScriptMgr::loadUniqueData( const XMLNode & node, const std::string & group
 
                 // Save the byte code
                 CByteCodeStream byteCode( byteCodePath, "wb" );
-                if( pScriptModule->SaveByteCode( &byteCode, CSettings::Instance().getStripDebugInfo() ) < 0 )
+                if( (pScriptModule->SaveByteCode( &byteCode, CSettings::Instance().getStripDebugInfo() ) < 0) || !byteCode.flush() )
                 {
                     throw NExcept::CCriticalException("Script Byte Code Save Error!",
                         boost::str( boost::format("Error writing script byte code (%s).\n\n%s\nLine: %s")
@@ -100,6 +156,24 @@ void CScriptMgr::loadUniqueData( const XMLNode & node, const std::string & group
             }
         }
     }
+
+    // Do we want to generate the C++ of the scripts compiled ahead of time
+    if( node.isAttributeSet("aotFile") && CSettings::Instance().getSaveAotCode() )
+    {
+        // Make sure it's not an empty path
+        std::string aotPath = node.getAttribute("aotFile");
+        if( !aotPath.empty() )
+        {
+            // Build the scripts for this group and write out the C++ for each function
+            m_upAotCompiler->beginGenerate( group );
+            loadGroup( group, FORCE_LOAD_FROM_SCRIPT );
+            m_upAotCompiler->endGenerate( aotPath );
+
+            // Discard this module and all it's contents.
+            // It will be reloaded through the normal process and will error if it's not discarded
+            scpEngine->DiscardModule( group.c_str() );
+        }
+    }
 }
 
 
@@ -118,6 +192,9 @@ void CScriptMgr::clear()
     m_pContextPoolVec.clear();
     m_pActiveContextVec.clear();
     m_activeContextCounter = 0;
+    m_roundRobinIndex = 0;
+
+    CScriptScheduler::Instance().clear();
 }
 
 
@@ -144,6 +221,10 @@ void CScriptMgr::loadGroup( const std::string & group, const bool forceLoadFromS
                 % group % __FUNCTION__ % __LINE__ ));
     }
 
+    // Mark the memory pool to check for leaks when the group is freed
+    if( CSettings::Instance().getScriptMemoryPoolDebug() )
+        m_memoryMarkMap[group] = NScriptMemoryPool::GetMark();
+
     // See if we have the file path to the byte code
     auto byteCodeFileIter = m_byteCodeFileMap.find( group );
 
@@ -158,6 +239,11 @@ void CScriptMgr::loadGroup( const std::string & group, const bool forceLoadFromS
                     % group % __FUNCTION__ % __LINE__ ));
         }
     }
+    // Load the byte code from the cache or build and cache it
+    else if( m_upByteCodeCache && !forceLoadFromScript )
+    {
+        loadFromCache( pScriptModule, group, listTableIter->second );
+    }
     else
     {
         // Add the scripts to the module
@@ -167,6 +253,12 @@ void CScriptMgr::loadGroup( const std::string & group, const bool forceLoadFromS
         // Build all the scripts added to the module
         buildScript( pScriptModule, group );
     }
+
+    if( m_parallelGroupSet.find( group ) != m_parallelGroupSet.end() )
+        m_pParallelModuleSet.insert( pScriptModule );
+
+    // Function handles need to look up their function again
+    ++m_groupGeneration;
 }
 
 
@@ -176,8 +268,11 @@ void CScriptMgr::loadGroup( const std::string & group, const bool forceLoadFromS
 void CScriptMgr::addScript( asIScriptModule * pScriptModule, const std::string & filePath )
 {
     // Load the script file into a charater array
-    std::vector<char> bufVec = NGenFunc::FileToVec( filePath, NGenFunc::TERMINATE );
+    addScript( pScriptModule, filePath, NGenFunc::FileToVec( filePath, NGenFunc::TERMINATE ) );
+}
 
+void CScriptMgr::addScript( asIScriptModule * pScriptModule, const std::string & filePath, const std::vector<char> & bufVec )
+{
     // Load script into module section - the file path is it's ID
     if( pScriptModule->AddScriptSection(filePath.c_str(), bufVec.data() ) < 0 )
     {
@@ -188,6 +283,54 @@ void CScriptMgr::addScript( asIScriptModule * pScriptModule, const std::string &
 }
 
 
+/************************************************************************
+*    DESC:  Load the group from the byte code cache
+*           Builds the scripts and caches the byte code if it's stale
+************************************************************************/
+void CScriptMgr::loadFromCache(
+    asIScriptModule * pScriptModule, const std::string & group, const std::vector<std::string> & fileVec )
+{
+    // Waits on the group if it's being preloaded
+    auto groupData = m_upByteCodeCache->getGroupData( group, fileVec );
+
+    // The registered interface is part of the key because the byte code refers to it
+    const uint64_t engineHash = CScriptByteCodeCache::hashEngine( scpEngine.get() );
+    const bool stripDebugInfo = CSettings::Instance().getStripDebugInfo();
+
+    if( !m_upByteCodeCache->load( pScriptModule, groupData, engineHash, stripDebugInfo ) )
+    {
+        // Build from the scripts already read in
+        for( size_t i = 0; i < fileVec.size(); ++i )
+            addScript( pScriptModule, fileVec[i], groupData.sourceVec[i] );
+
+        buildScript( pScriptModule, group );
+
+        m_upByteCodeCache->save( pScriptModule, group, groupData, engineHash, stripDebugInfo );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Read the scripts of a group on a background thread ahead of loading it
+*           NOTE: Only used with the byte code cache
+************************************************************************/
+void CScriptMgr::preloadGroup( const std::string & group )
+{
+    if( !m_upByteCodeCache )
+        return;
+
+    auto listTableIter = m_listTableMap.find( group );
+    if( listTableIter == m_listTableMap.end() )
+        throw NExcept::CCriticalException("Script List Preload Group Error!",
+            boost::str( boost::format("Script list group name can't be found (%s).\n\n%s\nLine: %s")
+                % group % __FUNCTION__ % __LINE__ ));
+
+    // Skip groups that are already loaded
+    if( scpEngine->GetModule(group.c_str(), asGM_ONLY_IF_EXISTS) == nullptr )
+        m_upByteCodeCache->preload( group, listTableIter->second );
+}
+
+
 /************************************************************************
 *    DESC:  Build all the scripts added to the module
 ************************************************************************/
@@ -212,6 +355,9 @@ void CScriptMgr::buildScript( asIScriptModule * pScriptModule, const std::string
 ************************************************************************/
 asIScriptContext * CScriptMgr::getContext()
 {
+    // Parallel updates take turns with the pool
+    auto lock = CScriptParallel::Instance().serialize();
+
     // Set the active contex counter
     CStatCounter::Instance().setActiveContexCounter( ++m_activeContextCounter );
 
@@ -235,6 +381,16 @@ asIScriptContext * CScriptMgr::getContext()
 ************************************************************************/
 void CScriptMgr::recycleContext( asIScriptContext * pContext )
 {
+    // Parallel updates recycle at the sync point so the scheduler isn't changed while being read
+    if( CScriptParallel::isParallel() )
+    {
+        CScriptParallel::Instance().defer( [this, pContext]() { recycleContext( pContext ); } );
+        return;
+    }
+
+    // Drop any wait and wake up the scripts waiting for this one to finish
+    CScriptScheduler::Instance().release( pContext );
+
     if( m_pContextPoolVec.size() < (float)m_activeContextCounter * m_maxPoolPercentage )
         m_pContextPoolVec.push_back( pContext );
     else
@@ -345,12 +501,28 @@ void CScriptMgr::freeGroup( const std::string & group )
                 % group % __FUNCTION__ % __LINE__ ));
 
     // Discard the module and free its memory.
+    m_pParallelModuleSet.erase( scpEngine->GetModule( group.c_str(), asGM_ONLY_IF_EXISTS ) );
     scpEngine->DiscardModule( group.c_str() );
 
     // Erase the group from the map
     auto mapMapIter = m_scriptFunctMapMap.find( group );
     if( mapMapIter != m_scriptFunctMapMap.end() )
             m_scriptFunctMapMap.erase( mapMapIter );
+
+    // Function handles need to look up their function again
+    ++m_groupGeneration;
+
+    // Anything from the group still alive after a full garbage collection was leaked
+    auto markIter = m_memoryMarkMap.find( group );
+    if( markIter != m_memoryMarkMap.end() )
+    {
+        scpEngine->GarbageCollect( asGC_FULL_CYCLE );
+
+        NScriptMemoryPool::ReportLeaks( markIter->second, group );
+        NGenFunc::PostDebugMsg( NScriptMemoryPool::FormatStats() );
+
+        m_memoryMarkMap.erase( markIter );
+    }
 }
 
 
@@ -360,82 +532,197 @@ void CScriptMgr::freeGroup( const std::string & group )
 void CScriptMgr::prepare(
     const std::string & group,
     const std::string & funcName,
-    const std::vector<CScriptParam> & paramVec )
+    const CScriptArgs & args )
 {
-    prepare( group, funcName, m_pActiveContextVec, paramVec );
+    prepare( group, funcName, m_pActiveContextVec, args );
 }
 
 void CScriptMgr::prepare(
     const std::string & group,
     const std::string & funcName,
     std::vector<asIScriptContext *> & pContextVec,
-    const std::vector<CScriptParam> & paramVec )
+    const CScriptArgs & args )
 {
     // Get a context from the script manager pool
     pContextVec.push_back( getContext() );
 
-    prepare( group, funcName, pContextVec.back(), paramVec );
+    prepare( getPtrToFunc(group, funcName), pContextVec.back(), args );
 }
 
 void CScriptMgr::prepare(
     const std::string & group,
     const std::string & funcName,
     asIScriptContext * pContext,
-    const std::vector<CScriptParam> & paramVec )
+    const CScriptArgs & args )
 {
-    // Get the function pointer
-    asIScriptFunction * pScriptFunc = getPtrToFunc(group, funcName);
+    prepare( getPtrToFunc(group, funcName), pContext, args );
+}
+
 
+/************************************************************************
+*    DESC:  Prepare the script function of the handle to run
+*           NOTE: No look up or allocation unless the script groups changed
+************************************************************************/
+void CScriptMgr::prepare(
+    const CScriptFuncHandle & funcHandle,
+    const CScriptArgs & args )
+{
+    prepare( funcHandle, m_pActiveContextVec, args );
+}
+
+void CScriptMgr::prepare(
+    const CScriptFuncHandle & funcHandle,
+    std::vector<asIScriptContext *> & pContextVec,
+    const CScriptArgs & args )
+{
+    // Parallel updates share the function cached in the handle
+    auto lock = CScriptParallel::Instance().serialize();
+
+    // Get the function before the context in case it throws
+    asIScriptFunction * pScriptFunc = funcHandle.get();
+
+    // Get a context from the script manager pool
+    pContextVec.push_back( getContext() );
+
+    prepare( pScriptFunc, pContextVec.back(), args );
+}
+
+void CScriptMgr::prepare(
+    asIScriptFunction * pScriptFunc,
+    asIScriptContext * pContext,
+    const CScriptArgs & args )
+{
     // Prepare the function to run
     if( pContext->Prepare(pScriptFunc) < 0 )
     {
         throw NExcept::CCriticalException("Error Preparing Script!",
             boost::str( boost::format("There was an error preparing the script (%s).\n\n%s\nLine: %s")
-                % funcName % __FUNCTION__ % __LINE__ ));
+                % pScriptFunc->GetName() % __FUNCTION__ % __LINE__ ));
     }
 
     // Pass the parameters to the script function
-    for( size_t i = 0; i < paramVec.size(); ++i )
+    for( size_t i = 0; i < args.size(); ++i )
     {
         int returnVal(0);
 
-        if( paramVec[i].getType() == CScriptParam::EPT_BOOL )
+        if( args[i].getType() == CScriptParam::EPT_BOOL )
         {
-            returnVal = pContext->SetArgByte(i, paramVec[i].get<bool>());
+            returnVal = pContext->SetArgByte(i, args[i].get<bool>());
         }
-        else if( paramVec[i].getType() == CScriptParam::EPT_INT )
+        else if( args[i].getType() == CScriptParam::EPT_INT )
         {
-            returnVal = pContext->SetArgDWord(i, paramVec[i].get<int>());
+            returnVal = pContext->SetArgDWord(i, args[i].get<int>());
         }
-        else if( paramVec[i].getType() == CScriptParam::EPT_UINT )
+        else if( args[i].getType() == CScriptParam::EPT_UINT )
         {
-            returnVal = pContext->SetArgDWord(i, paramVec[i].get<uint>());
+            returnVal = pContext->SetArgDWord(i, args[i].get<uint>());
         }
-        else if( paramVec[i].getType() == CScriptParam::EPT_FLOAT )
+        else if( args[i].getType() == CScriptParam::EPT_FLOAT )
         {
-            returnVal = pContext->SetArgFloat(i, paramVec[i].get<float>());
+            returnVal = pContext->SetArgFloat(i, args[i].get<float>());
         }
-        else if( paramVec[i].getType() == CScriptParam::EPT_REG_OBJ )
+        else if( args[i].getType() == CScriptParam::EPT_REG_OBJ )
         {
-            returnVal = pContext->SetArgObject(i, paramVec[i].get<void *>());
+            returnVal = pContext->SetArgObject(i, args[i].get<void *>());
         }
 
         if( returnVal < 0 )
         {
             throw NExcept::CCriticalException("Error Setting Script Param!",
                 boost::str( boost::format("There was an error setting the script parameter (%s).\n\n%s\nLine: %s")
-                    % funcName % __FUNCTION__ % __LINE__ ));
+                    % pScriptFunc->GetName() % __FUNCTION__ % __LINE__ ));
         }
     }
 }
 
 
+/************************************************************************
+*    DESC:  Run the garbage collector within the budget or do a full cycle
+*           NOTE: Full cycles are for state changes and load screens
+************************************************************************/
+void CScriptMgr::collectGarbage( const bool fullCycle )
+{
+    const double budget = CSettings::Instance().getScriptGCBudget();
+
+    // The script engine is collecting the garbage
+    if( !fullCycle && (budget <= 0.0) )
+        return;
+
+    asUINT startDestroyed(0);
+    scpEngine->GetGCStatistics( nullptr, &startDestroyed );
+
+    if( fullCycle )
+    {
+        scpEngine->GarbageCollect( asGC_FULL_CYCLE );
+    }
+    else
+    {
+        // Step through the cycle until it's done or the budget is used up. The budget is in microseconds
+        const double startTime = CHighResTimer::Instance().getTime();
+
+        while( (scpEngine->GarbageCollect( asGC_ONE_STEP ) == 1) &&
+               ((CHighResTimer::Instance().getTime() - startTime) * 1000.0 < budget) )
+        { }
+    }
+
+    asUINT currentSize(0), totalDestroyed(0);
+    scpEngine->GetGCStatistics( &currentSize, &totalDestroyed );
+
+    CStatCounter::Instance().setScriptGCCounters( currentSize, totalDestroyed - startDestroyed );
+}
+
+
+/************************************************************************
+*    DESC:  Start sampling the executing scripts
+************************************************************************/
+void CScriptMgr::startProfiler( const uint32_t intervalMicroSec, const uint32_t topCount )
+{
+    CScriptProfiler::Instance().clear();
+    CScriptProfiler::Instance().start( intervalMicroSec, topCount );
+}
+
+
+/************************************************************************
+*    DESC:  Stop sampling and save the folded stacks if a file is given
+************************************************************************/
+void CScriptMgr::stopProfiler( const std::string & foldedFilePath )
+{
+    CScriptProfiler::Instance().stop();
+
+    if( !foldedFilePath.empty() )
+        CScriptProfiler::Instance().saveFoldedStacks( foldedFilePath );
+}
+
+
+/************************************************************************
+*    DESC:  Get the generation of the script groups
+*           Changes when a group is loaded or freed
+************************************************************************/
+uint32_t CScriptMgr::getGroupGeneration() const
+{
+    return m_groupGeneration;
+}
+
+
 /************************************************************************
 *    DESC:  Prepare the spawn script function to run
+*           Returns the spawn id to wait on or zero if nothing was spawned
 ************************************************************************/
-void CScriptMgr::prepareSpawn( const std::string & funcName, const std::string & group )
+uint32_t CScriptMgr::prepareSpawn( const std::string & funcName, const std::string & group )
 {
     auto pContex = asGetActiveContext();
+
+    // Parallel updates spawn at the sync point so there's no id to wait on
+    if( CScriptParallel::isParallel() )
+    {
+        std::string grp = group;
+        if( grp.empty() && pContex )
+            grp = pContex->GetFunction()->GetModuleName();
+
+        CScriptParallel::Instance().defer( [this, funcName, grp]() { prepareSpawn( funcName, grp ); } );
+        return 0;
+    }
+
     if( pContex || !group.empty() )
     {
         // Get the module name
@@ -445,7 +732,11 @@ void CScriptMgr::prepareSpawn( const std::string & funcName, const std::string &
 
         // Prepare the script function to run
         prepare( grp, funcName, m_pActiveContextVec );
+
+        return CScriptScheduler::Instance().addSpawn( m_pActiveContextVec.back() );
     }
+
+    return 0;
 }
 
 
@@ -528,14 +819,30 @@ bool CScriptMgr::update()
     if( !m_errorMsg.empty() )
         throw NExcept::CCriticalException( m_errorTitle, m_errorMsg );
     
+    // Wake up the scripts whose wait is over
+    CScriptScheduler::Instance().update();
+
+    // Post the top script functions
+    if( CScriptProfiler::Instance().isActive() )
+        CScriptProfiler::Instance().update();
+
     if( !m_pActiveContextVec.empty() )
-        update( m_pActiveContextVec );
+    {
+        const double timeBudget = CSettings::Instance().getScriptTimeBudget();
+
+        if( timeBudget > 0.0 )
+            updateWithBudget( m_pActiveContextVec, timeBudget );
+        else
+            update( m_pActiveContextVec );
+    }
     
     return !m_pActiveContextVec.empty();
 }
 
 void CScriptMgr::update( std::vector<asIScriptContext *> & pContextVec, const bool forcedUpdate )
 {
+    CScriptScheduler & rScheduler = CScriptScheduler::Instance();
+
     // This is to allow for "forced Updates" when a new script has been added.
     // A new script is always the last one in the vector
     size_t i = 0;
@@ -546,22 +853,88 @@ void CScriptMgr::update( std::vector<asIScriptContext *> & pContextVec, const bo
     // while the for loop is executing as spawn contexts are added.
     // DO NOT change to a C++11 ranged for loop. It won't work.
     for( ; i < pContextVec.size(); ++i )
-        executeScript( pContextVec[i] );
+    {
+        // Contexts waiting on time, frames, events or spawns are not resumed
+        if( !rScheduler.isWaiting( pContextVec[i] ) )
+            executeScript( pContextVec[i] );
+    }
+
+    recycleFinished( pContextVec );
+}
+
+
+/************************************************************************
+*    DESC:  Update the active scripts within the time budget
+*           Once over budget, the spawned scripts left are put off until
+*           the next update which starts with them. The scripts not
+*           spawned by other scripts always run
+************************************************************************/
+void CScriptMgr::updateWithBudget( std::vector<asIScriptContext *> & pContextVec, const double timeBudget )
+{
+    CScriptScheduler & rScheduler = CScriptScheduler::Instance();
+    const double startTime = CHighResTimer::Instance().getTime();
+    asIScriptContext * pResumeContext = nullptr;
+    bool overBudget = false;
 
-    auto iter = pContextVec.begin();
-    while( iter != pContextVec.end() )
+    auto resume = [&]( asIScriptContext * pContext )
     {
-        // Return the context to the pool if it has not been suspended
-        if( (*iter)->GetState() != asEXECUTION_SUSPENDED )
+        if( rScheduler.isWaiting( pContext ) )
+            return;
+
+        if( overBudget && rScheduler.isSpawn( pContext ) )
         {
-            recycleContext( (*iter) );
-            iter = pContextVec.erase( iter );
+            if( pResumeContext == nullptr )
+                pResumeContext = pContext;
+
+            return;
         }
+
+        executeScript( pContext );
+
+        overBudget = ((CHighResTimer::Instance().getTime() - startTime) > timeBudget);
+    };
+
+    // Go around starting where the last update left off
+    const size_t count = pContextVec.size();
+    const size_t start = (m_roundRobinIndex < count) ? m_roundRobinIndex : 0;
+
+    for( size_t i = 0; i < count; ++i )
+        resume( pContextVec[(start + i) % count] );
+
+    // Contexts spawned during this update. The vector can grow so index it
+    for( size_t i = count; i < pContextVec.size(); ++i )
+        resume( pContextVec[i] );
+
+    recycleFinished( pContextVec );
+
+    m_roundRobinIndex = 0;
+    if( pResumeContext != nullptr )
+        m_roundRobinIndex = std::find( pContextVec.begin(), pContextVec.end(), pResumeContext ) - pContextVec.begin();
+}
+
+
+/************************************************************************
+*    DESC:  Recycle the contexts that are done executing
+*           Compacts in one pass keeping the order because
+*           a new script is expected to be the last one
+************************************************************************/
+void CScriptMgr::recycleFinished( std::vector<asIScriptContext *> & pContextVec )
+{
+    size_t count = 0;
+
+    for( size_t i = 0; i < pContextVec.size(); ++i )
+    {
+        asIScriptContext * pContext = pContextVec[i];
+        const asEContextState state = pContext->GetState();
+
+        // Return the context to the pool if it's not suspended or waiting to run
+        if( (state == asEXECUTION_SUSPENDED) || (state == asEXECUTION_PREPARED) )
+            pContextVec[count++] = pContext;
         else
-        {
-            ++iter;
-        }
+            recycleContext( pContext );
     }
+
+    pContextVec.resize( count );
 }
 
 
@@ -574,6 +947,10 @@ void CScriptMgr::executeScript( asIScriptContext * pContext )
     if( (pContext->GetState() == asEXECUTION_SUSPENDED) ||
         (pContext->GetState() == asEXECUTION_PREPARED) )
     {
+        // Sample the script while it executes
+        if( CScriptProfiler::Instance().isActive() )
+            CScriptProfiler::Instance().attach( pContext );
+
         // Execute the script and check for errors
         // Since the script can be suspended, this also is used to continue execution
         const int execReturnCode = pContext->Execute();
@@ -610,3 +987,27 @@ void CScriptMgr::setMaxPoolPercentage( float poolPercentage )
 {
     m_maxPoolPercentage = poolPercentage;
 }
+
+
+/************************************************************************
+*    DESC:  Are any script groups flagged as parallel safe
+************************************************************************/
+bool CScriptMgr::hasParallelGroups() const
+{
+    return !m_pParallelModuleSet.empty();
+}
+
+
+/************************************************************************
+*    DESC:  Was the context started with a function from a parallel safe group
+************************************************************************/
+bool CScriptMgr::isParallel( asIScriptContext * pContext ) const
+{
+    const asUINT callstackSize = pContext->GetCallstackSize();
+    if( callstackSize == 0 )
+        return false;
+
+    asIScriptFunction * pFunc = pContext->GetFunction( callstackSize - 1 );
+
+    return (pFunc != nullptr) && (m_pParallelModuleSet.find( pFunc->GetModule() ) != m_pParallelModuleSet.end());
+}
@@ -12,12 +12,16 @@
 
 // Game lib dependencies
 #include <utilities/smartpointers.h>
-#include <script/scriptparam.h>
+#include <script/scriptargs.h>
 
 // Standard lib dependencies
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
+#include <unordered_set>
+#include <memory>
+#include <cstdint>
 
 // Forward declaration(s)
 class asIScriptEngine;
@@ -26,6 +30,9 @@ class asIScriptModule;
 class asIScriptFunction;
 class asITypeInfo;
 struct asSMessageInfo;
+class CScriptAotCompiler;
+class CScriptByteCodeCache;
+class CScriptFuncHandle;
 
 class CScriptMgr : public CManagerBase
 {
@@ -47,6 +54,10 @@ public:
     // Load all of the scripts of a specific group
     void loadGroup( const std::string & group, const bool forceLoadFromScript = false );
 
+    // Read the scripts of a group on a background thread ahead of loading it
+    // NOTE: Only used with the byte code cache
+    void preloadGroup( const std::string & group );
+
     // Free all of the scripts of a specific data group
     void freeGroup( const std::string & group );
     
@@ -71,26 +82,45 @@ public:
     // Get pointer to type declaration
     asITypeInfo * getPtrToTypeInfo( const std::string & typeDecl );
     
+    // Get the generation of the script groups. Changes when a group is loaded or freed
+    uint32_t getGroupGeneration() const;
+    
     // Prepare the script function to run
     void prepare(
         const std::string & group,
         const std::string & funcName,
-        const std::vector<CScriptParam> & paramVec = std::vector<CScriptParam>() );
+        const CScriptArgs & args = CScriptArgs() );
     
     void prepare(
         const std::string & group,
         const std::string & funcName,
         std::vector<asIScriptContext *> & pContextVec,
-        const std::vector<CScriptParam> & paramVec = std::vector<CScriptParam>() );
+        const CScriptArgs & args = CScriptArgs() );
     
     void prepare(
         const std::string & group,
         const std::string & funcName,
         asIScriptContext * pContext,
-        const std::vector<CScriptParam> & paramVec = std::vector<CScriptParam>() );
+        const CScriptArgs & args = CScriptArgs() );
+
+    // Prepare the script function of the handle to run
+    // NOTE: No look up or allocation unless the script groups changed
+    void prepare(
+        const CScriptFuncHandle & funcHandle,
+        const CScriptArgs & args = CScriptArgs() );
+
+    void prepare(
+        const CScriptFuncHandle & funcHandle,
+        std::vector<asIScriptContext *> & pContextVec,
+        const CScriptArgs & args = CScriptArgs() );
+
+    void prepare(
+        asIScriptFunction * pScriptFunc,
+        asIScriptContext * pContext,
+        const CScriptArgs & args = CScriptArgs() );
     
-    // Prepare the spawn script function to run
-    void prepareSpawn( const std::string & funcName, const std::string & group = "" );
+    // Prepare the spawn script function to run. Returns the spawn id to wait on
+    uint32_t prepareSpawn( const std::string & funcName, const std::string & group = "" );
 
     // Spawn by thread
     void spawnByThread( const std::string & funcName, const std::string & group = "" );
@@ -98,6 +128,22 @@ public:
     // Set the max pool percentage
     void setMaxPoolPercentage( float poolPercentage );
 
+    // Are any script groups flagged as parallel safe
+    bool hasParallelGroups() const;
+
+    // Was the context started with a function from a parallel safe group
+    bool isParallel( asIScriptContext * pContext ) const;
+
+    // Run the garbage collector within the budget or do a full cycle
+    // NOTE: Full cycles are for state changes and load screens
+    void collectGarbage( const bool fullCycle = false );
+
+    // Start sampling the executing scripts
+    void startProfiler( const uint32_t intervalMicroSec = 1000, const uint32_t topCount = 3 );
+
+    // Stop sampling and save the folded stacks if a file is given
+    void stopProfiler( const std::string & foldedFilePath = "" );
+
 private:
 
     // Constructor
@@ -108,6 +154,10 @@ private:
 
     // Add the script to the module
     void addScript( asIScriptModule * pScriptModule, const std::string & filePath );
+    void addScript( asIScriptModule * pScriptModule, const std::string & filePath, const std::vector<char> & bufVec );
+
+    // Load the group from the byte code cache. Builds and caches it if stale
+    void loadFromCache( asIScriptModule * pScriptModule, const std::string & group, const std::vector<std::string> & fileVec );
 
     // Build all the scripts added to the module
     void buildScript( asIScriptModule * pScriptModule, const std::string & group );
@@ -117,6 +167,12 @@ private:
     
     // Execute the script
     void executeScript( asIScriptContext * pContext );
+
+    // Update the active scripts within the time budget
+    void updateWithBudget( std::vector<asIScriptContext *> & pContextVec, const double timeBudget );
+
+    // Recycle the contexts that are done executing
+    void recycleFinished( std::vector<asIScriptContext *> & pContextVec );
     
     // Execute the script from thread
     void executeFromThread( asIScriptContext * pContext );
@@ -125,6 +181,13 @@ private:
 
     const bool FORCE_LOAD_FROM_SCRIPT = true;
 
+    // Hooks up the scripts compiled ahead of time to C++
+    // NOTE: Declared before the engine so it's destroyed after
+    std::unique_ptr<CScriptAotCompiler> m_upAotCompiler;
+
+    // Byte code cached by the hash of the sources and the engine
+    std::unique_ptr<CScriptByteCodeCache> m_upByteCodeCache;
+
     // Smart com pointer to AngelScript script engine
     NSmart::scoped_com_ptr<asIScriptEngine> scpEngine;
 
@@ -150,6 +213,19 @@ private:
     // Maximum pool percentage
     float m_maxPoolPercentage = 0.25f;
 
+    // Where to start the next update that has a time budget
+    size_t m_roundRobinIndex = 0;
+
+    // Generation of the script groups for the function handles
+    uint32_t m_groupGeneration = 1;
+
     // Holds the list table map
     std::map<const std::string, std::string> m_byteCodeFileMap;
+
+    // Memory pool marks of the loaded groups to check for leaks when freed
+    std::map<const std::string, uint64_t> m_memoryMarkMap;
+
+    // Groups flagged as parallel safe and their modules
+    std::set<std::string> m_parallelGroupSet;
+    std::unordered_set<asIScriptModule *> m_pParallelModuleSet;
 };
@@ -0,0 +1,481 @@
+
+/************************************************************************
+*    FILE NAME:       scriptmemorypool.cpp
+*
+*    DESCRIPTION:     Size class pool allocator for the script engine.
+*                     Each thread keeps a cache of free blocks so the
+*                     thread pool doesn't fight over a lock
+************************************************************************/
+
+// Physical component dependency
+#include <script/scriptmemorypool.h>
+
+// Game lib dependencies
+#include <utilities/genfunc.h>
+
+// AngelScript lib dependencies
+#include <angelscript.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdlib>
+
+namespace NScriptMemoryPool
+{
+    namespace
+    {
+        // Header in front of every block. Keeps the memory 16 byte aligned
+        struct SHeader
+        {
+            uint32_t classIndex;
+            uint32_t pad;
+            uint64_t serial;
+        };
+
+        // Free blocks are linked through their memory
+        struct SBlock
+        {
+            SBlock * pNext;
+        };
+
+        const size_t HEADER_SIZE = sizeof(SHeader);
+        const size_t CLASS_SIZE[] = {16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048};
+        const size_t CLASS_COUNT = sizeof(CLASS_SIZE) / sizeof(CLASS_SIZE[0]);
+        const size_t MAX_CLASS_SIZE = CLASS_SIZE[CLASS_COUNT-1];
+        const uint32_t LARGE_CLASS = CLASS_COUNT;
+
+        // Blocks are carved out of chunks
+        const size_t CHUNK_SIZE = 64 * 1024;
+
+        // Blocks kept by each thread and moved to and from the shared pool at a time
+        const size_t CACHE_MAX = 64;
+        const size_t BATCH_SIZE = 32;
+
+        // Size class of each 16 byte step
+        uint8_t classLookupAry[(MAX_CLASS_SIZE / 16) + 1];
+
+        class CThreadCache;
+
+        // Free blocks of a size class shared by all the threads
+        class CSharedClass
+        {
+        public:
+            std::mutex mutex;
+            SBlock * pFree = nullptr;
+            size_t reservedBytes = 0;
+        };
+
+        // The shared state of the pool
+        class CPool
+        {
+        public:
+            CSharedClass classAry[CLASS_COUNT];
+
+            // Thread caches for the statistics
+            std::mutex cacheMutex;
+            std::vector<CThreadCache *> pCacheVec;
+
+            // Counters of the threads that exited. The last one is for large allocations
+            uint64_t exitedAllocAry[CLASS_COUNT+1] = {};
+            uint64_t exitedFreeAry[CLASS_COUNT+1] = {};
+
+            // Allocations alive in debug mode
+            bool debugMode = false;
+            std::mutex debugMutex;
+            std::unordered_map<void *, size_t> liveMap;
+            std::atomic<uint64_t> serial{0};
+        };
+
+        // Never deleted because the script engine is freed after everything else at exit
+        CPool * pPool = nullptr;
+
+        /************************************************************************
+        *    DESC:  Get a batch of free blocks from the shared size class
+        ************************************************************************/
+        SBlock * TakeBatch( const uint32_t classIndex, size_t & count, const size_t maxCount = BATCH_SIZE )
+        {
+            CSharedClass & rClass = pPool->classAry[classIndex];
+            std::lock_guard<std::mutex> lock( rClass.mutex );
+
+            // Carve a new chunk if there's nothing free
+            if( rClass.pFree == nullptr )
+            {
+                const size_t blockSize = HEADER_SIZE + CLASS_SIZE[classIndex];
+                const size_t blockCount = CHUNK_SIZE / blockSize;
+                char * pChunk = static_cast<char *>( std::malloc( blockSize * blockCount ) );
+                if( pChunk == nullptr )
+                    return nullptr;
+
+                for( size_t i = 0; i < blockCount; ++i )
+                {
+                    SBlock * pBlock = reinterpret_cast<SBlock *>( pChunk + (i * blockSize) );
+                    pBlock->pNext = rClass.pFree;
+                    rClass.pFree = pBlock;
+                }
+
+                rClass.reservedBytes += blockSize * blockCount;
+            }
+
+            SBlock * pBatch = rClass.pFree;
+            SBlock * pLast = pBatch;
+            count = 1;
+
+            while( (count < maxCount) && (pLast->pNext != nullptr) )
+            {
+                pLast = pLast->pNext;
+                ++count;
+            }
+
+            rClass.pFree = pLast->pNext;
+            pLast->pNext = nullptr;
+
+            return pBatch;
+        }
+
+        /************************************************************************
+        *    DESC:  Give a list of free blocks back to the shared size class
+        ************************************************************************/
+        void GiveBatch( const uint32_t classIndex, SBlock * pFirst, SBlock * pLast )
+        {
+            CSharedClass & rClass = pPool->classAry[classIndex];
+            std::lock_guard<std::mutex> lock( rClass.mutex );
+
+            pLast->pNext = rClass.pFree;
+            rClass.pFree = pFirst;
+        }
+
+        /************************************************************************
+        *    DESC:  Free blocks cached by a thread
+        ************************************************************************/
+        class CThreadCache
+        {
+        public:
+
+            CThreadCache()
+            {
+                std::lock_guard<std::mutex> lock( pPool->cacheMutex );
+                pPool->pCacheVec.push_back( this );
+            }
+
+            ~CThreadCache();
+
+            // Get a block of the size class
+            SBlock * pop( const uint32_t classIndex )
+            {
+                if( pFreeAry[classIndex] == nullptr )
+                    pFreeAry[classIndex] = TakeBatch( classIndex, countAry[classIndex] );
+
+                SBlock * pBlock = pFreeAry[classIndex];
+                if( pBlock != nullptr )
+                {
+                    pFreeAry[classIndex] = pBlock->pNext;
+                    --countAry[classIndex];
+                }
+
+                return pBlock;
+            }
+
+            // Keep the block. Half the cache goes back to the shared pool when it's full
+            void push( const uint32_t classIndex, SBlock * pBlock )
+            {
+                pBlock->pNext = pFreeAry[classIndex];
+                pFreeAry[classIndex] = pBlock;
+
+                if( ++countAry[classIndex] > CACHE_MAX )
+                {
+                    SBlock * pLast = pBlock;
+                    for( size_t i = 1; i < BATCH_SIZE; ++i )
+                        pLast = pLast->pNext;
+
+                    pFreeAry[classIndex] = pLast->pNext;
+                    countAry[classIndex] -= BATCH_SIZE;
+
+                    GiveBatch( classIndex, pBlock, pLast );
+                }
+            }
+
+            // Only written by the owning thread. Atomic so the statistics can read them
+            void count( std::atomic<uint64_t> & rCounter )
+            {
+                rCounter.store( rCounter.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+            }
+
+            SBlock * pFreeAry[CLASS_COUNT] = {};
+            size_t countAry[CLASS_COUNT] = {};
+            std::atomic<uint64_t> allocAry[CLASS_COUNT+1] = {};
+            std::atomic<uint64_t> freeAry[CLASS_COUNT+1] = {};
+        };
+
+        // Set when the thread's cache is destroyed so blocks freed
+        // after that go straight to the shared pool
+        thread_local bool t_cacheDestroyed = false;
+        thread_local CThreadCache t_cache;
+
+        /************************************************************************
+        *    DESC:  Give the cached blocks back when the thread exits
+        ************************************************************************/
+        CThreadCache::~CThreadCache()
+        {
+            t_cacheDestroyed = true;
+
+            for( uint32_t i = 0; i < CLASS_COUNT; ++i )
+            {
+                if( pFreeAry[i] != nullptr )
+                {
+                    SBlock * pLast = pFreeAry[i];
+                    while( pLast->pNext != nullptr )
+                        pLast = pLast->pNext;
+
+                    GiveBatch( i, pFreeAry[i], pLast );
+                }
+            }
+
+            std::lock_guard<std::mutex> lock( pPool->cacheMutex );
+
+            for( uint32_t i = 0; i <= CLASS_COUNT; ++i )
+            {
+                pPool->exitedAllocAry[i] += allocAry[i].load( std::memory_order_relaxed );
+                pPool->exitedFreeAry[i] += freeAry[i].load( std::memory_order_relaxed );
+            }
+
+            pPool->pCacheVec.erase( std::remove( pPool->pCacheVec.begin(), pPool->pCacheVec.end(), this ), pPool->pCacheVec.end() );
+        }
+
+        /************************************************************************
+        *    DESC:  Keep track of the allocations alive in debug mode
+        ************************************************************************/
+        void TrackAlloc( SHeader * pHeader, const size_t size )
+        {
+            pHeader->serial = ++pPool->serial;
+
+            std::lock_guard<std::mutex> lock( pPool->debugMutex );
+            pPool->liveMap.emplace( pHeader, size );
+        }
+
+        void TrackFree( SHeader * pHeader )
+        {
+            std::lock_guard<std::mutex> lock( pPool->debugMutex );
+            pPool->liveMap.erase( pHeader );
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  Install the pool as the script engine's memory functions
+    *           NOTE: Needs to be called before the engine allocates anything
+    ************************************************************************/
+    void Install( const bool debugMode )
+    {
+        if( pPool != nullptr )
+            return;
+
+        pPool = new CPool;
+        pPool->debugMode = debugMode;
+
+        uint32_t classIndex = 0;
+        for( size_t i = 0; i < sizeof(classLookupAry); ++i )
+        {
+            while( CLASS_SIZE[classIndex] < (i * 16) )
+                ++classIndex;
+
+            classLookupAry[i] = classIndex;
+        }
+
+        asSetGlobalMemoryFunctions( Alloc, Free );
+    }
+
+    /************************************************************************
+    *    DESC:  Is the pool installed
+    ************************************************************************/
+    bool IsInstalled()
+    {
+        return (pPool != nullptr);
+    }
+
+    /************************************************************************
+    *    DESC:  Allocate memory for the script engine
+    ************************************************************************/
+    void * Alloc( size_t size )
+    {
+        SHeader * pHeader(nullptr);
+        uint32_t classIndex = LARGE_CLASS;
+
+        if( size <= MAX_CLASS_SIZE )
+        {
+            classIndex = classLookupAry[(size + 15) / 16];
+
+            if( !t_cacheDestroyed )
+            {
+                pHeader = reinterpret_cast<SHeader *>( t_cache.pop( classIndex ) );
+                t_cache.count( t_cache.allocAry[classIndex] );
+            }
+            else
+            {
+                size_t count(0);
+                pHeader = reinterpret_cast<SHeader *>( TakeBatch( classIndex, count, 1 ) );
+            }
+        }
+        else
+        {
+            pHeader = static_cast<SHeader *>( std::malloc( HEADER_SIZE + size ) );
+
+            if( !t_cacheDestroyed )
+                t_cache.count( t_cache.allocAry[classIndex] );
+        }
+
+        if( pHeader == nullptr )
+            return nullptr;
+
+        pHeader->classIndex = classIndex;
+
+        if( pPool->debugMode )
+            TrackAlloc( pHeader, size );
+
+        return reinterpret_cast<char *>(pHeader) + HEADER_SIZE;
+    }
+
+    /************************************************************************
+    *    DESC:  Free memory for the script engine
+    ************************************************************************/
+    void Free( void * pMem )
+    {
+        if( pMem == nullptr )
+            return;
+
+        SHeader * pHeader = reinterpret_cast<SHeader *>( static_cast<char *>(pMem) - HEADER_SIZE );
+        const uint32_t classIndex = pHeader->classIndex;
+
+        if( pPool->debugMode )
+            TrackFree( pHeader );
+
+        if( !t_cacheDestroyed )
+            t_cache.count( t_cache.freeAry[classIndex] );
+
+        if( classIndex == LARGE_CLASS )
+        {
+            std::free( pHeader );
+        }
+        else
+        {
+            SBlock * pBlock = reinterpret_cast<SBlock *>( pHeader );
+
+            if( !t_cacheDestroyed )
+            {
+                t_cache.push( classIndex, pBlock );
+            }
+            else
+            {
+                pBlock->pNext = nullptr;
+                GiveBatch( classIndex, pBlock, pBlock );
+            }
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  Get the statistics of each size class
+    ************************************************************************/
+    std::vector<CSizeClassStats> GetStats()
+    {
+        std::vector<CSizeClassStats> statsVec( CLASS_COUNT + 1 );
+
+        if( pPool == nullptr )
+            return statsVec;
+
+        std::lock_guard<std::mutex> lock( pPool->cacheMutex );
+
+        for( uint32_t i = 0; i <= CLASS_COUNT; ++i )
+        {
+            CSizeClassStats & rStats = statsVec[i];
+
+            rStats.allocCount = pPool->exitedAllocAry[i];
+            rStats.freeCount = pPool->exitedFreeAry[i];
+
+            for( auto pCache : pPool->pCacheVec )
+            {
+                rStats.allocCount += pCache->allocAry[i].load( std::memory_order_relaxed );
+                rStats.freeCount += pCache->freeAry[i].load( std::memory_order_relaxed );
+            }
+
+            if( i < CLASS_COUNT )
+            {
+                rStats.size = CLASS_SIZE[i];
+
+                std::lock_guard<std::mutex> classLock( pPool->classAry[i].mutex );
+                rStats.reservedBytes = pPool->classAry[i].reservedBytes;
+            }
+        }
+
+        return statsVec;
+    }
+
+    /************************************************************************
+    *    DESC:  Format the statistics of the size classes in use
+    ************************************************************************/
+    std::string FormatStats()
+    {
+        std::string statsStr = "Script memory pool (size: alive/allocs, reserved KB):";
+
+        for( auto & iter : GetStats() )
+        {
+            if( iter.allocCount > 0 )
+            {
+                statsStr += boost::str( boost::format("\n  %s: %d/%d, %d")
+                    % (iter.size > 0 ? std::to_string(iter.size) : std::string("large"))
+                    % (iter.allocCount - iter.freeCount)
+                    % iter.allocCount
+                    % (iter.reservedBytes / 1024) );
+            }
+        }
+
+        return statsStr;
+    }
+
+    /************************************************************************
+    *    DESC:  Get a mark of the allocations made so far
+    *           NOTE: Debug mode only. Zero if not in debug mode
+    ************************************************************************/
+    uint64_t GetMark()
+    {
+        if( (pPool == nullptr) || !pPool->debugMode )
+            return 0;
+
+        return pPool->serial.load();
+    }
+
+    /************************************************************************
+    *    DESC:  Report the allocations made since the mark that are still alive
+    *           NOTE: Debug mode only
+    ************************************************************************/
+    size_t ReportLeaks( const uint64_t mark, const std::string & name )
+    {
+        if( (pPool == nullptr) || !pPool->debugMode )
+            return 0;
+
+        size_t leakCount(0);
+        size_t leakBytes(0);
+
+        {
+            std::lock_guard<std::mutex> lock( pPool->debugMutex );
+
+            for( auto & iter : pPool->liveMap )
+            {
+                if( static_cast<SHeader *>(iter.first)->serial > mark )
+                {
+                    ++leakCount;
+                    leakBytes += iter.second;
+                }
+            }
+        }
+
+        if( leakCount > 0 )
+            NGenFunc::PostDebugMsg( boost::str( boost::format("Script memory possibly leaked by (%s): %d allocations, %d bytes")
+                % name % leakCount % leakBytes ) );
+
+        return leakCount;
+    }
+}
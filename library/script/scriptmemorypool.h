@@ -0,0 +1,54 @@
+
+/************************************************************************
+*    FILE NAME:       scriptmemorypool.h
+*
+*    DESCRIPTION:     Size class pool allocator for the script engine.
+*                     Each thread keeps a cache of free blocks so the
+*                     thread pool doesn't fight over a lock
+************************************************************************/
+
+#pragma once
+
+// Standard lib dependencies
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace NScriptMemoryPool
+{
+    // Statistics of a size class. A size of zero is the allocations too big for a class
+    class CSizeClassStats
+    {
+    public:
+        size_t size = 0;
+        uint64_t allocCount = 0;
+        uint64_t freeCount = 0;
+        size_t reservedBytes = 0;
+    };
+
+    // Install the pool as the script engine's memory functions
+    // NOTE: Needs to be called before the engine allocates anything
+    void Install( const bool debugMode );
+
+    // Is the pool installed
+    bool IsInstalled();
+
+    // Allocate and free memory for the script engine
+    void * Alloc( size_t size );
+    void Free( void * pMem );
+
+    // Get the statistics of each size class
+    std::vector<CSizeClassStats> GetStats();
+
+    // Format the statistics of the size classes in use
+    std::string FormatStats();
+
+    // Get a mark of the allocations made so far
+    // NOTE: Debug mode only. Zero if not in debug mode
+    uint64_t GetMark();
+
+    // Report the allocations made since the mark that are still alive. Returns the number
+    // NOTE: Debug mode only
+    size_t ReportLeaks( const uint64_t mark, const std::string & name );
+}
@@ -12,12 +12,12 @@
 #include <gui/menumanager.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
 #include <utilities/exceptionhandling.h>
 #include <system/device.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
-#include <autowrapper/aswrappedcall.h>
 
 namespace NScriptMenuManager
 {
@@ -341,42 +341,42 @@ namespace NScriptMenuManager
         // Register type
         Throw( pEngine->RegisterObjectType( "CMenuMgr", 0, asOBJ_REF|asOBJ_NOCOUNT) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void loadListTable(string &in)",                 WRAP_OBJ_LAST(LoadListTable),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void loadMenuAction(string &in)",                WRAP_MFN(CMenuMgr, loadMenuAction),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void loadGroup(string &in, bool doInit = true)", WRAP_OBJ_LAST(LoadGroup),              asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void initGroup(string &in)",                     WRAP_OBJ_LAST(InitGroup),              asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void freeGroup(string &in)",                     WRAP_OBJ_LAST(FreeGroup),              asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void loadListTable(string &in)",                 SCRIPT_OBJ_LAST(LoadListTable)) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void loadMenuAction(string &in)",                SCRIPT_MFN(CMenuMgr, loadMenuAction)) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void loadGroup(string &in, bool doInit = true)", SCRIPT_OBJ_LAST(LoadGroup)) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void initGroup(string &in)",                     SCRIPT_OBJ_LAST(InitGroup)) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void freeGroup(string &in)",                     SCRIPT_OBJ_LAST(FreeGroup)) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void activateMenu(string &in, string &in, string &in)", WRAP_OBJ_LAST(ActivateMenu1),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void activateMenu(string &in, string &in)",             WRAP_OBJ_LAST(ActivateMenu2),   asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void activateMenu(string &in, string &in, string &in)", SCRIPT_OBJ_LAST(ActivateMenu1)) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void activateMenu(string &in, string &in)",             SCRIPT_OBJ_LAST(ActivateMenu2)) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void activateTree(string &in, string &in)",             WRAP_OBJ_LAST(ActivateTree1),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void activateTree(string &in)",                         WRAP_OBJ_LAST(ActivateTree2),   asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void activateTree(string &in, string &in)",             SCRIPT_OBJ_LAST(ActivateTree1)) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void activateTree(string &in)",                         SCRIPT_OBJ_LAST(ActivateTree2)) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void deactivateTree(string &in, string &in)",           WRAP_OBJ_LAST(DeactivateTree1), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void deactivateTree(string &in)",                       WRAP_OBJ_LAST(DeactivateTree2), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void deactivateTree(string &in, string &in)",           SCRIPT_OBJ_LAST(DeactivateTree1)) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void deactivateTree(string &in)",                       SCRIPT_OBJ_LAST(DeactivateTree2)) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void transitionMenu(string &in, string &in)",             WRAP_OBJ_LAST(TransitionMenu1),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void transitionMenu(string &in)",                         WRAP_OBJ_LAST(TransitionMenu2),   asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void transitionMenu(string &in, string &in)",             SCRIPT_OBJ_LAST(TransitionMenu1)) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void transitionMenu(string &in)",                         SCRIPT_OBJ_LAST(TransitionMenu2)) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void clearActiveTrees()",                               WRAP_MFN(CMenuMgr, clearActiveTrees), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void clearActiveTrees()",                               SCRIPT_MFN(CMenuMgr, clearActiveTrees)) );
 
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "CMenu & getMenu(string &in)",                           WRAP_OBJ_LAST(GetMenu),         asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "CMenu & getActiveMenu()",                               WRAP_OBJ_LAST(GetActiveMenu),   asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "CMenu & getMenu(string &in)",                           SCRIPT_OBJ_LAST(GetMenu)) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "CMenu & getActiveMenu()",                               SCRIPT_OBJ_LAST(GetActiveMenu)) );
         
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "bool isActive()",                   WRAP_MFN(CMenuMgr, isActive),              asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "bool isMenuActive()",               WRAP_MFN(CMenuMgr, isMenuActive),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "bool isMenuItemActive()",           WRAP_MFN(CMenuMgr, isMenuItemActive),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "bool isInterfaceItemActive()",      WRAP_MFN(CMenuMgr, isInterfaceItemActive), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "bool isActive()",                   SCRIPT_MFN(CMenuMgr, isActive)) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "bool isMenuActive()",               SCRIPT_MFN(CMenuMgr, isMenuActive)) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "bool isMenuItemActive()",           SCRIPT_MFN(CMenuMgr, isMenuItemActive)) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "bool isInterfaceItemActive()",      SCRIPT_MFN(CMenuMgr, isInterfaceItemActive)) );
         
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void resetTransform()",             WRAP_MFN(CMenuMgr, resetTransform),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void resetDynamicOffset()",         WRAP_MFN(CMenuMgr, resetDynamicOffset),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void allow(bool allow = true)",     WRAP_MFN(CMenuMgr, allow),                 asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void resetTransform()",             SCRIPT_MFN(CMenuMgr, resetTransform)) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void resetDynamicOffset()",         SCRIPT_MFN(CMenuMgr, resetDynamicOffset)) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void allow(bool allow = true)",     SCRIPT_MFN(CMenuMgr, allow)) );
         
         Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void update()",                     asFUNCTION(Update),                        asCALL_GENERIC) );
         Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void transform()",                  asFUNCTION(Transform),                     asCALL_GENERIC) );
         
-        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void setCommandBuffer(string &in)", WRAP_OBJ_LAST(SetCommandBuffer),           asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CMenuMgr", "void setCommandBuffer(string &in)", SCRIPT_OBJ_LAST(SetCommandBuffer)) );
 
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CMenuMgr MenuMgr", &CMenuMgr::Instance()) );
@@ -12,11 +12,11 @@
 #include <objectdata/objectdatamanager.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
 #include <utilities/exceptionhandling.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
-#include <autowrapper/aswrappedcall.h>
 #include <scriptarray/scriptarray.h>
 
 namespace NScriptObjectDataManager
@@ -123,11 +123,11 @@ namespace NScriptObjectDataManager
         // Register type
         Throw( pEngine->RegisterObjectType( "CObjectDataMgr", 0, asOBJ_REF|asOBJ_NOCOUNT) );
         
-        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void loadListTable(string &in)",       WRAP_OBJ_LAST(LoadListTable), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void loadGroup(string &in)",           WRAP_OBJ_LAST(LoadGroup),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void loadGroupAry(array<string> &in)", WRAP_OBJ_LAST(LoadGroupAry),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void freeGroup(string &in)",           WRAP_OBJ_LAST(FreeGroup),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void freeGroupAry(array<string> &in)", WRAP_OBJ_LAST(FreeGroupAry),  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void loadListTable(string &in)",       SCRIPT_OBJ_LAST(LoadListTable)) );
+        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void loadGroup(string &in)",           SCRIPT_OBJ_LAST(LoadGroup)) );
+        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void loadGroupAry(array<string> &in)", SCRIPT_OBJ_LAST(LoadGroupAry)) );
+        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void freeGroup(string &in)",           SCRIPT_OBJ_LAST(FreeGroup)) );
+        Throw( pEngine->RegisterObjectMethod("CObjectDataMgr", "void freeGroupAry(array<string> &in)", SCRIPT_OBJ_LAST(FreeGroupAry)) );
         
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CObjectDataMgr ObjectDataMgr", &CObjectDataMgr::Instance()) );
@@ -0,0 +1,177 @@
+
+/************************************************************************
+*    FILE NAME:       scriptparallel.cpp
+*
+*    DESCRIPTION:     Updates the script components of sprites running
+*                     parallel safe scripts on the thread pool. Calls
+*                     that change the engine are deferred to a command
+*                     buffer that's run at the sync point
+************************************************************************/
+
+// Physical component dependency
+#include <script/scriptparallel.h>
+
+// Game lib dependencies
+#include <script/scriptcomponent.h>
+#include <script/scriptmanager.h>
+#include <utilities/threadpool.h>
+
+// Standard lib dependencies
+#include <algorithm>
+#include <exception>
+#include <future>
+
+namespace
+{
+    // Fewest components a job is given so small updates aren't split up
+    const size_t MIN_JOB_SIZE = 64;
+
+    // Command buffer of the job running on this thread. Null when not in a parallel update
+    thread_local std::vector< std::function<void()> > * t_pCommandVec = nullptr;
+
+    // Sets the command buffer for the thread for the life of the job
+    class CJobScope
+    {
+    public:
+        CJobScope( std::vector< std::function<void()> > & rCommandVec ) { t_pCommandVec = &rCommandVec; }
+        ~CJobScope() { t_pCommandVec = nullptr; }
+    };
+}
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CScriptParallel::CScriptParallel()
+{
+}
+
+/************************************************************************
+*    DESC:  Is the calling thread running a parallel update
+************************************************************************/
+bool CScriptParallel::isParallel()
+{
+    return (t_pCommandVec != nullptr);
+}
+
+/************************************************************************
+*    DESC:  Are there parallel safe scripts and workers to run them on
+************************************************************************/
+bool CScriptParallel::isActive()
+{
+    return CScriptMgr::Instance().hasParallelGroups() &&
+           CThreadPool::Instance().isActive() &&
+           (CThreadPool::Instance().threadCount() > 0);
+}
+
+/************************************************************************
+*    DESC:  Update the script components on the thread pool and run the
+*           deferred commands. This thread takes the first job
+************************************************************************/
+void CScriptParallel::update( std::vector<CScriptComponent *> & pComponentVec )
+{
+    const size_t count = pComponentVec.size();
+    const size_t jobCount = std::min( CThreadPool::Instance().threadCount() + 1, (count + MIN_JOB_SIZE - 1) / MIN_JOB_SIZE );
+
+    if( jobCount < 2 )
+    {
+        for( auto iter : pComponentVec )
+            iter->update();
+
+        return;
+    }
+
+    m_jobVec.resize( jobCount );
+
+    const size_t jobSize = (count + jobCount - 1) / jobCount;
+
+    std::vector< std::future<void> > futureVec;
+    futureVec.reserve( jobCount - 1 );
+
+    for( size_t i = 1; i < jobCount; ++i )
+    {
+        const size_t begin = std::min( i * jobSize, count );
+        const size_t end = std::min( begin + jobSize, count );
+
+        futureVec.emplace_back(
+            CThreadPool::Instance().post( &CScriptParallel::runJob, this, std::ref(pComponentVec), i, begin, end ) );
+    }
+
+    // All the jobs need to finish before an error can be thrown
+    std::exception_ptr pException;
+
+    try
+    {
+        runJob( pComponentVec, 0, 0, std::min( jobSize, count ) );
+    }
+    catch(...)
+    {
+        pException = std::current_exception();
+    }
+
+    for( auto & iter : futureVec )
+    {
+        try
+        {
+            iter.get();
+        }
+        catch(...)
+        {
+            if( !pException )
+                pException = std::current_exception();
+        }
+    }
+
+    sync();
+
+    if( pException )
+        std::rethrow_exception( pException );
+}
+
+/************************************************************************
+*    DESC:  Update a range of the script components
+************************************************************************/
+void CScriptParallel::runJob( std::vector<CScriptComponent *> & pComponentVec, size_t job, size_t begin, size_t end )
+{
+    CJobScope jobScope( m_jobVec[job].commandVec );
+
+    for( size_t i = begin; i < end; ++i )
+        pComponentVec[i]->update();
+}
+
+/************************************************************************
+*    DESC:  Run the deferred commands in job order
+************************************************************************/
+void CScriptParallel::sync()
+{
+    for( auto & iter : m_jobVec )
+    {
+        for( auto & command : iter.commandVec )
+            command();
+
+        iter.commandVec.clear();
+    }
+}
+
+/************************************************************************
+*    DESC:  Defer the command to the sync point if called from a parallel
+*           update. Otherwise it's run now
+************************************************************************/
+void CScriptParallel::defer( std::function<void()> && command )
+{
+    if( t_pCommandVec != nullptr )
+        t_pCommandVec->push_back( std::move(command) );
+    else
+        command();
+}
+
+/************************************************************************
+*    DESC:  Lock out the other workers if called from a parallel update
+*           Used for the calls that need to return a value
+************************************************************************/
+std::unique_lock<std::recursive_mutex> CScriptParallel::serialize()
+{
+    if( t_pCommandVec != nullptr )
+        return std::unique_lock<std::recursive_mutex>( m_mutex );
+
+    return std::unique_lock<std::recursive_mutex>();
+}
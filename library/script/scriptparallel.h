@@ -0,0 +1,92 @@
+
+/************************************************************************
+*    FILE NAME:       scriptparallel.h
+*
+*    DESCRIPTION:     Updates the script components of sprites running
+*                     parallel safe scripts on the thread pool. Calls
+*                     that change the engine are deferred to a command
+*                     buffer that's run at the sync point
+************************************************************************/
+
+#pragma once
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <vector>
+#include <functional>
+#include <mutex>
+
+// Forward declaration(s)
+class CScriptComponent;
+
+class CScriptParallel : boost::noncopyable
+{
+public:
+
+    // Get the instance of the singleton class
+    static CScriptParallel & Instance()
+    {
+        static CScriptParallel scriptParallel;
+        return scriptParallel;
+    }
+
+    // Is the calling thread running a parallel update
+    static bool isParallel();
+
+    // Are there parallel safe scripts and workers to run them on
+    bool isActive();
+
+    // Update the script components on the thread pool and run the deferred commands
+    void update( std::vector<CScriptComponent *> & pComponentVec );
+
+    // Defer the command to the sync point if called from a parallel update. Otherwise it's run now
+    void defer( std::function<void()> && command );
+
+    // Lock out the other workers if called from a parallel update.
+    // Used for the calls that need to return a value
+    std::unique_lock<std::recursive_mutex> serialize();
+
+private:
+
+    struct SJob
+    {
+        // Commands deferred by this job
+        std::vector< std::function<void()> > commandVec;
+    };
+
+    // Constructor
+    CScriptParallel();
+
+    // Update a range of the script components
+    void runJob( std::vector<CScriptComponent *> & pComponentVec, size_t job, size_t begin, size_t end );
+
+    // Run the deferred commands in job order
+    void sync();
+
+private:
+
+    // Jobs of the last parallel update
+    std::vector<SJob> m_jobVec;
+
+    // Mutex for the calls that can't be deferred
+    std::recursive_mutex m_mutex;
+};
+
+namespace NScriptParallel
+{
+    // Script binding of a method that's deferred when called from a parallel update
+    // NOTE: The object is the last parameter to be registered with SCRIPT_OBJ_LAST
+    template<auto>
+    struct SDefer;
+
+    template<typename T, typename... Args, void (T::*pMethod)(Args...)>
+    struct SDefer<pMethod>
+    {
+        static void call( Args... args, T & rObj )
+        {
+            CScriptParallel::Instance().defer( [&rObj, args...]() { (rObj.*pMethod)( args... ); } );
+        }
+    };
+}
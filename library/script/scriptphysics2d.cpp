@@ -11,14 +11,19 @@
 // Game lib dependencies
 #include <physics/physicsworldmanager2d.h>
 #include <physics/physicsworld2d.h>
+#include <physics/contact2d.h>
+#include <sprite/sprite.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
 #include <utilities/exceptionhandling.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
 #include <scriptarray/scriptarray.h>
-#include <autowrapper/aswrappedcall.h>
+
+// Standard lib dependencies
+#include <vector>
 
 namespace NScriptPhysics2d
 {
@@ -40,6 +45,42 @@ namespace NScriptPhysics2d
             asGetActiveContext()->SetException(ex.what());
         }
     }
+
+    /************************************************************************
+    *    DESC:  Get the sprites of the contact
+    *           NOTE: Contacts are only saved for fixtures with user data
+    ************************************************************************/
+    CSprite & GetSpriteA( const CContact2D & rContact )
+    {
+        return *static_cast<CSprite *>(rContact.pUserDataA);
+    }
+
+    CSprite & GetSpriteB( const CContact2D & rContact )
+    {
+        return *static_cast<CSprite *>(rContact.pUserDataB);
+    }
+
+    /************************************************************************
+    *    DESC:  Get the size of the contact list
+    ************************************************************************/
+    uint ContactListSize( const std::vector<CContact2D> & rContactVec )
+    {
+        return rContactVec.size();
+    }
+
+    /************************************************************************
+    *    DESC:  Get the contact from the contact list
+    ************************************************************************/
+    const CContact2D & ContactListAt( uint index, const std::vector<CContact2D> & rContactVec )
+    {
+        if( index >= rContactVec.size() )
+        {
+            asGetActiveContext()->SetException("Contact index out of range!");
+            index = 0;
+        }
+
+        return rContactVec[index];
+    }
     
     /************************************************************************
     *    DESC:  Register global functions
@@ -53,19 +94,36 @@ namespace NScriptPhysics2d
         // Register type
         Throw( pEngine->RegisterObjectType("CPhysicsWorld2D", 0, asOBJ_REF|asOBJ_NOCOUNT) );
 
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void fixedTimeStep()",                                 WRAP_MFN(CPhysicsWorld2D, fixedTimeStep),             asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void variableTimeStep()",                              WRAP_MFN(CPhysicsWorld2D, variableTimeStep),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void EnableContactListener( bool enable = true )",     WRAP_MFN(CPhysicsWorld2D, EnableContactListener),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void EnableDestructionListener( bool enable = true )", WRAP_MFN(CPhysicsWorld2D, EnableDestructionListener), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void fixedTimeStep()",                                 SCRIPT_MFN(CPhysicsWorld2D, fixedTimeStep)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void variableTimeStep()",                              SCRIPT_MFN(CPhysicsWorld2D, variableTimeStep)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void EnableContactListener( bool enable = true )",     SCRIPT_MFN(CPhysicsWorld2D, EnableContactListener)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorld2D", "void EnableDestructionListener( bool enable = true )", SCRIPT_MFN(CPhysicsWorld2D, EnableDestructionListener)) );
+
+        // Register type
+        Throw( pEngine->RegisterObjectType("CContact2D", 0, asOBJ_REF|asOBJ_NOCOUNT) );
+
+        Throw( pEngine->RegisterObjectProperty("CContact2D", "const float normalX", asOFFSET(CContact2D, normalX)) );
+        Throw( pEngine->RegisterObjectProperty("CContact2D", "const float normalY", asOFFSET(CContact2D, normalY)) );
+        Throw( pEngine->RegisterObjectProperty("CContact2D", "const float impulse", asOFFSET(CContact2D, impulse)) );
+
+        Throw( pEngine->RegisterObjectMethod("CContact2D", "CSprite & getSpriteA() const", SCRIPT_OBJ_LAST(GetSpriteA)) );
+        Throw( pEngine->RegisterObjectMethod("CContact2D", "CSprite & getSpriteB() const", SCRIPT_OBJ_LAST(GetSpriteB)) );
+
+        // Register type
+        // NOTE: The list is only valid until the physics world steps again
+        Throw( pEngine->RegisterObjectType("CContactList2D", 0, asOBJ_REF|asOBJ_NOCOUNT) );
+
+        Throw( pEngine->RegisterObjectMethod("CContactList2D", "uint size() const",                        SCRIPT_OBJ_LAST(ContactListSize)) );
+        Throw( pEngine->RegisterObjectMethod("CContactList2D", "const CContact2D & opIndex(uint) const", SCRIPT_OBJ_LAST(ContactListAt)) );
 
         // Register type
         Throw( pEngine->RegisterObjectType( "CPhysicsWorldManager2D", 0, asOBJ_REF|asOBJ_NOCOUNT) );
         
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void loadListTable(string &in)",         WRAP_OBJ_LAST(LoadListTable),                   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void createWorld(string &in)",           WRAP_MFN(CPhysicsWorldManager2D, createWorld),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void destroyWorld(string &in)",          WRAP_MFN(CPhysicsWorldManager2D, destroyWorld), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "CPhysicsWorld2D & getWorld(string &in)", WRAP_MFN(CPhysicsWorldManager2D, getWorld),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void clear()",                           WRAP_MFN(CPhysicsWorldManager2D, clear),        asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void loadListTable(string &in)",         SCRIPT_OBJ_LAST(LoadListTable)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void createWorld(string &in)",           SCRIPT_MFN(CPhysicsWorldManager2D, createWorld)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void destroyWorld(string &in)",          SCRIPT_MFN(CPhysicsWorldManager2D, destroyWorld)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "CPhysicsWorld2D & getWorld(string &in)", SCRIPT_MFN(CPhysicsWorldManager2D, getWorld)) );
+        Throw( pEngine->RegisterObjectMethod("CPhysicsWorldManager2D", "void clear()",                           SCRIPT_MFN(CPhysicsWorldManager2D, clear)) );
         
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CPhysicsWorldManager2D PhysicsWorldManager2D", &CPhysicsWorldManager2D::Instance()) );
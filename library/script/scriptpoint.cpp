@@ -12,10 +12,10 @@
 #include <common/point.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
-#include <autowrapper/aswrappedcall.h>
 
 namespace NScriptPoint
 {
@@ -142,36 +142,36 @@ namespace NScriptPoint
         Throw( pEngine->RegisterObjectType("CPoint", sizeof(CPoint<float>), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<CPoint<float>>() | asOBJ_APP_CLASS_ALLFLOATS ) );
 
         // Register the object operator overloads
-        Throw( pEngine->RegisterObjectBehaviour("CPoint", asBEHAVE_CONSTRUCT, "void f()",                    WRAP_OBJ_LAST(Constructor),                asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CPoint", asBEHAVE_CONSTRUCT, "void f(const CPoint & in)",   WRAP_OBJ_LAST(CopyConstructor),            asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CPoint", asBEHAVE_CONSTRUCT, "void f(float, float, float)", WRAP_OBJ_LAST(ConstructorFromThreeFloats), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CPoint", asBEHAVE_CONSTRUCT, "void f(float, float)",        WRAP_OBJ_LAST(ConstructorFromTwoFloats),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CPoint", asBEHAVE_DESTRUCT,  "void f()",                    WRAP_OBJ_LAST(Destructor),                 asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectBehaviour("CPoint", asBEHAVE_CONSTRUCT, "void f()",                    SCRIPT_OBJ_LAST(Constructor)) );
+        Throw( pEngine->RegisterObjectBehaviour("CPoint", asBEHAVE_CONSTRUCT, "void f(const CPoint & in)",   SCRIPT_OBJ_LAST(CopyConstructor)) );
+        Throw( pEngine->RegisterObjectBehaviour("CPoint", asBEHAVE_CONSTRUCT, "void f(float, float, float)", SCRIPT_OBJ_LAST(ConstructorFromThreeFloats)) );
+        Throw( pEngine->RegisterObjectBehaviour("CPoint", asBEHAVE_CONSTRUCT, "void f(float, float)",        SCRIPT_OBJ_LAST(ConstructorFromTwoFloats)) );
+        Throw( pEngine->RegisterObjectBehaviour("CPoint", asBEHAVE_DESTRUCT,  "void f()",                    SCRIPT_OBJ_LAST(Destructor)) );
 
         // assignment operator
         Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint & opAssign(const CPoint & in)", asFUNCTION(OpAssignCPoint), asCALL_GENERIC) );
 
         // binary operators
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opAdd ( CPoint & in )", WRAP_MFN_PR(CPoint<float>, operator +, (const CPoint<float> &) const, CPoint<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opSub ( CPoint & in )", WRAP_MFN_PR(CPoint<float>, operator -, (const CPoint<float> &) const, CPoint<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opMul ( CPoint & in )", WRAP_MFN_PR(CPoint<float>, operator *, (const CPoint<float> &) const, CPoint<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opDiv ( CPoint & in )", WRAP_MFN_PR(CPoint<float>, operator /, (const CPoint<float> &) const, CPoint<float>), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opAdd ( CPoint & in )", SCRIPT_MFN_PR(CPoint<float>, operator +, (const CPoint<float> &) const, CPoint<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opSub ( CPoint & in )", SCRIPT_MFN_PR(CPoint<float>, operator -, (const CPoint<float> &) const, CPoint<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opMul ( CPoint & in )", SCRIPT_MFN_PR(CPoint<float>, operator *, (const CPoint<float> &) const, CPoint<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opDiv ( CPoint & in )", SCRIPT_MFN_PR(CPoint<float>, operator /, (const CPoint<float> &) const, CPoint<float>)) );
 
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opAdd ( float )", WRAP_MFN_PR(CPoint<float>, operator +, (float) const, CPoint<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opSub ( float )", WRAP_MFN_PR(CPoint<float>, operator -, (float) const, CPoint<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opMul ( float )", WRAP_MFN_PR(CPoint<float>, operator *, (float) const, CPoint<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opDiv ( float )", WRAP_MFN_PR(CPoint<float>, operator /, (float) const, CPoint<float>), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opAdd ( float )", SCRIPT_MFN_PR(CPoint<float>, operator +, (float) const, CPoint<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opSub ( float )", SCRIPT_MFN_PR(CPoint<float>, operator -, (float) const, CPoint<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opMul ( float )", SCRIPT_MFN_PR(CPoint<float>, operator *, (float) const, CPoint<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opDiv ( float )", SCRIPT_MFN_PR(CPoint<float>, operator /, (float) const, CPoint<float>)) );
 
         // compound assignment operators
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opAddAssign ( CPoint & in )", WRAP_MFN_PR(CPoint<float>, operator +=, (const CPoint<float> &), CPoint<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opSubAssign ( CPoint & in )", WRAP_MFN_PR(CPoint<float>, operator -=, (const CPoint<float> &), CPoint<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opMulAssign ( CPoint & in )", WRAP_MFN_PR(CPoint<float>, operator *=, (const CPoint<float> &), CPoint<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opDivAssign ( CPoint & in )", WRAP_MFN_PR(CPoint<float>, operator /=, (const CPoint<float> &), CPoint<float>), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opAddAssign ( CPoint & in )", SCRIPT_MFN_PR(CPoint<float>, operator +=, (const CPoint<float> &), CPoint<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opSubAssign ( CPoint & in )", SCRIPT_MFN_PR(CPoint<float>, operator -=, (const CPoint<float> &), CPoint<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opMulAssign ( CPoint & in )", SCRIPT_MFN_PR(CPoint<float>, operator *=, (const CPoint<float> &), CPoint<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opDivAssign ( CPoint & in )", SCRIPT_MFN_PR(CPoint<float>, operator /=, (const CPoint<float> &), CPoint<float>)) );
 
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opAddAssign ( float )", WRAP_MFN_PR(CPoint<float>, operator +=, (float) , CPoint<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opSubAssign ( float )", WRAP_MFN_PR(CPoint<float>, operator -=, (float) , CPoint<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opMulAssign ( float )", WRAP_MFN_PR(CPoint<float>, operator *=, (float) , CPoint<float>), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opDivAssign ( float )", WRAP_MFN_PR(CPoint<float>, operator /=, (float) , CPoint<float>), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opAddAssign ( float )", SCRIPT_MFN_PR(CPoint<float>, operator +=, (float) , CPoint<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opSubAssign ( float )", SCRIPT_MFN_PR(CPoint<float>, operator -=, (float) , CPoint<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opMulAssign ( float )", SCRIPT_MFN_PR(CPoint<float>, operator *=, (float) , CPoint<float>)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint opDivAssign ( float )", SCRIPT_MFN_PR(CPoint<float>, operator /=, (float) , CPoint<float>)) );
 
         // Register property
         Throw( pEngine->RegisterObjectProperty("CPoint", "float x", asOFFSET(CPoint<float>, x)) );
@@ -179,35 +179,35 @@ namespace NScriptPoint
         Throw( pEngine->RegisterObjectProperty("CPoint", "float z", asOFFSET(CPoint<float>, z)) );
 
         // Class members
-        Throw( pEngine->RegisterObjectMethod("CPoint", "void clearX()",            WRAP_MFN(CPoint<float>, clearX),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "void clearY()",            WRAP_MFN(CPoint<float>, clearY),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "void clearZ()",            WRAP_MFN(CPoint<float>, clearZ),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "void clear()",             WRAP_MFN(CPoint<float>, clear),       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "bool isEmpty()",           WRAP_MFN(CPoint<float>, isEmpty),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "bool isXEmpty()",          WRAP_MFN(CPoint<float>, isXEmpty),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "bool isYEmpty()",          WRAP_MFN(CPoint<float>, isYEmpty),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "bool isZEmpty()",          WRAP_MFN(CPoint<float>, isZEmpty),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "void invert()",            WRAP_MFN(CPoint<float>, invert),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "void invertX()",           WRAP_MFN(CPoint<float>, invert),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "void invertY()",           WRAP_MFN(CPoint<float>, invert),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "void invertZ()",           WRAP_MFN(CPoint<float>, invert),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint getInvert() const", WRAP_MFN(CPoint<float>, getInvert),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "void normalize()",         WRAP_MFN(CPoint<float>, normalize),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "void normalize2D()",       WRAP_MFN(CPoint<float>, normalize2D), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "void clearX()",            SCRIPT_MFN(CPoint<float>, clearX)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "void clearY()",            SCRIPT_MFN(CPoint<float>, clearY)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "void clearZ()",            SCRIPT_MFN(CPoint<float>, clearZ)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "void clear()",             SCRIPT_MFN(CPoint<float>, clear)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "bool isEmpty()",           SCRIPT_MFN(CPoint<float>, isEmpty)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "bool isXEmpty()",          SCRIPT_MFN(CPoint<float>, isXEmpty)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "bool isYEmpty()",          SCRIPT_MFN(CPoint<float>, isYEmpty)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "bool isZEmpty()",          SCRIPT_MFN(CPoint<float>, isZEmpty)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "void invert()",            SCRIPT_MFN(CPoint<float>, invert)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "void invertX()",           SCRIPT_MFN(CPoint<float>, invert)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "void invertY()",           SCRIPT_MFN(CPoint<float>, invert)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "void invertZ()",           SCRIPT_MFN(CPoint<float>, invert)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint getInvert() const", SCRIPT_MFN(CPoint<float>, getInvert)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "void normalize()",         SCRIPT_MFN(CPoint<float>, normalize)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "void normalize2D()",       SCRIPT_MFN(CPoint<float>, normalize2D)) );
         
-        Throw( pEngine->RegisterObjectMethod("CPoint", "float getLengthSquared2D() const",            WRAP_OBJ_LAST(GetLengthSquared2D1), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "float getLengthSquared2D(CPoint & in) const", WRAP_OBJ_LAST(GetLengthSquared2D2), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "float getLengthSquared() const",              WRAP_OBJ_LAST(GetLengthSquared1),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "float getLengthSquared(CPoint & in) const",   WRAP_OBJ_LAST(GetLengthSquared2),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "float getLength2D() const",                   WRAP_OBJ_LAST(GetLength2D1),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "float getLength2D(CPoint & in) const",        WRAP_OBJ_LAST(GetLength2D2),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "float getLength() const",                     WRAP_OBJ_LAST(GetLength1),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "float getLength(CPoint & in) const",          WRAP_OBJ_LAST(GetLength2),          asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "float getLengthSquared2D() const",            SCRIPT_OBJ_LAST(GetLengthSquared2D1)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "float getLengthSquared2D(CPoint & in) const", SCRIPT_OBJ_LAST(GetLengthSquared2D2)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "float getLengthSquared() const",              SCRIPT_OBJ_LAST(GetLengthSquared1)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "float getLengthSquared(CPoint & in) const",   SCRIPT_OBJ_LAST(GetLengthSquared2)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "float getLength2D() const",                   SCRIPT_OBJ_LAST(GetLength2D1)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "float getLength2D(CPoint & in) const",        SCRIPT_OBJ_LAST(GetLength2D2)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "float getLength() const",                     SCRIPT_OBJ_LAST(GetLength1)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "float getLength(CPoint & in) const",          SCRIPT_OBJ_LAST(GetLength2)) );
         
-        Throw( pEngine->RegisterObjectMethod("CPoint", "bool isEquilEnough(CPoint & in, float val)", WRAP_OBJ_LAST(IsEquilEnough),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "float getDotProduct(CPoint & in) const",     WRAP_OBJ_LAST(GetDotProduct),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "float getDotProduct2D(CPoint & in) const",   WRAP_OBJ_LAST(GetDotProduct2D),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint getCrossProduct(CPoint & in) const",  WRAP_OBJ_LAST(GetCrossProduct),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CPoint", "void cap(float)",                            WRAP_OBJ_LAST(Cap),                  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "bool isEquilEnough(CPoint & in, float val)", SCRIPT_OBJ_LAST(IsEquilEnough)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "float getDotProduct(CPoint & in) const",     SCRIPT_OBJ_LAST(GetDotProduct)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "float getDotProduct2D(CPoint & in) const",   SCRIPT_OBJ_LAST(GetDotProduct2D)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "CPoint getCrossProduct(CPoint & in) const",  SCRIPT_OBJ_LAST(GetCrossProduct)) );
+        Throw( pEngine->RegisterObjectMethod("CPoint", "void cap(float)",                            SCRIPT_OBJ_LAST(Cap)) );
     }
 }
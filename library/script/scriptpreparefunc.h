@@ -7,8 +7,12 @@
 
 #pragma once
 
+// Game lib dependencies
+#include <script/scriptfunchandle.h>
+
 // Standard lib dependencies
 #include <string>
+#include <map>
 
 class CScriptPrepareFunc
 {
@@ -17,6 +21,7 @@ public:
     CScriptPrepareFunc(const std::string & grp, const std::string & fName, bool prep, bool force) :
         group(grp),
         funcName(fName),
+        funcHandle(grp, fName),
         prepareOnInit(prep),
         forceUpdate(force)
     {}
@@ -27,9 +32,15 @@ public:
     // Function Id
     std::string funcName;
 
+    // Handle to the function so it's not looked up on every prepare
+    CScriptFuncHandle funcHandle;
+
     // Prepare on Init flag
     bool prepareOnInit = false;
 
     // Force Update flag
     bool forceUpdate = false;
 };
+
+// Script function map. Execute scripts with an id
+typedef std::map<const std::string, CScriptPrepareFunc> scriptFuncMap_t;
@@ -0,0 +1,282 @@
+
+/************************************************************************
+*    FILE NAME:       scriptprofiler.cpp
+*
+*    DESCRIPTION:     Sampling profiler for the scripts. A background
+*                     thread ticks at the sample interval and each
+*                     executing context records its call stack once per
+*                     tick from the line callback
+************************************************************************/
+
+// Physical component dependency
+#include <script/scriptprofiler.h>
+
+// Game lib dependencies
+#include <utilities/exceptionhandling.h>
+#include <utilities/statcounter.h>
+#include <utilities/genfunc.h>
+#include <utilities/smartpointers.h>
+
+// AngelScript lib dependencies
+#include <angelscript.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+// SDL lib dependencies
+#include <SDL3/SDL.h>
+
+namespace
+{
+    // The last tick sampled on this thread
+    thread_local uint32_t t_lastTick = 0;
+
+    // Get the name of the function for the stack
+    std::string GetName( asIScriptFunction * pFunc )
+    {
+        if( pFunc->GetObjectName() != nullptr )
+            return std::string(pFunc->GetObjectName()) + "::" + pFunc->GetName();
+
+        return pFunc->GetName();
+    }
+}
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CScriptProfiler::CScriptProfiler() :
+    m_active(false),
+    m_tick(0),
+    m_postTimer(2000)
+{
+}
+
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CScriptProfiler::~CScriptProfiler()
+{
+    m_active = false;
+
+    if( m_tickThread.joinable() )
+        m_tickThread.join();
+}
+
+
+/************************************************************************
+*    DESC:  Start sampling the executing scripts
+************************************************************************/
+void CScriptProfiler::start( const uint32_t intervalMicroSec, const uint32_t topCount )
+{
+    if( m_active )
+        return;
+
+    m_intervalMicroSec = std::max( intervalMicroSec, 100u );
+    m_topCount = topCount;
+    m_postTimer.reset();
+
+    m_active = true;
+    m_tickThread = std::thread( &CScriptProfiler::tick, this );
+}
+
+
+/************************************************************************
+*    DESC:  Stop sampling. The samples are kept until cleared
+*           NOTE: Contexts still holding the line callback clear it
+*                 the next time it's called
+************************************************************************/
+void CScriptProfiler::stop()
+{
+    m_active = false;
+
+    if( m_tickThread.joinable() )
+        m_tickThread.join();
+
+    CStatCounter::Instance().setScriptProfile( "" );
+}
+
+
+/************************************************************************
+*    DESC:  Sample the context while it executes
+*           NOTE: Called on the executing thread before each execute
+************************************************************************/
+void CScriptProfiler::attach( asIScriptContext * pContext )
+{
+    // Start from the current tick so the ticks that passed while no
+    // script ran on this thread aren't charged to this script
+    t_lastTick = m_tick.load( std::memory_order_relaxed );
+
+    pContext->SetLineCallback( asMETHOD(CScriptProfiler, lineCallback), this, asCALL_THISCALL );
+}
+
+
+/************************************************************************
+*    DESC:  Called by the executing context
+*           NOTE: The scripts are built without line cues so this
+*                 is called on function calls and loops
+************************************************************************/
+void CScriptProfiler::lineCallback( asIScriptContext * pContext )
+{
+    if( !m_active.load( std::memory_order_relaxed ) )
+    {
+        pContext->ClearLineCallback();
+        return;
+    }
+
+    // Only one sample per tick on this thread
+    const uint32_t tick = m_tick.load( std::memory_order_relaxed );
+    if( tick != t_lastTick )
+    {
+        t_lastTick = tick;
+        sample( pContext );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Record the call stack of the context
+************************************************************************/
+void CScriptProfiler::sample( asIScriptContext * pContext )
+{
+    asIScriptFunction * pLeafFunc = pContext->GetFunction( 0 );
+    if( pLeafFunc == nullptr )
+        return;
+
+    // Folded stacks go from the root to the leaf
+    std::string stack;
+    for( asUINT i = pContext->GetCallstackSize(); i-- > 0; )
+    {
+        // Nested calls have a null function
+        asIScriptFunction * pFunc = pContext->GetFunction( i );
+        if( pFunc != nullptr )
+        {
+            if( !stack.empty() )
+                stack += ';';
+
+            stack += GetName( pFunc );
+        }
+    }
+
+    const int line = pContext->GetLineNumber( 0 );
+
+    const std::string funcName = GetName( pLeafFunc );
+    const std::string lineName = boost::str( boost::format("%s:%d") % funcName % line );
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    ++m_stackMap[stack];
+    ++m_funcMap[funcName];
+    ++m_lineMap[lineName];
+    ++m_sampleCount;
+}
+
+
+/************************************************************************
+*    DESC:  Tick at the sample interval
+************************************************************************/
+void CScriptProfiler::tick()
+{
+    while( m_active )
+    {
+        std::this_thread::sleep_for( std::chrono::microseconds( m_intervalMicroSec ) );
+        m_tick.fetch_add( 1, std::memory_order_relaxed );
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Post the top functions and lines to the stat counter
+************************************************************************/
+void CScriptProfiler::update()
+{
+    if( m_postTimer.expired( CTimer::RESTART_ON_EXPIRE ) )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        if( m_sampleCount > 0 )
+        {
+            const std::string funcStr = formatTop( m_funcMap, m_sampleCount );
+            const std::string lineStr = formatTop( m_lineMap, m_sampleCount );
+
+            CStatCounter::Instance().setScriptProfile( funcStr );
+            NGenFunc::PostDebugMsg( "Script profile: " + funcStr + " | " + lineStr );
+        }
+
+        m_funcMap.clear();
+        m_lineMap.clear();
+        m_sampleCount = 0;
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Format the top lines of the samples
+************************************************************************/
+std::string CScriptProfiler::formatTop(
+    const std::unordered_map<std::string, uint32_t> & sampleMap, const uint32_t sampleCount ) const
+{
+    std::vector< std::pair<std::string, uint32_t> > sampleVec( sampleMap.begin(), sampleMap.end() );
+
+    const size_t count = std::min( sampleVec.size(), (size_t)m_topCount );
+    std::partial_sort( sampleVec.begin(), sampleVec.begin() + count, sampleVec.end(),
+        []( const auto & a, const auto & b ) { return a.second > b.second; } );
+
+    std::string topStr;
+    for( size_t i = 0; i < count; ++i )
+    {
+        if( !topStr.empty() )
+            topStr += ", ";
+
+        topStr += boost::str( boost::format("%s %.1f%% %.1fms")
+            % sampleVec[i].first
+            % (100.0 * sampleVec[i].second / sampleCount)
+            % (sampleVec[i].second * m_intervalMicroSec / 1000.0) );
+    }
+
+    return topStr;
+}
+
+
+/************************************************************************
+*    DESC:  Save the samples as folded stacks for flamegraph tools
+************************************************************************/
+void CScriptProfiler::saveFoldedStacks( const std::string & filePath ) const
+{
+    std::string folded;
+
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        for( auto & iter : m_stackMap )
+            folded += boost::str( boost::format("%s %u\n") % iter.first % iter.second );
+    }
+
+    NSmart::scoped_SDL_filehandle_ptr<SDL_IOStream> scpFile( SDL_IOFromFile( filePath.c_str(), "wb" ) );
+    if( scpFile.isNull() )
+        throw NExcept::CCriticalException("Script Profiler Save Error!",
+            boost::str( boost::format("Error Opening file (%s).\n\n%s\nLine: %s") % filePath % __FUNCTION__ % __LINE__ ));
+
+    if( SDL_WriteIO( scpFile.get(), folded.data(), folded.size() ) != folded.size() )
+        throw NExcept::CCriticalException("Script Profiler Save Error!",
+            boost::str( boost::format("Error writing file (%s).\n\n%s\nLine: %s") % filePath % __FUNCTION__ % __LINE__ ));
+}
+
+
+/************************************************************************
+*    DESC:  Clear the samples
+************************************************************************/
+void CScriptProfiler::clear()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_stackMap.clear();
+    m_funcMap.clear();
+    m_lineMap.clear();
+    m_sampleCount = 0;
+}
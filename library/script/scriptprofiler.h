@@ -0,0 +1,115 @@
+
+/************************************************************************
+*    FILE NAME:       scriptprofiler.h
+*
+*    DESCRIPTION:     Sampling profiler for the scripts. A background
+*                     thread ticks at the sample interval and each
+*                     executing context records its call stack once per
+*                     tick from the line callback
+************************************************************************/
+
+#pragma once
+
+// Game lib dependencies
+#include <utilities/timer.h>
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <string>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+// Forward declaration(s)
+class asIScriptContext;
+
+class CScriptProfiler : boost::noncopyable
+{
+public:
+
+    // Get the instance of the singleton class
+    static CScriptProfiler & Instance()
+    {
+        static CScriptProfiler scriptProfiler;
+        return scriptProfiler;
+    }
+
+    // Start sampling the executing scripts
+    void start( const uint32_t intervalMicroSec, const uint32_t topCount );
+
+    // Stop sampling. The samples are kept until cleared
+    void stop();
+
+    // Is the profiler sampling
+    bool isActive() const
+    {
+        return m_active.load( std::memory_order_relaxed );
+    }
+
+    // Sample the context while it executes. Call on the executing thread before each execute
+    void attach( asIScriptContext * pContext );
+
+    // Post the top functions and lines to the stat counter
+    void update();
+
+    // Save the samples as folded stacks for flamegraph tools
+    void saveFoldedStacks( const std::string & filePath ) const;
+
+    // Clear the samples
+    void clear();
+
+private:
+
+    // Constructor
+    CScriptProfiler();
+
+    // Destructor
+    ~CScriptProfiler();
+
+    // Called by the executing context
+    void lineCallback( asIScriptContext * pContext );
+
+    // Record the call stack of the context
+    void sample( asIScriptContext * pContext );
+
+    // Tick at the sample interval
+    void tick();
+
+    // Format the top lines of the samples
+    std::string formatTop( const std::unordered_map<std::string, uint32_t> & sampleMap, const uint32_t sampleCount ) const;
+
+private:
+
+    // Sampling flag
+    std::atomic<bool> m_active;
+
+    // Advanced every sample interval
+    std::atomic<uint32_t> m_tick;
+
+    // Sample interval
+    uint32_t m_intervalMicroSec = 1000;
+
+    // Number of lines to post to the stat counter
+    uint32_t m_topCount = 3;
+
+    // Thread ticking the sample interval
+    std::thread m_tickThread;
+
+    // Samples from the thread pool are recorded with a lock
+    mutable std::mutex m_mutex;
+
+    // Samples of each folded call stack
+    std::unordered_map<std::string, uint32_t> m_stackMap;
+
+    // Samples of each function and line since the last post
+    std::unordered_map<std::string, uint32_t> m_lineMap;
+    std::unordered_map<std::string, uint32_t> m_funcMap;
+    uint32_t m_sampleCount = 0;
+
+    // Timer to post to the stat counter
+    CTimer m_postTimer;
+};
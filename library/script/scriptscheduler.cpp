@@ -0,0 +1,249 @@
+
+/************************************************************************
+*    FILE NAME:       scriptscheduler.cpp
+*
+*    DESCRIPTION:     Keeps track of the script contexts waiting on
+*                     time, frames, events or other spawned scripts
+*                     so only the contexts that are ready get resumed
+************************************************************************/
+
+// Physical component dependency
+#include <script/scriptscheduler.h>
+
+// Game lib dependencies
+#include <utilities/highresolutiontimer.h>
+#include <script/scriptparallel.h>
+
+// Standard lib dependencies
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // One millisecond a tick so a turn of the wheel is about a second
+    const uint32_t TIME_WHEEL_SLOTS = 1024;
+
+    // One frame a tick
+    const uint32_t FRAME_WHEEL_SLOTS = 64;
+}
+
+/************************************************************************
+*    DESC:  Constructor
+*           NOTE: The script manager creates this on the main thread
+************************************************************************/
+CScriptScheduler::CScriptScheduler() :
+    m_timeWheel( TIME_WHEEL_SLOTS ),
+    m_frameWheel( FRAME_WHEEL_SLOTS ),
+    m_threadId( std::this_thread::get_id() )
+{
+}
+
+/************************************************************************
+*    DESC:  Wait for the time in milliseconds
+************************************************************************/
+void CScriptScheduler::waitMs( asIScriptContext * pContext, const double time )
+{
+    if( CScriptParallel::isParallel() )
+    {
+        CScriptParallel::Instance().defer( [this, pContext, time]() { waitMs( pContext, time ); } );
+        return;
+    }
+
+    const uint32_t serial = addWait( pContext );
+    const double expire = std::ceil( CHighResTimer::Instance().getTime() + time );
+
+    m_timeWheel.add( pContext, serial, (uint64_t)expire );
+}
+
+/************************************************************************
+*    DESC:  Wait for the number of frames
+************************************************************************/
+void CScriptScheduler::waitFrames( asIScriptContext * pContext, const uint32_t frames )
+{
+    if( CScriptParallel::isParallel() )
+    {
+        CScriptParallel::Instance().defer( [this, pContext, frames]() { waitFrames( pContext, frames ); } );
+        return;
+    }
+
+    const uint32_t serial = addWait( pContext );
+    const uint64_t expire = CHighResTimer::Instance().getFrameCount() + std::max( frames, 1U );
+
+    m_frameWheel.add( pContext, serial, expire );
+}
+
+/************************************************************************
+*    DESC:  Wait for the event type to be queued
+************************************************************************/
+void CScriptScheduler::waitEvent( asIScriptContext * pContext, const uint32_t type )
+{
+    if( CScriptParallel::isParallel() )
+    {
+        CScriptParallel::Instance().defer( [this, pContext, type]() { waitEvent( pContext, type ); } );
+        return;
+    }
+
+    const uint32_t serial = addWait( pContext );
+
+    m_eventWaitMap[type].push_back( {pContext, serial} );
+}
+
+/************************************************************************
+*    DESC:  Wait for the spawned script to finish. Returns false if it's not running
+*           Parallel updates always wait. If the spawned script is done by
+*           the sync point, the context is resumed with the next update
+************************************************************************/
+bool CScriptScheduler::waitUntil( asIScriptContext * pContext, const uint32_t spawnId )
+{
+    if( CScriptParallel::isParallel() )
+    {
+        CScriptParallel::Instance().defer( [this, pContext, spawnId]() { waitUntil( pContext, spawnId ); } );
+        return true;
+    }
+
+    auto iter = m_spawnIdMap.find( spawnId );
+    if( (iter == m_spawnIdMap.end()) || (iter->second == pContext) )
+        return false;
+
+    const uint32_t serial = addWait( pContext );
+
+    m_spawnWaitMap[spawnId].push_back( {pContext, serial} );
+
+    return true;
+}
+
+/************************************************************************
+*    DESC:  Wake up the contexts waiting on this event type
+************************************************************************/
+void CScriptScheduler::signalEvent( const uint32_t type )
+{
+    if( m_eventWaitMap.empty() )
+        return;
+
+    auto iter = m_eventWaitMap.find( type );
+    if( iter != m_eventWaitMap.end() )
+    {
+        wake( iter->second );
+        m_eventWaitMap.erase( iter );
+    }
+}
+
+/************************************************************************
+*    DESC:  Advance the timers and wake up the contexts that are due
+************************************************************************/
+void CScriptScheduler::update()
+{
+    m_timeWheel.advance( (uint64_t)CHighResTimer::Instance().getTime(), m_expiredVec );
+    m_frameWheel.advance( CHighResTimer::Instance().getFrameCount(), m_expiredVec );
+
+    for( auto & iter : m_expiredVec )
+        wake( iter.pContext, iter.serial );
+
+    m_expiredVec.clear();
+}
+
+/************************************************************************
+*    DESC:  Is this context waiting. Waiting contexts are not resumed
+************************************************************************/
+bool CScriptScheduler::isWaiting( asIScriptContext * pContext ) const
+{
+    return !m_waitMap.empty() && (m_waitMap.find( pContext ) != m_waitMap.end());
+}
+
+/************************************************************************
+*    DESC:  Give the spawned context an id other scripts can wait on
+************************************************************************/
+uint32_t CScriptScheduler::addSpawn( asIScriptContext * pContext )
+{
+    // Zero is never handed out so scripts can use it as no spawn
+    if( ++m_spawnId == 0 )
+        ++m_spawnId;
+
+    m_spawnMap[pContext] = m_spawnId;
+    m_spawnIdMap[m_spawnId] = pContext;
+
+    return m_spawnId;
+}
+
+/************************************************************************
+*    DESC:  Is this a spawned context
+************************************************************************/
+bool CScriptScheduler::isSpawn( asIScriptContext * pContext ) const
+{
+    return !m_spawnMap.empty() && (m_spawnMap.find( pContext ) != m_spawnMap.end());
+}
+
+/************************************************************************
+*    DESC:  Release the wait state of the context and wake up the
+*           contexts waiting for it to finish
+*           NOTE: Called when the context is recycled
+************************************************************************/
+void CScriptScheduler::release( asIScriptContext * pContext )
+{
+    m_waitMap.erase( pContext );
+
+    auto spawnIter = m_spawnMap.find( pContext );
+    if( spawnIter != m_spawnMap.end() )
+    {
+        const uint32_t spawnId = spawnIter->second;
+
+        m_spawnIdMap.erase( spawnId );
+        m_spawnMap.erase( spawnIter );
+
+        auto waitIter = m_spawnWaitMap.find( spawnId );
+        if( waitIter != m_spawnWaitMap.end() )
+        {
+            wake( waitIter->second );
+            m_spawnWaitMap.erase( waitIter );
+        }
+    }
+}
+
+/************************************************************************
+*    DESC:  Is this the thread the scheduled contexts run on
+*           Parallel updates defer their waits to the sync point
+************************************************************************/
+bool CScriptScheduler::isSchedulerThread() const
+{
+    return (std::this_thread::get_id() == m_threadId) || CScriptParallel::isParallel();
+}
+
+/************************************************************************
+*    DESC:  Clear all the waits and spawn ids
+************************************************************************/
+void CScriptScheduler::clear()
+{
+    m_waitMap.clear();
+    m_timeWheel.clear();
+    m_frameWheel.clear();
+    m_eventWaitMap.clear();
+    m_spawnWaitMap.clear();
+    m_spawnMap.clear();
+    m_spawnIdMap.clear();
+}
+
+/************************************************************************
+*    DESC:  Start a new wait for the context. Any prior wait is dropped
+************************************************************************/
+uint32_t CScriptScheduler::addWait( asIScriptContext * pContext )
+{
+    m_waitMap[pContext] = ++m_serial;
+
+    return m_serial;
+}
+
+/************************************************************************
+*    DESC:  Wake up the context if it's still on the same wait
+************************************************************************/
+void CScriptScheduler::wake( asIScriptContext * pContext, const uint32_t serial )
+{
+    auto iter = m_waitMap.find( pContext );
+    if( (iter != m_waitMap.end()) && (iter->second == serial) )
+        m_waitMap.erase( iter );
+}
+
+void CScriptScheduler::wake( std::vector<SWaitEntry> & rWaitVec )
+{
+    for( auto & iter : rWaitVec )
+        wake( iter.pContext, iter.serial );
+}
@@ -0,0 +1,123 @@
+
+/************************************************************************
+*    FILE NAME:       scriptscheduler.h
+*
+*    DESCRIPTION:     Keeps track of the script contexts waiting on
+*                     time, frames, events or other spawned scripts
+*                     so only the contexts that are ready get resumed
+************************************************************************/
+
+#pragma once
+
+// Game lib dependencies
+#include <script/scripttimerwheel.h>
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <thread>
+
+// Forward declaration(s)
+class asIScriptContext;
+
+class CScriptScheduler : boost::noncopyable
+{
+public:
+
+    // Get the instance of the singleton class
+    static CScriptScheduler & Instance()
+    {
+        static CScriptScheduler scriptScheduler;
+        return scriptScheduler;
+    }
+
+    // Wait for the time in milliseconds
+    void waitMs( asIScriptContext * pContext, const double time );
+
+    // Wait for the number of frames
+    void waitFrames( asIScriptContext * pContext, const uint32_t frames );
+
+    // Wait for the event type to be queued
+    void waitEvent( asIScriptContext * pContext, const uint32_t type );
+
+    // Wait for the spawned script to finish. Returns false if it's not running
+    bool waitUntil( asIScriptContext * pContext, const uint32_t spawnId );
+
+    // Wake up the contexts waiting on this event type
+    void signalEvent( const uint32_t type );
+
+    // Advance the timers and wake up the contexts that are due
+    void update();
+
+    // Is this context waiting. Waiting contexts are not resumed
+    bool isWaiting( asIScriptContext * pContext ) const;
+
+    // Give the spawned context an id other scripts can wait on
+    uint32_t addSpawn( asIScriptContext * pContext );
+
+    // Is this a spawned context
+    bool isSpawn( asIScriptContext * pContext ) const;
+
+    // Release the wait state of the context and wake up the contexts waiting for it to finish
+    void release( asIScriptContext * pContext );
+
+    // Is this the thread the scheduled contexts run on
+    bool isSchedulerThread() const;
+
+    // Clear all the waits and spawn ids
+    void clear();
+
+private:
+
+    struct SWaitEntry
+    {
+        asIScriptContext * pContext;
+        uint32_t serial;
+    };
+
+    // Constructor
+    CScriptScheduler();
+
+    // Start a new wait for the context. Any prior wait is dropped
+    uint32_t addWait( asIScriptContext * pContext );
+
+    // Wake up the context if it's still on the same wait
+    void wake( asIScriptContext * pContext, const uint32_t serial );
+
+    // Wake up all the contexts in the list
+    void wake( std::vector<SWaitEntry> & rWaitVec );
+
+private:
+
+    // Waiting contexts and the serial of the wait they are on.
+    // Entries left in the wheels and lists by a prior wait don't match the serial
+    std::unordered_map<asIScriptContext *, uint32_t> m_waitMap;
+
+    // Contexts waiting on time in milliseconds and on frames
+    CScriptTimerWheel m_timeWheel;
+    CScriptTimerWheel m_frameWheel;
+
+    // Contexts waiting on event types
+    std::unordered_map<uint32_t, std::vector<SWaitEntry>> m_eventWaitMap;
+
+    // Contexts waiting on spawned scripts to finish
+    std::unordered_map<uint32_t, std::vector<SWaitEntry>> m_spawnWaitMap;
+
+    // Spawned contexts and their ids
+    std::unordered_map<asIScriptContext *, uint32_t> m_spawnMap;
+    std::unordered_map<uint32_t, asIScriptContext *> m_spawnIdMap;
+
+    // Expired timer wheel entries
+    std::vector<CScriptTimerWheel::SEntry> m_expiredVec;
+
+    // Wait serial and spawn id counters
+    uint32_t m_serial = 0;
+    uint32_t m_spawnId = 0;
+
+    // The thread the scheduled contexts run on
+    std::thread::id m_threadId;
+};
@@ -11,11 +11,11 @@
 // Game lib dependencies
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
 #include <utilities/exceptionhandling.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
-#include <autowrapper/aswrappedcall.h>
 
 namespace NScriptScriptManager
 {
@@ -38,6 +38,25 @@ namespace NScriptScriptManager
         }
     }
     
+    /************************************************************************
+    *    DESC:  Read the script group on a background thread ahead of loading it
+    ************************************************************************/
+    void PreloadGroup( const std::string & group, CScriptMgr & rScriptMgr )
+    {
+        try
+        {
+            rScriptMgr.preloadGroup( group );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+    }
+    
     /************************************************************************
     *    DESC:  Free the script group                                                            
     ************************************************************************/
@@ -57,6 +76,25 @@ namespace NScriptScriptManager
         }
     }
     
+    /************************************************************************
+    *    DESC:  Stop the profiler and save the folded stacks
+    ************************************************************************/
+    void StopProfiler( const std::string & foldedFilePath, CScriptMgr & rScriptMgr )
+    {
+        try
+        {
+            rScriptMgr.stopProfiler( foldedFilePath );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+    }
+    
     /************************************************************************
     *    DESC:  Clear all the scripts
     ************************************************************************/
@@ -88,10 +126,14 @@ namespace NScriptScriptManager
         // Register type
         Throw( pEngine->RegisterObjectType( "CScriptMgr", 0, asOBJ_REF|asOBJ_NOCOUNT) );
         
-        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void loadGroup(string &in)",       WRAP_OBJ_LAST(LoadGroup),       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void freeGroup(string &in)",       WRAP_OBJ_LAST(FreeGroup),       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void clear()",                     WRAP_OBJ_LAST(Clear),           asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void setMaxPoolPercentage(float)", WRAP_MFN(CScriptMgr, setMaxPoolPercentage), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void loadGroup(string &in)",       SCRIPT_OBJ_LAST(LoadGroup)) );
+        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void preloadGroup(string &in)",    SCRIPT_OBJ_LAST(PreloadGroup)) );
+        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void freeGroup(string &in)",       SCRIPT_OBJ_LAST(FreeGroup)) );
+        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void clear()",                     SCRIPT_OBJ_LAST(Clear)) );
+        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void setMaxPoolPercentage(float)", SCRIPT_MFN(CScriptMgr, setMaxPoolPercentage)) );
+        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void collectGarbage(bool full = false)", SCRIPT_MFN(CScriptMgr, collectGarbage)) );
+        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void startProfiler(uint interval = 1000, uint top = 3)", SCRIPT_MFN(CScriptMgr, startProfiler)) );
+        Throw( pEngine->RegisterObjectMethod("CScriptMgr", "void stopProfiler(string &in file = \"\")",             SCRIPT_OBJ_LAST(StopProfiler)) );
         
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CScriptMgr ScriptMgr", &CScriptMgr::Instance()) );
@@ -16,6 +16,8 @@
 #include <physics/iphysicscomponent.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
+#include <script/scriptparallel.h>
 #include <utilities/genfunc.h>
 #include <node/inode.h>
 
@@ -24,7 +26,6 @@
 
 // AngelScript lib dependencies
 #include <angelscript.h>
-#include <autowrapper/aswrappedcall.h>
 
 namespace NScriptSprite
 {
@@ -35,7 +36,7 @@ namespace NScriptSprite
     /************************************************************************
     *    DESC:  Wrapper functions
     ************************************************************************/
-    const CSize<float> & GetSize(CSprite & sprite)
+    CSize<float> GetSize(CSprite & sprite)
     {
         auto component = sprite.getVisualComponent();
         if( component != nullptr )
@@ -230,9 +231,13 @@ namespace NScriptSprite
         auto component = sprite.getPhysicsComponent();
         if( component != nullptr )
         {
-            component->setTransform( x, y, angle, resetVelocity );
-            if( component->isBodyTypeStatic() )
-                sprite.setPos(x, y, sprite.getPos().z);
+            // Moving the body changes the physics world so parallel scripts defer it
+            CScriptParallel::Instance().defer( [=, &sprite]()
+            {
+                component->setTransform( x, y, angle, resetVelocity );
+                if( component->isBodyTypeStatic() )
+                    sprite.setPos(x, y, sprite.getPos().z);
+            } );
         }
         else
             NGenFunc::PostDebugMsg( "WARNING: Physics component does not exist." );
@@ -269,7 +274,7 @@ namespace NScriptSprite
     {
         auto component = sprite.getPhysicsComponent();
         if( component != nullptr )
-            component->setActive( value );
+            CScriptParallel::Instance().defer( [component, value]() { component->setActive( value ); } );
         else
             NGenFunc::PostDebugMsg( "WARNING: Physics component does not exist." );
     }
@@ -414,104 +419,104 @@ namespace NScriptSprite
         // Register type
         Throw( pEngine->RegisterObjectType( "CSprite", 0, asOBJ_REF|asOBJ_NOCOUNT) );
         Throw( pEngine->RegisterObjectType( "CObject", 0, asOBJ_REF|asOBJ_NOCOUNT) );
-        Throw( pEngine->RegisterObjectType( "handle", sizeof(uint16_t), asOBJ_VALUE|asOBJ_POD) );
+        Throw( pEngine->RegisterObjectType( "handle", sizeof(uint16_t), asOBJ_VALUE|asOBJ_POD|asOBJ_APP_PRIMITIVE) );
 
         // Visual component functions
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setColor(const CColor &in)",                  WRAP_OBJ_LAST(SetColor1),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setColor(float, float, float, float)",        WRAP_OBJ_LAST(SetColor2),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "const CColor & getColor() const",                  WRAP_OBJ_LAST(GetColor),         asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setDefaultColor()",                           WRAP_OBJ_LAST(SetDefaultColor),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "const CColor & getDefaultColor() const",           WRAP_OBJ_LAST(GetDefaultColor),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setAlpha(float, bool allowToExceed = false)", WRAP_OBJ_LAST(SetAlpha),         asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "float getAlpha() const",                           WRAP_OBJ_LAST(GetAlpha),         asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setDefaultAlpha()",                           WRAP_OBJ_LAST(SetDefaultAlpha),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "float getDefaultAlpha() const",                    WRAP_OBJ_LAST(GetDefaultAlpha),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void createFontString(string &in)",                WRAP_OBJ_LAST(CreateFontString), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "const string & getFontString() const",             WRAP_OBJ_LAST(GetFontString),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "bool isFontSprite() const",                        WRAP_OBJ_LAST(IsFontSprite),     asCALL_GENERIC) );
-
-        Throw( pEngine->RegisterObjectMethod("CSprite", "int getId()",                                      WRAP_OBJ_LAST(GetSpriteId),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "handle getHandle()",                               WRAP_OBJ_LAST(GetSpriteHandle),  asCALL_GENERIC) );
-
-        Throw( pEngine->RegisterObjectMethod("CObject", "int getId()",                                      WRAP_OBJ_LAST(GetObjectId),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "handle getHandle()",                               WRAP_OBJ_LAST(GetObjectHandle),  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setColor(const CColor &in)",                  SCRIPT_OBJ_LAST(SetColor1)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setColor(float, float, float, float)",        SCRIPT_OBJ_LAST(SetColor2)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "const CColor & getColor() const",                  SCRIPT_OBJ_LAST(GetColor)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setDefaultColor()",                           SCRIPT_OBJ_LAST(SetDefaultColor)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "const CColor & getDefaultColor() const",           SCRIPT_OBJ_LAST(GetDefaultColor)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setAlpha(float, bool allowToExceed = false)", SCRIPT_OBJ_LAST(SetAlpha)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "float getAlpha() const",                           SCRIPT_OBJ_LAST(GetAlpha)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setDefaultAlpha()",                           SCRIPT_OBJ_LAST(SetDefaultAlpha)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "float getDefaultAlpha() const",                    SCRIPT_OBJ_LAST(GetDefaultAlpha)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void createFontString(string &in)",                SCRIPT_OBJ_LAST(CreateFontString)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "const string & getFontString() const",             SCRIPT_OBJ_LAST(GetFontString)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "bool isFontSprite() const",                        SCRIPT_OBJ_LAST(IsFontSprite)) );
+
+        Throw( pEngine->RegisterObjectMethod("CSprite", "int getId()",                                      SCRIPT_OBJ_LAST(GetSpriteId)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "handle getHandle()",                               SCRIPT_OBJ_LAST(GetSpriteHandle)) );
+
+        Throw( pEngine->RegisterObjectMethod("CObject", "int getId()",                                      SCRIPT_OBJ_LAST(GetObjectId)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "handle getHandle()",                               SCRIPT_OBJ_LAST(GetObjectHandle)) );
 
         // Sprite specific functions
-        Throw( pEngine->RegisterObjectMethod("CSprite", "CSize getSize() const",                               WRAP_OBJ_LAST(GetSize),             asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "uint getFrameCount() const",                          WRAP_MFN(CSprite, getFrameCount),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setFrame(uint)",                                 WRAP_MFN(CSprite, setFrame),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "uint getCurrentFrame() const",                        WRAP_MFN(CSprite, getCurrentFrame), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "CSize getSize() const",                               SCRIPT_OBJ_LAST(GetSize)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "uint getFrameCount() const",                          SCRIPT_MFN(CSprite, getFrameCount)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setFrame(uint)",                                 SCRIPT_MFN(CSprite, setFrame)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "uint getCurrentFrame() const",                        SCRIPT_MFN(CSprite, getCurrentFrame)) );
 
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setVisible(bool)",                               WRAP_MFN(CSprite, setVisible),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "bool isVisible() const",                              WRAP_MFN(CSprite, isVisible),    asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setVisible(bool)",                               SCRIPT_MFN(CSprite, setVisible)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "bool isVisible() const",                              SCRIPT_MFN(CSprite, isVisible)) );
 
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setPos(CPoint &in)",                             WRAP_OBJ_LAST(SetSpritePos1),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setPos(float x = 0, float y = 0, float z = 0)",  WRAP_OBJ_LAST(SetSpritePos2),      asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setPos(CPoint &in)",                             SCRIPT_OBJ_LAST(SetSpritePos1)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setPos(float x = 0, float y = 0, float z = 0)",  SCRIPT_OBJ_LAST(SetSpritePos2)) );
 
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void incPos(CPoint & in)",                            WRAP_OBJ_LAST(IncSpritePos1),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void incPos(float x = 0, float y = 0, float z = 0)",  WRAP_OBJ_LAST(IncSpritePos2),      asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void incPos(CPoint & in)",                            SCRIPT_OBJ_LAST(IncSpritePos1)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void incPos(float x = 0, float y = 0, float z = 0)",  SCRIPT_OBJ_LAST(IncSpritePos2)) );
 
-        Throw( pEngine->RegisterObjectMethod("CSprite", "const CPoint & getPos() const",                       WRAP_MFN(CSprite, getPos),       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "const CPoint & getTransPos() const",                  WRAP_MFN(CSprite, getTransPos),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "const CPoint & getCenterPos() const",                 WRAP_MFN(CSprite, getCenterPos), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "const CPoint & getRot() const",                         WRAP_MFN(CSprite, getRot), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "const CPoint & getPos() const",                       SCRIPT_MFN(CSprite, getPos)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "const CPoint & getTransPos() const",                  SCRIPT_MFN(CSprite, getTransPos)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "const CPoint & getCenterPos() const",                 SCRIPT_MFN(CSprite, getCenterPos)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "const CPoint & getRot() const",                         SCRIPT_MFN(CSprite, getRot)) );
 
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setRot(CPoint &in, bool convertToRadians = true)", WRAP_OBJ_LAST(SetSpriteRot1),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", WRAP_OBJ_LAST(SetSpriteRot2), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setRot(CPoint &in, bool convertToRadians = true)", SCRIPT_OBJ_LAST(SetSpriteRot1)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", SCRIPT_OBJ_LAST(SetSpriteRot2)) );
 
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void incRot(CPoint &in, bool convertToRadians = true)", WRAP_OBJ_LAST(IncSpriteRot1), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void incRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", WRAP_OBJ_LAST(IncSpriteRot2), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void incRot(CPoint &in, bool convertToRadians = true)", SCRIPT_OBJ_LAST(IncSpriteRot1)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void incRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", SCRIPT_OBJ_LAST(IncSpriteRot2)) );
 
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setScale(CPoint & in)",                            WRAP_OBJ_LAST(SetSpriteScale1),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setScale(float x = 1, float y = 1, float z = 1)",  WRAP_OBJ_LAST(SetSpriteScale2),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void incScale(CPoint & in)",                            WRAP_OBJ_LAST(IncSpriteScale1),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void incScale(float x = 1, float y = 1, float z = 1)",  WRAP_OBJ_LAST(IncSpriteScale2),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "const CPoint & getScale() const",                       WRAP_MFN(CSprite, getScale),       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "CBitmask & getParameters()",                            WRAP_MFN(CSprite, getParameters),  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setScale(CPoint & in)",                            SCRIPT_OBJ_LAST(SetSpriteScale1)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setScale(float x = 1, float y = 1, float z = 1)",  SCRIPT_OBJ_LAST(SetSpriteScale2)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void incScale(CPoint & in)",                            SCRIPT_OBJ_LAST(IncSpriteScale1)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void incScale(float x = 1, float y = 1, float z = 1)",  SCRIPT_OBJ_LAST(IncSpriteScale2)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "const CPoint & getScale() const",                       SCRIPT_MFN(CSprite, getScale)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "CBitmask & getParameters()",                            SCRIPT_MFN(CSprite, getParameters)) );
 
         // Object specific functions
-        Throw( pEngine->RegisterObjectMethod("CObject", "void setVisible(bool)",                               WRAP_MFN(CObject, setVisible),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "bool isVisible() const",                              WRAP_MFN(CObject, isVisible),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "const CPoint & getRot() const",                       WRAP_MFN(CObject, getRot),         asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "const CPoint & getPos() const",                       WRAP_MFN(CObject, getPos),         asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "const CPoint & getTransPos() const",                  WRAP_MFN(CObject, getTransPos),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "const CPoint & getCenterPos() const",                 WRAP_MFN(CObject, getCenterPos),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "const CPoint & getScale() const",                     WRAP_MFN(CObject, getScale),       asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "CBitmask & getParameters()",                          WRAP_MFN(CObject, getParameters),  asCALL_GENERIC) );
-
-        Throw( pEngine->RegisterObjectMethod("CObject", "void setPos(CPoint &in)",                             WRAP_OBJ_LAST(SetObjectPos1),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "void setPos(float x = 0, float y = 0, float z = 0)",  WRAP_OBJ_LAST(SetObjectPos2),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "void incPos(CPoint & in)",                            WRAP_OBJ_LAST(IncObjectPos1),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "void incPos(float x = 0, float y = 0, float z = 0)",  WRAP_OBJ_LAST(IncObjectPos2),      asCALL_GENERIC) );
-
-        Throw( pEngine->RegisterObjectMethod("CObject", "void setRot(CPoint &in, bool convertToRadians = true)", WRAP_OBJ_LAST(SetObjectRot1),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "void setRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", WRAP_OBJ_LAST(SetObjectRot2), asCALL_GENERIC) );
-
-        Throw( pEngine->RegisterObjectMethod("CObject", "void incRot(CPoint &in, bool convertToRadians = true)", WRAP_OBJ_LAST(IncObjectRot1), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "void incRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", WRAP_OBJ_LAST(IncObjectRot2), asCALL_GENERIC) );
-
-        Throw( pEngine->RegisterObjectMethod("CObject", "void setScale(CPoint & in)",                            WRAP_OBJ_LAST(SetObjectScale1), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "void setScale(float x = 1, float y = 1, float z = 1)",  WRAP_OBJ_LAST(SetObjectScale2), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "void incScale(CPoint & in)",                            WRAP_OBJ_LAST(IncObjectScale1), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "void incScale(float x = 1, float y = 1, float z = 1)",  WRAP_OBJ_LAST(IncObjectScale2), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "void setVisible(bool)",                               SCRIPT_MFN(CObject, setVisible)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "bool isVisible() const",                              SCRIPT_MFN(CObject, isVisible)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "const CPoint & getRot() const",                       SCRIPT_MFN(CObject, getRot)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "const CPoint & getPos() const",                       SCRIPT_MFN(CObject, getPos)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "const CPoint & getTransPos() const",                  SCRIPT_MFN(CObject, getTransPos)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "const CPoint & getCenterPos() const",                 SCRIPT_MFN(CObject, getCenterPos)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "const CPoint & getScale() const",                     SCRIPT_MFN(CObject, getScale)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "CBitmask & getParameters()",                          SCRIPT_MFN(CObject, getParameters)) );
+
+        Throw( pEngine->RegisterObjectMethod("CObject", "void setPos(CPoint &in)",                             SCRIPT_OBJ_LAST(SetObjectPos1)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "void setPos(float x = 0, float y = 0, float z = 0)",  SCRIPT_OBJ_LAST(SetObjectPos2)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "void incPos(CPoint & in)",                            SCRIPT_OBJ_LAST(IncObjectPos1)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "void incPos(float x = 0, float y = 0, float z = 0)",  SCRIPT_OBJ_LAST(IncObjectPos2)) );
+
+        Throw( pEngine->RegisterObjectMethod("CObject", "void setRot(CPoint &in, bool convertToRadians = true)", SCRIPT_OBJ_LAST(SetObjectRot1)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "void setRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", SCRIPT_OBJ_LAST(SetObjectRot2)) );
+
+        Throw( pEngine->RegisterObjectMethod("CObject", "void incRot(CPoint &in, bool convertToRadians = true)", SCRIPT_OBJ_LAST(IncObjectRot1)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "void incRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", SCRIPT_OBJ_LAST(IncObjectRot2)) );
+
+        Throw( pEngine->RegisterObjectMethod("CObject", "void setScale(CPoint & in)",                            SCRIPT_OBJ_LAST(SetObjectScale1)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "void setScale(float x = 1, float y = 1, float z = 1)",  SCRIPT_OBJ_LAST(SetObjectScale2)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "void incScale(CPoint & in)",                            SCRIPT_OBJ_LAST(IncObjectScale1)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "void incScale(float x = 1, float y = 1, float z = 1)",  SCRIPT_OBJ_LAST(IncObjectScale2)) );
 
         // Physics component functions
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void physicsUpdate()",                                                               WRAP_MFN(CSprite, physicsUpdate),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setPhysicsTransform(float, float, float angle = 0, bool resetVelocity = true)", WRAP_OBJ_LAST(SetTransform),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setLinearVelocity(float, float)",                                               WRAP_OBJ_LAST(SetLinearVelocity),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setAngularVelocity(float)",                                                     WRAP_OBJ_LAST(SetAngularVelocity),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void applyAngularImpulse(float, bool wake = false)",                                 WRAP_OBJ_LAST(ApplyAngularImpulse), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setPhysicsActive(bool)",                                                        WRAP_OBJ_LAST(SetActive),           asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setPhysicsAwake(bool)",                                                         WRAP_OBJ_LAST(SetAwake),            asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void physicsUpdate()",                                                               SCRIPT_MFN(CSprite, physicsUpdate)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setPhysicsTransform(float, float, float angle = 0, bool resetVelocity = true)", SCRIPT_OBJ_LAST(SetTransform)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setLinearVelocity(float, float)",                                               SCRIPT_OBJ_LAST(SetLinearVelocity)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setAngularVelocity(float)",                                                     SCRIPT_OBJ_LAST(SetAngularVelocity)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void applyAngularImpulse(float, bool wake = false)",                                 SCRIPT_OBJ_LAST(ApplyAngularImpulse)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setPhysicsActive(bool)",                                                        SCRIPT_OBJ_LAST(SetActive)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setPhysicsAwake(bool)",                                                         SCRIPT_OBJ_LAST(SetAwake)) );
 
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void setPhysicsContactFilter(uint16 a=1, uint16 b=0xFFFF, int16 c=0, int d=-1)",     WRAP_OBJ_LAST(SetContactFilter),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void destroyPhysics()",                                                              WRAP_MFN(CSprite, destroyPhysics),  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void setPhysicsContactFilter(uint16 a=1, uint16 b=0xFFFF, int16 c=0, int d=-1)",     SCRIPT_OBJ_LAST(SetContactFilter)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void destroyPhysics()",                                                              SCRIPT_OBJ_LAST(NScriptParallel::SDefer<&CSprite::destroyPhysics>::call)) );
 
         // Script specific functions
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void update()",                                   WRAP_MFN(CSprite,   update),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "bool prepare(string &in, bool f = false)",        WRAP_MFN(CSprite,   prepare),         asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "bool stopAndRecycle(string &in)",                 WRAP_MFN(CSprite,   stopAndRecycle),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "bool stopAndRestart(string &in, bool f = false)", WRAP_MFN(CSprite,   stopAndRestart),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CSprite", "void resetAndRecycle()",                          WRAP_OBJ_LAST(ScriptResetAndRecycle), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void update()",                                   SCRIPT_MFN(CSprite,   update)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "bool prepare(string &in, bool f = false)",        SCRIPT_MFN(CSprite,   prepare)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "bool stopAndRecycle(string &in)",                 SCRIPT_MFN(CSprite,   stopAndRecycle)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "bool stopAndRestart(string &in, bool f = false)", SCRIPT_MFN(CSprite,   stopAndRestart)) );
+        Throw( pEngine->RegisterObjectMethod("CSprite", "void resetAndRecycle()",                          SCRIPT_OBJ_LAST(ScriptResetAndRecycle)) );
     }
 }
\ No newline at end of file
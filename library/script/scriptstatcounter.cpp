@@ -12,10 +12,10 @@
 #include <utilities/statcounter.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
-#include <autowrapper/aswrappedcall.h>
 
 namespace NScriptStatCounter
 {
@@ -31,7 +31,7 @@ namespace NScriptStatCounter
         // Register type
         Throw( pEngine->RegisterObjectType( "CStatCounter", 0, asOBJ_REF|asOBJ_NOCOUNT) );
         
-        Throw( pEngine->RegisterObjectMethod("CStatCounter", "void incCycle()",  WRAP_MFN(CStatCounter, incCycle), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CStatCounter", "void incCycle()",  SCRIPT_MFN(CStatCounter, incCycle)) );
 
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CStatCounter StatCounter", &CStatCounter::Instance()) );
@@ -14,15 +14,18 @@
 #include <strategy/strategyloader.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
+#include <script/scriptparallel.h>
 #include <utilities/exceptionhandling.h>
 #include <system/device.h>
 #include <node/inode.h>
 #include <sprite/sprite.h>
 #include <common/point.h>
+#include <common/rect.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
-#include <autowrapper/aswrappedcall.h>
+#include <scriptarray/scriptarray.h>
 
 namespace NScriptStrategy
 {
@@ -72,6 +75,9 @@ namespace NScriptStrategy
     ************************************************************************/
     iNode * Create( const std::string & id, const std::string & instance, bool active, const std::string & group, CStrategy & rStrategy )
     {
+        // Parallel scripts take turns creating
+        auto lock = CScriptParallel::Instance().serialize();
+
         try
         {
             return rStrategy.create( id, instance, active, group );
@@ -87,6 +93,17 @@ namespace NScriptStrategy
         
         return nullptr;
     }
+
+    /************************************************************************
+    *    DESC:  Activate the node
+    ************************************************************************/
+    iNode * ActivateNode( const std::string & instanceName, CStrategy & rStrategy )
+    {
+        // Parallel scripts take turns activating
+        auto lock = CScriptParallel::Instance().serialize();
+
+        return rStrategy.activateNode( instanceName );
+    }
     
     /************************************************************************
     *    DESC:  Create a basic sprite strategy                                                            
@@ -134,6 +151,137 @@ namespace NScriptStrategy
         return pStrategy;
     }
 
+    /************************************************************************
+    *    DESC:  Enable the spatial index of the strategy
+    ************************************************************************/
+    void EnableSpatialIndex( float cellSize, CStrategy & rStrategy )
+    {
+        try
+        {
+            rStrategy.enableSpatialIndex( cellSize );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  Return the nodes as a script array
+    ************************************************************************/
+    void SetReturnNodeArray( asIScriptGeneric * pScriptGen, const std::vector<iNode *> & pNodeVec )
+    {
+        // Get a pointer to type declaration
+        asITypeInfo * arrayType = CScriptMgr::Instance().getPtrToTypeInfo( "array<iNode@>" );
+
+        CScriptArray* ary = CScriptArray::Create(arrayType, pNodeVec.size());
+        for( std::size_t i = 0; i < pNodeVec.size(); ++i )
+        {
+            iNode * pNode = pNodeVec[i];
+            ary->SetValue(i, &pNode);
+        }
+
+        // Set the return value. Setting the handle adds a reference so release ours
+        pScriptGen->SetReturnObject( ary );
+        ary->Release();
+    }
+
+    /************************************************************************
+    *    DESC:  Get the active nodes in the rect
+    *    PARAM: float x1, float y1, float x2, float y2
+    ************************************************************************/
+    void GetNodesInRect( asIScriptGeneric * pScriptGen )
+    {
+        CStrategy * pStrategy = (CStrategy *)pScriptGen->GetObject();
+
+        const CRect<float> rect(
+            pScriptGen->GetArgFloat(0),
+            pScriptGen->GetArgFloat(1),
+            pScriptGen->GetArgFloat(2),
+            pScriptGen->GetArgFloat(3) );
+
+        try
+        {
+            SetReturnNodeArray( pScriptGen, pStrategy->getNodesInRect( rect ) );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  Get the active nodes in the radius
+    *    PARAM: CPoint pos, float radius
+    ************************************************************************/
+    void GetNodesInRadius( asIScriptGeneric * pScriptGen )
+    {
+        CStrategy * pStrategy = (CStrategy *)pScriptGen->GetObject();
+        const CPoint<float> * pPos = (CPoint<float> *)pScriptGen->GetArgObject(0);
+        const float radius = pScriptGen->GetArgFloat(1);
+
+        try
+        {
+            SetReturnNodeArray( pScriptGen, pStrategy->getNodesInRadius( *pPos, radius ) );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+    }
+
+    /************************************************************************
+    *    DESC:  Get the active node nearest to the point
+    ************************************************************************/
+    iNode * GetNearestNode( const CPoint<float> & pos, float maxDist, CStrategy & rStrategy )
+    {
+        try
+        {
+            return rStrategy.getNearestNode( pos, maxDist );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+
+        return nullptr;
+    }
+
+    /************************************************************************
+    *    DESC:  Set the policy of which active nodes get updated
+    ************************************************************************/
+    void SetActivityPolicy( const std::string & policy, float distance, int farTickRate, CStrategy & rStrategy )
+    {
+        try
+        {
+            rStrategy.setActivityPolicy( policy, distance, farTickRate );
+        }
+        catch( NExcept::CCriticalException & ex )
+        {
+            asGetActiveContext()->SetException(ex.getErrorMsg().c_str());
+        }
+        catch( std::exception const & ex )
+        {
+            asGetActiveContext()->SetException(ex.what());
+        }
+    }
+
     iNode * GetiNodeFromSprite(CSprite & sprite)
     {
         return dynamic_cast<iNode *>(&sprite);
@@ -143,6 +291,12 @@ namespace NScriptStrategy
     {
         return dynamic_cast<iNode *>(&object);
     }
+
+    // The node type is a byte but the script needs an int returned
+    int GetNodeType(iNode & node)
+    {
+        return (int)node.getType();
+    }
     
     /************************************************************************
     *    DESC:  Register the class with AngelScript
@@ -157,54 +311,65 @@ namespace NScriptStrategy
         Throw( pEngine->RegisterObjectType( "iNode", 0, asOBJ_REF|asOBJ_NOCOUNT) );
 
         // iNode specific functions
-        Throw( pEngine->RegisterObjectMethod("iNode", "CSprite & getSprite()",            WRAP_MFN(iNode, getSprite),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("iNode", "CObject & getObject()",            WRAP_MFN(iNode, getObject),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("iNode", "uiControl & getControl()",         WRAP_MFN(iNode, getControl),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("iNode", "iNode & next()",                   WRAP_MFN(iNode, next),           asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("iNode", "int getType()",                    WRAP_MFN(iNode, getType),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("iNode", "int getId()",                      WRAP_MFN(iNode, getId),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("iNode", "handle getHandle()",               WRAP_MFN(iNode, getHandle),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("iNode", "iNode & getChildNode(string &in)", WRAP_MFN(iNode, getChildNode),   asCALL_GENERIC) );
-
-        Throw( pEngine->RegisterObjectMethod("CSprite", "iNode & getNode()",                                     WRAP_OBJ_LAST(GetiNodeFromSprite), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CObject", "iNode & getNode()",                                   WRAP_OBJ_LAST(GetiNodeFromObject), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("iNode", "CSprite & getSprite()",            SCRIPT_MFN(iNode, getSprite)) );
+        Throw( pEngine->RegisterObjectMethod("iNode", "CObject & getObject()",            SCRIPT_MFN(iNode, getObject)) );
+        Throw( pEngine->RegisterObjectMethod("iNode", "uiControl & getControl()",         SCRIPT_MFN(iNode, getControl)) );
+        Throw( pEngine->RegisterObjectMethod("iNode", "iNode & next()",                   SCRIPT_MFN(iNode, next)) );
+        Throw( pEngine->RegisterObjectMethod("iNode", "int getType()",                    SCRIPT_OBJ_LAST(GetNodeType)) );
+        Throw( pEngine->RegisterObjectMethod("iNode", "int getId()",                      SCRIPT_MFN(iNode, getId)) );
+        Throw( pEngine->RegisterObjectMethod("iNode", "handle getHandle()",               SCRIPT_MFN(iNode, getHandle)) );
+        Throw( pEngine->RegisterObjectMethod("iNode", "iNode & getChildNode(string &in)", SCRIPT_MFN(iNode, getChildNode)) );
+
+        Throw( pEngine->RegisterObjectMethod("CSprite", "iNode & getNode()",                                     SCRIPT_OBJ_LAST(GetiNodeFromSprite)) );
+        Throw( pEngine->RegisterObjectMethod("CObject", "iNode & getNode()",                                   SCRIPT_OBJ_LAST(GetiNodeFromObject)) );
 
         // Register type
         Throw( pEngine->RegisterObjectType("Strategy", 0, asOBJ_REF|asOBJ_NOCOUNT) );
 
-        Throw( pEngine->RegisterObjectMethod("Strategy", "void setCommandBuffer(string &in)",           WRAP_OBJ_LAST(SetCommandBuffer), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("Strategy", "iNode & create(string &in, string &in = '', bool active = true, string &in = '')", WRAP_OBJ_LAST(Create), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("Strategy", "void destroy(handle)",                        WRAP_MFN(CStrategy, destroy),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("Strategy", "void setCamera(string &in)",                  WRAP_MFN(CStrategy, setCamera),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("Strategy", "iNode & getNode(string &in)",                 WRAP_OBJ_LAST(GetNode),    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("Strategy", "iNode & activateNode(string &in)",            WRAP_MFN(CStrategy, activateNode),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("Strategy", "void deactivateNode(string &in)",             WRAP_MFN(CStrategy, deactivateNode),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("Strategy", "void clear()",                                WRAP_MFN(CStrategy, clear),  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "void setCommandBuffer(string &in)",           SCRIPT_OBJ_LAST(SetCommandBuffer)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "iNode & create(string &in, string &in = '', bool active = true, string &in = '')", SCRIPT_OBJ_LAST(Create)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "void destroy(handle)",                        SCRIPT_OBJ_LAST(NScriptParallel::SDefer<&CStrategy::destroy>::call)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "void setCamera(string &in)",                  SCRIPT_MFN(CStrategy, setCamera)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "iNode & getNode(string &in)",                 SCRIPT_OBJ_LAST(GetNode)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "iNode & activateNode(string &in)",            SCRIPT_OBJ_LAST(ActivateNode)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "void deactivateNode(string &in)",             SCRIPT_OBJ_LAST(NScriptParallel::SDefer<&CStrategy::deactivateNode>::call)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "void clear()",                                SCRIPT_OBJ_LAST(NScriptParallel::SDefer<&CStrategy::clear>::call)) );
+
+        // Spatial index area queries. Positions are in the local space of the strategy
+        Throw( pEngine->RegisterObjectMethod("Strategy", "void enableSpatialIndex(float cellSize = 0)",                SCRIPT_OBJ_LAST(EnableSpatialIndex)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "array<iNode@> @ getNodesInRect(float, float, float, float)", asFUNCTION(GetNodesInRect),      asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "array<iNode@> @ getNodesInRadius(CPoint &in, float)",        asFUNCTION(GetNodesInRadius),    asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "iNode @ getNearestNode(CPoint &in, float maxDist = -1)",     SCRIPT_OBJ_LAST(GetNearestNode)) );
+
+        // Activity policy. Dormant nodes run their "wake" script function when they come back in the region
+        Throw( pEngine->RegisterObjectMethod("Strategy", "void setActivityPolicy(string &in, float distance = 0, int farTickRate = 0)", SCRIPT_OBJ_LAST(SetActivityPolicy)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "void setActivityFocus(CPoint &in)",                                          SCRIPT_MFN(CStrategy, setActivityFocus)) );
+        Throw( pEngine->RegisterObjectMethod("Strategy", "void clearActivityFocus()",                                                  SCRIPT_MFN(CStrategy, clearActivityFocus)) );
         
         // Register type
         Throw( pEngine->RegisterObjectType( "CStrategyMgr", 0, asOBJ_REF|asOBJ_NOCOUNT) );
         
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void loadListTable(string &in)",                WRAP_MFN(CStrategyMgr, loadListTable),         asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void loadListTable(string &in)",                SCRIPT_MFN(CStrategyMgr, loadListTable)) );
         
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "Strategy & createActorStrategy(string &in)",    WRAP_OBJ_LAST(CreateStrategy),            asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "Strategy & activateStrategy(string &in)",       WRAP_MFN(CStrategyMgr, activateStrategy),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void activateStrategyAry(array<string> &in)",   WRAP_MFN(CStrategyMgr, activateStrategyAry),   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deactivateStrategy(string &in)",           WRAP_MFN(CStrategyMgr, deactivateStrategy),    asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "Strategy & createActorStrategy(string &in)",    SCRIPT_OBJ_LAST(CreateStrategy)) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "Strategy & activateStrategy(string &in)",       SCRIPT_MFN(CStrategyMgr, activateStrategy)) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void activateStrategyAry(array<string> &in)",   SCRIPT_MFN(CStrategyMgr, activateStrategyAry)) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deactivateStrategy(string &in)",           SCRIPT_MFN(CStrategyMgr, deactivateStrategy)) );
 
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deactivateStrategyAry(array<string> &in)", WRAP_MFN(CStrategyMgr, deactivateStrategyAry), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deactivateStrategyAry(array<string> &in)", SCRIPT_MFN(CStrategyMgr, deactivateStrategyAry)) );
 
 
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "Strategy & getStrategy(string &in)",            WRAP_OBJ_LAST(GetStrategy),                    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deleteStrategy(string &in)",               WRAP_MFN(CStrategyMgr, deleteStrategy),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deleteStrategyAry(array<string> &in)",     WRAP_MFN(CStrategyMgr, deleteStrategyAry),     asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "Strategy & getStrategy(string &in)",            SCRIPT_OBJ_LAST(GetStrategy)) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deleteStrategy(string &in)",               SCRIPT_MFN(CStrategyMgr, deleteStrategy)) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void deleteStrategyAry(array<string> &in)",     SCRIPT_MFN(CStrategyMgr, deleteStrategyAry)) );
 
 
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void update()",                                 WRAP_MFN(CStrategyMgr, update),                asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void transform()",                              WRAP_MFN(CStrategyMgr, transform),             asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void clear()",                                  WRAP_MFN(CStrategyMgr, clear),                 asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void update()",                                 SCRIPT_MFN(CStrategyMgr, update)) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void transform()",                              SCRIPT_MFN(CStrategyMgr, transform)) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void clear()",                                  SCRIPT_MFN(CStrategyMgr, clear)) );
 
         // Load the strategy
-        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void loadStrategy(string &in)",                 WRAP_MFN(CStrategyloader, load),               asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CStrategyMgr", "void loadStrategy(string &in)",                 SCRIPT_MFN(CStrategyloader, load)) );
 
         // Set this object registration as a global property to simulate a singleton
         Throw( pEngine->RegisterGlobalProperty("CStrategyMgr StrategyMgr", &CStrategyMgr::Instance()) );
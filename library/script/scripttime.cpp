@@ -13,13 +13,13 @@
 #include <utilities/timeduration.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
 
 // Standard lib dependencies
 #include <sstream>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
-#include <autowrapper/aswrappedcall.h>
 
 namespace NScriptTime
 {
@@ -227,78 +227,78 @@ namespace NScriptTime
         
         // Register type
         Throw( pEngine->RegisterObjectType("CTimePoint",    sizeof(CTimePoint),    asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<CTimePoint>() ) );
-        Throw( pEngine->RegisterObjectType("CTimeDuration", sizeof(CTimeDuration), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<CTimePoint>() ) );
+        Throw( pEngine->RegisterObjectType("CTimeDuration", sizeof(CTimeDuration), asOBJ_VALUE | asOBJ_POD | asGetTypeTraits<CTimeDuration>() ) );
 
         // Register the object operator overloads
-        Throw( pEngine->RegisterObjectBehaviour("CTimePoint", asBEHAVE_CONSTRUCT, "void f()",                      WRAP_OBJ_LAST(ConstructorTP),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CTimePoint", asBEHAVE_CONSTRUCT, "void f(const CTimePoint & in)", WRAP_OBJ_LAST(CopyConstructorTP), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CTimePoint", asBEHAVE_CONSTRUCT, "void f(const CTimeDuration & in)", WRAP_OBJ_LAST(CopyConstructorTDtoTP), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectBehaviour("CTimePoint", asBEHAVE_CONSTRUCT, "void f()",                      SCRIPT_OBJ_LAST(ConstructorTP)) );
+        Throw( pEngine->RegisterObjectBehaviour("CTimePoint", asBEHAVE_CONSTRUCT, "void f(const CTimePoint & in)", SCRIPT_OBJ_LAST(CopyConstructorTP)) );
+        Throw( pEngine->RegisterObjectBehaviour("CTimePoint", asBEHAVE_CONSTRUCT, "void f(const CTimeDuration & in)", SCRIPT_OBJ_LAST(CopyConstructorTDtoTP)) );
 
-        Throw( pEngine->RegisterObjectBehaviour("CTimePoint", asBEHAVE_CONSTRUCT, "void f(int64)", WRAP_OBJ_LAST(CopyConstructorTPInt64), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectBehaviour("CTimePoint", asBEHAVE_CONSTRUCT, "void f(int64)", SCRIPT_OBJ_LAST(CopyConstructorTPInt64)) );
 
-        Throw( pEngine->RegisterObjectBehaviour("CTimeDuration", asBEHAVE_CONSTRUCT, "void f()",                         WRAP_OBJ_LAST(ConstructorTD),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CTimeDuration", asBEHAVE_CONSTRUCT, "void f(const CTimeDuration & in)", WRAP_OBJ_LAST(CopyConstructorTD), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CTimeDuration", asBEHAVE_CONSTRUCT, "void f(int64)",                 WRAP_OBJ_LAST(CopyConstructorTDInt64), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectBehaviour("CTimeDuration", asBEHAVE_CONSTRUCT, "void f()",                         SCRIPT_OBJ_LAST(ConstructorTD)) );
+        Throw( pEngine->RegisterObjectBehaviour("CTimeDuration", asBEHAVE_CONSTRUCT, "void f(const CTimeDuration & in)", SCRIPT_OBJ_LAST(CopyConstructorTD)) );
+        Throw( pEngine->RegisterObjectBehaviour("CTimeDuration", asBEHAVE_CONSTRUCT, "void f(int64)",                 SCRIPT_OBJ_LAST(CopyConstructorTDInt64)) );
 
-        Throw( pEngine->RegisterObjectBehaviour("CTimeDuration", asBEHAVE_CONSTRUCT, "void f(int64,int64,int64,int64)", WRAP_OBJ_LAST(CopyConstructorTDSet), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectBehaviour("CTimeDuration", asBEHAVE_CONSTRUCT, "void f(int64,int64,int64,int64)", SCRIPT_OBJ_LAST(CopyConstructorTDSet)) );
 
-        Throw( pEngine->RegisterObjectBehaviour("CTimePoint", asBEHAVE_DESTRUCT,  "void f()",                         WRAP_OBJ_LAST(DestructorTP),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CTimeDuration", asBEHAVE_DESTRUCT,  "void f()",                      WRAP_OBJ_LAST(DestructorTP),  asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectBehaviour("CTimePoint", asBEHAVE_DESTRUCT,  "void f()",                         SCRIPT_OBJ_LAST(DestructorTP)) );
+        Throw( pEngine->RegisterObjectBehaviour("CTimeDuration", asBEHAVE_DESTRUCT,  "void f()",                      SCRIPT_OBJ_LAST(DestructorTP)) );
 
         // assignment operator
-        Throw( pEngine->RegisterObjectMethod("CTimePoint", "CTimePoint & opAssign(const CTimePoint & in)", WRAP_MFN_PR(CTimePoint, operator =, (const CTimePoint &), CTimePoint &), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "CTimeDuration & opAssign(const CTimeDuration & in)", WRAP_MFN_PR(CTimeDuration, operator =, (const CTimeDuration &), CTimeDuration &), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CTimePoint", "CTimePoint & opAssign(const CTimePoint & in)", SCRIPT_MFN_PR(CTimePoint, operator =, (const CTimePoint &), CTimePoint &)) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "CTimeDuration & opAssign(const CTimeDuration & in)", SCRIPT_MFN_PR(CTimeDuration, operator =, (const CTimeDuration &), CTimeDuration &)) );
 
         // CTimePoint binary operators
-        Throw( pEngine->RegisterObjectMethod("CTimePoint", "CTimePoint opAdd ( const CTimeDuration & in )", WRAP_MFN_PR(CTimePoint, operator +, (const CTimeDuration &) const, CTimePoint), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimePoint", "CTimePoint opSub ( const CTimeDuration & in )", WRAP_MFN_PR(CTimePoint, operator -, (const CTimeDuration &) const, CTimePoint), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimePoint", "CTimeDuration opSub ( const CTimePoint & in )", WRAP_MFN_PR(CTimePoint, operator -, (const CTimePoint &) const, CTimeDuration), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CTimePoint", "CTimePoint opAdd ( const CTimeDuration & in )", SCRIPT_MFN_PR(CTimePoint, operator +, (const CTimeDuration &) const, CTimePoint)) );
+        Throw( pEngine->RegisterObjectMethod("CTimePoint", "CTimePoint opSub ( const CTimeDuration & in )", SCRIPT_MFN_PR(CTimePoint, operator -, (const CTimeDuration &) const, CTimePoint)) );
+        Throw( pEngine->RegisterObjectMethod("CTimePoint", "CTimeDuration opSub ( const CTimePoint & in )", SCRIPT_MFN_PR(CTimePoint, operator -, (const CTimePoint &) const, CTimeDuration)) );
 
         // CTimeDuration binary operators
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "CTimeDuration opAdd ( const CTimeDuration & in )", WRAP_MFN_PR(CTimeDuration, operator +, (const CTimeDuration &) const, CTimeDuration), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "CTimeDuration opSub ( const CTimeDuration & in )", WRAP_MFN_PR(CTimeDuration, operator -, (const CTimeDuration &) const, CTimeDuration), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "CTimeDuration opAdd ( const CTimeDuration & in )", SCRIPT_MFN_PR(CTimeDuration, operator +, (const CTimeDuration &) const, CTimeDuration)) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "CTimeDuration opSub ( const CTimeDuration & in )", SCRIPT_MFN_PR(CTimeDuration, operator -, (const CTimeDuration &) const, CTimeDuration)) );
 
         // CTimePoint compound assignment operators
-        Throw( pEngine->RegisterObjectMethod("CTimePoint", "CTimePoint opAddAssign ( const CTimeDuration & in )", WRAP_MFN_PR(CTimePoint, operator +=, (const CTimeDuration &), CTimePoint), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimePoint", "CTimePoint opSubAssign ( const CTimeDuration & in )", WRAP_MFN_PR(CTimePoint, operator -=, (const CTimeDuration &), CTimePoint), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CTimePoint", "CTimePoint opAddAssign ( const CTimeDuration & in )", SCRIPT_MFN_PR(CTimePoint, operator +=, (const CTimeDuration &), CTimePoint)) );
+        Throw( pEngine->RegisterObjectMethod("CTimePoint", "CTimePoint opSubAssign ( const CTimeDuration & in )", SCRIPT_MFN_PR(CTimePoint, operator -=, (const CTimeDuration &), CTimePoint)) );
 
         // CTimeDuration compound assignment operators
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "CTimeDuration opAddAssign ( const CTimeDuration & in )", WRAP_MFN_PR(CTimeDuration, operator +=, (const CTimeDuration &), CTimeDuration), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "CTimeDuration opSubAssign ( const CTimeDuration & in )", WRAP_MFN_PR(CTimeDuration, operator -=, (const CTimeDuration &), CTimeDuration), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "CTimeDuration opAddAssign ( const CTimeDuration & in )", SCRIPT_MFN_PR(CTimeDuration, operator +=, (const CTimeDuration &), CTimeDuration)) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "CTimeDuration opSubAssign ( const CTimeDuration & in )", SCRIPT_MFN_PR(CTimeDuration, operator -=, (const CTimeDuration &), CTimeDuration)) );
 
         // CTimePoint compair operators
-        Throw( pEngine->RegisterObjectMethod("CTimePoint", "bool opEquals ( const CTimePoint & in )", WRAP_MFN_PR(CTimePoint, operator ==, (const CTimePoint &) const, bool), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CTimePoint", "bool opEquals ( const CTimePoint & in )", SCRIPT_MFN_PR(CTimePoint, operator ==, (const CTimePoint &) const, bool)) );
         Throw( pEngine->RegisterObjectMethod("CTimePoint", "int opCmp ( const CTimePoint & in )",    asFUNCTION(opCmpTP), asCALL_CDECL_OBJFIRST ) );
 
         // CTimeDuration compair operators
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "bool opEquals ( const CTimeDuration & in )", WRAP_MFN_PR(CTimeDuration, operator ==, (const CTimeDuration &) const, bool), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "bool opEquals ( const CTimeDuration & in )", SCRIPT_MFN_PR(CTimeDuration, operator ==, (const CTimeDuration &) const, bool)) );
         Throw( pEngine->RegisterObjectMethod("CTimeDuration", "int opCmp ( const CTimeDuration & in )",    asFUNCTION(opCmpTD), asCALL_CDECL_OBJFIRST ) );
 
         // CTimePoint Class members
-        Throw( pEngine->RegisterObjectMethod("CTimePoint", "void now()",                         WRAP_OBJ_LAST(Now1), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimePoint", "void now(const CTimeDuration & in)", WRAP_OBJ_LAST(Now2), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CTimePoint", "void now()",                         SCRIPT_OBJ_LAST(Now1)) );
+        Throw( pEngine->RegisterObjectMethod("CTimePoint", "void now(const CTimeDuration & in)", SCRIPT_OBJ_LAST(Now2)) );
 
         // CTimeDuration Class members
         Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void set(int64,int64,int64,int64,int64 m = 0,int64 n = 0)",  asFUNCTION(SetTD),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void setNanoseconds(int64)",  WRAP_MFN(CTimeDuration, setNanoseconds),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void setMicroseconds(int64)", WRAP_MFN(CTimeDuration, setMicroseconds), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void setMilliseconds(int64)", WRAP_MFN(CTimeDuration, setMilliseconds), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void setSeconds(int64)",      WRAP_MFN(CTimeDuration, setSeconds),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void setMinutes(int64)",      WRAP_MFN(CTimeDuration, setMinutes),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void setHours(int64)",        WRAP_MFN(CTimeDuration, setHours),        asCALL_GENERIC) );
-
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void addNanoseconds(int64)",  WRAP_MFN(CTimeDuration, addNanoseconds),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void addMicroseconds(int64)", WRAP_MFN(CTimeDuration, addMicroseconds), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void addMilliseconds(int64)", WRAP_MFN(CTimeDuration, addMilliseconds), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void addSeconds(int64)",      WRAP_MFN(CTimeDuration, addSeconds),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void addMinutes(int64)",      WRAP_MFN(CTimeDuration, addMinutes),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void addHours(int64)",        WRAP_MFN(CTimeDuration, addHours),        asCALL_GENERIC) );
-
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "int64 getNanoseconds()",      WRAP_MFN(CTimeDuration, getNanoseconds),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "int64 getMicroseconds()",     WRAP_MFN(CTimeDuration, getMicroseconds), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "int64 getSeconds()",          WRAP_MFN(CTimeDuration, getSeconds),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "int64 getMinutes()",          WRAP_MFN(CTimeDuration, getMinutes),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "int64 getHours()",            WRAP_MFN(CTimeDuration, getHours),        asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void setNanoseconds(int64)",  SCRIPT_MFN(CTimeDuration, setNanoseconds)) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void setMicroseconds(int64)", SCRIPT_MFN(CTimeDuration, setMicroseconds)) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void setMilliseconds(int64)", SCRIPT_MFN(CTimeDuration, setMilliseconds)) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void setSeconds(int64)",      SCRIPT_MFN(CTimeDuration, setSeconds)) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void setMinutes(int64)",      SCRIPT_MFN(CTimeDuration, setMinutes)) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void setHours(int64)",        SCRIPT_MFN(CTimeDuration, setHours)) );
+
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void addNanoseconds(int64)",  SCRIPT_MFN(CTimeDuration, addNanoseconds)) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void addMicroseconds(int64)", SCRIPT_MFN(CTimeDuration, addMicroseconds)) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void addMilliseconds(int64)", SCRIPT_MFN(CTimeDuration, addMilliseconds)) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void addSeconds(int64)",      SCRIPT_MFN(CTimeDuration, addSeconds)) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void addMinutes(int64)",      SCRIPT_MFN(CTimeDuration, addMinutes)) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "void addHours(int64)",        SCRIPT_MFN(CTimeDuration, addHours)) );
+
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "int64 getNanoseconds()",      SCRIPT_MFN(CTimeDuration, getNanoseconds)) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "int64 getMicroseconds()",     SCRIPT_MFN(CTimeDuration, getMicroseconds)) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "int64 getSeconds()",          SCRIPT_MFN(CTimeDuration, getSeconds)) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "int64 getMinutes()",          SCRIPT_MFN(CTimeDuration, getMinutes)) );
+        Throw( pEngine->RegisterObjectMethod("CTimeDuration", "int64 getHours()",            SCRIPT_MFN(CTimeDuration, getHours)) );
 
         // Global functions
         Throw( pEngine->RegisterGlobalFunction("string FormatTimeDuration(const CTimeDuration &in, int)", asFUNCTION(FormatTimeDuration), asCALL_GENERIC) );
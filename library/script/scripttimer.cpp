@@ -12,11 +12,11 @@
 #include <utilities/timer.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
 #include <utilities/exceptionhandling.h>
 
 // AngelScript lib dependencies
 #include <angelscript.h>
-#include <autowrapper/aswrappedcall.h>
 
 namespace NScriptTimer
 {
@@ -54,15 +54,15 @@ namespace NScriptTimer
         Throw( pEngine->RegisterObjectType( "CTimer", sizeof(CTimer), asOBJ_VALUE|asOBJ_APP_CLASS) );
 
         // Register the object constructor
-        Throw( pEngine->RegisterObjectBehaviour("CTimer", asBEHAVE_CONSTRUCT, "void f()",                       WRAP_OBJ_LAST(Constructor),           asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CTimer", asBEHAVE_CONSTRUCT, "void f(double, bool s = false)", WRAP_OBJ_LAST(ConstructorFromParam),  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectBehaviour("CTimer", asBEHAVE_DESTRUCT,  "void f()",                       WRAP_OBJ_LAST(Destructor),            asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectBehaviour("CTimer", asBEHAVE_CONSTRUCT, "void f()",                       SCRIPT_OBJ_LAST(Constructor)) );
+        Throw( pEngine->RegisterObjectBehaviour("CTimer", asBEHAVE_CONSTRUCT, "void f(double, bool s = false)", SCRIPT_OBJ_LAST(ConstructorFromParam)) );
+        Throw( pEngine->RegisterObjectBehaviour("CTimer", asBEHAVE_DESTRUCT,  "void f()",                       SCRIPT_OBJ_LAST(Destructor)) );
         
-        Throw( pEngine->RegisterObjectMethod("CTimer", "void setExpired()",                        WRAP_MFN(CTimer, setExpired),      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimer", "bool expired(bool resetOnExpire = false)", WRAP_MFN(CTimer, expired),         asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimer", "void reset()",                             WRAP_MFN(CTimer, reset),           asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimer", "void set(double)",                         WRAP_MFN(CTimer, set),             asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimer", "void disable(bool disabled = true)",       WRAP_MFN(CTimer, disable),         asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("CTimer", "void setDisableValue(bool)",               WRAP_MFN(CTimer, setDisableValue), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("CTimer", "void setExpired()",                        SCRIPT_MFN(CTimer, setExpired)) );
+        Throw( pEngine->RegisterObjectMethod("CTimer", "bool expired(bool resetOnExpire = false)", SCRIPT_MFN(CTimer, expired)) );
+        Throw( pEngine->RegisterObjectMethod("CTimer", "void reset()",                             SCRIPT_MFN(CTimer, reset)) );
+        Throw( pEngine->RegisterObjectMethod("CTimer", "void set(double)",                         SCRIPT_MFN(CTimer, set)) );
+        Throw( pEngine->RegisterObjectMethod("CTimer", "void disable(bool disabled = true)",       SCRIPT_MFN(CTimer, disable)) );
+        Throw( pEngine->RegisterObjectMethod("CTimer", "void setDisableValue(bool)",               SCRIPT_MFN(CTimer, setDisableValue)) );
     }
 }
@@ -0,0 +1,93 @@
+
+/************************************************************************
+*    FILE NAME:       scripttimerwheel.cpp
+*
+*    DESCRIPTION:     Hashed timer wheel of waiting script contexts.
+*                     Only the slots the ticks pass over are looked at
+*                     so the cost doesn't grow with the number waiting
+************************************************************************/
+
+// Physical component dependency
+#include <script/scripttimerwheel.h>
+
+// Game lib dependencies
+#include <utilities/exceptionhandling.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <algorithm>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CScriptTimerWheel::CScriptTimerWheel( const uint32_t slotCount ) :
+    m_slotVec( slotCount ),
+    m_mask( slotCount - 1 )
+{
+    if( (slotCount == 0) || ((slotCount & m_mask) != 0) )
+        throw NExcept::CCriticalException("Script Timer Wheel Error!",
+            boost::str( boost::format("Slot count needs to be a power of 2 (%d).\n\n%s\nLine: %s")
+                % slotCount % __FUNCTION__ % __LINE__ ));
+}
+
+/************************************************************************
+*    DESC:  Add a context that expires on this tick
+************************************************************************/
+void CScriptTimerWheel::add( asIScriptContext * pContext, const uint32_t serial, const uint64_t expire )
+{
+    // Anything already due is put in the next slot to be picked up on the next advance
+    const uint64_t tick = std::max( expire, m_currentTick + 1 );
+
+    m_slotVec[tick & m_mask].push_back( {pContext, serial, expire} );
+    ++m_count;
+}
+
+/************************************************************************
+*    DESC:  Advance the wheel to this tick and add the expired entries to the vector
+*           Entries more than a turn of the wheel away stay in their slot
+*           until the turn they expire on
+************************************************************************/
+void CScriptTimerWheel::advance( const uint64_t tick, std::vector<SEntry> & rExpiredVec )
+{
+    if( tick <= m_currentTick )
+        return;
+
+    // Every slot only needs to be looked at once no matter how many turns were missed
+    const uint64_t steps = std::min( tick - m_currentTick, (uint64_t)m_slotVec.size() );
+
+    for( uint64_t i = 1; (i <= steps) && (m_count > 0); ++i )
+    {
+        auto & rSlot = m_slotVec[(m_currentTick + i) & m_mask];
+
+        size_t keep = 0;
+        for( size_t j = 0; j < rSlot.size(); ++j )
+        {
+            if( rSlot[j].expire <= tick )
+            {
+                rExpiredVec.push_back( rSlot[j] );
+                --m_count;
+            }
+            else
+            {
+                rSlot[keep++] = rSlot[j];
+            }
+        }
+
+        rSlot.resize( keep );
+    }
+
+    m_currentTick = tick;
+}
+
+/************************************************************************
+*    DESC:  Remove all the entries
+************************************************************************/
+void CScriptTimerWheel::clear()
+{
+    for( auto & iter : m_slotVec )
+        iter.clear();
+
+    m_count = 0;
+}
@@ -0,0 +1,59 @@
+
+/************************************************************************
+*    FILE NAME:       scripttimerwheel.h
+*
+*    DESCRIPTION:     Hashed timer wheel of waiting script contexts.
+*                     Only the slots the ticks pass over are looked at
+*                     so the cost doesn't grow with the number waiting
+************************************************************************/
+
+#pragma once
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <cstdint>
+#include <vector>
+
+// Forward declaration(s)
+class asIScriptContext;
+
+class CScriptTimerWheel : boost::noncopyable
+{
+public:
+
+    struct SEntry
+    {
+        asIScriptContext * pContext;
+        uint32_t serial;
+        uint64_t expire;
+    };
+
+    // Constructor
+    // NOTE: The slot count needs to be a power of 2
+    CScriptTimerWheel( const uint32_t slotCount );
+
+    // Add a context that expires on this tick
+    void add( asIScriptContext * pContext, const uint32_t serial, const uint64_t expire );
+
+    // Advance the wheel to this tick and add the expired entries to the vector
+    void advance( const uint64_t tick, std::vector<SEntry> & rExpiredVec );
+
+    // Remove all the entries
+    void clear();
+
+private:
+
+    // The slots of the wheel
+    std::vector< std::vector<SEntry> > m_slotVec;
+
+    // Mask to wrap the tick to a slot
+    uint64_t m_mask;
+
+    // Last tick the wheel was advanced to
+    uint64_t m_currentTick = 0;
+
+    // Number of entries in the wheel
+    size_t m_count = 0;
+};
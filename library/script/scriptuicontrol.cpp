@@ -13,6 +13,7 @@
 #include <gui/icontrol.h>
 #include <script/scriptmanager.h>
 #include <script/scriptglobals.h>
+#include <script/scriptcallconv.h>
 #include <utilities/exceptionhandling.h>
 #include <utilities/genfunc.h>
 
@@ -22,7 +23,6 @@
 // AngelScript lib dependencies
 #include <angelscript.h>
 #include <scriptarray/scriptarray.h>
-#include <autowrapper/aswrappedcall.h>
 
 namespace NScriptUIControl
 {
@@ -159,94 +159,94 @@ namespace NScriptUIControl
         // Register type
         Throw( pEngine->RegisterObjectType(  "uiControl", 0, asOBJ_REF|asOBJ_NOCOUNT) );
 
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setStringToList(string &in)",                                WRAP_MFN(iControl, setStringToList), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setStringToList(string &in)",                                SCRIPT_MFN(iControl, setStringToList)) );
         
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void createFontString(string &in, int spriteIndex = 0)",          WRAP_MFN_PR(iControl, createFontString, (const std::string &, int), void), asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void createFontString(int stringIndex = 0, int spriteIndex = 0)", WRAP_MFN_PR(iControl, createFontString, (int, int), void),                 asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setActionType(string &in)",                                  WRAP_MFN_PR(iControl, setActionType, (const std::string &), void),         asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setExecutionAction(string &in)",                             WRAP_MFN(iControl, setExecutionAction),                                    asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void changeState(int)",                                           WRAP_MFN(iControl, changeState),                                           asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "uiControl & findControl(string &in)",                             WRAP_OBJ_LAST(FindControl),                                                asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void createFontString(string &in, int spriteIndex = 0)",          SCRIPT_MFN_PR(iControl, createFontString, (const std::string &, int), void)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void createFontString(int stringIndex = 0, int spriteIndex = 0)", SCRIPT_MFN_PR(iControl, createFontString, (int, int), void)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setActionType(string &in)",                                  SCRIPT_MFN_PR(iControl, setActionType, (const std::string &), void)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setExecutionAction(string &in)",                             SCRIPT_MFN(iControl, setExecutionAction)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void changeState(int)",                                           SCRIPT_MFN(iControl, changeState)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "uiControl & findControl(string &in)",                             SCRIPT_OBJ_LAST(FindControl)) );
         
-        Throw( pEngine->RegisterObjectMethod("uiControl", "bool isDisabled() const",                               WRAP_MFN(iControl, isDisabled),                 asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "bool isInactive() const",                               WRAP_MFN(iControl, isInactive),                 asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "bool isActive() const",                                 WRAP_MFN(iControl, isActive),                   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "bool isSelected() const",                               WRAP_MFN(iControl, isSelected),                 asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "bool isSelectable() const",                             WRAP_MFN(iControl, isSelectable),               asCALL_GENERIC) );
-
-        Throw( pEngine->RegisterObjectMethod("uiControl", "const string & getName() const",                        WRAP_OBJ_LAST(GetName),                         asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "const string & getGroup() const",                       WRAP_OBJ_LAST(GetGroup),                        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "const string & getFaction() const",                     WRAP_OBJ_LAST(GetFaction),                      asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "const string & getExecutionAction() const",             WRAP_MFN(iControl, getExecutionAction),         asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "bool prepare(string &in, bool f = false)",              WRAP_MFN(iControl, prepare),                    asCALL_GENERIC) );
-
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void removeScriptFunction(string &in)",                 WRAP_MFN(iControl, removeScriptFunction),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void addScriptFunction(string &in, string &in, string &in, bool f1 = false, bool f2 = false, bool f3 = false)", WRAP_MFN(iControl, addScriptFunction), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "bool isDisabled() const",                               SCRIPT_MFN(iControl, isDisabled)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "bool isInactive() const",                               SCRIPT_MFN(iControl, isInactive)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "bool isActive() const",                                 SCRIPT_MFN(iControl, isActive)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "bool isSelected() const",                               SCRIPT_MFN(iControl, isSelected)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "bool isSelectable() const",                             SCRIPT_MFN(iControl, isSelectable)) );
+
+        Throw( pEngine->RegisterObjectMethod("uiControl", "const string & getName() const",                        SCRIPT_OBJ_LAST(GetName)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "const string & getGroup() const",                       SCRIPT_OBJ_LAST(GetGroup)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "const string & getFaction() const",                     SCRIPT_OBJ_LAST(GetFaction)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "const string & getExecutionAction() const",             SCRIPT_MFN(iControl, getExecutionAction)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "bool prepare(string &in, bool f = false)",              SCRIPT_MFN(iControl, prepare)) );
+
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void removeScriptFunction(string &in)",                 SCRIPT_MFN(iControl, removeScriptFunction)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void addScriptFunction(string &in, string &in, string &in, bool f1 = false, bool f2 = false, bool f3 = false)", SCRIPT_MFN(iControl, addScriptFunction)) );
         
         // Object pos, rot & scale
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setVisible(bool)",                                 WRAP_OBJ_LAST(SetVisible),                         asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "bool isVisible() const",                                WRAP_OBJ_LAST(IsVisible),                          asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setVisible(bool)",                                 SCRIPT_OBJ_LAST(SetVisible)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "bool isVisible() const",                                SCRIPT_OBJ_LAST(IsVisible)) );
 
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setPos(CPoint &in)",                               WRAP_OBJ_LAST(SetPos1),                            asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setPos(float x = 0, float y = 0, float z = 0)",    WRAP_OBJ_LAST(SetPos2),                            asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setPos(CPoint &in)",                               SCRIPT_OBJ_LAST(SetPos1)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setPos(float x = 0, float y = 0, float z = 0)",    SCRIPT_OBJ_LAST(SetPos2)) );
 
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void incPos(CPoint & in)",                              WRAP_OBJ_LAST(IncPos1),                            asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void incPos(float x = 0, float y = 0, float z = 0)",    WRAP_OBJ_LAST(IncPos2),                            asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void incPos(CPoint & in)",                              SCRIPT_OBJ_LAST(IncPos1)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void incPos(float x = 0, float y = 0, float z = 0)",    SCRIPT_OBJ_LAST(IncPos2)) );
 
-        Throw( pEngine->RegisterObjectMethod("uiControl", "const CPoint & getPos() const",                         WRAP_OBJ_LAST(GetPos),                             asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "const CPoint & getPos() const",                         SCRIPT_OBJ_LAST(GetPos)) );
 
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setRot(CPoint &in, bool convertToRadians = true)", WRAP_OBJ_LAST(SetRot1),                            asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", WRAP_OBJ_LAST(SetRot2), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setRot(CPoint &in, bool convertToRadians = true)", SCRIPT_OBJ_LAST(SetRot1)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", SCRIPT_OBJ_LAST(SetRot2)) );
 
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void incRot(CPoint &in, bool convertToRadians = true)", WRAP_OBJ_LAST(IncRot1),                            asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void incRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", WRAP_OBJ_LAST(IncRot2), asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void incRot(CPoint &in, bool convertToRadians = true)", SCRIPT_OBJ_LAST(IncRot1)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void incRot(float x = 0, float y = 0, float z = 0, bool convertToRadians = true)", SCRIPT_OBJ_LAST(IncRot2)) );
 
-        Throw( pEngine->RegisterObjectMethod("uiControl", "const CPoint & getRot() const",                         WRAP_OBJ_LAST(GetRot),                             asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "const CPoint & getRot() const",                         SCRIPT_OBJ_LAST(GetRot)) );
 
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setScale(CPoint & in)",                            WRAP_OBJ_LAST(SetScale1),                          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setScale(float x = 1, float y = 1, float z = 1)",  WRAP_OBJ_LAST(SetScale2),                          asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setScale(CPoint & in)",                            SCRIPT_OBJ_LAST(SetScale1)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setScale(float x = 1, float y = 1, float z = 1)",  SCRIPT_OBJ_LAST(SetScale2)) );
 
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void incScale(CPoint & in)",                            WRAP_OBJ_LAST(IncScale1),                          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void incScale(float x = 1, float y = 1, float z = 1)",  WRAP_OBJ_LAST(IncScale2),                          asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void incScale(CPoint & in)",                            SCRIPT_OBJ_LAST(IncScale1)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void incScale(float x = 1, float y = 1, float z = 1)",  SCRIPT_OBJ_LAST(IncScale2)) );
 
-        Throw( pEngine->RegisterObjectMethod("uiControl", "const CPoint & getScale() const",                       WRAP_OBJ_LAST(GetScale),                           asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "const CPoint & getScale() const",                       SCRIPT_OBJ_LAST(GetScale)) );
 
         // Interface to sub sontrol
-        Throw( pEngine->RegisterObjectMethod("uiControl", "uint size()",                                           WRAP_MFN(iControl, size),                       asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "uint size()",                                           SCRIPT_MFN(iControl, size)) );
         
         // Interface to button list
-        Throw( pEngine->RegisterObjectMethod("uiControl", "int getActiveIndex() const",                            WRAP_MFN(iControl, getActiveIndex),             asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setActiveIndex(int)",                              WRAP_MFN(iControl, setActiveIndex),             asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "int getActiveIndex() const",                            SCRIPT_MFN(iControl, getActiveIndex)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setActiveIndex(int)",                              SCRIPT_MFN(iControl, setActiveIndex)) );
         
         // Interface to check box
-        Throw( pEngine->RegisterObjectMethod("uiControl", "bool getToggleState() const",                           WRAP_MFN(iControl, getToggleState),             asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setToggleState(bool)",                             WRAP_MFN(iControl, setToggleState),             asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "bool getToggleState() const",                           SCRIPT_MFN(iControl, getToggleState)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setToggleState(bool)",                             SCRIPT_MFN(iControl, setToggleState)) );
         
         // Interface to meter
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setMeterValue(double)",                            WRAP_MFN(iControl, setMeterValue),              asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void startBangUp(double)",                              WRAP_MFN(iControl, startBangUp),                asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void incBangUp(double)",                                WRAP_MFN(iControl, incBangUp),                  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void fastBang()",                                       WRAP_MFN(iControl, fastBang),                   asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "bool isBanging() const",                                WRAP_MFN(iControl, isBanging),                  asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void clearMeter()",                                     WRAP_MFN(iControl, clearMeter),                 asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setMeterValue(double)",                            SCRIPT_MFN(iControl, setMeterValue)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void startBangUp(double)",                              SCRIPT_MFN(iControl, startBangUp)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void incBangUp(double)",                                SCRIPT_MFN(iControl, incBangUp)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void fastBang()",                                       SCRIPT_MFN(iControl, fastBang)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "bool isBanging() const",                                SCRIPT_MFN(iControl, isBanging)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void clearMeter()",                                     SCRIPT_MFN(iControl, clearMeter)) );
         
         // Interface to progress bar
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setProgressBarValue(float)",                       WRAP_MFN(iControl, setProgressBarValue),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "float getProgressBarValue() const",                     WRAP_MFN(iControl, getProgressBarValue),        asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void incProgressBarValue(float)",                       WRAP_MFN(iControl, incProgressBarValue),        asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setProgressBarValue(float)",                       SCRIPT_MFN(iControl, setProgressBarValue)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "float getProgressBarValue() const",                     SCRIPT_MFN(iControl, getProgressBarValue)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void incProgressBarValue(float)",                       SCRIPT_MFN(iControl, incProgressBarValue)) );
         
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setProgressBarMinValue(float)",                    WRAP_MFN(iControl, setProgressBarMinValue),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "float getProgressBarMinValue() const",                  WRAP_MFN(iControl, getProgressBarMinValue),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setProgressBarMaxValue(float)",                    WRAP_MFN(iControl, setProgressBarMaxValue),     asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "float getProgressBarMaxValue() const",                  WRAP_MFN(iControl, getProgressBarMaxValue),     asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setProgressBarMinValue(float)",                    SCRIPT_MFN(iControl, setProgressBarMinValue)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "float getProgressBarMinValue() const",                  SCRIPT_MFN(iControl, getProgressBarMinValue)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setProgressBarMaxValue(float)",                    SCRIPT_MFN(iControl, setProgressBarMaxValue)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "float getProgressBarMaxValue() const",                  SCRIPT_MFN(iControl, getProgressBarMaxValue)) );
         
         // Interface to slider
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setSliderPosValue(float)",                         WRAP_MFN(iControl, setSliderPosValue),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "float getSliderPosValue() const",                       WRAP_MFN(iControl, getSliderPosValue),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setSliderMinValue(float)",                         WRAP_MFN(iControl, setSliderMinValue),          asCALL_GENERIC) );
-        Throw( pEngine->RegisterObjectMethod("uiControl", "void setSliderMaxValue(float)",                         WRAP_MFN(iControl, setSliderMaxValue),          asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setSliderPosValue(float)",                         SCRIPT_MFN(iControl, setSliderPosValue)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "float getSliderPosValue() const",                       SCRIPT_MFN(iControl, getSliderPosValue)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setSliderMinValue(float)",                         SCRIPT_MFN(iControl, setSliderMinValue)) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "void setSliderMaxValue(float)",                         SCRIPT_MFN(iControl, setSliderMaxValue)) );
         
         // Interface to scroll box
-        Throw( pEngine->RegisterObjectMethod("uiControl", "uiControl & getScrollBoxControl(uint)",                 WRAP_MFN(iControl, getPtrToScrollBoxControl),   asCALL_GENERIC) );
+        Throw( pEngine->RegisterObjectMethod("uiControl", "uiControl & getScrollBoxControl(uint)",                 SCRIPT_MFN(iControl, getPtrToScrollBoxControl)) );
     }
 }
@@ -12,6 +12,7 @@
 #include <utilities/exceptionhandling.h>
 #include <utilities/genfunc.h>
 #include <utilities/xmlParser.h>
+#include <utilities/assetarchive.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
@@ -79,11 +80,12 @@ void CSound::loadFromNode( const XMLNode & node )
 {
     auto file = node.getAttribute( "file" );
             
+    // The mixer closes the stream. Music streams from it while it plays
     if( m_type == EST_LOADED )
-        m_pVoid = Mix_LoadWAV( file );
+        m_pVoid = Mix_LoadWAV_IO( CAssetArchive::Instance().openIO( file ), true );
 
     else if( m_type == EST_STREAM )
-        m_pVoid = Mix_LoadMUS( file );
+        m_pVoid = Mix_LoadMUS_IO( CAssetArchive::Instance().openIO( file ), true );
     
     // Set the volume if defined
     if( node.isAttributeSet("volume") )
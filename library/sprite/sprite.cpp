@@ -21,6 +21,7 @@
 #include <utilities/xmlParser.h>
 #include <utilities/matrix.h>
 #include <utilities/xmlparsehelper.h>
+#include <sprite/spritedata.h>
 
 /************************************************************************
 *    DESC:  Constructor
@@ -89,6 +90,26 @@ void CSprite::load( const XMLNode & node )
         setFrame( std::atoi( node.getAttribute("frameIndex") ) );
 }
 
+/************************************************************************
+*    DESC:  Load the sprite data compiled from the XML node
+************************************************************************/
+void CSprite::load( const CSpriteData & spriteData )
+{
+    // Copy the transform data
+    applyTransData( spriteData.getTransData() );
+
+    // Share the script functions
+    shareScriptFunctions( spriteData.getScriptFunctions() );
+
+    // Copy the font properties
+    if( m_upVisualComponent->isFontSprite() && (spriteData.getFontData() != nullptr) )
+        m_upVisualComponent->setFontData( *spriteData.getFontData() );
+    
+    // Set the frame of the animation
+    if( spriteData.getFrameIndex() > -1 )
+        setFrame( spriteData.getFrameIndex() );
+}
+
 /************************************************************************
 *    DESC:  Reload the sprite node
 *    NOTE:  This function is for reloading the sprite after it was initially
@@ -107,6 +128,43 @@ void CSprite::reload( const XMLNode & node )
         m_upPhysicsComponent->setTransform(m_pos.x, m_pos.y, m_rot.z);
 }
 
+/************************************************************************
+*    DESC:  Park the sprite so that it can be reused by a node pool
+************************************************************************/
+void CSprite::park()
+{
+    // Stop any running scripts
+    m_scriptComponent.resetAndRecycle();
+
+    // Pull the body out of the simulation
+    if( m_upPhysicsComponent )
+        m_upPhysicsComponent->setActive( false );
+}
+
+/************************************************************************
+*    DESC:  Respawn a parked sprite from the sprite data
+************************************************************************/
+void CSprite::respawn( const CSpriteData & spriteData )
+{
+    // Start from the state of a newly created sprite
+    resetTransform();
+    setVisible( m_rObjectData.getVisualData().isActive() );
+    setFrame( 0 );
+
+    // Load the sprite data
+    load( spriteData );
+
+    // Put the body back into the simulation
+    if( m_upPhysicsComponent )
+    {
+        m_upPhysicsComponent->setTransform( m_pos.x, m_pos.y, -m_rot.z );
+        m_upPhysicsComponent->setActive( true );
+    }
+
+    // Init
+    init();
+}
+
 /************************************************************************
 *    DESC:  Init the physics
 ************************************************************************/
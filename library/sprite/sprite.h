@@ -25,6 +25,7 @@
 
 // Forward declaration(s)
 class iObjectData;
+class CSpriteData;
 class iVisualComponent;
 class iPhysicsComponent;
 class CMatrix;
@@ -44,12 +45,19 @@ public:
     
     // Load the sprite data
     void load( const XMLNode & node );
+    void load( const CSpriteData & spriteData );
 
     // Reload the sprite node
     // NOTE:  This function is for reloading the sprite after it was initially
     //        created. One use case is that a basic sprite is created by
     //        the strategy to then be reloaded by the strategy loader
     void reload( const XMLNode & node );
+
+    // Park the sprite so that it can be reused by a node pool
+    void park();
+
+    // Respawn a parked sprite from the sprite data
+    void respawn( const CSpriteData & spriteData );
     
     // Init the physics
     void initPhysics();
@@ -10,6 +10,8 @@
 
 // Game lib dependencies
 #include <utilities/genfunc.h>
+#include <utilities/xmlparsehelper.h>
+#include <common/fontdata.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
@@ -43,7 +45,9 @@ CSpriteData::CSpriteData(
 
     else if(defObjName.empty())
         NGenFunc::PostDebugMsg( boost::str( boost::format("Node name used for object data look-up (%s, %s)!") % m_group % m_objectName ) );
-    
+
+    // Compile the XML node
+    compile();
 }
 
 CSpriteData::~CSpriteData()
@@ -56,17 +60,48 @@ CSpriteData::CSpriteData(
     const std::string & group,
     const std::string & objName ) :
         m_group(group),
-        m_objectName(objName)
+        m_objectName(objName),
+        m_spScriptFunctionMap( new scriptFuncMap_t )
 {
 }
 
 CSpriteData::CSpriteData( const CSpriteData & data ) :
     m_xmlNode( data.m_xmlNode ),
     m_group( data.m_group ),
-    m_objectName( data.m_objectName )
+    m_objectName( data.m_objectName ),
+    m_transData( data.m_transData ),
+    m_spScriptFunctionMap( data.m_spScriptFunctionMap ),
+    m_spFontData( data.m_spFontData ),
+    m_frameIndex( data.m_frameIndex )
 {
 }
 
+/************************************************************************
+*    DESC:  Compile the XML node so that creating a sprite doesn't parse it
+************************************************************************/
+void CSpriteData::compile()
+{
+    // Load the transform data
+    m_transData.loadFromNode( m_xmlNode );
+
+    // Load the script functions. The group defaults to the object data group
+    auto spScriptFunctionMap = std::make_shared<scriptFuncMap_t>();
+    NParseHelper::initScriptFunctions( m_xmlNode, *spScriptFunctionMap, m_group );
+    m_spScriptFunctionMap = spScriptFunctionMap;
+
+    // Load the font properties if the node defines them
+    if( !m_xmlNode.getChildNode( "font" ).isEmpty() )
+    {
+        auto spFontData = std::make_shared<CFontData>();
+        spFontData->loadFromNode( m_xmlNode );
+        m_spFontData = spFontData;
+    }
+
+    // Get the frame of the animation
+    if( m_xmlNode.isAttributeSet( "frameIndex" ) )
+        m_frameIndex = std::atoi( m_xmlNode.getAttribute("frameIndex") );
+}
+
 /************************************************************************
 *    DESC:  Get the XML Node
 ************************************************************************/
@@ -75,6 +110,39 @@ const XMLNode & CSpriteData::getXMLNode() const
     return m_xmlNode;
 }
 
+/************************************************************************
+*    DESC:  Get the transform data compiled from the XML node
+************************************************************************/
+const CTransformData & CSpriteData::getTransData() const
+{
+    return m_transData;
+}
+
+/************************************************************************
+*    DESC:  Get the script functions compiled from the XML node
+************************************************************************/
+const std::shared_ptr<const scriptFuncMap_t> & CSpriteData::getScriptFunctions() const
+{
+    return m_spScriptFunctionMap;
+}
+
+/************************************************************************
+*    DESC:  Get the font data compiled from the XML node
+*           nullptr if not defined
+************************************************************************/
+const CFontData * CSpriteData::getFontData() const
+{
+    return m_spFontData.get();
+}
+
+/************************************************************************
+*    DESC:  Get the frame index. -1 if not defined
+************************************************************************/
+int CSpriteData::getFrameIndex() const
+{
+    return m_frameIndex;
+}
+
 /************************************************************************
 *    DESC:  Get the group
 ************************************************************************/
@@ -9,10 +9,16 @@
 
 // Game lib dependencies
 #include <common/defs.h>
+#include <common/transformdata.h>
+#include <script/scriptpreparefunc.h>
 #include <utilities/xmlParser.h>
 
 // Standard lib dependencies
 #include <string>
+#include <memory>
+
+// Forward declaration(s)
+class CFontData;
 
 class CSpriteData
 {
@@ -43,6 +49,23 @@ public:
     // Get the XML Node
     const XMLNode & getXMLNode() const;
 
+    // Get the transform data compiled from the XML node
+    const CTransformData & getTransData() const;
+
+    // Get the script functions compiled from the XML node
+    const std::shared_ptr<const scriptFuncMap_t> & getScriptFunctions() const;
+
+    // Get the font data compiled from the XML node. nullptr if not defined
+    const CFontData * getFontData() const;
+
+    // Get the frame index. -1 if not defined
+    int getFrameIndex() const;
+
+private:
+
+    // Compile the XML node so that creating a sprite doesn't parse it
+    void compile();
+
 private:
 
     // XML Node holding sprite data
@@ -53,4 +76,16 @@ private:
     
     // Object name
     std::string m_objectName;
+
+    // Compiled transform
+    CTransformData m_transData;
+
+    // Compiled script functions shared by all the created objects
+    std::shared_ptr<const scriptFuncMap_t> m_spScriptFunctionMap;
+
+    // Compiled font data
+    std::shared_ptr<const CFontData> m_spFontData;
+
+    // Frame index
+    int m_frameIndex = -1;
 };
@@ -0,0 +1,204 @@
+
+/************************************************************************
+*    FILE NAME:       nodepool.cpp
+*
+*    DESCRIPTION:     Pool of parked nodes created from the same
+*                     node data list. Destroyed nodes are reset and
+*                     parked so they can be reused without allocating
+************************************************************************/
+
+// Physical component dependency
+#include <strategy/nodepool.h>
+
+// Game lib dependencies
+#include <utilities/exceptionhandling.h>
+#include <utilities/deletefuncs.h>
+#include <node/nodedatalist.h>
+#include <node/nodedata.h>
+#include <node/inode.h>
+#include <sprite/sprite.h>
+#include <common/object.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// Standard lib dependencies
+#include <algorithm>
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CNodePool::CNodePool( const CNodeDataList & rNodeDataList ) :
+    m_rNodeDataVec( rNodeDataList.getData() ),
+    m_maxSize( std::max( rNodeDataList.getPoolSize(), 0 ) ),
+    m_poolable( true )
+{
+    // Only sprite and object nodes know how to reset themselves
+    for( auto & iter : m_rNodeDataVec )
+    {
+        if( (iter.getNodeType() != ENodeType::SPRITE) && (iter.getNodeType() != ENodeType::OBJECT) )
+            m_poolable = false;
+    }
+
+    if( m_maxSize > 0 )
+        m_pParkedVec.reserve( m_maxSize );
+}
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CNodePool::~CNodePool()
+{
+    NDelFunc::DeleteVectorPointers( m_pParkedVec );
+}
+
+/************************************************************************
+*    DESC:  Get a parked node respawned from the node data.
+*           Returns nullptr if there is nothing parked
+************************************************************************/
+iNode * CNodePool::reuse()
+{
+    iNode * pHeadNode(nullptr);
+
+    if( !m_pParkedVec.empty() )
+    {
+        pHeadNode = m_pParkedVec.back();
+        m_pParkedVec.pop_back();
+
+        // Give the reused node a new handle so stale handles don't match
+        pHeadNode->newHandle();
+
+        respawnNode( pHeadNode );
+    }
+
+    return pHeadNode;
+}
+
+/************************************************************************
+*    DESC:  Park the node for reuse. Returns false if the pool is full
+************************************************************************/
+bool CNodePool::park( iNode * pHeadNode )
+{
+    if( !m_poolable || (m_pParkedVec.size() >= m_maxSize) )
+        return false;
+
+    parkNode( pHeadNode );
+
+    m_pParkedVec.push_back( pHeadNode );
+
+    return true;
+}
+
+/************************************************************************
+*    DESC:  Move the parked nodes into the passed in vector
+************************************************************************/
+void CNodePool::release( std::vector<iNode *> & pNodeVec )
+{
+    pNodeVec.insert( pNodeVec.end(), m_pParkedVec.begin(), m_pParkedVec.end() );
+    m_pParkedVec.clear();
+}
+
+/************************************************************************
+*    DESC:  Park the node and its children
+*           NOTE: This is a recursive function
+************************************************************************/
+void CNodePool::parkNode( iNode * pNode )
+{
+    auto pSprite = pNode->getSprite();
+    if( pSprite != nullptr )
+        pSprite->park();
+
+    iNode * pNextNode;
+    auto nodeIter = pNode->getNodeIter();
+
+    do
+    {
+        // get the next node
+        pNextNode = pNode->next(nodeIter);
+
+        if( pNextNode != nullptr )
+            parkNode( pNextNode );
+    }
+    while( pNextNode != nullptr );
+}
+
+/************************************************************************
+*    DESC:  Respawn the node and its children
+*           NOTE: This is a recursive function
+************************************************************************/
+void CNodePool::respawnNode( iNode * pNode )
+{
+    const CNodeData & rNodeData = getNodeData( pNode );
+
+    auto pSprite = pNode->getSprite();
+    if( pSprite != nullptr )
+    {
+        pSprite->respawn( rNodeData );
+    }
+    else
+    {
+        auto pObject = pNode->getObject();
+        if( pObject != nullptr )
+        {
+            pObject->resetTransform();
+            pObject->applyTransData( rNodeData.getTransData() );
+        }
+    }
+
+    iNode * pNextNode;
+    auto nodeIter = pNode->getNodeIter();
+
+    do
+    {
+        // get the next node
+        pNextNode = pNode->next(nodeIter);
+
+        if( pNextNode != nullptr )
+            respawnNode( pNextNode );
+    }
+    while( pNextNode != nullptr );
+}
+
+/************************************************************************
+*    DESC:  Get the node data for this node id
+************************************************************************/
+const CNodeData & CNodePool::getNodeData( iNode * pNode ) const
+{
+    const uint8_t nodeId = pNode->getNodeId();
+
+    auto iter = std::find_if(
+        m_rNodeDataVec.begin(),
+        m_rNodeDataVec.end(),
+        [nodeId](const CNodeData & rData) { return rData.getNodeId() == nodeId; } );
+
+    if( iter == m_rNodeDataVec.end() )
+        throw NExcept::CCriticalException("Node Pool Error!",
+            boost::str( boost::format("Node data can't be found for pooled node (%d).\n\n%s\nLine: %s")
+                % (int)nodeId % __FUNCTION__ % __LINE__ ));
+
+    return *iter;
+}
+
+/************************************************************************
+*    DESC:  Can nodes of this data be pooled
+************************************************************************/
+bool CNodePool::isPoolable() const
+{
+    return m_poolable && (m_maxSize > 0);
+}
+
+/************************************************************************
+*    DESC:  Get the number of parked nodes
+************************************************************************/
+size_t CNodePool::getParkedCount() const
+{
+    return m_pParkedVec.size();
+}
+
+/************************************************************************
+*    DESC:  Get the max number of parked nodes
+************************************************************************/
+size_t CNodePool::getMaxSize() const
+{
+    return m_maxSize;
+}
@@ -0,0 +1,79 @@
+
+/************************************************************************
+*    FILE NAME:       nodepool.h
+*
+*    DESCRIPTION:     Pool of parked nodes created from the same
+*                     node data list. Destroyed nodes are reset and
+*                     parked so they can be reused without allocating
+************************************************************************/
+
+#pragma once
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <vector>
+#include <cstddef>
+
+// Forward declaration(s)
+class iNode;
+class CNodeData;
+class CNodeDataList;
+
+class CNodePool : boost::noncopyable
+{
+public:
+
+    // Constructor
+    CNodePool( const CNodeDataList & rNodeDataList );
+
+    // Destructor
+    virtual ~CNodePool();
+
+    // Get a parked node respawned from the node data.
+    // Returns nullptr if there is nothing parked
+    iNode * reuse();
+
+    // Park the node for reuse. Returns false if the pool is full
+    bool park( iNode * pHeadNode );
+
+    // Move the parked nodes into the passed in vector
+    void release( std::vector<iNode *> & pNodeVec );
+
+    // Can nodes of this data be pooled
+    bool isPoolable() const;
+
+    // Get the number of parked nodes
+    size_t getParkedCount() const;
+
+    // Get the max number of parked nodes
+    size_t getMaxSize() const;
+
+private:
+
+    // Park the node and its children
+    // NOTE: This is a recursive function
+    void parkNode( iNode * pNode );
+
+    // Respawn the node and its children
+    // NOTE: This is a recursive function
+    void respawnNode( iNode * pNode );
+
+    // Get the node data for this node id
+    const CNodeData & getNodeData( iNode * pNode ) const;
+
+private:
+
+    // The node data the parked nodes were created from
+    const std::vector<CNodeData> & m_rNodeDataVec;
+
+    // Max number of parked nodes
+    size_t m_maxSize;
+
+    // Can these nodes be pooled
+    bool m_poolable;
+
+    // Parked nodes
+    std::vector<iNode *> m_pParkedVec;
+};
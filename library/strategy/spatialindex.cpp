@@ -0,0 +1,400 @@
+
+/************************************************************************
+*    FILE NAME:       spatialindex.cpp
+*
+*    DESCRIPTION:     Loose uniform grid of the active strategy nodes.
+*                     Nodes are indexed by their local position in
+*                     the cell that holds their center and queries
+*                     are expanded by the largest node radius
+************************************************************************/
+
+// Physical component dependency
+#include <strategy/spatialindex.h>
+
+// Game lib dependencies
+#include <node/inode.h>
+#include <common/object.h>
+
+// Standard lib dependencies
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    // Keep the cell coordinates well inside the range of an int
+    constexpr float MAX_CELL_COORD = 1000000000.f;
+}
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CSpatialIndex::CSpatialIndex() :
+    m_cellSize(0.f),
+    m_maxRadius(0.f),
+    m_orderCounter(0),
+    m_minX(0),
+    m_minY(0),
+    m_maxX(-1),
+    m_maxY(-1)
+{
+}
+
+/************************************************************************
+*    DESC:  Enable the index with the size of the grid cells
+************************************************************************/
+void CSpatialIndex::enable( float cellSize )
+{
+    // Cell size can't change with nodes indexed by the old one
+    clear();
+
+    m_cellSize = cellSize;
+}
+
+/************************************************************************
+*    DESC:  Is the index enabled
+************************************************************************/
+bool CSpatialIndex::isEnabled() const
+{
+    return m_cellSize > 0.f;
+}
+
+/************************************************************************
+*    DESC:  Add the node to the index
+************************************************************************/
+void CSpatialIndex::insert( iNode * pNode )
+{
+    if( !isEnabled() )
+        return;
+
+    const CPoint<float> & pos = pNode->getObject()->getPos();
+    const int x = getCellCoord( pos.x );
+    const int y = getCellCoord( pos.y );
+    const int64_t key = getKey( x, y );
+
+    // A node that is already indexed is moved to the end of the order
+    auto iter = m_linkMap.find( pNode );
+    if( iter != m_linkMap.end() )
+    {
+        removeFromCell( iter->second.key, pNode );
+        removeRadius( iter->second.radius );
+        m_linkMap.erase( iter );
+    }
+
+    const uint32_t order = m_orderCounter++;
+    const float radius = pNode->getRadius();
+
+    m_linkMap.emplace( pNode, CLink{key, order, radius} );
+    addToCell( key, CEntry{pNode, order} );
+    addRadius( radius );
+
+    if( m_maxX < m_minX )
+    {
+        m_minX = m_maxX = x;
+        m_minY = m_maxY = y;
+    }
+    else
+    {
+        m_minX = std::min( m_minX, x );
+        m_minY = std::min( m_minY, y );
+        m_maxX = std::max( m_maxX, x );
+        m_maxY = std::max( m_maxY, y );
+    }
+}
+
+/************************************************************************
+*    DESC:  Remove the node from the index
+************************************************************************/
+void CSpatialIndex::remove( iNode * pNode )
+{
+    auto iter = m_linkMap.find( pNode );
+    if( iter != m_linkMap.end() )
+    {
+        removeFromCell( iter->second.key, pNode );
+        removeRadius( iter->second.radius );
+        m_linkMap.erase( iter );
+    }
+}
+
+/************************************************************************
+*    DESC:  Move the node to the cell of it's current position
+************************************************************************/
+void CSpatialIndex::update( iNode * pNode )
+{
+    auto iter = m_linkMap.find( pNode );
+    if( iter == m_linkMap.end() )
+        return;
+
+    // Scale changes the radius so it's checked with the position
+    const float radius = pNode->getRadius();
+    if( radius != iter->second.radius )
+    {
+        removeRadius( iter->second.radius );
+        addRadius( radius );
+        iter->second.radius = radius;
+    }
+
+    const CPoint<float> & pos = pNode->getObject()->getPos();
+    const int x = getCellCoord( pos.x );
+    const int y = getCellCoord( pos.y );
+    const int64_t key = getKey( x, y );
+
+    if( key != iter->second.key )
+    {
+        removeFromCell( iter->second.key, pNode );
+        addToCell( key, CEntry{pNode, iter->second.order} );
+        iter->second.key = key;
+
+        m_minX = std::min( m_minX, x );
+        m_minY = std::min( m_minY, y );
+        m_maxX = std::max( m_maxX, x );
+        m_maxY = std::max( m_maxY, y );
+    }
+}
+
+/************************************************************************
+*    DESC:  Clear the index
+************************************************************************/
+void CSpatialIndex::clear()
+{
+    m_cellMap.clear();
+    m_linkMap.clear();
+    m_queryVec.clear();
+    m_radiusCountMap.clear();
+
+    m_maxRadius = 0.f;
+    m_orderCounter = 0;
+    m_minX = m_minY = 0;
+    m_maxX = m_maxY = -1;
+}
+
+/************************************************************************
+*    DESC:  Get the nodes that overlap the rect
+*           NOTE: The nodes are in the order they were inserted
+************************************************************************/
+void CSpatialIndex::getNodesInRect( const CRect<float> & rect, std::vector<iNode *> & pNodeVec )
+{
+    pNodeVec.clear();
+
+    if( m_linkMap.empty() )
+        return;
+
+    const float x1 = std::min( rect.x1, rect.x2 );
+    const float y1 = std::min( rect.y1, rect.y2 );
+    const float x2 = std::max( rect.x1, rect.x2 );
+    const float y2 = std::max( rect.y1, rect.y2 );
+
+    // Nodes are only in the cell of their center so expand by the largest radius
+    collectCells(
+        getCellCoord( x1 - m_maxRadius ), getCellCoord( y1 - m_maxRadius ),
+        getCellCoord( x2 + m_maxRadius ), getCellCoord( y2 + m_maxRadius ) );
+
+    // Keep the order of the active node list so the draw order doesn't change
+    std::sort( m_queryVec.begin(), m_queryVec.end(),
+        [](const CEntry & a, const CEntry & b) { return a.order < b.order; } );
+
+    for( auto & iter : m_queryVec )
+    {
+        const CPoint<float> & pos = iter.pNode->getObject()->getPos();
+        const float radius = iter.pNode->getRadius();
+
+        if( (pos.x + radius >= x1) && (pos.x - radius <= x2) &&
+            (pos.y + radius >= y1) && (pos.y - radius <= y2) )
+            pNodeVec.push_back( iter.pNode );
+    }
+}
+
+/************************************************************************
+*    DESC:  Get the nodes that overlap the circle
+************************************************************************/
+void CSpatialIndex::getNodesInRadius( const CPoint<float> & pos, float radius, std::vector<iNode *> & pNodeVec )
+{
+    getNodesInRect( CRect<float>( pos.x - radius, pos.y - radius, pos.x + radius, pos.y + radius ), pNodeVec );
+
+    auto iter = std::remove_if( pNodeVec.begin(), pNodeVec.end(),
+        [&pos, radius](iNode * pNode)
+        {
+            const CPoint<float> & nodePos = pNode->getObject()->getPos();
+            const float dist = radius + pNode->getRadius();
+            const float x = nodePos.x - pos.x;
+            const float y = nodePos.y - pos.y;
+
+            return (x * x) + (y * y) > (dist * dist);
+        } );
+
+    pNodeVec.erase( iter, pNodeVec.end() );
+}
+
+/************************************************************************
+*    DESC:  Get the node closest to the point. Returns nullptr if none in range
+*           NOTE: A negative max distance searches the whole index
+************************************************************************/
+iNode * CSpatialIndex::getNearestNode( const CPoint<float> & pos, float maxDist )
+{
+    if( m_linkMap.empty() )
+        return nullptr;
+
+    // Grow the search area until a node is found that's closer
+    // than anything that could be outside of the searched area
+    float searchDist = (maxDist < 0.f) ? m_cellSize : std::min( m_cellSize, maxDist );
+
+    while( true )
+    {
+        const int x1 = getCellCoord( pos.x - searchDist );
+        const int y1 = getCellCoord( pos.y - searchDist );
+        const int x2 = getCellCoord( pos.x + searchDist );
+        const int y2 = getCellCoord( pos.y + searchDist );
+
+        collectCells( x1, y1, x2, y2 );
+
+        // Once all the cells in use are searched, any node in the search is valid
+        const bool searchedAll = (x1 <= m_minX) && (y1 <= m_minY) && (x2 >= m_maxX) && (y2 >= m_maxY);
+
+        float nearestDist = searchDist * searchDist;
+        if( searchedAll )
+            nearestDist = (maxDist < 0.f) ? std::numeric_limits<float>::max() : maxDist * maxDist;
+
+        iNode * pNearest(nullptr);
+
+        for( auto & iter : m_queryVec )
+        {
+            const CPoint<float> & nodePos = iter.pNode->getObject()->getPos();
+            const float x = nodePos.x - pos.x;
+            const float y = nodePos.y - pos.y;
+            const float dist = (x * x) + (y * y);
+
+            if( dist <= nearestDist )
+            {
+                pNearest = iter.pNode;
+                nearestDist = dist;
+            }
+        }
+
+        if( (pNearest != nullptr) || searchedAll || ((maxDist >= 0.f) && (searchDist >= maxDist)) )
+            return pNearest;
+
+        searchDist *= 2.f;
+
+        if( maxDist >= 0.f )
+            searchDist = std::min( searchDist, maxDist );
+    }
+}
+
+/************************************************************************
+*    DESC:  Get the number of indexed nodes
+************************************************************************/
+size_t CSpatialIndex::getCount() const
+{
+    return m_linkMap.size();
+}
+
+/************************************************************************
+*    DESC:  Get the cell coordinate of the value
+************************************************************************/
+int CSpatialIndex::getCellCoord( float value ) const
+{
+    return (int)std::floor( std::clamp( value / m_cellSize, -MAX_CELL_COORD, MAX_CELL_COORD ) );
+}
+
+/************************************************************************
+*    DESC:  Get the key of the cell
+************************************************************************/
+int64_t CSpatialIndex::getKey( int x, int y )
+{
+    return (int64_t(x) << 32) | uint32_t(y);
+}
+
+/************************************************************************
+*    DESC:  Add the entry to the cell
+************************************************************************/
+void CSpatialIndex::addToCell( int64_t key, const CEntry & entry )
+{
+    m_cellMap[key].push_back( entry );
+}
+
+/************************************************************************
+*    DESC:  Remove the node from the cell
+************************************************************************/
+void CSpatialIndex::removeFromCell( int64_t key, iNode * pNode )
+{
+    auto cellIter = m_cellMap.find( key );
+    if( cellIter != m_cellMap.end() )
+    {
+        auto & rEntryVec = cellIter->second;
+
+        auto iter = std::find_if( rEntryVec.begin(), rEntryVec.end(),
+            [pNode](const CEntry & entry) { return entry.pNode == pNode; } );
+
+        if( iter != rEntryVec.end() )
+        {
+            *iter = rEntryVec.back();
+            rEntryVec.pop_back();
+        }
+
+        if( rEntryVec.empty() )
+            m_cellMap.erase( cellIter );
+    }
+}
+
+/************************************************************************
+*    DESC:  Count the radius of an indexed node and update the largest radius
+************************************************************************/
+void CSpatialIndex::addRadius( float radius )
+{
+    ++m_radiusCountMap[radius];
+
+    m_maxRadius = m_radiusCountMap.rbegin()->first;
+}
+
+void CSpatialIndex::removeRadius( float radius )
+{
+    auto iter = m_radiusCountMap.find( radius );
+    if( (iter != m_radiusCountMap.end()) && (--iter->second == 0) )
+        m_radiusCountMap.erase( iter );
+
+    m_maxRadius = m_radiusCountMap.empty() ? 0.f : m_radiusCountMap.rbegin()->first;
+}
+
+/************************************************************************
+*    DESC:  Collect the entries of the cells in the range
+************************************************************************/
+void CSpatialIndex::collectCells( int x1, int y1, int x2, int y2 )
+{
+    m_queryVec.clear();
+
+    // Only the cells in use need to be visited
+    x1 = std::max( x1, m_minX );
+    y1 = std::max( y1, m_minY );
+    x2 = std::min( x2, m_maxX );
+    y2 = std::min( y2, m_maxY );
+
+    if( (x1 > x2) || (y1 > y2) )
+        return;
+
+    const int64_t rangeCount = (int64_t(x2 - x1) + 1) * (int64_t(y2 - y1) + 1);
+
+    // If the range has more cells than are in use, check the cells in use instead
+    if( rangeCount > (int64_t)m_cellMap.size() )
+    {
+        for( auto & iter : m_cellMap )
+        {
+            const int x = int(iter.first >> 32);
+            const int y = int(int32_t(iter.first & 0xFFFFFFFF));
+
+            if( (x >= x1) && (x <= x2) && (y >= y1) && (y <= y2) )
+                m_queryVec.insert( m_queryVec.end(), iter.second.begin(), iter.second.end() );
+        }
+    }
+    else
+    {
+        for( int y = y1; y <= y2; ++y )
+        {
+            for( int x = x1; x <= x2; ++x )
+            {
+                auto iter = m_cellMap.find( getKey( x, y ) );
+                if( iter != m_cellMap.end() )
+                    m_queryVec.insert( m_queryVec.end(), iter->second.begin(), iter->second.end() );
+            }
+        }
+    }
+}
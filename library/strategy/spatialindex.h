@@ -0,0 +1,128 @@
+
+/************************************************************************
+*    FILE NAME:       spatialindex.h
+*
+*    DESCRIPTION:     Loose uniform grid of the active strategy nodes.
+*                     Nodes are indexed by their local position in
+*                     the cell that holds their center and queries
+*                     are expanded by the largest node radius
+************************************************************************/
+
+#pragma once
+
+// Game lib dependencies
+#include <common/point.h>
+#include <common/rect.h>
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <map>
+
+// Forward declaration(s)
+class iNode;
+
+class CSpatialIndex : boost::noncopyable
+{
+public:
+
+    // Constructor
+    CSpatialIndex();
+
+    // Enable the index with the size of the grid cells
+    void enable( float cellSize );
+
+    // Is the index enabled
+    bool isEnabled() const;
+
+    // Add the node to the index
+    void insert( iNode * pNode );
+
+    // Remove the node from the index
+    void remove( iNode * pNode );
+
+    // Move the node to the cell of it's current position
+    void update( iNode * pNode );
+
+    // Clear the index
+    void clear();
+
+    // Get the nodes that overlap the rect
+    // NOTE: The nodes are in the order they were inserted
+    void getNodesInRect( const CRect<float> & rect, std::vector<iNode *> & pNodeVec );
+
+    // Get the nodes that overlap the circle
+    void getNodesInRadius( const CPoint<float> & pos, float radius, std::vector<iNode *> & pNodeVec );
+
+    // Get the node closest to the point. Returns nullptr if none in range
+    // NOTE: A negative max distance searches the whole index
+    iNode * getNearestNode( const CPoint<float> & pos, float maxDist = -1.f );
+
+    // Get the number of indexed nodes
+    size_t getCount() const;
+
+private:
+
+    struct CEntry
+    {
+        iNode * pNode;
+        uint32_t order;
+    };
+
+    struct CLink
+    {
+        int64_t key;
+        uint32_t order;
+        float radius;
+    };
+
+    // Get the cell coordinate of the value
+    int getCellCoord( float value ) const;
+
+    // Get the key of the cell
+    static int64_t getKey( int x, int y );
+
+    // Add the entry to the cell
+    void addToCell( int64_t key, const CEntry & entry );
+
+    // Remove the node from the cell
+    void removeFromCell( int64_t key, iNode * pNode );
+
+    // Count the radius of an indexed node and update the largest radius
+    void addRadius( float radius );
+    void removeRadius( float radius );
+
+    // Collect the entries of the cells in the range
+    void collectCells( int x1, int y1, int x2, int y2 );
+
+private:
+
+    // Size of the grid cell
+    float m_cellSize;
+
+    // Largest radius of the indexed nodes
+    float m_maxRadius;
+
+    // Number of indexed nodes of each radius. Drops the largest radius
+    // when the last node of it is removed
+    std::map<float, uint32_t> m_radiusCountMap;
+
+    // Insert counter used to keep the active node order
+    uint32_t m_orderCounter;
+
+    // Range of the cells in use
+    int m_minX, m_minY, m_maxX, m_maxY;
+
+    // Nodes in each grid cell
+    std::unordered_map<int64_t, std::vector<CEntry>> m_cellMap;
+
+    // Cell each node is in
+    std::unordered_map<iNode *, CLink> m_linkMap;
+
+    // Entries collected by a query
+    std::vector<CEntry> m_queryVec;
+};
@@ -8,10 +8,13 @@
 #include <strategy/strategy.h>
 
 // Game lib dependencies
+#include <strategy/nodepool.h>
 #include <utilities/exceptionhandling.h>
 #include <utilities/xmlParser.h>
 #include <utilities/deletefuncs.h>
 #include <utilities/genfunc.h>
+#include <utilities/statcounter.h>
+#include <utilities/settings.h>
 #include <objectdata/objectdatamanager.h>
 #include <node/nodefactory.h>
 #include <node/nodedatalist.h>
@@ -22,10 +25,15 @@
 #include <system/device.h>
 #include <common/camera.h>
 #include <managers/cameramanager.h>
+#include <script/scriptparallel.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
 
+// Standard lib dependencies
+#include <cstring>
+#include <cassert>
+
 /************************************************************************
 *    DESC:  Constructor
 ************************************************************************/
@@ -89,6 +97,16 @@ void CStrategy::clearAllNodes()
         }
     }
 
+    // Parked nodes are freed with the rest
+    for( auto & iter : m_nodePoolMap )
+    {
+        CStatCounter::Instance().incParkedNodeCounter( -(int)iter.second.getParkedCount() );
+        iter.second.release( m_clearAllVec );
+    }
+
+    m_spatialIndex.clear();
+    m_dormantMap.clear();
+    m_pNodePoolLinkMap.clear();
     m_pNodeMap.clear();
     m_pNodeVec.clear();
     m_pActivateVec.clear();
@@ -128,6 +146,33 @@ void CStrategy::loadFromFile( const std::string & file )
 
         if( node.isAttributeSet( "defaultCamera" ) )
             m_pCamera = &CCameraMgr::Instance().get( node.getAttribute( "defaultCamera" ) );
+
+        if( node.isAttributeSet( "defaultPoolSize" ) )
+            m_defPoolSize = std::atoi(node.getAttribute( "defaultPoolSize" ));
+
+        // Index the nodes in a grid for culling and area queries
+        if( node.isAttributeSet( "spatialIndex" ) && (std::strcmp( node.getAttribute( "spatialIndex" ), "true" ) == 0) )
+        {
+            float cellSize = 0.f;
+            if( node.isAttributeSet( "cellSize" ) )
+                cellSize = std::atof(node.getAttribute( "cellSize" ));
+
+            enableSpatialIndex( cellSize );
+        }
+
+        // Policy of which active nodes get updated
+        if( node.isAttributeSet( "activityPolicy" ) )
+        {
+            float distance = 0.f;
+            if( node.isAttributeSet( "activityDistance" ) )
+                distance = std::atof(node.getAttribute( "activityDistance" ));
+
+            int farTickRate = 0;
+            if( node.isAttributeSet( "farTickRate" ) )
+                farTickRate = std::atoi(node.getAttribute( "farTickRate" ));
+
+            setActivityPolicy( node.getAttribute( "activityPolicy" ), distance, farTickRate );
+        }
     
         for( int i = 0; i < node.nChildNode(); ++i )
         {
@@ -149,7 +194,7 @@ void CStrategy::loadFromFile( const std::string & file )
                 bool duplicate = !m_dataMap.emplace(
                     std::piecewise_construct,
                     std::forward_as_tuple(name),
-                    std::forward_as_tuple(nodeLst, defGroup, defObjName, defUserId) ).second;
+                    std::forward_as_tuple(nodeLst, defGroup, defObjName, defUserId, m_defPoolSize) ).second;
 
                 // Check for duplicate names
                 if( duplicate )
@@ -228,27 +273,71 @@ iNode * CStrategy::create(
                 boost::str( boost::format("Need to supply an instance name if node is not active when created (%s).\n\n%s\nLine: %s")
                     % dataName % __FUNCTION__ % __LINE__ ));
 
-    auto & rNodeDataVec = getData( dataName, group ).getData();
+    auto & rNodeDataList = getData( dataName, group );
+    auto & rNodeDataVec = rNodeDataList.getData();
 
     iNode * pHeadNode(nullptr);
 
-    // Build the node list
-    for( auto & iter : rNodeDataVec )
+    // Try to reuse a parked node before allocating a new one
+    CNodePool * pNodePool = getNodePool( dataName, rNodeDataList );
+    if( pNodePool != nullptr )
     {
-        // Create the node from the factory function
-        iNode * pNode = NNodeFactory::Create( iter );
-        
-        if( pHeadNode == nullptr )
-            pHeadNode = pNode;
-        
-        else if( !pHeadNode->addNode( pNode ) )
-            throw NExcept::CCriticalException("Node Create Error!",
-                boost::str( boost::format("Parent node not found or node does not support adding children (%s, %d).\n\n%s\nLine: %s")
-                    % dataName % pNode->getParentId() % __FUNCTION__ % __LINE__ ));
+        pHeadNode = pNodePool->reuse();
+
+        if( pHeadNode != nullptr )
+            CStatCounter::Instance().incParkedNodeCounter( -1 );
+    }
+
+    if( pHeadNode == nullptr )
+    {
+        // Build the node list
+        // NOTE: The node data is in depth first order and the node ids are
+        //       the index into it so parents are found without a search
+        m_pBuildNodeVec.clear();
+
+        for( auto & iter : rNodeDataVec )
+        {
+            // Create the node from the factory function
+            iNode * pNode = NNodeFactory::Create( iter, &m_nodeArena );
+            
+            if( pHeadNode == nullptr )
+            {
+                pHeadNode = pNode;
+            }
+            else
+            {
+                const uint8_t parentId = pNode->getParentId();
+
+                if( (parentId >= m_pBuildNodeVec.size()) ||
+                    (m_pBuildNodeVec[parentId] == nullptr) ||
+                    !m_pBuildNodeVec[parentId]->pushBackNode( pNode ) )
+                {
+                    // Give the partly built nodes back to the arena
+                    NDelFunc::Delete( pNode );
+                    NDelFunc::Delete( pHeadNode );
+
+                    throw NExcept::CCriticalException("Node Create Error!",
+                        boost::str( boost::format("Parent node not found or node does not support adding children (%s, %d).\n\n%s\nLine: %s")
+                            % dataName % (int)parentId % __FUNCTION__ % __LINE__ ));
+                }
+            }
+
+            if( pNode->getNodeId() >= m_pBuildNodeVec.size() )
+                m_pBuildNodeVec.resize( pNode->getNodeId() + 1, nullptr );
+
+            m_pBuildNodeVec[pNode->getNodeId()] = pNode;
+        }
+
+        // Init the head node
+        pHeadNode->init();
+
+        if( pNodePool != nullptr )
+            CStatCounter::Instance().incNodeAllocCounter();
     }
 
-    // Init the head node
-    pHeadNode->init();
+    // Link the node to the pool it will be parked in when destroyed
+    if( pNodePool != nullptr )
+        m_pNodePoolLinkMap.emplace( pHeadNode->getHandle(), pNodePool );
 
     // Add the node pointer to the vector for adding to the list
     if( instanceName.empty() || makeActive )
@@ -372,8 +461,30 @@ void CStrategy::update()
     // Deleting it here allows for one cycle to complete before deleting
     deleteFromActiveList();
 
-    for( auto iter : m_pNodeVec )
-        iter->update();
+    // Sprites running only parallel safe scripts are put aside to be updated on the thread pool
+    m_collectParallel = CScriptParallel::Instance().isActive();
+
+    if( m_activityPolicy == EActivityPolicy::ALWAYS )
+    {
+        for( auto iter : m_pNodeVec )
+            updateNode( iter );
+    }
+    else
+    {
+        updateByActivity();
+    }
+
+    if( !m_pParallelScriptVec.empty() )
+    {
+        CScriptParallel::Instance().update( m_pParallelScriptVec );
+        m_pParallelScriptVec.clear();
+
+        // Sync the put aside sprites to their bodies after the script like the sprite update does
+        for( auto iter : m_pParallelPhysicsVec )
+            iter->physicsUpdate();
+
+        m_pParallelPhysicsVec.clear();
+    }
     
     if( m_clearAllNodesFlag )
     {
@@ -395,8 +506,24 @@ void CStrategy::transform()
 {
     CObject::transform();
 
-    for( auto iter : m_pNodeVec )
-        iter->transform( *this );
+    if( m_spatialIndex.isEnabled() )
+    {
+        for( auto iter : m_pNodeVec )
+        {
+            // Only nodes that moved need to be re-indexed
+            const bool moved = iter->getObject()->getParameters().isSet( CObject::TRANSFORM );
+
+            iter->transform( *this );
+
+            if( moved )
+                m_spatialIndex.update( iter );
+        }
+    }
+    else
+    {
+        for( auto iter : m_pNodeVec )
+            iter->transform( *this );
+    }
 }
 
 /***************************************************************************
@@ -409,14 +536,43 @@ void CStrategy::recordCommandBuffer( uint32_t index )
 
     CDevice::Instance().beginCommandBuffer( index, cmdBuf, m_pCamera->getProjectionType() );
 
-    m_pCamera->recordCommandBuffer( index, cmdBuf, m_pNodeVec );
+    recordCameraCmdBuf( index, cmdBuf, *m_pCamera );
 
     if(m_extraCamera != nullptr)
-        m_extraCamera->recordCommandBuffer( index, cmdBuf, m_pNodeVec );
+        recordCameraCmdBuf( index, cmdBuf, *m_extraCamera );
     
     CDevice::Instance().endCommandBuffer( cmdBuf );
 }
 
+/***************************************************************************
+*    DESC:  Record the command buffer for the nodes the camera can see
+****************************************************************************/
+void CStrategy::recordCameraCmdBuf( uint32_t index, VkCommandBuffer cmdBuf, CCamera & rCamera )
+{
+    CRect<float> rect;
+
+    // The index is in local space so the strategy can only be translated
+    if( m_spatialIndex.isEnabled() &&
+        getRot().isEmpty() && (getScale().x == 1.f) && (getScale().y == 1.f) &&
+        rCamera.getCullRect( rect ) )
+    {
+        const CPoint<float> & transPos = getTransPos();
+
+        rect.x1 -= transPos.x;
+        rect.x2 -= transPos.x;
+        rect.y1 -= transPos.y;
+        rect.y2 -= transPos.y;
+
+        // The camera still does the exact cull of the nodes in the overlapping cells
+        m_spatialIndex.getNodesInRect( rect, m_pQueryNodeVec );
+        rCamera.recordCommandBuffer( index, cmdBuf, m_pQueryNodeVec );
+    }
+    else
+    {
+        rCamera.recordCommandBuffer( index, cmdBuf, m_pNodeVec );
+    }
+}
+
 /***************************************************************************
 *    DESC:  Update the secondary command buffer vector
 ****************************************************************************/
@@ -469,6 +625,7 @@ void CStrategy::addToActiveList()
         {
             iter->update();
             m_pNodeVec.push_back( iter );
+            m_spatialIndex.insert( iter );
         }
         
         m_pActivateVec.clear();
@@ -487,7 +644,13 @@ void CStrategy::removeFromActiveList()
             auto iter = std::find( m_pNodeVec.begin(), m_pNodeVec.end(), pNode );
 
             if( iter != m_pNodeVec.end() )
+            {
+                // Don't leave the physics of an inactive node asleep
+                wakeNode( pNode, false );
+
+                m_spatialIndex.remove( pNode );
                 m_pNodeVec.erase( iter );
+            }
 
             else
                 NGenFunc::PostDebugMsg( boost::str( boost::format("Node id can't be found to be deactivated (%s).\n\n%s\nLine: %s")
@@ -505,8 +668,14 @@ void CStrategy::deleteFromActiveList()
 {
     // Clear all nodes
     if( !m_clearAllVec.empty() )
+    {
         NDelFunc::DeleteVectorPointers( m_clearAllVec );
 
+        // If that was all of them, release the memory in one go
+        if( m_nodeArena.getAllocCount() == 0 )
+            m_nodeArena.reset();
+    }
+
     if( !m_deleteVec.empty() )
     {
         for( auto handle : m_deleteVec )
@@ -518,7 +687,13 @@ void CStrategy::deleteFromActiveList()
 
             if( vecIter != m_pNodeVec.end() )
             {
-                NDelFunc::Delete( *vecIter );
+                m_spatialIndex.remove( *vecIter );
+                m_dormantMap.erase( *vecIter );
+
+                // Park the node for reuse if it came from a pool
+                if( !parkNode( *vecIter ) )
+                    NDelFunc::Delete( *vecIter );
+
                 m_pNodeVec.erase( vecIter );
             }
             else
@@ -545,6 +720,319 @@ void CStrategy::deleteFromActiveList()
     }
 }
 
+/************************************************************************
+*    DESC:  Get the node pool for this data.
+*           Returns nullptr if the data is not pooled
+************************************************************************/
+CNodePool * CStrategy::getNodePool( const std::string & name, const CNodeDataList & rNodeDataList )
+{
+    auto iter = m_nodePoolMap.find( name );
+
+    if( iter == m_nodePoolMap.end() )
+    {
+        // Skip creating a pool for data that doesn't ask for one
+        if( rNodeDataList.getPoolSize() <= 0 )
+            return nullptr;
+
+        iter = m_nodePoolMap.emplace(
+            std::piecewise_construct,
+            std::forward_as_tuple(name),
+            std::forward_as_tuple(rNodeDataList) ).first;
+
+        if( !iter->second.isPoolable() )
+            NGenFunc::PostDebugMsg( boost::str( boost::format("Node data can't be pooled. Only sprite and object nodes are supported (%s).") % name ) );
+    }
+
+    if( iter->second.isPoolable() )
+        return &iter->second;
+
+    return nullptr;
+}
+
+/************************************************************************
+*    DESC:  Park the node in the pool it was created from.
+*           Returns false if not parked
+************************************************************************/
+bool CStrategy::parkNode( iNode * pHeadNode )
+{
+    auto iter = m_pNodePoolLinkMap.find( pHeadNode->getHandle() );
+    if( iter != m_pNodePoolLinkMap.end() )
+    {
+        CNodePool * pNodePool = iter->second;
+        m_pNodePoolLinkMap.erase( iter );
+
+        if( pNodePool->park( pHeadNode ) )
+        {
+            CStatCounter::Instance().incParkedNodeCounter();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/************************************************************************
+*    DESC:  Index the active nodes in a grid for culling and area queries
+*           NOTE: A cell size of zero uses the sector size
+************************************************************************/
+void CStrategy::enableSpatialIndex( float cellSize )
+{
+    if( cellSize <= 0.f )
+        cellSize = CSettings::Instance().getSectorSize();
+
+    m_spatialIndex.enable( cellSize );
+
+    // Index the nodes that are already active
+    for( auto iter : m_pNodeVec )
+        m_spatialIndex.insert( iter );
+}
+
+/************************************************************************
+*    DESC:  Get the active nodes in the area. Only works with the spatial index
+*           NOTE: The area is in the local space of the strategy
+************************************************************************/
+const std::vector<iNode *> & CStrategy::getNodesInRect( const CRect<float> & rect )
+{
+    checkSpatialIndex();
+
+    m_spatialIndex.getNodesInRect( rect, m_pQueryNodeVec );
+
+    return m_pQueryNodeVec;
+}
+
+const std::vector<iNode *> & CStrategy::getNodesInRadius( const CPoint<float> & pos, float radius )
+{
+    checkSpatialIndex();
+
+    m_spatialIndex.getNodesInRadius( pos, radius, m_pQueryNodeVec );
+
+    return m_pQueryNodeVec;
+}
+
+/************************************************************************
+*    DESC:  Get the active node nearest to the point. Returns nullptr if none in range
+*           NOTE: A negative max distance has no limit
+************************************************************************/
+iNode * CStrategy::getNearestNode( const CPoint<float> & pos, float maxDist )
+{
+    checkSpatialIndex();
+
+    return m_spatialIndex.getNearestNode( pos, maxDist );
+}
+
+/************************************************************************
+*    DESC:  Check that the spatial index is enabled for queries
+************************************************************************/
+void CStrategy::checkSpatialIndex() const
+{
+    if( !m_spatialIndex.isEnabled() )
+        throw NExcept::CCriticalException("Spatial Index Error!",
+            boost::str( boost::format("Spatial index needs to be enabled for area queries.\n\n%s\nLine: %s")
+                % __FUNCTION__ % __LINE__ ));
+}
+
+/************************************************************************
+*    DESC:  Set the policy of which active nodes get updated. Nodes outside of
+*           the region are dormant unless there's a far tick rate to update
+*           them every so many frames
+************************************************************************/
+void CStrategy::setActivityPolicy( const std::string & policy, float distance, int farTickRate )
+{
+    if( policy == "ALWAYS" )
+        m_activityPolicy = EActivityPolicy::ALWAYS;
+
+    else if( policy == "IN_VIEW" )
+        m_activityPolicy = EActivityPolicy::IN_VIEW;
+
+    else if( policy == "DISTANCE" )
+        m_activityPolicy = EActivityPolicy::DISTANCE;
+
+    else
+        throw NExcept::CCriticalException("Activity Policy Error!",
+            boost::str( boost::format("Activity policy not defined (%s).\n\n%s\nLine: %s")
+                % policy % __FUNCTION__ % __LINE__ ));
+
+    m_activityDistance = distance;
+    m_farTickRate = std::max( farTickRate, 0 );
+
+    // Nodes are only dormant when there's no far tick rate
+    if( (m_activityPolicy == EActivityPolicy::ALWAYS) || (m_farTickRate > 0) )
+    {
+        while( !m_dormantMap.empty() )
+            wakeNode( m_dormantMap.begin()->first, true );
+    }
+}
+
+/************************************************************************
+*    DESC:  Set the point the activity distance is measured from.
+*           The camera is used if not set
+*           NOTE: The point is in the local space of the strategy
+************************************************************************/
+void CStrategy::setActivityFocus( const CPoint<float> & point )
+{
+    m_activityFocus = point;
+    m_useActivityFocus = true;
+}
+
+void CStrategy::clearActivityFocus()
+{
+    m_useActivityFocus = false;
+}
+
+/************************************************************************
+*    DESC:  Update the nodes that are in the activity region
+************************************************************************/
+void CStrategy::updateByActivity()
+{
+    ++m_activityFrame;
+
+    CPoint<float> focus( m_activityFocus );
+
+    // Measure from the center of the camera view in local space
+    if( (m_activityPolicy == EActivityPolicy::DISTANCE) && !m_useActivityFocus )
+    {
+        const CPoint<float> & camTransPos = m_pCamera->getTransPos();
+        const CPoint<float> & camScale = m_pCamera->getScale();
+
+        focus.x = (-camTransPos.x / camScale.x) - getTransPos().x;
+        focus.y = (-camTransPos.y / camScale.y) - getTransPos().y;
+        focus.z = -camTransPos.z - getTransPos().z;
+    }
+
+    for( auto iter : m_pNodeVec )
+    {
+        if( inActivityRegion( iter, focus ) )
+        {
+            // The wake event is prepared to run with this update
+            if( !m_dormantMap.empty() )
+                wakeNode( iter, true );
+
+            updateNode( iter );
+        }
+        else if( m_farTickRate > 0 )
+        {
+            // Spread the far nodes over the frames so they don't all update together
+            if( ((m_activityFrame + iter->getHandle()) % uint32_t(m_farTickRate)) == 0 )
+                updateNode( iter );
+        }
+        else
+        {
+            auto dormIter = m_dormantMap.find( iter );
+            if( dormIter == m_dormantMap.end() )
+            {
+                dormIter = m_dormantMap.emplace( iter, std::vector<iPhysicsComponent *>() ).first;
+                sleepNode( iter, dormIter->second );
+            }
+        }
+    }
+}
+
+/************************************************************************
+*    DESC:  Update the node or put aside it's script to be updated in parallel
+*           Only sprites without children are put aside. The physics
+*           update of the sprite is done on the main thread after the
+*           scripts are done
+************************************************************************/
+void CStrategy::updateNode( iNode * pNode )
+{
+    if( m_collectParallel )
+    {
+        auto pSprite = pNode->getSprite();
+        if( pSprite != nullptr )
+        {
+            auto nodeIter = pNode->getNodeIter();
+            CScriptComponent & rScriptComponent = pSprite->getScriptComponent();
+
+            if( (pNode->next( nodeIter ) == nullptr) && rScriptComponent.isParallel() )
+            {
+                // The sprite leaf node update is only the script and the physics update
+                assert( pNode->getType() == ENodeType::SPRITE );
+
+                m_pParallelScriptVec.push_back( &rScriptComponent );
+
+                if( pSprite->getPhysicsComponent() != nullptr )
+                    m_pParallelPhysicsVec.push_back( pSprite );
+
+                return;
+            }
+        }
+    }
+
+    pNode->update();
+}
+
+/************************************************************************
+*    DESC:  Is the node in the activity region
+************************************************************************/
+bool CStrategy::inActivityRegion( iNode * pNode, const CPoint<float> & focus )
+{
+    if( m_activityPolicy == EActivityPolicy::IN_VIEW )
+        return m_pCamera->inView( pNode->getObject()->getTransPos(), pNode->getRadius() + m_activityDistance );
+
+    if( m_activityPolicy == EActivityPolicy::DISTANCE )
+    {
+        const CPoint<float> & pos = pNode->getObject()->getPos();
+        const float dist = m_activityDistance + pNode->getRadius();
+        const float x = pos.x - focus.x;
+        const float y = pos.y - focus.y;
+        const float z = pos.z - focus.z;
+
+        return ((x * x) + (y * y) + (z * z)) <= (dist * dist);
+    }
+
+    return true;
+}
+
+/************************************************************************
+*    DESC:  Put the node to sleep by deactivating it's physics
+*           NOTE: This is a recursive function
+************************************************************************/
+void CStrategy::sleepNode( iNode * pNode, std::vector<iPhysicsComponent *> & pPhysicsVec )
+{
+    auto pSprite = pNode->getSprite();
+    if( pSprite != nullptr )
+    {
+        // Only deactivate what's active so the wake up doesn't activate anything else
+        auto pPhysics = pSprite->getPhysicsComponent();
+        if( (pPhysics != nullptr) && pPhysics->isActive() )
+        {
+            pPhysics->setActive( false );
+            pPhysicsVec.push_back( pPhysics );
+        }
+    }
+
+    iNode * pNextNode;
+    auto nodeIter = pNode->getNodeIter();
+
+    do
+    {
+        // get the next node
+        pNextNode = pNode->next(nodeIter);
+
+        if( pNextNode != nullptr )
+            sleepNode( pNextNode, pPhysicsVec );
+    }
+    while( pNextNode != nullptr );
+}
+
+/************************************************************************
+*    DESC:  Wake up a dormant node
+************************************************************************/
+void CStrategy::wakeNode( iNode * pNode, bool fireEvent )
+{
+    auto iter = m_dormantMap.find( pNode );
+    if( iter != m_dormantMap.end() )
+    {
+        for( auto pPhysics : iter->second )
+            pPhysics->setActive( true );
+
+        m_dormantMap.erase( iter );
+
+        if( fireEvent )
+            pNode->getObject()->prepare( "wake" );
+    }
+}
+
 /************************************************************************
  *    DESC:  Set the command buffers
  ************************************************************************/
@@ -12,6 +12,9 @@
 
 // Game lib dependencies
 #include <common/worldvalue.h>
+#include <node/nodearena.h>
+#include <strategy/spatialindex.h>
+#include <common/defs.h>
 
 // Vulkan lib dependencies
 #include <system/vulkan.h>
@@ -20,11 +23,16 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 // Forward Declarations
 class CNodeDataList;
+class CNodePool;
 class iNode;
 class CCamera;
+class iPhysicsComponent;
+class CScriptComponent;
+class CSprite;
 
 class CStrategy : public CObject
 {
@@ -97,6 +105,28 @@ public:
     // Increment tha active node vector position of all elements  
     void incActiveVecPos( const float x = 0.f, const float y = 0.f, float z = 0.f );
 
+    // Index the active nodes in a grid for culling and area queries
+    // NOTE: A cell size of zero uses the sector size
+    void enableSpatialIndex( float cellSize = 0.f );
+
+    // Get the active nodes in the area. Only works with the spatial index
+    // NOTE: The area is in the local space of the strategy
+    const std::vector<iNode *> & getNodesInRect( const CRect<float> & rect );
+    const std::vector<iNode *> & getNodesInRadius( const CPoint<float> & pos, float radius );
+
+    // Get the active node nearest to the point. Returns nullptr if none in range
+    // NOTE: A negative max distance has no limit
+    iNode * getNearestNode( const CPoint<float> & pos, float maxDist = -1.f );
+
+    // Set the policy of which active nodes get updated. Nodes outside of the region
+    // are dormant unless there's a far tick rate to update them every so many frames
+    void setActivityPolicy( const std::string & policy, float distance = 0.f, int farTickRate = 0 );
+
+    // Set the point the activity distance is measured from. The camera is used if not set
+    // NOTE: The point is in the local space of the strategy
+    void setActivityFocus( const CPoint<float> & point );
+    void clearActivityFocus();
+
 protected:
 
     // Get the node data by name
@@ -116,8 +146,39 @@ private:
     // Clear all nodes
     void clearAllNodes();
 
+    // Get the node pool for this data. Returns nullptr if the data is not pooled
+    CNodePool * getNodePool( const std::string & name, const CNodeDataList & rNodeDataList );
+
+    // Park the node in the pool it was created from. Returns false if not parked
+    bool parkNode( iNode * pHeadNode );
+
+    // Record the command buffer for the nodes the camera can see
+    void recordCameraCmdBuf( uint32_t index, VkCommandBuffer cmdBuf, CCamera & rCamera );
+
+    // Check that the spatial index is enabled for queries
+    void checkSpatialIndex() const;
+
+    // Update the nodes that are in the activity region
+    void updateByActivity();
+
+    // Update the node or put aside it's script to be updated in parallel
+    void updateNode( iNode * pNode );
+
+    // Is the node in the activity region
+    bool inActivityRegion( iNode * pNode, const CPoint<float> & focus );
+
+    // Put the node to sleep by deactivating it's physics
+    void sleepNode( iNode * pNode, std::vector<iPhysicsComponent *> & pPhysicsVec );
+
+    // Wake up a dormant node
+    void wakeNode( iNode * pNode, bool fireEvent );
+
 protected:
 
+    // Arena the nodes are allocated from
+    // NOTE: Needs to be the first member so that it's destroyed last
+    CNodeArena m_nodeArena;
+
     // World position value
     CPoint<CWorldValue> m_worldValPos;
     
@@ -151,6 +212,52 @@ protected:
     // Clear all nodes flag
     bool m_clearAllNodesFlag = false;
 
+    // Default max number of destroyed nodes to park for reuse
+    int m_defPoolSize = 0;
+
+    // Map of the node pools
+    std::map<const std::string, CNodePool> m_nodePoolMap;
+
+    // Handles of pooled nodes to the pool they were created from
+    std::map<handle16_t, CNodePool *> m_pNodePoolLinkMap;
+
+    // Nodes of the tree being built indexed by node id
+    std::vector<iNode *> m_pBuildNodeVec;
+
+    // Grid of the active nodes for culling and area queries
+    CSpatialIndex m_spatialIndex;
+
+    // Nodes found by the last spatial index query
+    std::vector<iNode *> m_pQueryNodeVec;
+
+    // Policy of which active nodes get updated
+    EActivityPolicy m_activityPolicy = EActivityPolicy::ALWAYS;
+
+    // Extra distance added to the activity region
+    float m_activityDistance = 0.f;
+
+    // Number of frames between updates of nodes outside the region. Zero makes them dormant
+    int m_farTickRate = 0;
+
+    // Frame counter for the far tick rate
+    uint32_t m_activityFrame = 0;
+
+    // Point the activity distance is measured from
+    CPoint<float> m_activityFocus;
+    bool m_useActivityFocus = false;
+
+    // Dormant nodes and the physics components deactivated when they went to sleep
+    std::unordered_map<iNode *, std::vector<iPhysicsComponent *>> m_dormantMap;
+
+    // Script components of the sprites to update in parallel
+    std::vector<CScriptComponent *> m_pParallelScriptVec;
+
+    // Sprites put aside with their script that still need their physics update
+    std::vector<CSprite *> m_pParallelPhysicsVec;
+
+    // Are the parallel safe scripts being put aside this update
+    bool m_collectParallel = false;
+
     // Command buffer
     // NOTE: command buffers don't have to be freed because
     //       they are freed by deleting the pool they belong to
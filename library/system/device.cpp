@@ -14,6 +14,7 @@
 #include <utilities/genfunc.h>
 #include <utilities/xmlParser.h>
 #include <utilities/smartpointers.h>
+#include <utilities/assetarchive.h>
 #include <common/texture.h>
 #include <common/color.h>
 #include <common/model.h>
@@ -58,6 +59,10 @@ void CDevice::init( std::function<void(uint32_t)> callback )
 
     // All file I/O is handled by SDL and SDL_Init must be called before doing any I/O.
     CSettings::Instance().loadXML();
+
+    // The settings are always loose. Everything after can come from the asset archive
+    if( !CSettings::Instance().getArchiveFile().empty() )
+        CAssetArchive::Instance().open( CSettings::Instance().getArchiveFile(), CSettings::Instance().isArchiveLooseOverride() );
     
     // Set the command buffer call back to be called from the game
     RecordCommandBufferCallback = callback;
@@ -1503,7 +1508,7 @@ void CDevice::loadFrom3DM(
     CModel & model )
 {
     // Open file for reading
-    NSmart::scoped_SDL_filehandle_ptr<SDL_IOStream> scpFile( SDL_IOFromFile( filePath.c_str(), "rb" ) );
+    NSmart::scoped_SDL_filehandle_ptr<SDL_IOStream> scpFile( CAssetArchive::Instance().openIO( filePath ) );
     if( scpFile.isNull() )
         throw NExcept::CCriticalException( "File Load Error!",
             boost::str( boost::format( "Error Loading file (%s).\n\n%s\nLine: %s" )
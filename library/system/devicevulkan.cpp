@@ -14,6 +14,7 @@
 #include <utilities/exceptionhandling.h>
 #include <utilities/settings.h>
 #include <utilities/genfunc.h>
+#include <utilities/assetarchive.h>
 #include <common/texture.h>
 #include <system/pipeline.h>
 #include <soil/SOIL.h>
@@ -1685,9 +1686,21 @@ VkCommandPool CDeviceVulkan::createCommandPool( uint32_t queueFamilyIndex )
 ****************************************************************************/
 void CDeviceVulkan::createTexture( CTexture & texture )
 {
+    // Decode the image in place when it's stored uncompressed in the asset archive
+    size_t fileSize(0);
+    std::vector<char> fileVec;
+    const void * pFile = CAssetArchive::Instance().getMemory( texture.textFilePath, fileSize );
+    if( pFile == nullptr )
+    {
+        fileVec = NGenFunc::FileToVec( texture.textFilePath );
+        pFile = fileVec.data();
+        fileSize = fileVec.size();
+    }
+
     int channels(0);
-    unsigned char * pixels = SOIL_load_image(
-        texture.textFilePath.c_str(),
+    unsigned char * pixels = SOIL_load_image_from_memory(
+        static_cast<const unsigned char *>(pFile),
+        (int)fileSize,
         &texture.size.w,
         &texture.size.h,
         &channels,
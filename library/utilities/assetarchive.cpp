@@ -0,0 +1,349 @@
+
+/************************************************************************
+*    FILE NAME:       assetarchive.cpp
+*
+*    DESCRIPTION:     Virtual file layer the loaders read through. Files
+*                     come from the mapped asset archive or as loose
+*                     files. Loose files override the archive so the data
+*                     can be edited during development
+************************************************************************/
+
+// Physical component dependency
+#include <utilities/assetarchive.h>
+
+// Game lib dependencies
+#include <utilities/exceptionhandling.h>
+#include <utilities/genfunc.h>
+
+// Boost lib dependencies
+#include <boost/format.hpp>
+
+// SDL lib dependencies
+#include <SDL3/SDL.h>
+
+// Compression lib dependencies
+#if defined(ASSET_ARCHIVE_LZ4)
+#include <lz4.h>
+#endif
+
+#if defined(ASSET_ARCHIVE_ZSTD)
+#include <zstd.h>
+#endif
+
+// Standard lib dependencies
+#include <algorithm>
+#include <cstring>
+
+// Platform dependencies for mapping the archive
+#if defined(_WINDOWS)
+#define STRICT
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif !defined(__ANDROID__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/************************************************************************
+*    DESC:  Constructor
+************************************************************************/
+CAssetArchive::CAssetArchive() :
+    m_pData(nullptr),
+    m_dataSize(0),
+    m_pFileHandle(nullptr),
+    m_pMapHandle(nullptr),
+    m_pHeader(nullptr),
+    m_pEntry(nullptr),
+    m_pPath(nullptr),
+    m_looseOverride(true)
+{
+}
+
+
+/************************************************************************
+*    DESC:  destructor
+************************************************************************/
+CAssetArchive::~CAssetArchive()
+{
+    close();
+}
+
+
+/************************************************************************
+*    DESC:  Open the archive. Loose files are looked for first when
+*           override is set
+************************************************************************/
+void CAssetArchive::open( const std::string & filePath, bool looseOverride )
+{
+    close();
+
+    mapFile( filePath );
+
+    // Check the archive before its offsets are used
+    const auto * pHeader = reinterpret_cast<const NAssetArchive::SHeader *>(m_pData);
+
+    bool valid = (m_dataSize >= sizeof(NAssetArchive::SHeader)) &&
+                 (pHeader->fileId == NAssetArchive::FILE_ID) &&
+                 (pHeader->version == NAssetArchive::VERSION) &&
+                 (pHeader->indexOffset <= m_dataSize) &&
+                 (pHeader->pathOffset <= m_dataSize) &&
+                 (pHeader->entryCount <= (m_dataSize - pHeader->indexOffset) / sizeof(NAssetArchive::SEntry));
+
+    if( valid )
+    {
+        const auto * pEntry = reinterpret_cast<const NAssetArchive::SEntry *>(m_pData + pHeader->indexOffset);
+        const uint64_t pathSize = m_dataSize - pHeader->pathOffset;
+
+        for( uint32_t i = 0; (i < pHeader->entryCount) && valid; ++i )
+        {
+            valid = (pEntry[i].offset <= m_dataSize) &&
+                    (pEntry[i].size <= m_dataSize - pEntry[i].offset) &&
+                    ((uint64_t)pEntry[i].pathOffset + pEntry[i].pathSize <= pathSize);
+        }
+    }
+
+    if( !valid )
+    {
+        unmapFile();
+
+        throw NExcept::CCriticalException("Asset Archive Error!",
+            boost::str( boost::format("File isn't an asset archive of version %d (%s).\n\n%s\nLine: %s")
+                % NAssetArchive::VERSION % filePath % __FUNCTION__ % __LINE__ ));
+    }
+
+    m_pHeader = pHeader;
+    m_pEntry = reinterpret_cast<const NAssetArchive::SEntry *>(m_pData + pHeader->indexOffset);
+    m_pPath = m_pData + pHeader->pathOffset;
+    m_looseOverride = looseOverride;
+
+    NGenFunc::PostDebugMsg( boost::str( boost::format("Asset archive opened (%s). Files: %d, Loose override: %s")
+        % filePath % pHeader->entryCount % (looseOverride ? "on" : "off") ) );
+}
+
+
+/************************************************************************
+*    DESC:  Close the archive
+************************************************************************/
+void CAssetArchive::close()
+{
+    unmapFile();
+
+    m_pHeader = nullptr;
+    m_pEntry = nullptr;
+    m_pPath = nullptr;
+    m_looseOverride = true;
+}
+
+
+/************************************************************************
+*    DESC:  Is an archive open
+************************************************************************/
+bool CAssetArchive::isOpen() const
+{
+    return (m_pHeader != nullptr);
+}
+
+
+/************************************************************************
+*    DESC:  Open the file for reading. Returns nullptr if the file can't be found
+*           NOTE: Files stored uncompressed are read from the mapped
+*                 archive without a copy
+************************************************************************/
+SDL_IOStream * CAssetArchive::openIO( const std::string & file )
+{
+    // Without an archive the files are all loose
+    if( (m_pHeader == nullptr) || m_looseOverride )
+    {
+        SDL_IOStream * pStream = SDL_IOFromFile( file.c_str(), "rb" );
+        if( (pStream != nullptr) || (m_pHeader == nullptr) )
+            return pStream;
+    }
+
+    const NAssetArchive::SEntry * pEntry = findEntry( file );
+    if( pEntry == nullptr )
+    {
+        SDL_SetError( "File isn't in the asset archive (%s)", file.c_str() );
+        return nullptr;
+    }
+
+    if( pEntry->compression == NAssetArchive::NONE )
+        return SDL_IOFromConstMem( m_pData + pEntry->offset, pEntry->size );
+
+    return decompress( *pEntry, file );
+}
+
+
+/************************************************************************
+*    DESC:  Get the data of a file stored uncompressed in the archive.
+*           Returns nullptr if the file is loose, compressed or not in
+*           the archive
+************************************************************************/
+const void * CAssetArchive::getMemory( const std::string & file, size_t & size )
+{
+    if( (m_pHeader == nullptr) || isLoose( file ) )
+        return nullptr;
+
+    const NAssetArchive::SEntry * pEntry = findEntry( file );
+    if( (pEntry == nullptr) || (pEntry->compression != NAssetArchive::NONE) )
+        return nullptr;
+
+    size = pEntry->size;
+
+    return m_pData + pEntry->offset;
+}
+
+
+/************************************************************************
+*    DESC:  Map the archive file into memory
+************************************************************************/
+void CAssetArchive::mapFile( const std::string & filePath )
+{
+#if defined(_WINDOWS)
+    HANDLE hFile = CreateFileA( filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+    if( hFile != INVALID_HANDLE_VALUE )
+    {
+        m_pFileHandle = hFile;
+
+        LARGE_INTEGER fileSize;
+        if( GetFileSizeEx( hFile, &fileSize ) && (fileSize.QuadPart > 0) )
+            m_pMapHandle = CreateFileMappingA( hFile, nullptr, PAGE_READONLY, 0, 0, nullptr );
+
+        if( m_pMapHandle != nullptr )
+        {
+            m_pData = static_cast<const char *>(MapViewOfFile( m_pMapHandle, FILE_MAP_READ, 0, 0, 0 ));
+            m_dataSize = (size_t)fileSize.QuadPart;
+        }
+    }
+#elif defined(__ANDROID__)
+    // The archive is packed in the apk's assets which can't be mapped
+    m_bufferVec = NGenFunc::FileToVec( filePath );
+    m_pData = m_bufferVec.data();
+    m_dataSize = m_bufferVec.size();
+#else
+    const int fileHandle = ::open( filePath.c_str(), O_RDONLY );
+    if( fileHandle != -1 )
+    {
+        struct stat fileStat;
+        if( (fstat( fileHandle, &fileStat ) == 0) && (fileStat.st_size > 0) )
+        {
+            void * pMap = mmap( nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fileHandle, 0 );
+            if( pMap != MAP_FAILED )
+            {
+                m_pData = static_cast<const char *>(pMap);
+                m_dataSize = fileStat.st_size;
+            }
+        }
+
+        // The mapping stays valid after the file is closed
+        ::close( fileHandle );
+    }
+#endif
+
+    if( m_pData == nullptr )
+    {
+        unmapFile();
+
+        throw NExcept::CCriticalException("Asset Archive Error!",
+            boost::str( boost::format("Can't map the asset archive (%s).\n\n%s\nLine: %s")
+                % filePath % __FUNCTION__ % __LINE__ ));
+    }
+}
+
+
+/************************************************************************
+*    DESC:  Unmap the archive file
+************************************************************************/
+void CAssetArchive::unmapFile()
+{
+#if defined(_WINDOWS)
+    if( m_pData != nullptr )
+        UnmapViewOfFile( m_pData );
+
+    if( m_pMapHandle != nullptr )
+        CloseHandle( m_pMapHandle );
+
+    if( m_pFileHandle != nullptr )
+        CloseHandle( m_pFileHandle );
+#elif defined(__ANDROID__)
+    m_bufferVec.clear();
+    m_bufferVec.shrink_to_fit();
+#else
+    if( m_pData != nullptr )
+        munmap( const_cast<char *>(m_pData), m_dataSize );
+#endif
+
+    m_pData = nullptr;
+    m_dataSize = 0;
+    m_pFileHandle = nullptr;
+    m_pMapHandle = nullptr;
+}
+
+
+/************************************************************************
+*    DESC:  Find the entry of the file. Returns nullptr if it's not in the archive
+************************************************************************/
+const NAssetArchive::SEntry * CAssetArchive::findEntry( const std::string & file ) const
+{
+    const std::string path = NAssetArchive::NormalizePath( file );
+    const uint64_t hash = NAssetArchive::HashPath( path );
+
+    const NAssetArchive::SEntry * pEnd = m_pEntry + m_pHeader->entryCount;
+    const NAssetArchive::SEntry * pEntry = std::lower_bound( m_pEntry, pEnd, hash,
+        []( const NAssetArchive::SEntry & entry, uint64_t value ) { return entry.hash < value; } );
+
+    // Paths with the same hash are next to each other
+    for( ; (pEntry != pEnd) && (pEntry->hash == hash); ++pEntry )
+    {
+        if( (pEntry->pathSize == path.size()) && (std::memcmp( m_pPath + pEntry->pathOffset, path.data(), path.size() ) == 0) )
+            return pEntry;
+    }
+
+    return nullptr;
+}
+
+
+/************************************************************************
+*    DESC:  Does the loose file override the archive
+************************************************************************/
+bool CAssetArchive::isLoose( const std::string & file ) const
+{
+    return m_looseOverride && SDL_GetPathInfo( file.c_str(), nullptr );
+}
+
+
+/************************************************************************
+*    DESC:  Decompress the entry into a stream
+************************************************************************/
+SDL_IOStream * CAssetArchive::decompress( const NAssetArchive::SEntry & entry, const std::string & file ) const
+{
+    std::vector<char> fileVec( entry.fileSize );
+    const char * pSource = m_pData + entry.offset;
+    bool result = false;
+
+#if defined(ASSET_ARCHIVE_LZ4)
+    if( entry.compression == NAssetArchive::LZ4 )
+        result = (LZ4_decompress_safe( pSource, fileVec.data(), (int)entry.size, (int)entry.fileSize ) == (int)entry.fileSize);
+#endif
+
+#if defined(ASSET_ARCHIVE_ZSTD)
+    if( entry.compression == NAssetArchive::ZSTD )
+        result = (ZSTD_decompress( fileVec.data(), fileVec.size(), pSource, entry.size ) == entry.fileSize);
+#endif
+
+    if( !result )
+        throw NExcept::CCriticalException("Asset Archive Error!",
+            boost::str( boost::format("Can't decompress the file (%s). Compression (%d) may not be built in.\n\n%s\nLine: %s")
+                % file % (int)entry.compression % __FUNCTION__ % __LINE__ ));
+
+    // The stream keeps its own copy of the file
+    SDL_IOStream * pStream = SDL_IOFromDynamicMem();
+    if( pStream != nullptr )
+    {
+        SDL_WriteIO( pStream, fileVec.data(), fileVec.size() );
+        SDL_SeekIO( pStream, 0, SDL_IO_SEEK_SET );
+    }
+
+    return pStream;
+}
@@ -0,0 +1,99 @@
+
+/************************************************************************
+*    FILE NAME:       assetarchive.h
+*
+*    DESCRIPTION:     Virtual file layer the loaders read through. Files
+*                     come from the mapped asset archive or as loose
+*                     files. Loose files override the archive so the data
+*                     can be edited during development
+************************************************************************/
+
+#pragma once
+
+// Game lib dependencies
+#include <utilities/assetarchiveformat.h>
+
+// Boost lib dependencies
+#include <boost/noncopyable.hpp>
+
+// Standard lib dependencies
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// Forward declaration(s)
+struct SDL_IOStream;
+
+class CAssetArchive : boost::noncopyable
+{
+public:
+
+    // Get the instance of the singleton class
+    static CAssetArchive & Instance()
+    {
+        static CAssetArchive assetArchive;
+        return assetArchive;
+    }
+
+    // Open the archive. Loose files are looked for first when override is set
+    // NOTE: Open the archive before anything is loaded from it
+    void open( const std::string & filePath, bool looseOverride = true );
+
+    // Close the archive
+    void close();
+
+    // Is an archive open
+    bool isOpen() const;
+
+    // Open the file for reading. Returns nullptr if the file can't be found
+    // NOTE: Files stored uncompressed are read from the mapped archive without a copy
+    SDL_IOStream * openIO( const std::string & file );
+
+    // Get the data of a file stored uncompressed in the archive. Returns nullptr
+    // if the file is loose, compressed or not in the archive
+    const void * getMemory( const std::string & file, size_t & size );
+
+private:
+
+    // Constructor
+    CAssetArchive();
+
+    // Destructor
+    virtual ~CAssetArchive();
+
+    // Map the archive file into memory
+    void mapFile( const std::string & filePath );
+
+    // Unmap the archive file
+    void unmapFile();
+
+    // Find the entry of the file. Returns nullptr if it's not in the archive
+    const NAssetArchive::SEntry * findEntry( const std::string & file ) const;
+
+    // Does the loose file override the archive
+    bool isLoose( const std::string & file ) const;
+
+    // Decompress the entry into a stream
+    SDL_IOStream * decompress( const NAssetArchive::SEntry & entry, const std::string & file ) const;
+
+private:
+
+    // The mapped archive
+    const char * m_pData;
+    size_t m_dataSize;
+
+    // Platform handles of the mapping
+    void * m_pFileHandle;
+    void * m_pMapHandle;
+
+    // Archive read into memory where it can't be mapped
+    std::vector<char> m_bufferVec;
+
+    // The header, the index sorted by hash and the path strings in the mapped archive
+    const NAssetArchive::SHeader * m_pHeader;
+    const NAssetArchive::SEntry * m_pEntry;
+    const char * m_pPath;
+
+    // Loose files override the archive
+    bool m_looseOverride;
+};
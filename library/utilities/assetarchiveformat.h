@@ -0,0 +1,116 @@
+
+/************************************************************************
+*    FILE NAME:       assetarchiveformat.h
+*
+*    DESCRIPTION:     Layout of the packed asset archive shared by the
+*                     packer and the runtime archive
+*
+*                     header | entry data | index | paths
+*
+*                     The entry data is aligned so the mapped archive can
+*                     be read in place. The index is sorted by the hash
+*                     of the path. Values are stored little endian
+************************************************************************/
+
+#pragma once
+
+// Standard lib dependencies
+#include <string>
+#include <cstdint>
+
+namespace NAssetArchive
+{
+    // "WPAK" at the start of the file
+    const uint32_t FILE_ID = 0x4b415057;
+    const uint32_t VERSION = 1;
+
+    // Entry data starts on this boundary
+    const uint32_t ALIGNMENT = 16;
+
+    enum ECompression : uint32_t
+    {
+        NONE,
+        LZ4,
+        ZSTD
+    };
+
+    struct SHeader
+    {
+        uint32_t fileId;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t alignment;
+
+        // Offset of the index and of the path strings from the start of the file
+        uint64_t indexOffset;
+        uint64_t pathOffset;
+    };
+
+    struct SEntry
+    {
+        // Hash of the path
+        uint64_t hash;
+
+        // Offset of the data from the start of the file and the size stored
+        uint64_t offset;
+        uint64_t size;
+
+        // Size of the file after decompressing
+        uint64_t fileSize;
+
+        // Offset of the path from the start of the path strings
+        uint32_t pathOffset;
+        uint32_t pathSize;
+
+        ECompression compression;
+        uint32_t unused;
+    };
+
+    static_assert( sizeof(SHeader) == 32, "Archive header has padding" );
+    static_assert( sizeof(SEntry) == 48, "Archive entry has padding" );
+
+    /************************************************************************
+    *    DESC:  Make the path the same no matter how it was written
+    *           ex: ".\data\\objects/x.png" is "data/objects/x.png"
+    ************************************************************************/
+    inline std::string NormalizePath( const std::string & path )
+    {
+        std::string result;
+        result.reserve( path.size() );
+
+        for( char c : path )
+        {
+            if( c == '\\' )
+                c = '/';
+
+            // Drop repeated separators
+            if( (c == '/') && !result.empty() && (result.back() == '/') )
+                continue;
+
+            result.push_back( c );
+
+            // Drop the current folder
+            if( (result.size() >= 2) && (result.compare( result.size() - 2, 2, "./" ) == 0) &&
+                ((result.size() == 2) || (result[result.size() - 3] == '/')) )
+                result.erase( result.size() - 2 );
+        }
+
+        return result;
+    }
+
+    /************************************************************************
+    *    DESC:  Hash of the normalized path. 64 bit FNV-1a
+    ************************************************************************/
+    inline uint64_t HashPath( const std::string & normalizedPath )
+    {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+
+        for( unsigned char c : normalizedPath )
+        {
+            hash ^= c;
+            hash *= 0x100000001b3ULL;
+        }
+
+        return hash;
+    }
+}
@@ -16,6 +16,7 @@
 // Game lib dependencies
 #include <utilities/smartpointers.h>
 #include <utilities/exceptionhandling.h>
+#include <utilities/assetarchive.h>
 
 // Boost lib dependencies
 #include <boost/format.hpp>
@@ -69,8 +70,8 @@ namespace NGenFunc
         if( terminate )
             terminatorSize = 1;
 
-        // Open file for reading
-        NSmart::scoped_SDL_filehandle_ptr<SDL_IOStream> scpFile( SDL_IOFromFile( file.c_str(), "rb" ) );
+        // Open file for reading from the asset archive or the loose file
+        NSmart::scoped_SDL_filehandle_ptr<SDL_IOStream> scpFile( CAssetArchive::Instance().openIO( file ) );
         if( scpFile.isNull() )
             throw NExcept::CCriticalException("File Load Error!",
                 boost::str( boost::format("Error Loading file (%s).\n\n%s\nLine: %s") % file % __FUNCTION__ % __LINE__ ));
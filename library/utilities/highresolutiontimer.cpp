@@ -17,7 +17,8 @@ CHighResTimer::CHighResTimer()
     : m_inverseTimerFrequency(0.0),
       m_lastTime(uint64_t(0.0)),
       m_elapsedTime(0.0),
-      m_fps(0.0f)
+      m_fps(0.0f),
+      m_frameCount(0)
 {
     // inverse it so that we can do a simple multiplication instead of division
     m_inverseTimerFrequency = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
@@ -80,6 +81,9 @@ void CHighResTimer::calcElapsedTime()
 
     // Reset the last time
     m_lastTime = time;
+
+    // The elapsed time is calculated once a frame
+    ++m_frameCount;
 }
 
 
@@ -111,3 +115,12 @@ double CHighResTimer::getTime()
 
     return (double)(time * m_inverseTimerFrequency);
 }
+
+
+/***************************************************************************
+*    DESC:  Get the number of frames the elapsed time was calculated for
+****************************************************************************/
+uint64_t CHighResTimer::getFrameCount()
+{
+    return m_frameCount;
+}
@@ -38,6 +38,9 @@ public:
     // Get the time
     double getTime();
 
+    // Get the number of frames the elapsed time was calculated for
+    uint64_t getFrameCount();
+
 private:
 
     // Constructor
@@ -61,4 +64,7 @@ private:
     // The frames per second
     float m_fps;
 
+    // Number of times the elapsed time was calculated
+    uint64_t m_frameCount;
+
 };
@@ -62,7 +62,13 @@ CSettings::CSettings() :
     m_tripleBuffering(false),
     m_saveByteCode(false),
     m_loadByteCode(false),
-    m_stripDebugInfo(false)
+    m_stripDebugInfo(false),
+    m_saveAotCode(false),
+    m_scriptTimeBudget(0.0),
+    m_scriptGCBudget(0.0),
+    m_scriptMemoryPool(false),
+    m_scriptMemoryPoolDebug(false),
+    m_archiveLooseOverride(true)
 {
     CWorldValue::setSectorSize( 512 );
     
@@ -136,6 +142,17 @@ void CSettings::loadXML()
                 m_engineVersion = std::atoi(infoNode.getAttribute("engineVersion"));
         }
 
+        // Get the asset archive. Empty reads all the files loose
+        const XMLNode archiveNode = m_mainNode.getChildNode("archive");
+        if( !archiveNode.isEmpty() )
+        {
+            if( archiveNode.isAttributeSet("file") )
+                m_archiveFile = archiveNode.getAttribute("file");
+
+            if( archiveNode.isAttributeSet("looseOverride") )
+                m_archiveLooseOverride = ( std::strcmp( archiveNode.getAttribute("looseOverride"), "true" ) == 0 );
+        }
+
         const XMLNode displayListNode = m_mainNode.getChildNode("display");
         if( !displayListNode.isEmpty() )
         {
@@ -313,6 +330,24 @@ void CSettings::loadXML()
 
                 if( scriptNode.isAttributeSet("stripDebugInfo") )
                     m_stripDebugInfo = ( std::strcmp( scriptNode.getAttribute("stripDebugInfo"), "true" ) == 0 );
+
+                if( scriptNode.isAttributeSet("saveAotCode") )
+                    m_saveAotCode = ( std::strcmp( scriptNode.getAttribute("saveAotCode"), "true" ) == 0 );
+
+                if( scriptNode.isAttributeSet("timeBudget") )
+                    m_scriptTimeBudget = std::atof( scriptNode.getAttribute("timeBudget") );
+
+                if( scriptNode.isAttributeSet("byteCodeCache") )
+                    m_byteCodeCache = scriptNode.getAttribute("byteCodeCache");
+
+                if( scriptNode.isAttributeSet("gcBudget") )
+                    m_scriptGCBudget = std::atof( scriptNode.getAttribute("gcBudget") );
+
+                if( scriptNode.isAttributeSet("memoryPool") )
+                    m_scriptMemoryPool = ( std::strcmp( scriptNode.getAttribute("memoryPool"), "true" ) == 0 );
+
+                if( scriptNode.isAttributeSet("memoryPoolDebug") )
+                    m_scriptMemoryPoolDebug = ( std::strcmp( scriptNode.getAttribute("memoryPoolDebug"), "true" ) == 0 );
             }
 
             // Get the sound settings
@@ -651,6 +686,75 @@ bool CSettings::getStripDebugInfo() const
     return m_stripDebugInfo;
 }
 
+/************************************************************************
+*    DESC:  Do we want to generate the C++ of the scripts compiled ahead of time
+************************************************************************/
+bool CSettings::getSaveAotCode() const
+{
+    return m_saveAotCode;
+}
+
+void CSettings::setSaveAotCode( bool value )
+{
+    m_saveAotCode = value;
+}
+
+/************************************************************************
+*    DESC:  Get the time in milliseconds spawned scripts can run a script update
+*           Zero is no limit
+************************************************************************/
+double CSettings::getScriptTimeBudget() const
+{
+    return m_scriptTimeBudget;
+}
+
+/************************************************************************
+*    DESC:  Get the folder script byte code is cached in. Empty is no cache
+************************************************************************/
+const std::string & CSettings::getByteCodeCache() const
+{
+    return m_byteCodeCache;
+}
+
+/************************************************************************
+*    DESC:  Get the time in microseconds the script garbage collector can run after a render
+*           Zero leaves the garbage collection to the script engine
+************************************************************************/
+double CSettings::getScriptGCBudget() const
+{
+    return m_scriptGCBudget;
+}
+
+/************************************************************************
+*    DESC:  Does the script engine use the memory pool and
+*           check for leaks when a group is freed
+************************************************************************/
+bool CSettings::getScriptMemoryPool() const
+{
+    return m_scriptMemoryPool;
+}
+
+bool CSettings::getScriptMemoryPoolDebug() const
+{
+    return m_scriptMemoryPoolDebug;
+}
+
+/************************************************************************
+*    DESC:  Get the asset archive file. Empty reads all the files loose
+************************************************************************/
+const std::string & CSettings::getArchiveFile() const
+{
+    return m_archiveFile;
+}
+
+/************************************************************************
+*    DESC:  Do loose files override the files in the asset archive
+************************************************************************/
+bool CSettings::isArchiveLooseOverride() const
+{
+    return m_archiveLooseOverride;
+}
+
 /************************************************************************
 *    DESC:  Get the sound frequency
 ************************************************************************/
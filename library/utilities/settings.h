@@ -117,6 +117,30 @@ public:
     bool getSaveByteCode() const;
     bool getLoadByteCode() const;
     bool getStripDebugInfo() const;
+
+    // Do we want to generate the C++ of the scripts compiled ahead of time
+    bool getSaveAotCode() const;
+    void setSaveAotCode( bool value );
+
+    // Get the time in milliseconds spawned scripts can run a script update. Zero is no limit
+    double getScriptTimeBudget() const;
+
+    // Get the folder script byte code is cached in. Empty is no cache
+    const std::string & getByteCodeCache() const;
+
+    // Get the time in microseconds the script garbage collector can run after a render
+    // Zero leaves the garbage collection to the script engine
+    double getScriptGCBudget() const;
+
+    // Does the script engine use the memory pool and check for leaks when a group is freed
+    bool getScriptMemoryPool() const;
+    bool getScriptMemoryPoolDebug() const;
+
+    // Get the asset archive file. Empty reads all the files loose
+    const std::string & getArchiveFile() const;
+
+    // Do loose files override the files in the asset archive
+    bool isArchiveLooseOverride() const;
     
     // Get the sound frequency
     int getFrequency() const;
@@ -282,4 +306,14 @@ private:
     bool m_saveByteCode;
     bool m_loadByteCode;
     bool m_stripDebugInfo;
+    bool m_saveAotCode;
+    double m_scriptTimeBudget;
+    std::string m_byteCodeCache;
+    double m_scriptGCBudget;
+    bool m_scriptMemoryPool;
+    bool m_scriptMemoryPoolDebug;
+
+    // Asset archive members
+    std::string m_archiveFile;
+    bool m_archiveLooseOverride;
 };
@@ -25,6 +25,10 @@ CStatCounter::CStatCounter() :
     m_cycleCounter(0),
     m_poolContexCounter(0),
     m_activeContexCounter(0),
+    m_parkedNodeCounter(0),
+    m_nodeAllocCounter(0),
+    m_gcSizeCounter(0),
+    m_gcDestroyedCounter(0),
     m_statsDisplayTimer(2000)
 {
     resetCounters();
@@ -91,6 +95,8 @@ void CStatCounter::resetCounters()
     m_physicsObjCounter = 0;
     m_elapsedFPSCounter = 0.0;
     m_cycleCounter = 0;
+    m_nodeAllocCounter = 0;
+    m_gcDestroyedCounter = 0;
 }
 
 
@@ -99,7 +105,7 @@ void CStatCounter::resetCounters()
 ************************************************************************/
 void CStatCounter::formatStatString()
 {
-    m_statStr = boost::str( boost::format("fps: %d - sca: %d - scp: %d - vis: %d - phy: %d - res: %d x %d")
+    m_statStr = boost::str( boost::format("fps: %d - sca: %d - scp: %d - vis: %d - phy: %d - res: %d x %d - pnd: %d - nal: %d - gcs: %d - gcd: %d")
         % ((int)(m_elapsedFPSCounter / (double)m_cycleCounter))
         % m_activeContexCounter
         % m_poolContexCounter
@@ -107,9 +113,16 @@ void CStatCounter::formatStatString()
         % (m_physicsObjCounter / m_cycleCounter)
         % CSettings::Instance().getSize().w
         % CSettings::Instance().getSize().h
+        % m_parkedNodeCounter
+        % m_nodeAllocCounter
+        % m_gcSizeCounter
+        % m_gcDestroyedCounter
         //% (playerPos.x)
         //% (playerPos.y)
         );
+
+    if( !m_scriptProfileStr.empty() )
+        m_statStr += " - prf: " + m_scriptProfileStr;
 }
 
 
@@ -147,3 +160,40 @@ void CStatCounter::setActiveContexCounter( int value )
 {
     m_activeContexCounter = value;
 }
+
+
+/************************************************************************
+*    DESC:  Inc the parked node counter
+************************************************************************/
+void CStatCounter::incParkedNodeCounter( int value )
+{
+    m_parkedNodeCounter += value;
+}
+
+
+/************************************************************************
+*    DESC:  Inc the pooled node allocation counter
+************************************************************************/
+void CStatCounter::incNodeAllocCounter()
+{
+    ++m_nodeAllocCounter;
+}
+
+
+/************************************************************************
+*    DESC:  Set the top script functions from the profiler
+************************************************************************/
+void CStatCounter::setScriptProfile( const std::string & profile )
+{
+    m_scriptProfileStr = profile;
+}
+
+
+/************************************************************************
+*    DESC:  Set the script garbage collector counters
+************************************************************************/
+void CStatCounter::setScriptGCCounters( uint currentSize, uint destroyed )
+{
+    m_gcSizeCounter = currentSize;
+    m_gcDestroyedCounter += destroyed;
+}
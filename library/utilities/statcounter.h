@@ -41,6 +41,18 @@ public:
     // Set the contex counters
     void setPoolContexCounter( size_t value );
     void setActiveContexCounter( int value );
+
+    // Inc the parked node counter
+    void incParkedNodeCounter( int value = 1 );
+
+    // Inc the pooled node allocation counter
+    void incNodeAllocCounter();
+
+    // Set the top script functions from the profiler
+    void setScriptProfile( const std::string & profile );
+
+    // Set the script garbage collector counters
+    void setScriptGCCounters( uint currentSize, uint destroyed );
     
     // Connect/Disconnect to the signal
     void connect( const statCounterSignal_t::slot_type & slot );
@@ -75,6 +87,17 @@ private:
     size_t m_poolContexCounter;
     int m_activeContexCounter;
 
+    // Node pool counters
+    int m_parkedNodeCounter;
+    int m_nodeAllocCounter;
+
+    // Top script functions from the profiler
+    std::string m_scriptProfileStr;
+
+    // Script garbage collector counters
+    uint m_gcSizeCounter;
+    uint m_gcDestroyedCounter;
+
     // Stat string
     std::string m_statStr;
 
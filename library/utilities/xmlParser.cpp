@@ -53,6 +53,9 @@
 // SDL lib dependencies
 #include <SDL3/SDL.h>
 
+// Game lib dependencies
+#include <utilities/assetarchive.h>
+
 // disable warning about unsafe functions
 #if defined(_WINDOWS)
 #pragma warning(disable : 4996)
@@ -427,7 +430,7 @@ XMLNode XMLNode::openFileHelper(XMLCSTR filename, XMLCSTR tag)
 
     #else*/
     
-    SDL_IOStream *f=SDL_IOFromFile(filename,_CXML("rb"));
+    SDL_IOStream *f=CAssetArchive::Instance().openIO(filename);
     if (f)
     {
         char bb[205];
@@ -1936,7 +1939,7 @@ XMLNode XMLNode::parseFile(XMLCSTR filename, XMLCSTR tag, XMLResults *pResults)
     l=(int)fread(buf,1,l,f);
     fclose(f);
     #else*/
-    SDL_IOStream *f=SDL_IOFromFile(filename,_CXML("rb"));
+    SDL_IOStream *f=CAssetArchive::Instance().openIO(filename);
     if (f==NULL) { if (pResults) pResults->error=eXMLErrorFileNotFound; return emptyXMLNode; }
     int l=SDL_SeekIO(f, 0, SDL_IO_SEEK_END), headerSz=0;
     //int l=SDL_RWtell(f), headerSz=0;
@@ -11,9 +11,11 @@
 // Game lib dependencies
 #include <script/scriptmanager.h>
 #include <utilities/exceptionhandling.h>
+#include <utilities/settings.h>
 
 // Standard lib dependencies
 #include <string>
+#include <cstring>
 #include <ctime>
 
 // SDL lib dependencies
@@ -25,13 +27,18 @@ int main( int argc, char* args[] )
 
     CGame game;
 
+    // Only generate the C++ of the scripts compiled ahead of time
+    const bool saveAotCode = (argc > 1) && (std::strcmp( args[1], "--save-aot-code" ) == 0);
+    if( saveAotCode )
+        CSettings::Instance().setSaveAotCode( true );
+
     try
     {
         // Create the game
         game.create();
 
         // Call the game loop
-        while( CScriptMgr::Instance().update() )
+        while( !saveAotCode && CScriptMgr::Instance().update() )
         { }
     }
     catch( NExcept::CCriticalException & ex )